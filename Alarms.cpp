@@ -0,0 +1,295 @@
+/*
+Alarms.cpp
+The alarm table, working out the next alarm due, and ringing, snoozing & stopping.
+The table is read straight out of EEPROM whenever the next alarm is worked out, which is only when one has gone off
+or the time or the table has changed, so none of it sits in RAM.
+*/
+
+#include "Alarms.h"
+#include "ClockDrivers.h"
+#include <EEPROM.h>
+
+#define SLOT_ADDRESS(n)		(EEPROM_ALARM_LOCATION + ((n) * sizeof(alarmEntry_t)))
+#define SECS_PER_DAY		86400UL
+
+extern ClockRtc RTClock;	// Real-time clock object
+
+AlarmTable::AlarmTable()
+{
+	state = ALARM_IDLE;
+	flash = false;
+	next.hour = ALARM_EMPTY;
+	loadedDate = RTC_ALARM_NEVER;
+	dueIn = 0;
+	snoozeIn = 0;
+	snoozeAt = 0;
+	ringLeft = 0;
+	rung = snoozes = checks = 0;
+}
+
+// Read one slot. Returns false for an empty one (or one that isn't a time at all), which ends the table
+bool AlarmTable::read(uint8_t slot, alarmEntry_t *e)
+{
+	EEPROM.get(SLOT_ADDRESS(slot), *e);
+	return (e->hour < 24) && (e->min < 60);
+}
+
+// Entries in the table
+uint8_t AlarmTable::count()
+{
+	alarmEntry_t e;
+	uint8_t n;
+
+	for (n = 0; (n < ALARM_SLOTS) && read(n, &e); ++n)
+		;
+	return n;
+}
+
+// Look up the entry for a time
+bool AlarmTable::find(uint8_t hour, uint8_t min, alarmEntry_t *e)
+{
+	uint8_t i;
+
+	for (i = 0; (i < ALARM_SLOTS) && read(i, e); ++i)
+		if ((e->hour == hour) && (e->min == min))
+			return true;
+	return false;
+}
+
+/*
+Take out the entry at oldHour:oldMin (if there is one) and put 'e' in, in time order. An entry already at e's time
+is replaced. e->days of 0 just takes the old one out. Returns false if the table is full.
+Only the bytes that change are written. Call schedule() afterwards.
+*/
+bool AlarmTable::replace(uint8_t oldHour, uint8_t oldMin, const alarmEntry_t *e)
+{
+	alarmEntry_t table[ALARM_SLOTS], cur;
+	uint8_t n = 0, i;
+
+	for (i = 0; (i < ALARM_SLOTS) && read(i, &cur); ++i)
+		if (!((cur.hour == oldHour) && (cur.min == oldMin)) && !((cur.hour == e->hour) && (cur.min == e->min)))
+			table[n++] = cur;
+
+	if (e->days != 0)
+	{
+		if (n == ALARM_SLOTS)
+			return false;
+		for (i = n++; (i > 0) && ((table[i - 1].hour > e->hour) || ((table[i - 1].hour == e->hour) && (table[i - 1].min > e->min))); --i)
+			table[i] = table[i - 1];
+		table[i] = *e;
+	}
+
+	for (i = 0; i < ALARM_SLOTS; ++i)
+	{
+		if (i >= n)
+			table[i].hour = table[i].min = table[i].days = ALARM_EMPTY;
+		EEPROM.put(SLOT_ADDRESS(i), table[i]);		// put() uses update(), so bytes that match aren't rewritten
+	}
+	return true;
+}
+
+/*
+Work out the next alarm due after 'now' and load it into the RTC's alarm 2
+The table's in time order, so the first entry that's on for a day (and hasn't gone by, today) is that day's next.
+A week on from today catches an alarm that's only on today's day of the week and has already gone off.
+The RTC's alarm is only written when the next alarm has moved.
+*/
+void AlarmTable::schedule(const struct ts *now)
+{
+	alarmEntry_t e;
+	struct ts at;
+	uint32_t secs = RTClockClass::toSeconds(now);
+	uint32_t sod = secs % SECS_PER_DAY, t;
+	uint8_t today = (secs / SECS_PER_DAY + 6) % 7;		// 1/1/2000 was a Saturday. 0 = Sunday
+	uint8_t d, i;
+
+	dueIn = 0;
+	for (d = 0; (d <= 7) && !dueIn; ++d)
+	{
+		for (i = 0; (i < ALARM_SLOTS) && read(i, &e); ++i)
+		{
+			t = e.hour * 3600UL + e.min * 60;
+			if ((e.days & ALARM_ON) && (e.days & (1 << ((today + d) % 7))) && ((d > 0) || (t > sod)))
+			{
+				dueIn = d * SECS_PER_DAY + t - sod;
+				break;
+			}
+		}
+	}
+
+	if (!dueIn)
+	{
+		next.hour = ALARM_EMPTY;
+		if (state == ALARM_ARMED)
+			state = ALARM_IDLE;
+		return;
+	}
+
+	RTClockClass::fromSeconds(secs + dueIn, &at);
+	if ((e.hour != next.hour) || (e.min != next.min) || (at.mday != loadedDate))
+	{
+		RTClock.setAlarm(RTC_ALARM_2, &at);
+		loadedDate = at.mday;
+	}
+	next = e;
+	if (state == ALARM_IDLE)
+		state = ALARM_ARMED;
+}
+
+/*
+Once a second, from the RTC tick. Counts down to the next alarm and the end of a snooze, and flashes the mark while
+it's ringing. Returns true if the mark on the face has changed
+*/
+bool AlarmTable::tick()
+{
+	uint8_t mark = getMark();
+
+	if (state == ALARM_RINGING)
+	{
+		flash = !flash;
+		if (--ringLeft == 0)
+			stop();
+	}
+	if (dueIn && (--dueIn == 0))
+		check();
+	if ((state == ALARM_SNOOZED) && snoozeIn && (--snoozeIn == 0))
+		check();
+
+	return getMark() != mark;
+}
+
+/*
+The count says an alarm is due. The RTC's flags say whether it's gone off. If it hasn't yet the count was ahead, and
+working the next one out again from the RTC's time puts it right
+*/
+void AlarmTable::check()
+{
+	uint8_t fired = RTClock.takeAlarms();
+	uint32_t secs;
+
+	++checks;
+	RTClock.readTime();
+	secs = RTClockClass::toSeconds(RTClock.getTime());
+	if ((state == ALARM_SNOOZED) && (snoozeIn == 0))
+	{
+		if ((fired & DS3231_A1F) || (secs >= snoozeAt))
+			ring();
+		else
+			snoozeIn = snoozeAt - secs;
+	}
+	if ((fired & DS3231_A2F) && (next.hour != ALARM_EMPTY))
+		ring();
+	schedule(RTClock.getTime());
+}
+
+void AlarmTable::ring()
+{
+	state = ALARM_RINGING;
+	flash = true;
+	ringLeft = ALARM_RING_LIMIT;
+	snoozeIn = 0;
+	++rung;
+}
+
+// Snooze a ringing alarm. It comes back ALARM_SNOOZE from now, off the RTC's alarm 1
+bool AlarmTable::snooze()
+{
+	struct ts at;
+
+	if (state != ALARM_RINGING)
+		return false;
+	RTClock.readTime();
+	snoozeAt = RTClockClass::toSeconds(RTClock.getTime()) + ALARM_SNOOZE;
+	RTClockClass::fromSeconds(snoozeAt, &at);
+	RTClock.setAlarm(RTC_ALARM_1, &at);
+	snoozeIn = ALARM_SNOOZE;
+	state = ALARM_SNOOZED;
+	++snoozes;
+	return true;
+}
+
+// Stop a ringing or snoozed alarm. The table's next alarm stays armed
+bool AlarmTable::stop()
+{
+	if (!isSounding())
+		return false;
+	snoozeIn = 0;
+	state = (next.hour != ALARM_EMPTY) ? ALARM_ARMED : ALARM_IDLE;
+	return true;
+}
+
+uint8_t AlarmTable::getMark()
+{
+	switch (state)
+	{
+	case ALARM_ARMED:
+		return ALARM_MARK_ARMED;
+	case ALARM_RINGING:
+		return flash ? ALARM_MARK_RING : ALARM_MARK_ARMED;
+	case ALARM_SNOOZED:
+		return ALARM_MARK_SNOOZE;
+	}
+	return ALARM_MARK_NONE;
+}
+
+// HH:MM
+void AlarmTable::printTime(Print *out, uint8_t hour, uint8_t min)
+{
+	if (hour < 10)
+		out->print('0');
+	out->print(hour);
+	out->print(':');
+	if (min < 10)
+		out->print('0');
+	out->print(min);
+}
+
+/*
+Print one line of the report. The state and next alarm (seconds to go), the counts since boot, then the table
+	alarm state 1 next 07:30 in 3600
+	alarm rung 2 snoozed 1 checks 3
+	alarm 1 07:30 on SMTWTFS
+Returns false once there are no more lines
+*/
+bool AlarmTable::printLine(Print *out, uint8_t line)
+{
+	alarmEntry_t e;
+	const char *days = "SMTWTFS";
+	uint8_t i;
+
+	switch (line)
+	{
+	case 0:
+		out->print(F("alarm state "));
+		out->print(state);
+		if (next.hour != ALARM_EMPTY)
+		{
+			out->print(F(" next "));
+			printTime(out, next.hour, next.min);
+			out->print(F(" in "));
+			out->print(dueIn);
+		}
+		out->println();
+		return true;
+	case 1:
+		out->print(F("alarm rung "));
+		out->print(rung);
+		out->print(F(" snoozed "));
+		out->print(snoozes);
+		out->print(F(" checks "));
+		out->println(checks);
+		return true;
+	}
+
+	if ((line - 2 >= ALARM_SLOTS) || !read(line - 2, &e))
+		return false;
+	out->print(F("alarm "));
+	out->print(line - 1);
+	out->print(' ');
+	printTime(out, e.hour, e.min);
+	out->print((e.days & ALARM_ON) ? F(" on  ") : F(" off "));
+	for (i = 0; i < 7; ++i)
+		out->print((e.days & (1 << i)) ? days[i] : '-');
+	out->println();
+	return true;
+}
@@ -0,0 +1,102 @@
+// Alarms.h
+// Alarm table in EEPROM, with the next one due loaded into the DS3231's alarm registers
+
+#ifndef _ALARMS_h
+#define _ALARMS_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include "RTClock.h"
+
+/*
+The table
+ALARM_SLOTS entries of hour, minute and days, kept in time-of-day order with the empty slots at the end. An empty slot
+has ALARM_EMPTY for the hour, which is what blank EEPROM reads as. The days byte has a bit per day of the week
+(Sunday is bit 0) and ALARM_ON. An entry is known by its time: there's only ever one per hour & minute.
+*/
+#define ALARM_SLOTS			8
+#define ALARM_EMPTY			0xFF
+#define ALARM_ON			0x80
+#define ALARM_EVERY_DAY		0x7F
+#define ALARM_SETUP_HOUR	7		// Where an alarm made on the setup screen starts out
+#define ALARM_SETUP_MIN		0
+
+typedef struct
+{
+	uint8_t hour;			// 0-23, or ALARM_EMPTY
+	uint8_t min;
+	uint8_t days;			// Bit per day, Sunday = bit 0, plus ALARM_ON
+} alarmEntry_t;
+
+#define ALARM_SNOOZE		540		// s. Nine minutes
+#define ALARM_RING_LIMIT	600		// s a ring goes on for if nobody touches the clock
+
+// States
+#define ALARM_IDLE			0		// Nothing on in the table
+#define ALARM_ARMED			1		// Next one is loaded into the RTC's alarm 2
+#define ALARM_RINGING		2
+#define ALARM_SNOOZED		3		// Comes back at the time loaded into alarm 1
+
+// What the mark on the face shows (ClockDisplay)
+#define ALARM_MARK_NONE		0
+#define ALARM_MARK_ARMED	1		// "ALM"
+#define ALARM_MARK_RING		2		// "ALM" inverted. Alternates with ALARM_MARK_ARMED each second while it rings
+#define ALARM_MARK_SNOOZE	3		// "SNZ"
+
+// Serial link controls (LINK_ALARM_CTRL)
+#define ALARM_CTRL_SNOOZE	0
+#define ALARM_CTRL_STOP		1
+
+#define ALARM_REPORT_LINE	40		// Longest line printLine() writes
+
+/*
+Costs nothing between alarms. The RTC does the matching, and tick() only counts the 1Hz ticks down to the next
+alarm (or the end of a snooze). On the tick it's due the RTC's flags are read to see that it really went off, the
+next one is loaded, and that's the only I2C. A count that has gone wrong (missed ticks, the time being set) only
+shows up as a flag that isn't there yet or is already waiting, so it's put right from the RTC at that point.
+Call schedule() whenever the time or the table has changed.
+*/
+class AlarmTable
+{
+public:
+	AlarmTable();
+	void schedule(const struct ts *now);
+	bool tick();
+	bool snooze();
+	bool stop();
+	uint8_t getState() { return state; }
+	bool isRinging() { return state == ALARM_RINGING; }
+	bool isSounding() { return (state == ALARM_RINGING) || (state == ALARM_SNOOZED); }
+	uint8_t getMark();
+	uint32_t getDueIn() { return dueIn; }
+	bool getNext(alarmEntry_t *e) { *e = next; return next.hour != ALARM_EMPTY; }
+	uint8_t count();
+	bool read(uint8_t slot, alarmEntry_t *e);
+	bool find(uint8_t hour, uint8_t min, alarmEntry_t *e);
+	bool replace(uint8_t oldHour, uint8_t oldMin, const alarmEntry_t *e);
+	bool printLine(Print *out, uint8_t line);
+	uint16_t getRung() { return rung; }
+	uint16_t getSnoozes() { return snoozes; }
+	uint16_t getChecks() { return checks; }
+
+private:
+	uint8_t state;
+	bool flash;						// Ring mark inverted this second
+	alarmEntry_t next;				// Next table alarm, as loaded into alarm 2
+	uint8_t loadedDate;				// Date alarm 2 is loaded for. RTC_ALARM_NEVER if it isn't
+	uint32_t dueIn;					// Ticks until next goes off. 0 = nothing to count down to
+	uint16_t snoozeIn;				// Ticks until the snooze runs out
+	uint32_t snoozeAt;				// When it does, in RTC seconds (since 2000)
+	uint16_t ringLeft;				// Ticks left before a ring stops by itself
+	uint16_t rung, snoozes, checks;	// Rings, snoozes and RTC flag reads since boot
+
+	void check();
+	void ring();
+	void printTime(Print *out, uint8_t hour, uint8_t min);
+};
+
+#endif // _ALARMS_h
@@ -1,233 +1,385 @@
-#include "ClockDigit.h"
-#include "ClockDisplay.h"
-
-// Font definition file
-#include "MSTahomaBold48.c"
-
-#include "ClockDisplay.h" // Need for number base definitions
-
-ClockDigit::ClockDigit()
-{
-}
-
-/*
-Initialize character
-c = char being displayed
-w,h - width, height of character
-x, y - X/Y coordinates for lower left corner of the digit
-u - unit type
-*/
-void ClockDigit::setup(char c, int w, int h, uint16_t x, uint16_t y, uint8_t u)
-{
-	dChar = c;
-	oldDChar = '\0';
-	updatedHex = updatedBinary = true;
-	tVal = 0;
-	uType = u;
-	currx = x;
-	curry = y;
-}
-
-ClockDigit::~ClockDigit()
-{
-}
-
-// Custom fonts don't automatically erase when overwritten. Need to help it along
-void ClockDigit::eraseChar(RA8875 *disp, uint16_t bgColor)
-{
-	if (oldDChar != '\0')
-	{
-		// Set cursor, color, & print character
-		disp->setCursor(currx, curry);
-		disp->setTextColor(bgColor, bgColor);		// "erase" character by printing the character in the background color
-		disp->print(oldDChar);
-	}
-	return;
-}
-
-// Update the binary display at the bottom of the screen
-int ClockDigit::drawBinary(RA8875 *disp, uint16_t fg, uint16_t bg)
-{
-	char binChars[5];
-	int i;
-	int16_t x, y;
-
-	// Only draw if character has been updated, because need to erase old one first
-	if (updatedBinary == false)
-		return;
-
-	// Create a null-terminated string representation of the binary number
-	for (i = 0; i < 4; ++i)
-	{
-		if (tVal & (0x1 << i))
-			binChars[3 - i] = '1';
-		else
-			binChars[3 - i] = '0';
-	}
-	binChars[4] = '\0';
-
-	// Prepare to print
-	disp->setFont(INT);  // Reset to default (small) font for binary display
-	disp->setFontScale(BINFONTSIZE);
-	disp->setTextColor(fg, bg);
-
-	// Set cursur to appropriate location
-	switch (uType) {
-	case HRHIGH:
-		x = X_BINTIME + X_BIN_OFFSET_HIGH;
-		y = Y_BIN_1;
-		break;
-	case HRLOW:
-		x = X_BINTIME + X_BIN_OFFSET_LOW;
-		y = Y_BIN_1;
-		break;
-	case MNHIGH:
-		x = X_BINTIME + X_BIN_OFFSET_HIGH;
-		y = Y_BIN_2;
-		break;
-	case MNLOW:
-		x = X_BINTIME + X_BIN_OFFSET_LOW;
-		y = Y_BIN_2;
-		break;
-	case SEHIGH:
-		x = X_BINTIME + X_BIN_OFFSET_HIGH;
-		y = Y_BIN_3;
-		break;
-	case SELOW:
-		x = X_BINTIME + X_BIN_OFFSET_LOW;
-		y = Y_BIN_3;
-		break;
-	case MOHIGH:
-		x = X_BINDATE + X_BIN_OFFSET_HIGH;
-		y = Y_BIN_1;
-		break;
-	case MOLOW:
-		x = X_BINDATE + X_BIN_OFFSET_LOW;
-		y = Y_BIN_1;
-		break;
-	case DYHIGH:
-		x = X_BINDATE + X_BIN_OFFSET_HIGH;
-		y = Y_BIN_2;
-		break;
-	case DYLOW:
-		x = X_BINDATE + X_BIN_OFFSET_LOW;
-		y = Y_BIN_2;
-		break;
-	case YRHIGH:
-		x = X_BINDATE + X_BIN_OFFSET_HIGH;
-		y = Y_BIN_3;
-		break;
-	case YRLOW:
-		x = X_BINDATE + X_BIN_OFFSET_LOW;
-		y = Y_BIN_3;
-		break;
-	}
-
-	disp->setCursor(x, y);
-	disp->print(binChars);
-	updatedBinary = false; // reset updated flag to prevent unnecessary redrawing
-
-	return;
-}
-
-/* 
-Draw the digit character on the screen
-fg, bg - foreground & backgrond color for the digit
-*/
-void ClockDigit::drawChar(RA8875 *disp, uint16_t fg, uint16_t bg)
-{
-	// Only draw if character has been updated, because we need to erase old one first
-	if (updatedHex == false)
-		return;
-
-	disp->setFont(&MSTahomaBold48);	// Set to large font
-	disp->setFontScale(HEXFONTSIZE);
-	if (oldDChar != '\0')
-		eraseChar(disp, bg); // erase the char currently at that location
-	
-	// Set cursor, color, & print character
-	disp->setCursor(currx, curry);
-	disp->setTextColor(fg, bg);
-	disp->print(dChar);
-	
-	updatedHex = false; // reset updated flag to prevent unnecessary redrawing
-
-	return;
-}
-
-// Update the character stored in the digit
-bool ClockDigit::setNewChar(uint8_t t, char c, int mode)
-{
-	updatedHex = updatedBinary = false;	// Begin with the assumption that nothing has changed.
-
-	// t is the value of the digit. 'c' is the character
-	if ((c == dChar) && (t == tVal) && (mode != REFRESH_ALL)) // Same character & binary, no forced update
-	{
-		updatedHex = updatedBinary = false;
-		return false;
-	}
-	
-	if ((c != dChar) || (mode == REFRESH_ALL))
-	{
-		// New char. Make some changes
-		oldDChar = dChar;	// Need to save the last character so we can erase it
-		dChar = c;			// The new character
-		updatedHex = true;
-	}
-
-	if ((t != tVal) || (mode == REFRESH_ALL))
-	{
-		tVal = t;			// Value of the unit
-		updatedBinary = true;
-	}
-
-	return (updatedHex || updatedBinary);	// Something has changed
-}
-
-
-AmPmDot::AmPmDot()
-{
-}
-
-AmPmDot::~AmPmDot()
-{
-}
-
-void AmPmDot::setup(uint8_t x, uint8_t y, uint8_t r)
-{
-	xLoc = x;
-	yLoc = y;
-	radius = r;
-	on = false;
-}
-
-void AmPmDot::eraseDot(RA8875 *disp, uint16_t color)
-{
-	if (on)	// Only erase if already displayed - eliminates flicker
-	{
-		disp->drawCircle(xLoc, yLoc, radius, color);
-		disp->fillCircle(xLoc, yLoc, radius, color);
-		on = false;
-	}
-}
-
-void AmPmDot::drawDot(RA8875 *disp, uint16_t color)
-{
-	if (!on) // Only draw if already erased - eliminates flicker
-	{
-		disp->drawCircle(xLoc, yLoc, radius, color);
-		disp->fillCircle(xLoc, yLoc, radius, color);
-		on = true;
-	}
-}
-
-void AmPmDot::refreshDot(RA8875 *disp, uint16_t color)
-{
-	if (on)
-	{
-		disp->drawCircle(xLoc, yLoc, radius, color);
-		disp->fillCircle(xLoc, yLoc, radius, color);
-	}
-}
-
-
+#include "ClockDigit.h"
+#include "ClockDisplay.h"
+#include "Profiler.h"
+
+#if FACE_DIGITS
+// Font definition file
+#include "MSTahomaBold48.c"
+#endif
+
+#include "ClockDisplay.h" // Need for number base definitions
+
+ClockDigit::ClockDigit()
+{
+}
+
+/*
+Initialize character
+c = char being displayed
+u - unit type. Where it goes on the screen comes from its cell in the layout table (Layout.h)
+*/
+void ClockDigit::setup(char c, uint8_t u)
+{
+	dChar = c;
+	oldDChar = '\0';
+	updatedHex = updatedBinary = true;
+	tVal = 0;
+	uType = u;
+}
+
+ClockDigit::~ClockDigit()
+{
+}
+
+#if FACE_DIGITS
+// Custom fonts don't automatically erase when overwritten. Need to help it along
+void ClockDigit::eraseChar(ClockScreen *disp, uint16_t bgColor)
+{
+	if (oldDChar != '\0')
+	{
+		// Set cursor, color, & print character
+		disp->setCursor(layoutX(uType), layoutY(uType));
+		disp->setTextColor(bgColor, bgColor);		// "erase" character by printing the character in the background color
+		disp->print(oldDChar);
+		PROF_SPI(3);
+	}
+	return;
+}
+
+#endif
+
+#if FACE_BINARY
+// Update the binary display at the bottom of the screen
+void ClockDigit::drawBinary(ClockScreen *disp, uint16_t fg, uint16_t bg)
+{
+	char binChars[5];
+	int i;
+
+	// Only draw if character has been updated, because need to erase old one first
+	if (updatedBinary == false)
+		return;
+
+	PROF_STAGE(PROF_DRAWBINARY);
+
+	// Create a null-terminated string representation of the binary number
+	for (i = 0; i < 4; ++i)
+	{
+		if (tVal & (0x1 << i))
+			binChars[3 - i] = '1';
+		else
+			binChars[3 - i] = '0';
+	}
+	binChars[4] = '\0';
+
+	// Prepare to print
+	disp->setFont(INT);  // Reset to default (small) font for binary display
+	disp->setFontScale(BINFONTSIZE);
+	disp->setTextColor(fg, bg);
+
+	// Set cursor to this digit's place in the binary rows
+	disp->setCursor(layoutBinX(uType), layoutBinY(uType));
+	disp->print(binChars);
+	PROF_SPI(5);
+	updatedBinary = false; // reset updated flag to prevent unnecessary redrawing
+
+	return;
+}
+
+#endif
+
+#if FACE_DIGITS
+#define GLYPH_SCALE		(HEXFONTSIZE + 1)	// Screen pixels per font pixel. setFontScale(n) draws the font n+1 times size
+#define GLYPH_TOP_BIT	0x80000000UL
+
+// A run of pixels being painted. Stays open while the rows below repeat it
+typedef struct
+{
+	uint8_t start, len;		// Font columns
+	uint8_t top;			// Row it started on
+	bool set;				// Foreground (true) or background
+} paintSpan_t;
+
+// The glyph for a character in the big font. NULL if the font doesn't have it
+static const tImage *glyphOf(char c)
+{
+	uint8_t i;
+
+	for (i = 0; i < MSTahomaBold48.length; ++i)
+	{
+		if (pgm_read_byte(&MSTahomaBold48.chars[i].char_code) == (uint8_t)c)
+			return (const tImage *)pgm_read_ptr(&MSTahomaBold48.chars[i].image);
+	}
+	return NULL;
+}
+
+static uint8_t glyphWidth(const tImage *img)
+{
+	return img ? pgm_read_byte(&img->image_width) : 0;
+}
+
+/*
+One row of a glyph, leftmost pixel in the top bit. The rows are packed end to end, so a row can start anywhere in a
+byte. A missing glyph reads as blank. Only for glyphs up to REPAINT_MAX_WIDTH wide.
+*/
+static uint32_t glyphRow(const tImage *img, uint8_t row)
+{
+	const uint8_t *data;
+	uint16_t bit, len, i;
+	uint8_t w, shift;
+	uint32_t v = 0;
+
+	if (!img)
+		return 0;
+	w = pgm_read_byte(&img->image_width);
+	data = (const uint8_t *)pgm_read_ptr(&img->data);
+	len = pgm_read_word(&img->image_datalen);
+	bit = (uint16_t)row * w;
+	shift = bit & 7;
+	for (i = bit >> 3; i < (bit >> 3) + 4; ++i)
+		v = (v << 8) | ((i < len) ? pgm_read_byte(&data[i]) : 0);
+	if (shift)
+		v = (v << shift) | ((i < len) ? (pgm_read_byte(&data[i]) >> (8 - shift)) : 0);
+	if (w < 32)
+		v &= ~(0xFFFFFFFFUL >> w);
+	return v;
+}
+
+/*
+Paint the new character (dChar) over the old one (oldDChar) with our own rectangles, REPAINT_OPAQUE or REPAINT_DELTA.
+Works across the wider of the two, so an opaque box covers the old one whatever its width, and a delta clears what's
+left of it. REPAINT_INK paints the new one's strokes alone, and the old one doesn't come into it. With draw false it
+only counts. Returns the rectangles, with the pixels they cover, or 0xFFFF if a row has more than REPAINT_SPANS runs
+to paint.
+*/
+uint16_t ClockDigit::paintRuns(ClockScreen *disp, uint16_t fg, uint16_t bg, uint8_t how, bool draw, uint32_t *pixels)
+{
+	paintSpan_t open[REPAINT_SPANS], next[REPAINT_SPANS];
+	const tImage *was = (how == REPAINT_INK) ? NULL : glyphOf(oldDChar), *now = glyphOf(dChar);
+	uint8_t h = MSTahomaBold48.font_height, w, nOpen = 0, nNext, row, col, len, i, j;
+	int16_t x = layoutX(uType), y = layoutY(uType);
+	uint32_t n, diff;
+	uint16_t rects = 0;
+	bool set, changed;
+
+	w = (glyphWidth(was) > glyphWidth(now)) ? glyphWidth(was) : glyphWidth(now);
+	*pixels = 0;
+	if (how == REPAINT_OPAQUE)
+	{
+		++rects;
+		*pixels = (uint32_t)w * h * GLYPH_SCALE * GLYPH_SCALE;
+		if (draw)
+			disp->fillRect(x, y, w * GLYPH_SCALE, h * GLYPH_SCALE, bg);
+	}
+
+	for (row = 0; row <= h; ++row)		// The row past the bottom has no runs, which finishes the open ones
+	{
+		nNext = 0;
+		if (row < h)
+		{
+			n = glyphRow(now, row);
+			diff = glyphRow(was, row) ^ n;
+			for (col = 0; col < w; col += len)
+			{
+				set = (n & GLYPH_TOP_BIT) != 0;
+				changed = false;
+				for (len = 0; (col + len < w) && (((n & GLYPH_TOP_BIT) != 0) == set); ++len, n <<= 1, diff <<= 1)
+					changed |= (diff & GLYPH_TOP_BIT) != 0;
+				if ((how == REPAINT_DELTA) ? !changed : !set)
+					continue;
+				if (nNext == REPAINT_SPANS)
+					return 0xFFFF;
+				next[nNext].start = col;
+				next[nNext].len = len;
+				next[nNext].top = row;
+				next[nNext++].set = set;
+			}
+		}
+
+		for (i = 0; i < nOpen; ++i)
+		{
+			for (j = 0; j < nNext; ++j)
+			{
+				if ((next[j].start == open[i].start) && (next[j].len == open[i].len) && (next[j].set == open[i].set))
+					break;
+			}
+			if (j < nNext)		// Carries on
+			{
+				next[j].top = open[i].top;
+				continue;
+			}
+			++rects;
+			*pixels += (uint32_t)open[i].len * (row - open[i].top) * GLYPH_SCALE * GLYPH_SCALE;
+			if (draw)
+				disp->fillRect(x + open[i].start * GLYPH_SCALE, y + open[i].top * GLYPH_SCALE, open[i].len * GLYPH_SCALE,
+					(row - open[i].top) * GLYPH_SCALE, open[i].set ? fg : bg);
+		}
+		memcpy(open, next, nNext * sizeof(paintSpan_t));
+		nOpen = nNext;
+	}
+	if (draw)
+		PROF_SPI(rects);
+	return rects;
+}
+
+/* 
+Draw the digit character on the screen
+fg, bg - foreground & backgrond color for the digit
+cheapest - paint it whichever of REPAINT_OPAQUE and REPAINT_DELTA is estimated to cost less, instead of erasing &
+           drawing. Only good while the screen holds exactly the old character in these colors.
+Returns how it was drawn (REPAINT_*)
+*/
+uint8_t ClockDigit::drawChar(ClockScreen *disp, uint16_t fg, uint16_t bg, bool cheapest)
+{
+	uint32_t cost, best = 0xFFFFFFFFUL, pixels;
+	uint16_t rects;
+	uint8_t how = REPAINT_GLYPH, i;
+
+	// Only draw if character has been updated, because we need to erase old one first
+	if (updatedHex == false)
+		return REPAINT_NONE;
+
+	PROF_STAGE(PROF_DRAWCHAR);
+	if (cheapest && (oldDChar != '\0') && (glyphWidth(glyphOf(oldDChar)) <= REPAINT_MAX_WIDTH) &&
+		(glyphWidth(glyphOf(dChar)) <= REPAINT_MAX_WIDTH))
+	{
+		for (i = REPAINT_OPAQUE; i <= REPAINT_DELTA; ++i)
+		{
+			if ((rects = paintRuns(disp, fg, bg, i, false, &pixels)) == 0xFFFF)
+				continue;
+			cost = (uint32_t)rects * REPAINT_RECT_US + pixels / REPAINT_PIXELS_US;
+			if (cost < best)
+			{
+				best = cost;
+				how = i;
+			}
+		}
+	}
+
+	if (how != REPAINT_GLYPH)
+		paintRuns(disp, fg, bg, how, true, &pixels);
+	else
+	{
+		disp->setFont(&MSTahomaBold48);	// Set to large font
+		disp->setFontScale(HEXFONTSIZE);
+		if (oldDChar != '\0')
+			eraseChar(disp, bg); // erase the char currently at that location
+	
+		// Set cursor, color, & print character
+		disp->setCursor(layoutX(uType), layoutY(uType));
+		disp->setTextColor(fg, bg);
+		disp->print(dChar);
+		PROF_SPI(5);
+	}
+	
+	updatedHex = false; // reset updated flag to prevent unnecessary redrawing
+
+	return how;
+}
+
+/*
+Draw just the character's strokes, onto background the controller has already filled in. A glyph this can't paint
+(too wide, or too many runs in a row) goes through the library with transparent text instead; any runs already
+painted are the same color, so going over them does no harm. Returns REPAINT_INK, or REPAINT_NONE
+*/
+uint8_t ClockDigit::inkChar(ClockScreen *disp, uint16_t fg)
+{
+	uint32_t pixels;
+
+	if (updatedHex == false)
+		return REPAINT_NONE;
+
+	PROF_STAGE(PROF_DRAWCHAR);
+	if ((glyphWidth(glyphOf(dChar)) > REPAINT_MAX_WIDTH) || (paintRuns(disp, fg, fg, REPAINT_INK, true, &pixels) == 0xFFFF))
+	{
+		disp->setFont(&MSTahomaBold48);
+		disp->setFontScale(HEXFONTSIZE);
+		disp->setCursor(layoutX(uType), layoutY(uType));
+		disp->setTextColor(fg);		// Transparent: the background is left as it is
+		disp->print(dChar);
+		PROF_SPI(5);
+	}
+
+	updatedHex = false;
+	return REPAINT_INK;
+}
+#endif
+
+// Update the character stored in the digit
+bool ClockDigit::setNewChar(uint8_t t, char c, int mode)
+{
+	updatedHex = updatedBinary = false;	// Begin with the assumption that nothing has changed.
+
+	// t is the value of the digit. 'c' is the character
+	if ((c == dChar) && (t == tVal) && (mode != REFRESH_ALL)) // Same character & binary, no forced update
+	{
+		updatedHex = updatedBinary = false;
+		return false;
+	}
+	
+	if ((c != dChar) || (mode == REFRESH_ALL))
+	{
+		// New char. Make some changes
+		oldDChar = dChar;	// Need to save the last character so we can erase it
+		dChar = c;			// The new character
+		updatedHex = true;
+	}
+
+	if ((t != tVal) || (mode == REFRESH_ALL))
+	{
+		tVal = t;			// Value of the unit
+		updatedBinary = true;
+	}
+
+	return (updatedHex || updatedBinary);	// Something has changed
+}
+
+
+#if FACE_12H
+AmPmDot::AmPmDot()
+{
+}
+
+AmPmDot::~AmPmDot()
+{
+}
+
+void AmPmDot::setup(uint8_t x, uint8_t y, uint8_t r)
+{
+	xLoc = x;
+	yLoc = y;
+	radius = r;
+	on = false;
+}
+
+void AmPmDot::eraseDot(ClockScreen *disp, uint16_t color)
+{
+	if (on)	// Only erase if already displayed - eliminates flicker
+	{
+		disp->drawCircle(xLoc, yLoc, radius, color);
+		disp->fillCircle(xLoc, yLoc, radius, color);
+		PROF_SPI(2);
+		on = false;
+	}
+}
+
+void AmPmDot::drawDot(ClockScreen *disp, uint16_t color)
+{
+	if (!on) // Only draw if already erased - eliminates flicker
+	{
+		disp->drawCircle(xLoc, yLoc, radius, color);
+		disp->fillCircle(xLoc, yLoc, radius, color);
+		PROF_SPI(2);
+		on = true;
+	}
+}
+
+void AmPmDot::refreshDot(ClockScreen *disp, uint16_t color)
+{
+	if (on)
+	{
+		disp->drawCircle(xLoc, yLoc, radius, color);
+		disp->fillCircle(xLoc, yLoc, radius, color);
+		PROF_SPI(2);
+	}
+}
+#endif
@@ -1,73 +1,107 @@
-/*
-ClockDigit.h - Class to manage digits on clock face
-*/
-
-#ifndef _CLOCKDIGIT_H_
-#define _CLOCKDIGIT_H_
-
-#include <SPI.h>
-#include <RA8875.h>
-
-// Font size for digits
-#define HEXFONTSIZE 2
-#define BINFONTSIZE 3
-#define SETUPFONTSIZE 0
-
-// Define whether a full or partial refresh is needed
-#define REFRESH_MIN 0
-#define REFRESH_ALL 1
-
-// Definitions for high & low segments for a variety of uses
-#define HRHIGH	0	// Hour high bits
-#define HRLOW	1	// Hour low bits
-#define MNHIGH	2	// Minutes high bits
-#define MNLOW	3	// Minutes low bits
-#define SEHIGH	4	// Seconds high bits
-#define SELOW	5	// Seconds low bits
-#define DYHIGH	6	// Day high bits
-#define DYLOW	7	// Day low bits
-#define MOHIGH	8	// Month high bits
-#define MOLOW	9	// Month low bits
-#define YRHIGH	10	// Year high bits
-#define YRLOW	11	// Year low bits
-#define IDNULL  12	// NO Value - Placeholder
-
-class ClockDigit
-{
-public:
-	ClockDigit();
-	~ClockDigit();
-	void setup(char c, int w, int h, uint16_t x, uint16_t y, uint8_t u);
-	void eraseChar(RA8875 *disp, uint16_t bgColor);
-	void drawChar(RA8875 *disp, uint16_t fg, uint16_t bg);
-	int drawBinary(RA8875 *disp, uint16_t fg, uint16_t bg);
-	bool setNewChar(uint8_t t, char c, int mode = REFRESH_MIN);
-	void triggerHexUpdate() { updatedHex = true; }
-	void triggerBinaryUpdate() { updatedBinary = true; }
-
-private:
-	int16_t currx, curry;		// Current X/Y position on the display
-	char dChar, oldDChar;		// The character we're representing, and the last character 
-	uint8_t tVal; // The value of the character we're representing
-	bool updatedHex, updatedBinary;  // Has this been updated? If so, need to redraw
-	uint8_t uType; // Unit for this character (Hour, Minute, Month, etc)
-};
-
-class AmPmDot
-{
-public:
-	AmPmDot();
-	~AmPmDot();
-	void setup(uint8_t x, uint8_t y, uint8_t r);
-	void eraseDot(RA8875 *disp, uint16_t color);
-	void drawDot(RA8875 *disp, uint16_t color);
-	void refreshDot(RA8875 *disp, uint16_t color);
-	bool isOn() { return on; }
-
-private:
-	bool on;
-	uint8_t xLoc, yLoc, radius;
-};
-
-
-#endif //_CLOCKDIGIT_H_
+/*
+ClockDigit.h - Class to manage digits on clock face
+*/
+
+#ifndef _CLOCKDIGIT_H_
+#define _CLOCKDIGIT_H_
+
+#include "ClockDrivers.h"
+#include "FaceConfig.h"
+#include "Layout.h"
+
+// Define whether a full or partial refresh is needed
+#define REFRESH_MIN 0
+#define REFRESH_ALL 1
+
+// Definitions for high & low segments for a variety of uses. Also the digit's cell in the layout (Layout.h)
+#define HRHIGH	0	// Hour high bits
+#define HRLOW	1	// Hour low bits
+#define MNHIGH	2	// Minutes high bits
+#define MNLOW	3	// Minutes low bits
+#define SEHIGH	4	// Seconds high bits
+#define SELOW	5	// Seconds low bits
+#define DYHIGH	6	// Day high bits
+#define DYLOW	7	// Day low bits
+#define MOHIGH	8	// Month high bits
+#define MOLOW	9	// Month low bits
+#define YRHIGH	10	// Year high bits
+#define YRLOW	11	// Year low bits
+#define COLON1	12	// Hour:minute colon
+#define COLON2	13	// Minute:second colon
+#define SLASH1	14	// Month/day slash
+#define SLASH2	15	// Day/year slash
+
+/*
+How a big digit gets repainted. The face always erases the old character and draws the new one (REPAINT_GLYPH), which
+the library does with a filled rectangle for every run of pixels on every row of both. The stopwatch's fast digits ask
+drawChar() for the cheapest way instead. It draws the rectangles itself, and a run that the next row repeats exactly
+grows down into one taller rectangle, so a straight stroke is one rectangle, not one a row. Either the new character
+goes over a background box (REPAINT_OPAQUE), or only the runs of the new character that have a changed pixel in them
+are painted, in whichever color they are now (REPAINT_DELTA). Every rectangle costs a round of register writes on top
+of its fill time, so the choice mostly comes down to the rectangle count.
+A full redraw starts from a screen the controller has just filled with the background, so there's nothing to erase
+and no background to paint: inkChar() puts down only the new character's strokes, the same taller rectangles
+(REPAINT_INK).
+*/
+#define REPAINT_NONE		0		// Nothing changed
+#define REPAINT_GLYPH		1		// Erase the old character, draw the new one
+#define REPAINT_OPAQUE		2		// Background box, then the new character's strokes
+#define REPAINT_DELTA		3		// Just the runs that changed
+#define REPAINT_INK			4		// Just the new character's strokes, onto a clean background
+#define REPAINT_KINDS		5
+#define REPAINT_RECT_US		130		// One filled rectangle: its register writes over SPI and the busy poll
+#define REPAINT_PIXELS_US	100		// Pixels the geometry engine fills per us
+#define REPAINT_SPANS		10		// Most runs a glyph row can paint. Past this it's left to the library
+#define REPAINT_MAX_WIDTH	32		// Widest glyph that can be painted this way (one row in a uint32_t)
+
+class ClockDigit
+{
+public:
+	ClockDigit();
+	~ClockDigit();
+	void setup(char c, uint8_t u);
+#if FACE_DIGITS
+	void eraseChar(ClockScreen *disp, uint16_t bgColor);
+	uint8_t drawChar(ClockScreen *disp, uint16_t fg, uint16_t bg, bool cheapest = false);
+	uint8_t inkChar(ClockScreen *disp, uint16_t fg);
+#endif
+#if FACE_BINARY
+	void drawBinary(ClockScreen *disp, uint16_t fg, uint16_t bg);
+#endif
+	bool setNewChar(uint8_t t, char c, int mode = REFRESH_MIN);
+	char getChar() { return dChar; }
+	uint8_t getValue() { return tVal; }
+	void triggerHexUpdate() { updatedHex = true; }
+	void triggerBinaryUpdate() { updatedBinary = true; }
+
+private:
+	char dChar, oldDChar;		// The character we're representing, and the last character 
+	uint8_t tVal; // The value of the character we're representing
+	bool updatedHex, updatedBinary;  // Has this been updated? If so, need to redraw
+	uint8_t uType; // Unit for this character (Hour, Minute, Month, etc). Also its cell in the layout
+
+#if FACE_DIGITS
+	uint16_t paintRuns(ClockScreen *disp, uint16_t fg, uint16_t bg, uint8_t how, bool draw, uint32_t *pixels);
+#endif
+};
+
+#if FACE_12H
+class AmPmDot
+{
+public:
+	AmPmDot();
+	~AmPmDot();
+	void setup(uint8_t x, uint8_t y, uint8_t r);
+	void eraseDot(ClockScreen *disp, uint16_t color);
+	void drawDot(ClockScreen *disp, uint16_t color);
+	void refreshDot(ClockScreen *disp, uint16_t color);
+	bool isOn() { return on; }
+
+private:
+	bool on;
+	uint8_t xLoc, yLoc, radius;
+};
+#endif
+
+
+#endif //_CLOCKDIGIT_H_
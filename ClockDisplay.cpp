@@ -1,657 +1,1786 @@
-/*
-ClockDisplay.cpp
-Manage the display of the LCD clock face
-*/
-
-#include "ClockDisplay.h"
-#include "EEPROMFunctions.h"
-#include "RTClock.h"
-#include "Button.h"
-
-extern RTClockClass RTClock;	// Real-time clock object
-Button buttonArray[MAXBUTTONS];	// Array of buttons used on the configuration screen
-
-/**************************************************************************
-@brief  Converts raw touch screen locations (screenPtr) into actual pixel locations on the display (displayPtr) using the
-supplied matrix.
-
-@param[out] displayPtr  Pointer to the tsPoint_t object that will hold
-the compensated pixel location on the display
-@param[in]  screenPtr   Pointer to the tsPoint_t object that contains the
-raw touch screen co-ordinates (before the
-calibration calculations are made)
-@param[in]  matrixPtr   Pointer to the calibration matrix coefficients
-used during the calibration process (calculated
-via the tsCalibrate() helper function)
-**************************************************************************/
-int ClockDisplay::calibrateTSPoint(tsPoint_t * displayPtr, tsPoint_t * screenPtr )
-{
-	//tsMatrix_t * matrixPtr = &_tsMatrix;
-	int  retValue = 0;
-
-	if (_tsMatrixPtr->Divider != 0)
-	{
-		displayPtr->x = ((_tsMatrixPtr->An * screenPtr->x) +
-			(_tsMatrixPtr->Bn * screenPtr->y) +
-			_tsMatrixPtr->Cn
-			) / _tsMatrixPtr->Divider;
-
-		displayPtr->y = ((_tsMatrixPtr->Dn * screenPtr->x) +
-			(_tsMatrixPtr->En * screenPtr->y) +
-			_tsMatrixPtr->Fn
-			) / _tsMatrixPtr->Divider;
-	}
-	else
-	{
-		return -1;
-	}
-
-	return(retValue);
-}
-
-/**************************************************************************/
-/*!
-@brief  Checks for a touch event
-*/
-/**************************************************************************/
-int ClockDisplay::checkForTouchEvent(RA8875* disp, tsPoint_t * point, bool waitMode)
-{
-
-	tsPoint_t raw, calibrated;
-	uint16_t x, y;
-
-	disp->touchEnable(true);
-	if (disp->touched())
-	{
-		// We're reading the raw register data.
-		// The Sumotoy calibration routine was highly inaccurate,
-		// So we're using the Adafruit calibration code instead
-		disp->touchReadAdc(&x, &y);	
-		raw.x = x;
-		raw.y = y;
-		calibrateTSPoint(&calibrated, &raw);
-		point->x = calibrated.x;
-		point->y = calibrated.y;
-		//disp->fillCircle(point->x, point->y, 3, RA8875_YELLOW);
-
-		if (waitMode) // waitMode = wait for remaining touches to be cleared
-		{
-			while (disp->touched())
-			{
-				disp->touchReadAdc(&x, &y);
-				delay(1);
-			}
-		}
-		return 1;
-	}
-	else
-	{
-		point->x = 0;
-		point->y = 0;
-		return 0;
-	}
-	return 0;
-}
-
-/**************************************************************************/
-/*!
-@brief  Starts the screen calibration process.  Each corner will be
-tested, meaning that each boundary (top, left, right and
-bottom) will be tested twice and the readings averaged.
-*/
-/**************************************************************************/
-void ClockDisplay::tsCalibrate(RA8875* disp)
-{
-	// read calibration data from eeprom
-	_tsMatrix0.An = EEPROMReadSignedLong(EEPROM_CALIBRATION_LOCATION);
-	_tsMatrix0.Bn = EEPROMReadSignedLong(EEPROM_CALIBRATION_LOCATION + 4);
-	_tsMatrix0.Cn = EEPROMReadSignedLong(EEPROM_CALIBRATION_LOCATION + 8);
-	_tsMatrix0.Dn = EEPROMReadSignedLong(EEPROM_CALIBRATION_LOCATION + 12);
-	_tsMatrix0.En = EEPROMReadSignedLong(EEPROM_CALIBRATION_LOCATION + 16);
-	_tsMatrix0.Fn = EEPROMReadSignedLong(EEPROM_CALIBRATION_LOCATION + 20);
-	_tsMatrix0.Divider = EEPROMReadSignedLong(EEPROM_CALIBRATION_LOCATION + 24);
-
-	/*
-	Serial.println(_tsMatrix0.An);
-	Serial.println(_tsMatrix0.Bn);
-	Serial.println(_tsMatrix0.Cn);
-	Serial.println(_tsMatrix0.Dn);
-	Serial.println(_tsMatrix0.En);
-	Serial.println(_tsMatrix0.Fn);
-	Serial.println(_tsMatrix0.Divider);
-	*/
-
-	_tsMatrix180.An = EEPROMReadSignedLong(EEPROM_CALIBRATION_LOCATION + 28);
-	_tsMatrix180.Bn = EEPROMReadSignedLong(EEPROM_CALIBRATION_LOCATION + 32);
-	_tsMatrix180.Cn = EEPROMReadSignedLong(EEPROM_CALIBRATION_LOCATION + 36);
-	_tsMatrix180.Dn = EEPROMReadSignedLong(EEPROM_CALIBRATION_LOCATION + 40);
-	_tsMatrix180.En = EEPROMReadSignedLong(EEPROM_CALIBRATION_LOCATION + 44);
-	_tsMatrix180.Fn = EEPROMReadSignedLong(EEPROM_CALIBRATION_LOCATION + 48);
-	_tsMatrix180.Divider = EEPROMReadSignedLong(EEPROM_CALIBRATION_LOCATION + 52);
-
-	/*
-	Serial.println(_tsMatrix180.An);
-	Serial.println(_tsMatrix180.Bn);
-	Serial.println(_tsMatrix180.Cn);
-	Serial.println(_tsMatrix180.Dn);
-	Serial.println(_tsMatrix180.En);
-	Serial.println(_tsMatrix180.Fn);
-	Serial.println(_tsMatrix180.Divider);
-	*/
-}
-
-// Display boot-up colors test pattern on the screen. Oooh, pretty!
-void ClockDisplay::testPattern(RA8875 *disp)
-{
-	uint16_t colors[] = { RA8875_WHITE , RA8875_RED , RA8875_YELLOW , RA8875_GREEN , RA8875_CYAN , RA8875_MAGENTA, RA8875_BLACK };
-	for (int i = 0; i < 7; ++i)
-	{
-		disp->fillWindow(colors[i]);
-		delay(500);
-	}
-}
-
-ClockDisplay::ClockDisplay()
-{
-	// Initiatize Main Time section
-	timeArray[0].setup('0', W_LARGEDIGIT, H_LARGEDIGIT, X_TIMEHOURHIGH, Y_TIME_UPPER, HRHIGH);
-	timeArray[1].setup('0', W_LARGEDIGIT, H_LARGEDIGIT, X_TIMEHOURLOW, Y_TIME_UPPER, HRLOW);
-	timeArray[2].setup('0', W_LARGEDIGIT, H_LARGEDIGIT, X_TIMEMINUTEHIGH, Y_TIME_UPPER, MNHIGH);
-	timeArray[3].setup('0', W_LARGEDIGIT, H_LARGEDIGIT, X_TIMEMINUTELOW, Y_TIME_UPPER, MNLOW);
-	timeArray[4].setup('0', W_LARGEDIGIT, H_LARGEDIGIT, X_TIMESECONDHIGH, Y_TIME_UPPER, SEHIGH);
-	timeArray[5].setup('0', W_LARGEDIGIT, H_LARGEDIGIT, X_TIMESECONDLOW, Y_TIME_UPPER, SELOW);
-	colonChar1.setup(':', W_COLON, H_COLON, X_COLON1, Y_TIME_UPPER, IDNULL);
-	colonChar2.setup(':', W_COLON, H_COLON, X_COLON2, Y_TIME_UPPER, IDNULL);
-
-	// Initialize Main Date section
-	dateArray[0].setup('0', W_LARGEDIGIT, H_LARGEDIGIT, X_DATEMONTHHIGH, Y_DATE_UPPER, MOHIGH);
-	dateArray[1].setup('1', W_LARGEDIGIT, H_LARGEDIGIT, X_DATEMONTHLOW, Y_DATE_UPPER, MOLOW);
-	dateArray[2].setup('0', W_LARGEDIGIT, H_LARGEDIGIT, X_DATEDAYHIGH, Y_DATE_UPPER, DYHIGH);
-	dateArray[3].setup('1', W_LARGEDIGIT, H_LARGEDIGIT, X_DATEDAYLOW, Y_DATE_UPPER, DYLOW);
-	dateArray[4].setup('1', W_LARGEDIGIT, H_LARGEDIGIT, X_DATEYEARHIGH, Y_DATE_UPPER, YRHIGH);
-	dateArray[5].setup('6', W_LARGEDIGIT, H_LARGEDIGIT, X_DATEYEARLOW, Y_DATE_UPPER, YRLOW);
-	slashChar1.setup('/', W_SLASH, H_SLASH, X_SLASH1, Y_DATE_UPPER, IDNULL);
-	slashChar2.setup('/', W_SLASH, H_SLASH, X_SLASH2, Y_DATE_UPPER, IDNULL);
-
-	// Initialize  up AM/PM indicator dots
-	amDot.setup(X_AMPM, Y_AM, AMPM_DOTSIZE);
-	pmDot.setup(X_AMPM, Y_PM, AMPM_DOTSIZE);
-
-	numberBase = BASE_HEX;	// Default number base for display is HEX
-	configMode = false;		// In "run" mode, not configutration mode
-	displayBase = DISPLAY_24H;	// Default to military time display
-	amPm = AMPM_MORNING;				// default to AM
-	rotation = ROTATION_0;				// 0-degree screen rotation
-	_tsMatrixPtr = &_tsMatrix0;			// Touch screen calibration matrix for 0-degree rotation
-}
-
-
-ClockDisplay::~ClockDisplay()
-{
-}
-
-/*
-Refresh the time on the clock
-Refreshes only the internal time elements. Does NOT refresh the time on the clock's face. refreshClock() does that.
-Mode is passed through to the function that updates the time/date character objects:
-	REFRESH_MIN = refresh an object only if the value of the time element in that object has changed. Minimizes screen redraws, which can be slow on the tft display.
-	REFRESH_ALL = Refresh the object whether it's changed or not. Forces a full redraw of the whole clock acreen.
-*/
-void ClockDisplay::refreshTime(RA8875 *disp, int mode)
-{
-	uint8_t tUnit;
-	char charRep[3];
-	int i;
-	char *baseArray = "0123456789ABCDEF";	// Possible display digits
-
-	for (i = UNIT_HOUR; i <= UNIT_YEAR_SHORT; ++i)	// Loop through all time/date parts
-	{
-		tUnit = RTClock.getUnit(i);
-
-		if (i == UNIT_HOUR)		// Account for 12H display
-		{
-			amPm = (tUnit < 12) ? AMPM_MORNING : AMPM_AFTERNOON;
-			if (displayBase == DISPLAY_12H) 
-			{
-				if (tUnit > 12)
-					tUnit -= 12;
-				if (tUnit == 0) 
-					tUnit = 12;
-			}
-		}
-
-		// Account for 12-hour display time
-		// Get high- and low-order digits base on the current display mode (decimal or hex)
-		// If in configuration mode mode, force decimal base.
-		charRep[0] = baseArray[tUnit / (configMode ? BASE_DEC : numberBase)];	
-		charRep[1] = baseArray[tUnit % (configMode ? BASE_DEC : numberBase)];	// Get low-order digit
-		charRep[2] = '\0';	// NULL-terminate string, not because it's really needed here, but just for safety
-
-		timeArray[(i - 1) * 2].setNewChar((tUnit >> 4), charRep[0], mode);			// Set high-order digit & bits
-		timeArray[((i - 1) * 2) + 1].setNewChar((tUnit & 0xF), charRep[1], mode);		// Set low-order digit & bits
-	}
-
-	return;
-}
-
-void ClockDisplay::setRotation(uint8_t rot)
-{
-	rotation = rot;
-	_tsMatrixPtr = (rotation == ROTATION_0) ? &_tsMatrix0 : &_tsMatrix180;	// Set calibration matrix based on screen orientation (0 or 180 degrees)
-}
-
-
-/*
-Refresh the clock face.
-refreshMode indicates how to handles the refresh
-	REFRESH_MIN = refresh the character object only if the value of the time element in that object has changed. Minimizes screen redraws, which can be slow on the tft display.
-	REFRESH_ALL = Refresh the character whether it's changed or not. Forces a full redraw of the whole clock.
-drawMode indicates what parts of the clock face to draw
-	DRAW_HEXBIN	= Draw both Hex & Binary parts
-	DRAW_HEXONLY = Draw only the upper hexadecimal part
-*/
-void ClockDisplay::refreshClock(RA8875 *disp, int refreshMode, int drawMode)
-{
-	int i;
-
-	if (refreshMode == REFRESH_ALL)
-		disp->fillWindow(bgColor);		// Start with a clean slate
-
-	disp->setRotation(rotation);
-		
-	// Print time
-	for (int i = 0; i < 6; ++i)		// HH, MM, SS
-	{
-		timeArray[i].drawChar(disp, fgColor, bgColor);
-
-		// Normally we draw both the hex/decimal time on the upper part of the screen and the binary time on the lower part of the screen. 
-		// On the configuration screen, we don't want to draw the binary time, because that's where the config buttons go
-		// DRAW_HEXONLY indicates to not draw the lower binary part
-		if (drawMode == DRAW_HEXBIN) 
-			timeArray[i].drawBinary(disp, fgColor, bgColor);
-	}
-	colonChar1.drawChar(disp, fgColor, bgColor);	// 2 colons between time elements
-	colonChar2.drawChar(disp, fgColor, bgColor);
-
-	// Print Date
-	for (int i = 0; i<6; ++i)		// MM, DD, YY
-	{
-		dateArray[i].drawChar(disp, fgColor, bgColor);
-
-		// Same as above
-		if (drawMode == DRAW_HEXBIN)
-			dateArray[i].drawBinary(disp, fgColor, bgColor);
-	}
-	slashChar1.drawChar(disp, fgColor, bgColor);	// 2 slashes between date elements
-	slashChar2.drawChar(disp, fgColor, bgColor);
-
-	if (displayBase == DISPLAY_12H)	// Need AM/PM indicator
-	{
-		if (amPm == AMPM_MORNING)
-		{
-			if (refreshMode == REFRESH_ALL)
-				amDot.refreshDot(disp, fgColor);
-			else
-				amDot.drawDot(disp, fgColor);
-			pmDot.eraseDot(disp, bgColor);
-		}
-		else // AMPM_AFTERNOON
-		{
-			amDot.eraseDot(disp, bgColor);
-			if (refreshMode == REFRESH_ALL)
-				pmDot.refreshDot(disp, fgColor);
-			else
-				pmDot.drawDot(disp, fgColor);
-		}
-	}
-	else
-	{
-		amDot.eraseDot(disp, bgColor);
-		pmDot.eraseDot(disp, bgColor);
-	}
-
-	if ((refreshMode == REFRESH_ALL) && (drawMode == DRAW_HEXBIN))  // Refreshing whole screen (hex & binary). Need to add the binary labels
-	{
-		disp->setFont(INT);
-		disp->setTextColor(fgColor, bgColor);
-		disp->setFontScale(BINFONTSIZE);
-
-		disp->setCursor(X_BIN_TIMELABEL, Y_BIN_1); disp->println(F("H:"));
-		disp->setCursor(X_BIN_TIMELABEL, Y_BIN_2); disp->println(F("M:"));
-		disp->setCursor(X_BIN_TIMELABEL, Y_BIN_3); disp->println(F("S:"));
-
-		disp->setCursor(X_BIN_DATELABEL, Y_BIN_1); disp->println(F("M:"));
-		disp->setCursor(X_BIN_DATELABEL, Y_BIN_2); disp->println(F("D:"));
-		disp->setCursor(X_BIN_DATELABEL, Y_BIN_3); disp->println(F("Y:"));
-	}
-
-	return;
-}
-
-
-/*
-Given an X,Y point on the screen, return which button (if any) was pressed
-Returns 0-MAXBUTTONS for an actual button
-Returns -1 if area pressed was not a button
-*/
-int ClockDisplay::identifyArea(tsPoint_t point)
-{
-	int i;
-
-	for (i = 0; i < MAXBUTTONS; ++i)
-	{
-		if (buttonArray[i].isButton(point.x, point.y))
-			return i;
-	}
-	return -1;
-}
-
-/*
-Displays the setup screen, places the buttons, and watches for screen presses
-*/
-int ClockDisplay::setupScreen(RA8875* disp)
-{
-	tsPoint_t calibrated;	// Holds calibrated screen points when screen is touched
-	int touchArea;			// The button that was touched
-	int i, newRefreshMode;
-	bool redrawButtons = true, exitLoop=false;
-	uint16_t newFg=fgColor, newBg=bgColor;
-	
-	/*
-	systemresetCounter is used as a safeguard to accidentally resetting the clock
-	The user must press the three reset buttons in order to force the reset.
-	Press the buttons in any other order and systemresetCounter is reset to zero and the user must start again.
-	*/
-	int systemResetCounter = 0;
-
-	configMode = true;  // Tells the clock we're in configuration mode. Suppress some normal screen drawing functions
-
-	// Initialize all the buttons on the display
-	// These are the buttons to adjust the time/date up & down
-	buttonArray[BTN_HOURUP].setup(X_TIMEHOURHIGH, Y_TIME_UPPER, ((X_COLON1) - (X_TIMEHOURHIGH)), (H_LARGEDIGIT/2), NULL_COLOR, NULL_COLOR, NULL_COLOR, NULL, SETUPFONTSIZE, NULL, NULL, NULL);
-	buttonArray[BTN_HOURDOWN].setup(X_TIMEHOURHIGH, Y_TIME_MID, ((X_COLON1) - (X_TIMEHOURHIGH)), (H_LARGEDIGIT/2), NULL_COLOR, NULL_COLOR, NULL_COLOR, NULL, SETUPFONTSIZE, NULL, NULL, NULL);
-	buttonArray[BTN_MINUTEUP].setup(X_TIMEMINUTEHIGH, Y_TIME_UPPER, ((X_COLON2) - (X_TIMEMINUTEHIGH)), (H_LARGEDIGIT/2), NULL_COLOR, NULL_COLOR, NULL_COLOR, NULL, SETUPFONTSIZE, NULL, NULL, NULL);
-	buttonArray[BTN_MINUTEDOWN].setup(X_TIMEMINUTEHIGH, Y_TIME_MID, ((X_COLON2) - (X_TIMEMINUTEHIGH)), (H_LARGEDIGIT / 2), NULL_COLOR, NULL_COLOR, NULL_COLOR, NULL, SETUPFONTSIZE, NULL, NULL, NULL);
-	buttonArray[BTN_MONTHUP].setup(X_DATEMONTHHIGH, Y_DATE_UPPER, ((X_SLASH1)-(X_DATEMONTHHIGH)), (H_LARGEDIGIT / 2), NULL_COLOR, NULL_COLOR, NULL_COLOR, NULL, SETUPFONTSIZE, NULL, NULL, NULL);
-	buttonArray[BTN_MONTHDOWN].setup(X_DATEMONTHHIGH, Y_DATE_MID, ((X_SLASH1)-(X_DATEMONTHHIGH)), (H_LARGEDIGIT / 2), NULL_COLOR, NULL_COLOR, NULL_COLOR, NULL, SETUPFONTSIZE, NULL, NULL, NULL);
-	buttonArray[BTN_DAYUP].setup(X_DATEDAYHIGH, Y_DATE_UPPER, ((X_SLASH2) - (X_DATEDAYHIGH)), (H_LARGEDIGIT / 2), NULL_COLOR, NULL_COLOR, NULL_COLOR, NULL, SETUPFONTSIZE, NULL, NULL, NULL);
-	buttonArray[BTN_DAYDOWN].setup(X_DATEDAYHIGH, Y_DATE_MID, ((X_SLASH2) - (X_DATEDAYHIGH)), (H_LARGEDIGIT / 2), NULL_COLOR, NULL_COLOR, NULL_COLOR, NULL, SETUPFONTSIZE, NULL, NULL, NULL);
-	buttonArray[BTN_YEARUP].setup(X_DATEYEARHIGH, Y_DATE_UPPER, ((X_DATEYEARHIGH) + (W_LARGEDIGIT * 2)), (H_LARGEDIGIT / 2), NULL_COLOR, NULL_COLOR, NULL_COLOR, NULL, SETUPFONTSIZE, NULL, NULL, NULL);
-	buttonArray[BTN_YEARDOWN].setup(X_DATEYEARHIGH, Y_DATE_MID, ((X_DATEYEARHIGH) + (W_LARGEDIGIT * 2)), (H_LARGEDIGIT / 2), NULL_COLOR, NULL_COLOR, NULL_COLOR, NULL, SETUPFONTSIZE, NULL, NULL, NULL);
-	
-	// These are the configuration buttons (color, number base, reset, etc)
-	buttonArray[BTN_FGBLACK].setup(X_COLOR1, Y_COLOR_FG, W_COLOR, H_COLOR, RA8875_BLACK, RA8875_WHITE, NULL, NULL, NULL, NULL, NULL, NULL);
-	buttonArray[BTN_FGBLUE].setup(X_COLOR2, Y_COLOR_FG, W_COLOR, H_COLOR, RA8875_BLUE, RA8875_WHITE, NULL, NULL, NULL, NULL, NULL, NULL);
-	buttonArray[BTN_FGRED].setup(X_COLOR3, Y_COLOR_FG, W_COLOR, H_COLOR, RA8875_RED, RA8875_BLACK, NULL, NULL, NULL, NULL, NULL, NULL);
-	buttonArray[BTN_FGGREEN].setup(X_COLOR4, Y_COLOR_FG, W_COLOR, H_COLOR, RA8875_GREEN, RA8875_BLACK, NULL, NULL, NULL, NULL, NULL, NULL);
-	buttonArray[BTN_FGCYAN].setup(X_COLOR5, Y_COLOR_FG, W_COLOR, H_COLOR, RA8875_CYAN, RA8875_BLACK, NULL, NULL, NULL, NULL, NULL, NULL);
-	buttonArray[BTN_FGMAGENTA].setup(X_COLOR6, Y_COLOR_FG, W_COLOR, H_COLOR, RA8875_MAGENTA, RA8875_BLACK, NULL, NULL, NULL, NULL, NULL, NULL);
-	buttonArray[BTN_FGYELLOW].setup(X_COLOR7, Y_COLOR_FG, W_COLOR, H_COLOR, RA8875_YELLOW, RA8875_BLACK, NULL, NULL, NULL, NULL, NULL, NULL);
-	buttonArray[BTN_FGWHITE].setup(X_COLOR8, Y_COLOR_FG, W_COLOR, H_COLOR, RA8875_WHITE, RA8875_BLACK, NULL, NULL, NULL, NULL, NULL, NULL);
-	buttonArray[BTN_BGBLACK].setup(X_COLOR1, Y_COLOR_BG, W_COLOR, H_COLOR, RA8875_BLACK, RA8875_WHITE, NULL, NULL, NULL, NULL, NULL, NULL);
-	buttonArray[BTN_BGBLUE].setup(X_COLOR2, Y_COLOR_BG, W_COLOR, H_COLOR, RA8875_BLUE, RA8875_WHITE, NULL, NULL, NULL, NULL, NULL, NULL);
-	buttonArray[BTN_BGRED].setup(X_COLOR3, Y_COLOR_BG, W_COLOR, H_COLOR, RA8875_RED, RA8875_BLACK, NULL, NULL, NULL, NULL, NULL, NULL);
-	buttonArray[BTN_BGGREEN].setup(X_COLOR4, Y_COLOR_BG, W_COLOR, H_COLOR, RA8875_GREEN, RA8875_BLACK, NULL, NULL, NULL, NULL, NULL, NULL);
-	buttonArray[BTN_BGCYAN].setup(X_COLOR5, Y_COLOR_BG, W_COLOR, H_COLOR, RA8875_CYAN, RA8875_BLACK, NULL, NULL, NULL, NULL, NULL, NULL);
-	buttonArray[BTN_BGMAGENTA].setup(X_COLOR6, Y_COLOR_BG, W_COLOR, H_COLOR, RA8875_MAGENTA, RA8875_BLACK, NULL, NULL, NULL, NULL, NULL, NULL);
-	buttonArray[BTN_BGYELLOW].setup(X_COLOR7, Y_COLOR_BG, W_COLOR, H_COLOR, RA8875_YELLOW, RA8875_BLACK, NULL, NULL, NULL, NULL, NULL, NULL);
-	buttonArray[BTN_BGWHITE].setup(X_COLOR8, Y_COLOR_BG, W_COLOR, H_COLOR, RA8875_WHITE, RA8875_BLACK, NULL, NULL, NULL, NULL, NULL, NULL);
-	buttonArray[BTN_BASE].setup(X_BASE, Y_BASE, W_BASE, H_BASE, RA8875_WHITE, RA8875_BLACK, RA8875_BLACK, RA8875_WHITE, SETUPFONTSIZE, (numberBase == BASE_HEX)?"HEX":"DEC", (X_BASE + 12), (Y_BASE + 6));
-	buttonArray[BTN_RST1].setup(X_RESET1, Y_RESET, W_RESET, H_RESET, RA8875_GREEN, RA8875_BLACK, RA8875_BLACK, RA8875_GREEN, SETUPFONTSIZE, "1st", (X_RESET1 + 7), (Y_RESET + 5));
-	buttonArray[BTN_RST2].setup(X_RESET2, Y_RESET, W_RESET, H_RESET, RA8875_YELLOW, RA8875_BLACK, RA8875_BLACK, RA8875_YELLOW, SETUPFONTSIZE, "2nd", (X_RESET2 + 7), (Y_RESET + 5));
-	buttonArray[BTN_RST3].setup(X_RESET3, Y_RESET, W_RESET, H_RESET, RA8875_RED, RA8875_BLACK, RA8875_WHITE, RA8875_RED, SETUPFONTSIZE, "3rd", (X_RESET3 + 7), (Y_RESET + 5));
-	buttonArray[BTN_DONE].setup(X_DONE, Y_DONE, W_DONE, H_DONE, RA8875_RED, RA8875_BLACK, RA8875_WHITE, RA8875_RED, SETUPFONTSIZE+1, "Done!", (X_DONE + 7), (Y_DONE + 5));
-	buttonArray[BTN_DISPLAY].setup(X_DISPLAY, Y_DISPLAY, W_DISPLAY, H_DISPLAY, RA8875_WHITE, RA8875_BLACK, RA8875_BLACK, RA8875_WHITE, SETUPFONTSIZE, (displayBase == DISPLAY_24H) ? "24H" : "12H", (X_DISPLAY + 12), (Y_DISPLAY + 6));
-	buttonArray[BTN_ROTATE].setup(X_ROTATE, Y_ROTATE, W_ROTATE, H_ROTATE, RA8875_WHITE, RA8875_BLACK, RA8875_BLACK, RA8875_WHITE, SETUPFONTSIZE, "Rotate", (X_ROTATE + 3), (Y_ROTATE + 6));
-
-	disp->fillWindow(bgColor);	// Clear the screen
-
-	// Get the latest date & time
-	refreshTime(disp, REFRESH_ALL);
-	
-	// Only draw upper part of screen
-	refreshClock(disp, REFRESH_ALL, DRAW_HEXONLY);
-
-	do
-	{	
-		if (redrawButtons)	// For some reason, we need to redraw the buttons and their labels
-		{ 	
-			disp->setFont(INT);
-			for (i = 0; i < MAXBUTTONS; ++i)
-				buttonArray[i].draw(disp, fgColor, bgColor);
-			disp->setTextColor(RA8875_WHITE, RA8875_BLACK);
-			disp->setFontScale(SETUPFONTSIZE);
-			disp->setCursor(X_FOREBACKBASE_LABEL, Y_FORELABEL); disp->print(F(" Foreground:"));
-			disp->setCursor(X_FOREBACKBASE_LABEL, Y_BACKLABEL); disp->print(F(" Background:"));
-			disp->setCursor(X_FOREBACKBASE_LABEL, Y_BASELABEL); disp->print(F(" Number Base:"));
-			disp->setCursor(X_DISPLAYLABEL, Y_DISPLAYLABEL); disp->print(F(" Display:"));
-			disp->setCursor(X_RESETLABEL, Y_RESETLABEL); disp->print(F(" Reset:"));
-			redrawButtons = false;
-		}
-
-		newRefreshMode = REFRESH_MIN;	// For any changes, refresh the screen only as much as needed
-		if (checkForTouchEvent(disp, &calibrated, true) != 0)		// Was screen touched?
-		{
-			if ((touchArea = identifyArea(calibrated)) != -1)		// If so, was it touched in a button area?
-			{
-				switch (touchArea)
-				{
-				case BTN_HOURUP:	// Incremenmt hour
-					RTClock.incrementUnit(UNIT_HOUR);
-					systemResetCounter = 0;
-					break;
-				case BTN_HOURDOWN:	// Decrement hour
-					RTClock.decrementUnit(UNIT_HOUR);
-					systemResetCounter = 0;
-					break;
-				case BTN_MINUTEUP:	// Increment minute. Seconds are automatically set to zero
-					RTClock.incrementUnit(UNIT_MINUTE);
-					systemResetCounter = 0;
-					break;
-				case BTN_MINUTEDOWN:	// Decrement minute. Seconds are automatically set to zero
-					RTClock.decrementUnit(UNIT_MINUTE);
-					systemResetCounter = 0;
-					break;
-				case BTN_MONTHUP:		// Increment month
-					RTClock.incrementUnit(UNIT_MONTH);
-					systemResetCounter = 0;
-					break;
-				case BTN_MONTHDOWN:		// Decrement month
-					RTClock.decrementUnit(UNIT_MONTH);
-					systemResetCounter = 0;
-					break;
-				case BTN_DAYUP:			// Increment day
-					RTClock.incrementUnit(UNIT_DAY);
-					systemResetCounter = 0;
-					break;
-				case BTN_DAYDOWN:		// Decrement day
-					RTClock.decrementUnit(UNIT_DAY);
-					systemResetCounter = 0;
-					break;
-				case BTN_YEARUP:		// Increment year
-					RTClock.incrementUnit(UNIT_YEAR);
-					systemResetCounter = 0;
-					break;
-				case BTN_YEARDOWN:		// Decrement year
-					RTClock.decrementUnit(UNIT_YEAR);
-					systemResetCounter = 0;
-					break;
-				case BTN_FGBLACK:		// Set foreground to black
-					newFg=RA8875_BLACK;
-					newRefreshMode = REFRESH_ALL;
-					redrawButtons = true;
-					systemResetCounter = 0;
-					break;
-				case BTN_FGBLUE:		// Set foreground to blue
-					newFg = RA8875_BLUE;
-					newRefreshMode = REFRESH_ALL;
-					redrawButtons = true;
-					systemResetCounter = 0;
-					break;
-				case BTN_FGRED:			// Set foreground to red
-					newFg = RA8875_RED;
-					newRefreshMode = REFRESH_ALL;
-					redrawButtons = true;
-					systemResetCounter = 0;
-					break;
-				case BTN_FGGREEN:		// Set foreground to green
-					newFg = RA8875_GREEN;
-					newRefreshMode = REFRESH_ALL;
-					redrawButtons = true;
-					systemResetCounter = 0;
-					break;
-				case BTN_FGCYAN:		// Set foreground to cyan
-					newFg = RA8875_CYAN;
-					newRefreshMode = REFRESH_ALL;
-					redrawButtons = true;
-					systemResetCounter = 0;
-					break;
-				case BTN_FGMAGENTA:		// Set foreground to magenta
-					newFg = RA8875_MAGENTA;
-					newRefreshMode = REFRESH_ALL;
-					redrawButtons = true;
-					systemResetCounter = 0;
-					break;
-				case BTN_FGYELLOW:		// Set foreground to yellow
-					newFg = RA8875_YELLOW;
-					newRefreshMode = REFRESH_ALL;
-					redrawButtons = true;
-					systemResetCounter = 0;
-					break;
-				case BTN_FGWHITE:		// Set foreground to white
-					newFg = RA8875_WHITE;
-					newRefreshMode = REFRESH_ALL;
-					redrawButtons = true;
-					systemResetCounter = 0;
-					break;
-				case BTN_BGBLACK:		// Set background to black
-					newBg = RA8875_BLACK;
-					newRefreshMode = REFRESH_ALL;
-					redrawButtons = true;
-					systemResetCounter = 0;
-					break;
-				case BTN_BGBLUE:		// Set background to blue
-					newBg = RA8875_BLUE;
-					newRefreshMode = REFRESH_ALL;
-					redrawButtons = true;
-					systemResetCounter = 0;
-					break;
-				case BTN_BGRED:			// Set background to red
-					newBg = RA8875_RED;
-					newRefreshMode = REFRESH_ALL;
-					redrawButtons = true;
-					systemResetCounter = 0;
-					break;
-				case BTN_BGGREEN:		// Set background to green
-					newBg = RA8875_GREEN;
-					newRefreshMode = REFRESH_ALL;
-					redrawButtons = true;
-					systemResetCounter = 0;
-					break;
-				case BTN_BGCYAN:		// Set background to cyan
-					newBg = RA8875_CYAN;
-					newRefreshMode = REFRESH_ALL;
-					redrawButtons = true;
-					systemResetCounter = 0;
-					break;
-				case BTN_BGMAGENTA:		// Set background to magenta
-					newBg = RA8875_MAGENTA;
-					newRefreshMode = REFRESH_ALL;
-					redrawButtons = true;
-					systemResetCounter = 0;
-					break;
-				case BTN_BGYELLOW:		// Set background to yellow
-					newBg = RA8875_YELLOW;
-					newRefreshMode = REFRESH_ALL;
-					redrawButtons = true;
-					systemResetCounter = 0;
-					break;
-				case BTN_BGWHITE:		// Set background to white
-					newBg = RA8875_WHITE;
-					newRefreshMode = REFRESH_ALL;
-					redrawButtons = true;
-					systemResetCounter = 0;
-					break;
-				case BTN_BASE:			// Toggle between hex & decimal display
-					numberBase = (numberBase == BASE_HEX) ? BASE_DEC : BASE_HEX;
-					buttonArray[BTN_BASE].setLabel((numberBase == BASE_HEX) ? "HEX" : "DEC");
-					redrawButtons = true;
-					break;
-				case BTN_RST1:			// Reset clock - 1st step
-					/* 
-					Resetting the clock resets the time, color, and display components back to default state, then reboots the Arduino.
-					It does NOT reset the display calibration coordinates. To reset the calibration you must run the TftCalibration Sketch again.
-					To reset the clock, the "1st", "2nd", and "3rd" buttons must be pressed in that order.
-					This was done to prevent accidental reset due to the flaky nature of the touch screen accuracy.
-					*/
-					systemResetCounter = 1;
-					break;	
-				case BTN_RST2:			// Reset clock - second step
-					if (systemResetCounter == 1)
-						systemResetCounter = 2;
-					else 
-						systemResetCounter = 0;	// Start counting over again.
-					break;
-				case BTN_RST3:			// Reset clock - 3rd step
-					if (systemResetCounter == 2)	// First two steps have already been completed
-					{
-						disp->fillWindow(RA8875_BLACK);	// Give immediate feedback to user
-						EEPROMWritelong(EEPROM_SIGNATURE_LOCATION, (uint32_t)0x0);  // Reset system settings signature. Force new settings on reboot.
-						RTClock.resetClock();		// Set time/date back to initial time
-						softwareReset();
-					}
-					else
-						systemResetCounter = 0;
-					break;
-				case BTN_DISPLAY:		// Toggle 12/24H display
-					displayBase = (displayBase == DISPLAY_24H) ? DISPLAY_12H : DISPLAY_24H;
-					buttonArray[BTN_DISPLAY].setLabel((displayBase == DISPLAY_24H) ? "24H" : "12H");
-					redrawButtons = true;
-					systemResetCounter = 0;
-					break;
-				case BTN_ROTATE:		// Rotate display 180 degrees
-					setRotation((rotation == ROTATION_0) ? ROTATION_180 : ROTATION_0);		// screen Flip rotation 
-					disp->setRotation(rotation);	// Reset screen rotation
-					redrawButtons = true;
-					systemResetCounter = 0;
-					break;
-				case BTN_DONE:
-					newRefreshMode = REFRESH_ALL;
-					disp->fillWindow(bgColor);
-					exitLoop = true;
-					break;
-				}
-
-			// Adjust screen to account for any color changes
-			setFgColor(newFg);
-			setBgColor(newBg);
-			refreshTime(disp, newRefreshMode);
-			refreshClock(disp, newRefreshMode, (exitLoop == false)?DRAW_HEXONLY:DRAW_HEXBIN);
-			newRefreshMode = REFRESH_MIN;
-
-			// Save new settings
-			EEPROMWritelong(EEPROM_CONFIG_LOCATION, (uint32_t)fgColor);
-			EEPROMWritelong(EEPROM_CONFIG_LOCATION + 4, (uint32_t)bgColor);
-			EEPROMWritelong(EEPROM_CONFIG_LOCATION + 8, (uint32_t)numberBase);
-			EEPROMWritelong(EEPROM_CONFIG_LOCATION + 12, (uint32_t)displayBase);
-			EEPROMWritelong(EEPROM_CONFIG_LOCATION + 16, (uint32_t)rotation);
-			}
-		}
-	}
-	while (exitLoop == false);
-
-	configMode = false;
-	// Force redraw of colons & slashes, because the system doesn't think they've been updated and won't draw them otherwise.
-	colonChar1.triggerHexUpdate();
-	colonChar2.triggerHexUpdate();
-	slashChar1.triggerHexUpdate();
-	slashChar2.triggerHexUpdate();
-
-	return 0;
-}
-
-void ClockDisplay::softwareReset() // Restarts program from beginning but does not reset the peripherals and registers
-{
-	asm volatile ("  jmp 0");
-}
-
+/*
+ClockDisplay.cpp
+Manage the display of the LCD clock face
+*/
+
+#include "ClockDisplay.h"
+#include "EEPROMFunctions.h"
+#include "RTClock.h"
+#include "Button.h"
+#include "Settings.h"
+#include "Profiler.h"
+#include "RamMonitor.h"
+#include "TouchTrace.h"
+#include "ScratchArena.h"
+#include "HexTime.h"
+#include "Stopwatch.h"
+#include "Alarms.h"
+#include "Sun.h"
+#include "Power.h"
+
+extern SettingsStore Settings;	// Saved clock settings
+extern RamMonitor RamMon;		// Stack high-water marks
+extern TouchTrace Touch;		// Touch capture & replay
+extern ScratchArena Arena;		// Shared scratch RAM
+#if FACE_HEXTIME
+extern HexTime Hex;				// Hex day timer
+#endif
+#if FACE_WATCH
+extern Stopwatch Watch;			// Stopwatch & countdown
+#endif
+#if FACE_ALARM
+extern AlarmTable Alarms;		// Alarm table & the RTC's alarms
+#endif
+#if FACE_SUN
+extern SunTimes Sun;			// Today's sunrise & sunset
+#endif
+#if FACE_POWER
+extern PowerManager Power;		// Backlight schedule
+#endif
+
+/**************************************************************************
+@brief  Converts raw touch screen locations (screenPtr) into actual pixel locations on the display (displayPtr) using the
+supplied matrix.
+
+@param[out] displayPtr  Pointer to the tsPoint_t object that will hold
+the compensated pixel location on the display
+@param[in]  screenPtr   Pointer to the tsPoint_t object that contains the
+raw touch screen co-ordinates (before the
+calibration calculations are made)
+@param[in]  matrixPtr   Pointer to the calibration matrix coefficients
+used during the calibration process (calculated
+via the tsCalibrate() helper function)
+**************************************************************************/
+int ClockDisplay::calibrateTSPoint(tsPoint_t * displayPtr, tsPoint_t * screenPtr )
+{
+	//tsMatrix_t * matrixPtr = &_tsMatrix;
+	int  retValue = 0;
+
+	if (_tsMatrixPtr->Divider != 0)
+	{
+		displayPtr->x = ((_tsMatrixPtr->An * screenPtr->x) +
+			(_tsMatrixPtr->Bn * screenPtr->y) +
+			_tsMatrixPtr->Cn
+			) / _tsMatrixPtr->Divider;
+
+		displayPtr->y = ((_tsMatrixPtr->Dn * screenPtr->x) +
+			(_tsMatrixPtr->En * screenPtr->y) +
+			_tsMatrixPtr->Fn
+			) / _tsMatrixPtr->Divider;
+	}
+	else
+	{
+		return -1;
+	}
+
+	return(retValue);
+}
+
+#if FACE_TIMECOLOR
+// The time as a color, #HHMMSS: the decimal digits read as hex, so 12:34:56 is #123456. In RGB565
+static uint16_t colorOfTime(const struct ts *tm)
+{
+	uint8_t r = ((tm->hour / 10) << 4) | (tm->hour % 10);
+	uint8_t g = ((tm->min / 10) << 4) | (tm->min % 10);
+	uint8_t b = ((tm->sec / 10) << 4) | (tm->sec % 10);
+
+	return ((uint16_t)(r & 0xF8) << 8) | ((uint16_t)(g & 0xFC) << 3) | (b >> 3);
+}
+
+// Black or white, whichever stands out more against an RGB565 color. Brightness is 0.30 R + 0.59 G + 0.11 B
+static uint16_t contrastOf(uint16_t c)
+{
+	uint16_t r = (c >> 11) << 3, g = ((c >> 5) & 0x3F) << 2, b = (c & 0x1F) << 3;
+
+	return (((r * 77UL) + (g * 150UL) + (b * 29UL)) >> 8) > 128 ? RA8875_BLACK : RA8875_WHITE;
+}
+#endif
+
+#if FACE_SETUP
+/*
+Color picker colors. Hue, saturation & value are 0-255, and the hue circle is six sectors of 43 from red. Integer
+only, so the pure colors at the sector edges can come out a step off in the low bits.
+*/
+static uint16_t hsvColor(uint8_t h, uint8_t s, uint8_t v)
+{
+	uint8_t sector = h / 43, f = (h - sector * 43) * 6, r, g, b;
+	uint8_t p = ((uint16_t)v * (255 - s)) >> 8;
+	uint8_t q = ((uint16_t)v * (255 - (((uint16_t)s * f) >> 8))) >> 8;
+	uint8_t t = ((uint16_t)v * (255 - (((uint16_t)s * (255 - f)) >> 8))) >> 8;
+
+	switch (sector)
+	{
+	case 0:		r = v; g = t; b = p; break;
+	case 1:		r = q; g = v; b = p; break;
+	case 2:		r = p; g = v; b = t; break;
+	case 3:		r = p; g = q; b = v; break;
+	case 4:		r = t; g = p; b = v; break;
+	default:	r = v; g = p; b = q; break;
+	}
+	return ((uint16_t)(r & 0xF8) << 8) | ((uint16_t)(g & 0xFC) << 3) | (b >> 3);
+}
+
+// The other way, for where the sliders start. The RGB565 fields are widened to 8 bits first
+static void colorHsv(uint16_t c, uint8_t *hsv)
+{
+	uint8_t r = ((c >> 8) & 0xF8) | (c >> 13), g = ((c >> 3) & 0xFC) | ((c >> 9) & 0x03), b = (c << 3) | ((c >> 2) & 0x07);
+	uint8_t hi = (r > g) ? r : g, lo = (r < g) ? r : g, d;
+
+	if (b > hi)
+		hi = b;
+	if (b < lo)
+		lo = b;
+	d = hi - lo;
+	hsv[2] = hi;
+	hsv[1] = hi ? ((uint16_t)d * 255) / hi : 0;
+	if (!d)
+		hsv[0] = 0;
+	else if (hi == r)
+		hsv[0] = (43 * ((int16_t)g - b)) / d;		// Magenta-red-yellow. Wraps round below red
+	else if (hi == g)
+		hsv[0] = 85 + (43 * ((int16_t)b - r)) / d;
+	else
+		hsv[0] = 171 + (43 * ((int16_t)r - g)) / d;
+}
+#endif
+
+// Sort a burst of ADC readings in place. Insertion sort is plenty for TOUCH_BURST entries
+static void sortTouchReadings(uint16_t *r)
+{
+	uint8_t i, j;
+	uint16_t v;
+
+	for (i = 1; i < TOUCH_BURST; ++i)
+	{
+		v = r[i];
+		for (j = i; (j > 0) && (r[j - 1] > v); --j)
+			r[j] = r[j - 1];
+		r[j] = v;
+	}
+}
+
+/*
+Take a conditioned touch sample
+Reads a fixed-size burst from the touch ADC and returns the median in raw. The sample is rejected (returns false) if:
+	- the trimmed spread of the burst is too wide (finger still settling or sliding)
+	- the median falls outside the ADC window (pressure too light to trust)
+	- the panel is no longer touched at the end of the burst (release edge)
+The burst always takes the same number of reads, so the cost per touch is fixed.
+*/
+bool ClockDisplay::readTouchSample(ClockScreen* disp, tsPoint_t * raw)
+{
+	uint16_t xr[TOUCH_BURST], yr[TOUCH_BURST];
+	uint16_t x, y;
+	uint8_t i;
+
+	for (i = 0; i < TOUCH_SETTLE_READS; ++i)	// Touch-down edge. Throw these away
+	{
+		Touch.readAdc(disp, &x, &y);
+		delayMicroseconds(TOUCH_READ_SPACING);
+	}
+
+	for (i = 0; i < TOUCH_BURST; ++i)
+	{
+		Touch.readAdc(disp, &xr[i], &yr[i]);
+		delayMicroseconds(TOUCH_READ_SPACING);
+	}
+	PROF_SPI(TOUCH_SETTLE_READS + TOUCH_BURST + 1);
+
+	// Finger came up during the burst. The tail of the burst is release-edge garbage
+	if (!Touch.touched(disp))
+	{
+		++touchRejected;
+		return false;
+	}
+
+	sortTouchReadings(xr);
+	sortTouchReadings(yr);
+
+	// Stability gate. Ignore the single highest & lowest reading, then check how far apart the rest are
+	if (((xr[TOUCH_BURST - 2] - xr[1]) > TOUCH_MAX_SPREAD) || ((yr[TOUCH_BURST - 2] - yr[1]) > TOUCH_MAX_SPREAD))
+	{
+		++touchRejected;
+		return false;
+	}
+
+	raw->x = xr[TOUCH_BURST / 2];
+	raw->y = yr[TOUCH_BURST / 2];
+
+	// Pressure gate. The RA8875 doesn't give us a Z reading, but a light touch pulls the ADC toward the rails
+	if ((raw->x < TOUCH_ADC_MIN) || (raw->x > TOUCH_ADC_MAX) || (raw->y < TOUCH_ADC_MIN) || (raw->y > TOUCH_ADC_MAX))
+	{
+		++touchRejected;
+		return false;
+	}
+
+	++touchAccepted;
+	return true;
+}
+
+/**************************************************************************/
+/*!
+@brief  Checks for a touch event
+Returns TOUCH_ACCEPTED if the screen was touched and point holds a good, calibrated location
+Returns TOUCH_REJECTED if the screen is being touched but the sample was too noisy to use
+Returns TOUCH_NONE if the screen isn't being touched
+*/
+/**************************************************************************/
+int ClockDisplay::checkForTouchEvent(ClockScreen* disp, tsPoint_t * point, bool waitMode)
+{
+
+	tsPoint_t raw, calibrated;
+	uint16_t x, y;
+
+	PROF_STAGE(PROF_TOUCH);
+	point->x = 0;
+	point->y = 0;
+
+	disp->touchEnable(true);
+	PROF_SPI(2);
+	if (Touch.touched(disp))
+	{
+		// We're reading the raw register data.
+		// The Sumotoy calibration routine was highly inaccurate,
+		// So we're using the Adafruit calibration code instead
+		if (!readTouchSample(disp, &raw))
+			return TOUCH_REJECTED;
+
+		calibrateTSPoint(&calibrated, &raw);
+		point->x = calibrated.x;
+		point->y = calibrated.y;
+		//disp->fillCircle(point->x, point->y, 3, RA8875_YELLOW);
+
+		if (waitMode) // waitMode = wait for remaining touches to be cleared
+		{
+			while (Touch.touched(disp))
+			{
+				Touch.readAdc(disp, &x, &y);
+				PROF_SPI(2);
+				delay(1);
+			}
+		}
+		return TOUCH_ACCEPTED;
+	}
+
+	return TOUCH_NONE;
+}
+
+/**************************************************************************/
+/*!
+@brief  Starts the screen calibration process.  Each corner will be
+tested, meaning that each boundary (top, left, right and
+bottom) will be tested twice and the readings averaged.
+*/
+/**************************************************************************/
+void ClockDisplay::tsCalibrate(ClockScreen* disp)
+{
+	// read calibration data from eeprom
+	_tsMatrix0.An = storage->readSignedLong(EEPROM_CALIBRATION_LOCATION);
+	_tsMatrix0.Bn = storage->readSignedLong(EEPROM_CALIBRATION_LOCATION + 4);
+	_tsMatrix0.Cn = storage->readSignedLong(EEPROM_CALIBRATION_LOCATION + 8);
+	_tsMatrix0.Dn = storage->readSignedLong(EEPROM_CALIBRATION_LOCATION + 12);
+	_tsMatrix0.En = storage->readSignedLong(EEPROM_CALIBRATION_LOCATION + 16);
+	_tsMatrix0.Fn = storage->readSignedLong(EEPROM_CALIBRATION_LOCATION + 20);
+	_tsMatrix0.Divider = storage->readSignedLong(EEPROM_CALIBRATION_LOCATION + 24);
+
+	/*
+	Serial.println(_tsMatrix0.An);
+	Serial.println(_tsMatrix0.Bn);
+	Serial.println(_tsMatrix0.Cn);
+	Serial.println(_tsMatrix0.Dn);
+	Serial.println(_tsMatrix0.En);
+	Serial.println(_tsMatrix0.Fn);
+	Serial.println(_tsMatrix0.Divider);
+	*/
+
+	_tsMatrix180.An = storage->readSignedLong(EEPROM_CALIBRATION_LOCATION + 28);
+	_tsMatrix180.Bn = storage->readSignedLong(EEPROM_CALIBRATION_LOCATION + 32);
+	_tsMatrix180.Cn = storage->readSignedLong(EEPROM_CALIBRATION_LOCATION + 36);
+	_tsMatrix180.Dn = storage->readSignedLong(EEPROM_CALIBRATION_LOCATION + 40);
+	_tsMatrix180.En = storage->readSignedLong(EEPROM_CALIBRATION_LOCATION + 44);
+	_tsMatrix180.Fn = storage->readSignedLong(EEPROM_CALIBRATION_LOCATION + 48);
+	_tsMatrix180.Divider = storage->readSignedLong(EEPROM_CALIBRATION_LOCATION + 52);
+
+	/*
+	Serial.println(_tsMatrix180.An);
+	Serial.println(_tsMatrix180.Bn);
+	Serial.println(_tsMatrix180.Cn);
+	Serial.println(_tsMatrix180.Dn);
+	Serial.println(_tsMatrix180.En);
+	Serial.println(_tsMatrix180.Fn);
+	Serial.println(_tsMatrix180.Divider);
+	*/
+}
+
+/*
+Display boot-up colors test pattern on the screen. Oooh, pretty!
+stepTime - ms each color stays up
+bootWork - optional. Called with the step number (0-6) right after each color goes up, so boot work can get done
+           while we'd otherwise just be waiting. The step still lasts stepTime in total.
+*/
+void ClockDisplay::testPattern(ClockScreen *disp, uint16_t stepTime, void (*bootWork)(uint8_t))
+{
+	uint16_t colors[] = { RA8875_WHITE , RA8875_RED , RA8875_YELLOW , RA8875_GREEN , RA8875_CYAN , RA8875_MAGENTA, RA8875_BLACK };
+	unsigned long stepStart;
+
+	for (int i = 0; i < TESTPATTERN_STEPS; ++i)
+	{
+		stepStart = millis();
+		disp->fillWindow(colors[i]);
+		if (bootWork != NULL)
+			bootWork(i);
+		while ((millis() - stepStart) < stepTime)
+			;
+	}
+}
+
+ClockDisplay::ClockDisplay(ClockRtc *clock, ClockStorage *store)
+{
+	rtc = clock;
+	storage = store;
+
+	// Initiatize Main Time section
+	timeArray[0].setup('0', HRHIGH);
+	timeArray[1].setup('0', HRLOW);
+	timeArray[2].setup('0', MNHIGH);
+	timeArray[3].setup('0', MNLOW);
+	timeArray[4].setup('0', SEHIGH);
+	timeArray[5].setup('0', SELOW);
+	colonChar1.setup(':', COLON1);
+	colonChar2.setup(':', COLON2);
+
+	// Initialize Main Date section
+	dateArray[0].setup('0', MOHIGH);
+	dateArray[1].setup('1', MOLOW);
+	dateArray[2].setup('0', DYHIGH);
+	dateArray[3].setup('1', DYLOW);
+	dateArray[4].setup('1', YRHIGH);
+	dateArray[5].setup('6', YRLOW);
+	slashChar1.setup('/', SLASH1);
+	slashChar2.setup('/', SLASH2);
+
+#if FACE_12H
+	// Initialize  up AM/PM indicator dots
+	amDot.setup(X_AMPM, Y_AM, AMPM_DOTSIZE);
+	pmDot.setup(X_AMPM, Y_PM, AMPM_DOTSIZE);
+#endif
+
+	numberBase = BASE_HEX;	// Default number base for display is HEX
+	configMode = false;		// In "run" mode, not configutration mode
+	setupPending = 0;
+#if FACE_SETUP
+	setupState = NULL;
+#endif
+	settingsDirty = false;
+	displayBase = DISPLAY_24H;	// Default to military time display
+	timeMode = TIME_MODE_CLOCK;
+	colorMode = COLOR_MODE_FIXED;
+	sunPanel = sunDirty = false;
+	faceFg = faceBg = 0;
+	recolorRest = false;
+#if FACE_TIMECOLOR
+	timeColor = stagedColor = 0;
+#endif
+	amPm = AMPM_MORNING;				// default to AM
+	rotation = ROTATION_0;				// 0-degree screen rotation
+	_tsMatrixPtr = &_tsMatrix0;			// Touch screen calibration matrix for 0-degree rotation
+	touchAccepted = touchRejected = 0;
+	timeRowDrawn = 0;
+	secondsDrawn = 0;
+	alarmMark = ALARM_MARK_NONE;
+	stagedValid = false;
+	quiet = false;
+}
+
+
+ClockDisplay::~ClockDisplay()
+{
+}
+
+/*
+Work out the display digits for a time: high & low digit of each unit, hours through years
+Hex or decimal per the current base (decimal on the setup screen), 12-hour adjusted if need be.
+A hex-only face (FACE_DECIMAL 0) is hex on the setup screen too.
+*/
+void ClockDisplay::timeToDigits(struct ts *tm, char *chars, uint8_t *values, bool *morning)
+{
+	uint8_t tUnit, base;
+	int i;
+	char *baseArray = "0123456789ABCDEF";	// Possible display digits
+
+#if FACE_DECIMAL
+	base = configMode ? BASE_DEC : numberBase;
+#else
+	base = BASE_HEX;
+#endif
+	for (i = UNIT_HOUR; i <= UNIT_YEAR_SHORT; ++i)	// Loop through all time/date parts
+	{
+		tUnit = ClockRtc::unitOf(tm, i);
+
+		if (i == UNIT_HOUR)		// Account for 12H display
+		{
+			*morning = (tUnit < 12) ? AMPM_MORNING : AMPM_AFTERNOON;
+			if (FACE_12H && (displayBase == DISPLAY_12H))
+			{
+				if (tUnit > 12)
+					tUnit -= 12;
+				if (tUnit == 0) 
+					tUnit = 12;
+			}
+		}
+
+		// Get high- and low-order digits base on the current display mode (decimal or hex)
+		chars[(i - 1) * 2] = baseArray[tUnit / base];
+		chars[((i - 1) * 2) + 1] = baseArray[tUnit % base];
+		values[(i - 1) * 2] = tUnit >> 4;
+		values[((i - 1) * 2) + 1] = tUnit & 0xF;
+	}
+
+	// Dimmed face: the seconds are blank, so it only changes on the minute. Hex day time keeps its own digits
+	if (quiet && !configMode)
+	{
+		chars[SEHIGH] = chars[SELOW] = ' ';
+		values[SEHIGH] = values[SELOW] = 0;
+	}
+
+#if FACE_HEXTIME
+	// Hex day time replaces the time digits. Off the timer once it's locked, otherwise from the RTC seconds
+	if (hexDay())
+		hexToDigits(Hex.locked() ? Hex.now() : HexTime::fromSeconds(tm->hour * 3600UL + tm->min * 60 + tm->sec),
+			chars, values);
+#endif
+}
+
+/*
+Hex day time digits for 'sub' 1/16 units since midnight. The four hex digits sit in the middle of the time row,
+" A:B7:C ", which also puts them in the binary rows two to a row: H is the first, M the middle two and S the last,
+with the 1/16 unit next to it (HEX_PROGRESS).
+*/
+void ClockDisplay::hexToDigits(uint32_t sub, char *chars, uint8_t *values)
+{
+	uint16_t unit = sub / HEX_SUBS_PER_UNIT;
+	char *baseArray = "0123456789ABCDEF";
+	int i;
+
+	values[HRHIGH] = 0;
+	values[HRLOW] = unit >> 12;
+	values[MNHIGH] = (unit >> 8) & 0xF;
+	values[MNLOW] = (unit >> 4) & 0xF;
+	values[SEHIGH] = unit & 0xF;
+	values[SELOW] = HEX_PROGRESS ? (sub % HEX_SUBS_PER_UNIT) : 0;
+	for (i = HRLOW; i <= SEHIGH; ++i)
+		chars[i] = baseArray[values[i]];
+	chars[HRHIGH] = chars[SELOW] = ' ';
+}
+
+// The time digits are following the hex day timer, not the RTC seconds
+bool ClockDisplay::hexTicking()
+{
+#if FACE_HEXTIME
+	return hexDay() && Hex.locked();
+#else
+	return false;
+#endif
+}
+
+// Clock or hex day time. The hex day timer (and the RTC's 32kHz output) only runs while it's in use
+void ClockDisplay::setTimeMode(uint8_t mode)
+{
+#if FACE_HEXTIME
+	timeMode = (mode == TIME_MODE_HEXDAY) ? TIME_MODE_HEXDAY : TIME_MODE_CLOCK;
+	if (timeMode == TIME_MODE_HEXDAY)
+		Hex.begin();
+	else
+		Hex.end();
+#else
+	timeMode = TIME_MODE_CLOCK;
+#endif
+	stagedValid = false;
+}
+
+/*
+Refresh the time on the clock
+Refreshes only the internal time elements. Does NOT refresh the time on the clock's face. refreshClock() does that.
+Mode is passed through to the function that updates the time/date character objects:
+	REFRESH_MIN = refresh an object only if the value of the time element in that object has changed. Minimizes screen redraws, which can be slow on the tft display.
+	REFRESH_ALL = Refresh the object whether it's changed or not. Forces a full redraw of the whole clock acreen.
+Returns true if anything needs redrawing
+*/
+bool ClockDisplay::refreshTime(ClockScreen *disp, int mode)
+{
+	char chars[TIME_DIGITS];
+	uint8_t values[TIME_DIGITS];
+	bool changed = false;
+	int i;
+#if FACE_HEXTIME
+	uint8_t edges = Hex.getEdges();
+	struct ts *tm;
+#endif
+
+	PROF_STAGE(PROF_REFRESHTIME);
+
+	rtc->readTime();		// One read gets every unit
+#if FACE_HEXTIME
+	tm = rtc->getTime();
+	Hex.expect(tm->hour * 3600UL + tm->min * 60 + tm->sec, edges);	// The next 1Hz edge checks the timer against this
+#endif
+	timeToDigits(rtc->getTime(), chars, values, &amPm);
+#if FACE_TIMECOLOR
+	timeColor = colorOfTime(rtc->getTime());
+#endif
+#if FACE_SUN
+	// The date's rolled over (or the place has changed): today's sun times, once
+	if (sunPanel && Sun.update(rtc->getTime()))
+	{
+		sunDirty = true;
+		changed = true;
+	}
+#endif
+#if FACE_SETUP && FACE_ALARM
+	// The alarm being set on the setup screen takes the time row: its hours & minutes, then "A1" when it's on or "A0"
+	if (configMode && setupState && setupState->alarmView)
+	{
+		struct ts alarmTm = *rtc->getTime();
+		bool morning;
+
+		alarmTm.hour = setupState->alarm.hour;
+		alarmTm.min = setupState->alarm.min;
+		timeToDigits(&alarmTm, chars, values, &morning);
+		values[SEHIGH] = 0xA;
+		values[SELOW] = (setupState->alarm.days & ALARM_ON) ? 1 : 0;
+		chars[SEHIGH] = 'A';
+		chars[SELOW] = '0' + values[SELOW];
+	}
+#endif
+#if FACE_SETUP
+	// The row being typed in on the keypad
+	if (configMode && setupState && setupState->keyRow)
+		keypadDigits(chars, values);
+#endif
+	// While the hex day timer has the time digits, only a full refresh touches them. See refreshHexTime()
+	for (i = (hexTicking() && (mode != REFRESH_ALL)) ? TIME_DIGITS / 2 : 0; i < TIME_DIGITS; ++i)
+		changed |= faceDigit(i)->setNewChar(values[i], chars[i], mode);
+
+	// The stopwatch puts colons in the date row
+	if (slashChar1.getChar() != '/')
+	{
+		slashChar1.setNewChar(0, '/', mode);
+		slashChar2.setNewChar(0, '/', mode);
+		changed = true;
+	}
+
+	return changed;
+}
+
+// Stopwatch or countdown is up in place of the time. Setup always shows the clock
+bool ClockDisplay::inWatch()
+{
+#if FACE_WATCH
+	return Watch.isOn() && !configMode;
+#else
+	return false;
+#endif
+}
+
+/*
+Stopwatch digits, always decimal. The time row has minutes, seconds & hundredths (tenths and a blank once the watch
+has dropped to its slow rate), the date row the last lap, blank until there is one. Colons in both rows. The binary
+rows show the same units. Returns true if anything needs redrawing
+*/
+bool ClockDisplay::refreshWatch(int mode)
+{
+#if FACE_WATCH
+	unsigned long t;
+	ClockDigit *row;
+	uint8_t unit, r, i;
+	bool changed = false, blank;
+	char c;
+
+	if (mode == REFRESH_ALL)
+		stagedValid = false;	// Staged clock digits are stale by the time the watch is put away
+	for (r = 0; r < 2; ++r)
+	{
+		row = r ? dateArray : timeArray;
+		t = r ? Watch.getLap() : Watch.shown(millis());
+		blank = r && (Watch.getLaps() == 0);
+		if (!r && Watch.isSlow())
+			t -= t % 100;
+		for (i = 0; i < TIME_DIGITS / 2; ++i)
+		{
+			unit = (i < 2) ? t / 60000 % 100 : (i < 4) ? t / 1000 % 60 : t / 10 % 100;
+			c = '0' + ((i & 1) ? unit % 10 : unit / 10);
+			if (blank || (!r && (i == SELOW) && Watch.isSlow()))
+				c = ' ';
+			changed |= row[i].setNewChar(blank ? 0 : ((i & 1) ? unit & 0xF : unit >> 4), c, mode);
+		}
+	}
+	changed |= colonChar1.setNewChar(0, ':', mode);
+	changed |= colonChar2.setNewChar(0, ':', mode);
+	changed |= slashChar1.setNewChar(0, blank ? ' ' : ':', mode);
+	changed |= slashChar2.setNewChar(0, blank ? ' ' : ':', mode);
+	return changed;
+#else
+	return false;
+#endif
+}
+
+/*
+Hex day timer tick. Puts the timer's time up in the time digits. Only the digits that change are touched, so one
+that changed on the last tick and hasn't been drawn yet keeps its update. Returns true if anything needs redrawing
+*/
+bool ClockDisplay::refreshHexTime()
+{
+#if FACE_HEXTIME
+	char chars[TIME_DIGITS / 2];
+	uint8_t values[TIME_DIGITS / 2];
+	bool changed = false;
+	int i;
+
+	if (!hexTicking())
+		return false;
+	hexToDigits(Hex.now(), chars, values);
+	for (i = 0; i < TIME_DIGITS / 2; ++i)
+	{
+		if ((chars[i] != timeArray[i].getChar()) || (values[i] != timeArray[i].getValue()))
+			changed |= timeArray[i].setNewChar(values[i], chars[i]);
+	}
+	return changed;
+#else
+	return false;
+#endif
+}
+
+/*
+Get the next second ready ahead of the tick
+Works out the digits for one second after the last RTC read and which of them will change, so when the tick comes
+applyStagedTime() only has to copy them in and the redraw can start straight away.
+Nothing is staged while the face is quiet: the seconds aren't shown, and the minute is read from the RTC.
+*/
+void ClockDisplay::stageNextSecond()
+{
+	struct ts next;
+	int i;
+
+	if (quiet)
+	{
+		stagedValid = false;
+		return;
+	}
+	rtc->getNextSecond(&next);
+	timeToDigits(&next, stagedChar, stagedValue, &stagedAmPm);
+#if FACE_TIMECOLOR
+	stagedColor = colorOfTime(&next);
+#endif
+	stagedMask = 0;
+	for (i = hexTicking() ? TIME_DIGITS / 2 : 0; i < TIME_DIGITS; ++i)	// Hex day timer ticks the time digits itself
+	{
+		if ((stagedChar[i] != faceDigit(i)->getChar()) || (stagedValue[i] != faceDigit(i)->getValue()))
+			stagedMask |= (1 << i);
+	}
+	stagedValid = true;
+}
+
+// Put the staged digits up on the tick. Returns false if nothing was staged (the time has to be read instead)
+bool ClockDisplay::applyStagedTime()
+{
+	int i;
+
+	if (!stagedValid)
+		return false;
+	for (i = 0; i < TIME_DIGITS; ++i)
+	{
+		if (stagedMask & (1 << i))
+			faceDigit(i)->setNewChar(stagedValue[i], stagedChar[i]);
+	}
+	amPm = stagedAmPm;
+#if FACE_TIMECOLOR
+	timeColor = stagedColor;
+#endif
+	stagedValid = false;	// Good for one tick only
+	return true;
+}
+
+void ClockDisplay::setRotation(uint8_t rot)
+{
+	rotation = rot;
+	_tsMatrixPtr = (rotation == ROTATION_0) ? &_tsMatrix0 : &_tsMatrix180;	// Set calibration matrix based on screen orientation (0 or 180 degrees)
+}
+
+
+/*
+Refresh the clock face.
+refreshMode indicates how to handles the refresh
+	REFRESH_MIN = refresh the character object only if the value of the time element in that object has changed. Minimizes screen redraws, which can be slow on the tft display.
+	REFRESH_ALL = Refresh the character whether it's changed or not. Forces a full redraw of the whole clock.
+drawMode indicates what parts of the clock face to draw
+	DRAW_HEXBIN	= Draw both Hex & Binary parts
+	DRAW_HEXONLY = Draw only the upper hexadecimal part
+A full redraw starts with the controller filling the screen with the background, so the big digits only need their
+strokes put down (ClockDigit::inkChar()). That's what makes it quick enough for the color of the time, which changes
+the background a dozen times a minute: when the face colors have changed, a minimal refresh becomes a full one.
+That recolor is done in two halves, so neither runs past the render budget: the fill and the time row, then
+everything else on the next call. isRecoloring() says the second half is still to come.
+*/
+void ClockDisplay::refreshClock(ClockScreen *disp, int refreshMode, int drawMode)
+{
+	bool rest = recolorRest;
+#if FACE_DIGITS
+	bool cheapest, ink, recolor = false;
+#endif
+
+	PROF_STAGE(PROF_REFRESHCLOCK);
+	recolorRest = false;
+	if (refreshMode == REFRESH_ALL)
+	{
+		faceColors(true);
+		rest = false;
+	}
+	else if (faceColors(false))
+	{
+		triggerAll();
+		refreshMode = REFRESH_ALL;
+#if FACE_DIGITS
+		recolor = true;		// In two halves. Without the big digits it's quick enough in one
+#endif
+	}
+	else if (rest)
+	{
+		// Second half of a recolor. The fill's done and the time row is up, so everything else is drawn as it would be
+		// after a fill. The time row only gets what's changed since
+		refreshMode = REFRESH_ALL;
+		triggerAll(false);
+	}
+	if (refreshMode == REFRESH_ALL)
+		RamMon.enterRedraw();
+	if ((refreshMode == REFRESH_ALL) && !rest)
+	{
+		disp->fillWindow(faceBg);		// Start with a clean slate
+		PROF_SPI(1);
+	}
+
+	disp->setRotation(rotation);
+	PROF_SPI(1);
+		
+#if FACE_DIGITS
+	cheapest = inWatch() && (refreshMode != REFRESH_ALL);	// Stopwatch frames repaint the big digits the cheapest way
+	ink = (refreshMode == REFRESH_ALL);
+
+	// Print time
+	// The big time digits go first, so after a full redraw the time is up on the screen as soon as possible.
+	// Seconds go before hours & minutes: they change on every tick, so they're the ones to get up quickest
+	drawDigit(disp, &timeArray[SEHIGH], cheapest, ink && !rest);
+	drawDigit(disp, &timeArray[SELOW], cheapest, ink && !rest);
+	secondsDrawn = micros();
+	for (int i = HRHIGH; i <= MNLOW; ++i)		// HH, MM
+		drawDigit(disp, &timeArray[i], cheapest, ink && !rest);
+	drawDigit(disp, &colonChar1, false, ink && !rest);	// 2 colons between time elements
+	drawDigit(disp, &colonChar2, false, ink && !rest);
+
+	if ((refreshMode == REFRESH_ALL) && !rest)
+		timeRowDrawn = millis();
+	if (recolor)
+	{
+		recolorRest = true;
+		RamMon.leaveRedraw();
+		return;
+	}
+
+	// Print Date
+	for (int i = 0; i<6; ++i)		// MM, DD, YY
+		drawDigit(disp, &dateArray[i], cheapest, ink);
+	drawDigit(disp, &slashChar1, false, ink);	// 2 slashes between date elements
+	drawDigit(disp, &slashChar2, false, ink);
+#endif
+
+	// Normally we draw both the hex/decimal time on the upper part of the screen and the binary time on the lower part of the screen. 
+	// On the configuration screen, we don't want to draw the binary time, because that's where the config buttons go
+	// DRAW_HEXONLY indicates to not draw the lower binary part
+#if FACE_BINARY
+	if (drawMode == DRAW_HEXBIN)
+	{
+		for (int i = 0; i < 6; ++i)
+		{
+			timeArray[i].drawBinary(disp, faceFg, faceBg);
+			if (!sunPanel)
+				dateArray[i].drawBinary(disp, faceFg, faceBg);
+		}
+#if FACE_SUN
+		if (sunPanel)
+			drawSunPanel(disp, refreshMode == REFRESH_ALL);
+#endif
+	}
+#endif
+#if !FACE_DIGITS
+	secondsDrawn = micros();	// The binary rows are all there is
+	if (refreshMode == REFRESH_ALL)
+		timeRowDrawn = millis();
+#endif
+
+#if FACE_12H
+	if ((displayBase == DISPLAY_12H) && !hexDay() && !inWatch())	// Need AM/PM indicator
+	{
+		if (amPm == AMPM_MORNING)
+		{
+			if (refreshMode == REFRESH_ALL)
+				amDot.refreshDot(disp, faceFg);
+			else
+				amDot.drawDot(disp, faceFg);
+			pmDot.eraseDot(disp, faceBg);
+		}
+		else // AMPM_AFTERNOON
+		{
+			amDot.eraseDot(disp, faceBg);
+			if (refreshMode == REFRESH_ALL)
+				pmDot.refreshDot(disp, faceFg);
+			else
+				pmDot.drawDot(disp, faceFg);
+		}
+	}
+	else
+	{
+		amDot.eraseDot(disp, faceBg);
+		pmDot.eraseDot(disp, faceBg);
+	}
+#endif
+
+	if (drawMode == DRAW_HEXBIN)
+		drawAlarmMark(disp, refreshMode == REFRESH_ALL);
+
+#if FACE_BINARY
+	if ((refreshMode == REFRESH_ALL) && (drawMode == DRAW_HEXBIN))  // Refreshing whole screen (hex & binary). Need to add the binary labels
+	{
+		disp->setFont(INT);
+		disp->setTextColor(faceFg, faceBg);
+		disp->setFontScale(BINFONTSIZE);
+
+		disp->setCursor(X_BIN_TIMELABEL, Y_BIN_1); disp->println(F("H:"));
+		disp->setCursor(X_BIN_TIMELABEL, Y_BIN_2); disp->println(F("M:"));
+		disp->setCursor(X_BIN_TIMELABEL, Y_BIN_3); disp->println(F("S:"));
+
+		disp->setCursor(X_BIN_DATELABEL, Y_BIN_1); disp->println(sunPanel ? F("R:") : F("M:"));	// Sunrise, sunset & length of the day
+		disp->setCursor(X_BIN_DATELABEL, Y_BIN_2); disp->println(sunPanel ? F("S:") : F("D:"));
+		disp->setCursor(X_BIN_DATELABEL, Y_BIN_3); disp->println(sunPanel ? F("L:") : F("Y:"));
+		PROF_SPI(15);
+	}
+#endif
+
+	if (refreshMode == REFRESH_ALL)
+		RamMon.leaveRedraw();
+
+	return;
+}
+
+#if FACE_DIGITS
+// Draw one big digit, just its strokes (ink) after a full-screen fill. Stopwatch frames count how each one was repainted
+void ClockDisplay::drawDigit(ClockScreen *disp, ClockDigit *digit, bool cheapest, bool ink)
+{
+#if FACE_WATCH
+	uint8_t how = ink ? digit->inkChar(disp, faceFg) : digit->drawChar(disp, faceFg, faceBg, cheapest);
+
+	if (cheapest && (how != REPAINT_NONE))
+		Watch.painted(how);
+#else
+	if (ink)
+		digit->inkChar(disp, faceFg);
+	else
+		digit->drawChar(disp, faceFg, faceBg, cheapest);
+#endif
+}
+#endif
+
+/*
+Pick the colors the face is drawn in: the color of the time when that's chosen, otherwise the ones from setup. The
+setup screen always has setup's, and a stopwatch keeps the ones it was put up in until there's a full redraw ('all').
+Returns true if they've changed, which means the whole face has to be redrawn in them
+*/
+bool ClockDisplay::faceColors(bool all)
+{
+	uint16_t fg = fgColor, bg = bgColor;
+
+#if FACE_TIMECOLOR
+	if ((colorMode == COLOR_MODE_TIME) && !configMode)
+	{
+		if (inWatch() && !all)
+			return false;
+		bg = timeColor;
+		fg = contrastOf(bg);
+	}
+#endif
+	if ((fg == faceFg) && (bg == faceBg))
+		return false;
+	faceFg = fg;
+	faceBg = bg;
+	return true;
+}
+
+// Every digit, colon & slash gets drawn on the next refreshClock(). Or all but the big time digits & colons (timeRow false)
+void ClockDisplay::triggerAll(bool timeRow)
+{
+	uint8_t i;
+
+	for (i = 0; i < 6; ++i)
+	{
+		if (timeRow)
+			timeArray[i].triggerHexUpdate();
+		timeArray[i].triggerBinaryUpdate();
+		dateArray[i].triggerHexUpdate();
+		dateArray[i].triggerBinaryUpdate();
+	}
+	if (timeRow)
+	{
+		colonChar1.triggerHexUpdate();
+		colonChar2.triggerHexUpdate();
+	}
+	slashChar1.triggerHexUpdate();
+	slashChar2.triggerHexUpdate();
+}
+
+/*
+The alarm mark, left of the binary rows: "ALM" while an alarm is set, flashing inverted while it rings, and "SNZ"
+while it's snoozed. Only drawn when it changes, or on a full redraw
+*/
+void ClockDisplay::drawAlarmMark(ClockScreen* disp, bool all)
+{
+#if FACE_ALARM
+	uint8_t mark = Alarms.getMark();
+	uint16_t box = (mark == ALARM_MARK_RING) ? faceFg : faceBg;
+
+	if ((mark == alarmMark) && !all)
+		return;
+	alarmMark = mark;
+	if (all && (mark == ALARM_MARK_NONE))	// Already cleared
+		return;
+
+	disp->fillRect(X_ALARMMARK, Y_ALARMMARK, W_ALARMMARK, H_ALARMMARK, box);
+	PROF_SPI(1);
+	if (mark == ALARM_MARK_NONE)
+		return;
+	disp->setFont(INT);
+	disp->setFontScale(ALARMFONTSIZE);
+	disp->setTextColor((mark == ALARM_MARK_RING) ? faceBg : faceFg, box);
+	disp->setCursor(X_ALARMMARK + DX_ALARMTEXT, Y_ALARMMARK + DY_ALARMTEXT);
+	disp->print((mark == ALARM_MARK_SNOOZE) ? F("SNZ") : F("ALM"));
+	PROF_SPI(6);
+#endif
+}
+
+#if FACE_SUN
+/*
+The sun panel, where the binary date goes: sunrise, sunset and the length of the day, as hours:minutes in the face's
+number base. Only drawn when the times have been worked out again, or on a full redraw
+*/
+void ClockDisplay::drawSunPanel(ClockScreen* disp, bool all)
+{
+	const sunTimes_t *sun = Sun.get();
+
+	if (!sunDirty && !all)
+		return;
+	sunDirty = false;
+	disp->setFont(INT);
+	disp->setFontScale(BINFONTSIZE);
+	disp->setTextColor(faceFg, faceBg);
+	PROF_SPI(3);
+	drawSunTime(disp, Y_BIN_1, sun->rise);
+	drawSunTime(disp, Y_BIN_2, sun->set);
+	drawSunTime(disp, Y_BIN_3, sun->length);
+}
+
+// HH:MM, or --:-- for a rise or set that doesn't happen today. Always five characters, so it covers the last one
+void ClockDisplay::drawSunTime(ClockScreen* disp, int16_t y, uint16_t minutes)
+{
+	const char *baseArray = "0123456789ABCDEF";
+	char text[6] = "--:--";
+	uint8_t h = minutes / 60, m = minutes % 60;
+
+	if (minutes != SUN_NONE)
+	{
+		text[0] = baseArray[h / numberBase];
+		text[1] = baseArray[h % numberBase];
+		text[3] = baseArray[m / numberBase];
+		text[4] = baseArray[m % numberBase];
+	}
+	disp->setCursor(X_BINDATE, y);
+	disp->print(text);
+	PROF_SPI(2);
+}
+#endif
+
+/*
+Put a low memory warning in the corner of the screen
+freeBytes - smallest gap there has been between the stack and the heap
+It's redrawn every time it's called, since a full redraw of the face wipes it out
+*/
+void ClockDisplay::showRamWarning(ClockScreen* disp, uint16_t freeBytes)
+{
+	disp->setFont(INT);
+	disp->setFontScale(0);
+	disp->setTextColor(RA8875_RED, faceBg);
+	disp->setCursor(X_RAMWARN, Y_RAMWARN);
+	disp->print(F("LOW RAM "));
+	disp->print(freeBytes);
+	PROF_SPI(6);
+}
+
+#if FACE_SETUP
+
+/*
+Given an X,Y point on the screen, return which button (if any) was pressed
+Returns 0-MAXBUTTONS for an actual button
+Returns -1 if area pressed was not a button
+*/
+int ClockDisplay::identifyArea(tsPoint_t point)
+{
+	Button *buttonArray = setupState->buttons;
+	int i, count = setupState->keyRow ? KEYPAD_KEYS : (setupState->pickFor ? PICKER_KEYS : MAXBUTTONS);	// Only the keys are live while the keypad or picker is up
+
+	for (i = 0; i < count; ++i)
+	{
+		if (buttonArray[i].isButton(point.x, point.y))
+			return i;
+	}
+	return -1;
+}
+
+/*
+Enter setup mode
+Displays the setup screen and places the buttons. Setup doesn't block. Once it's started, call serviceSetup() from loop()
+until it returns false. The clock keeps running the whole time.
+*/
+void ClockDisplay::startSetup(ClockScreen* disp)
+{
+	// Setup is the top owner, so this always works. A screenshot going out stops
+	setupState = (setupScratch_t *)Arena.take(ARENA_SETUP, sizeof(setupScratch_t));
+
+	/*
+	systemresetCounter is used as a safeguard to accidentally resetting the clock
+	The user must press the three reset buttons in order to force the reset.
+	Press the buttons in any other order and systemresetCounter is reset to zero and the user must start again.
+	*/
+	setupState->systemResetCounter = 0;
+	Touch.action();		// The long press got here
+
+	configMode = true;  // Tells the clock we're in configuration mode. Suppress some normal screen drawing functions
+	stagedValid = false;	// Setup shows decimal digits and can change the time
+	RamMon.setMode(RAM_MODE_SETUP);
+	setupPending = SETUP_PENDING_BUTTONS;
+	setupState->touchDown = true;	// The finger that opened setup is probably still on the screen. Wait for it to come up.
+	setupState->lastTouch = millis();
+	setupState->keyRow = KEY_ROW_NONE;
+	setupState->pickFor = PICK_FOR_NONE;
+	setupState->pickDrag = 0;
+
+	placeSetupButtons();
+
+#if FACE_ALARM
+	// The alarm they bring up: the next one due, or the first in the table, or a new one
+	setupState->alarmView = false;
+	setupState->alarmDirty = false;
+	if (!Alarms.getNext(&setupState->alarm) && !Alarms.read(0, &setupState->alarm))
+	{
+		setupState->alarm.hour = ALARM_SETUP_HOUR;
+		setupState->alarm.min = ALARM_SETUP_MIN;
+		setupState->alarm.days = ALARM_EVERY_DAY;
+	}
+	setupState->alarmHour = setupState->alarm.hour;
+	setupState->alarmMin = setupState->alarm.min;
+#endif
+
+	disp->fillWindow(bgColor);	// Clear the screen
+
+	// Get the latest date & time
+	refreshTime(disp, REFRESH_ALL);
+	
+	// Only draw upper part of screen
+	refreshClock(disp, REFRESH_ALL, DRAW_HEXONLY);
+}
+
+/*
+Run one step of setup mode
+Each call does at most one piece of work - a full face redraw, a button redraw, or handling a single touch - on top of
+the normal clock refresh, so the time on screen keeps ticking and loop() never waits long.
+Returns true while setup is still active, false once the user has pressed "Done!" or setup has timed out.
+*/
+bool ClockDisplay::serviceSetup(ClockScreen* disp)
+{
+	tsPoint_t calibrated;	// Holds calibrated screen points when screen is touched
+	int touchArea;			// The button that was touched
+	int touchState;
+
+	if (!configMode)
+		return false;
+
+	if (setupPending & SETUP_PENDING_EXIT)
+	{
+		endSetup(disp);
+		return false;
+	}
+
+	if (setupPending & SETUP_PENDING_FACE)	// Colors or rotation changed. Redraw the upper part of the screen
+	{
+		refreshTime(disp, REFRESH_ALL);
+		refreshClock(disp, REFRESH_ALL, DRAW_HEXONLY);
+		setupPending &= ~SETUP_PENDING_FACE;
+		return true;
+	}
+
+	if (setupPending & SETUP_PENDING_CONTROLS)	// Keypad or picker came up or went away. Clear under the date row
+	{
+		disp->fillRect(0, Y_CONTROLS, PANEL_WIDTH, PANEL_HEIGHT - Y_CONTROLS, bgColor);
+		setupPending &= ~SETUP_PENDING_CONTROLS;
+		return true;
+	}
+
+	if (setupPending & SETUP_PENDING_BUTTONS)
+	{
+		drawSetupButtons(disp);
+		setupPending &= ~SETUP_PENDING_BUTTONS;
+		return true;
+	}
+
+	// Keep the clock running on the setup screen
+	refreshTime(disp);
+	refreshClock(disp, REFRESH_MIN, DRAW_HEXONLY);
+
+	touchState = checkForTouchEvent(disp, &calibrated, false);
+	if (touchState == TOUCH_NONE)
+	{
+		setupState->touchDown = false;
+		if (setupState->pickDrag)		// Slider let go. The other sliders' ramps catch up with it
+		{
+			setupState->pickDrag = 0;
+			setupPending |= SETUP_PENDING_BUTTONS;
+		}
+		if ((millis() - setupState->lastTouch) > SETUP_IDLE_TIMEOUT)	// Nobody's home. Go back to the clock face
+			setupPending |= SETUP_PENDING_EXIT;
+		return true;
+	}
+
+	// Only act on the touch-down edge. Noisy samples and a finger that's still down from the last press are ignored,
+	// except that a picker slider follows the finger for as long as it stays down
+	if (touchState == TOUCH_REJECTED)
+		return true;
+	if (setupState->touchDown)
+	{
+		if (setupState->pickDrag)
+		{
+			setupState->lastTouch = millis();
+			movePicker(disp, setupState->pickDrag - 1, calibrated.x);
+		}
+		return true;
+	}
+
+	setupState->touchDown = true;
+	setupState->lastTouch = millis();
+
+	if ((touchArea = identifyArea(calibrated)) != -1)		// Was it touched in a button area?
+	{
+		Touch.action();
+		if (setupState->keyRow)
+			handleKey(touchArea);
+		else if (setupState->pickFor)
+			handlePick(disp, touchArea, calibrated.x);
+		else
+			handleSetupButton(disp, touchArea);
+	}
+
+	return true;
+}
+
+// Place the setup buttons: the touch areas over the digits, and the controls under them
+void ClockDisplay::placeSetupButtons()
+{
+	Button *buttonArray = setupState->buttons;
+
+	// The time & date fields. A tap on one brings up the keypad
+	buttonArray[BTN_HOUR].setup(X_TIMEHOURHIGH, Y_TIME_UPPER, ((X_COLON1) - (X_TIMEHOURHIGH)), H_LARGEDIGIT, NULL_COLOR, NULL_COLOR, NULL_COLOR, NULL, SETUPFONTSIZE, NULL, NULL, NULL);
+	buttonArray[BTN_MINUTE].setup(X_TIMEMINUTEHIGH, Y_TIME_UPPER, ((X_COLON2) - (X_TIMEMINUTEHIGH)), H_LARGEDIGIT, NULL_COLOR, NULL_COLOR, NULL_COLOR, NULL, SETUPFONTSIZE, NULL, NULL, NULL);
+	buttonArray[BTN_MONTH].setup(X_DATEMONTHHIGH, Y_DATE_UPPER, ((X_SLASH1) - (X_DATEMONTHHIGH)), H_LARGEDIGIT, NULL_COLOR, NULL_COLOR, NULL_COLOR, NULL, SETUPFONTSIZE, NULL, NULL, NULL);
+	buttonArray[BTN_DAY].setup(X_DATEDAYHIGH, Y_DATE_UPPER, ((X_SLASH2) - (X_DATEDAYHIGH)), H_LARGEDIGIT, NULL_COLOR, NULL_COLOR, NULL_COLOR, NULL, SETUPFONTSIZE, NULL, NULL, NULL);
+	buttonArray[BTN_YEAR].setup(X_DATEYEARHIGH, Y_DATE_UPPER, (W_LARGEDIGIT * 2), H_LARGEDIGIT, NULL_COLOR, NULL_COLOR, NULL_COLOR, NULL, SETUPFONTSIZE, NULL, NULL, NULL);
+
+	// These are the configuration buttons (color, number base, reset, etc)
+	buttonArray[BTN_FGBLACK].setup(X_COLOR1, Y_COLOR_FG, W_COLOR, H_COLOR, RA8875_BLACK, RA8875_WHITE, NULL, NULL, NULL, NULL, NULL, NULL);
+	buttonArray[BTN_FGBLUE].setup(X_COLOR2, Y_COLOR_FG, W_COLOR, H_COLOR, RA8875_BLUE, RA8875_WHITE, NULL, NULL, NULL, NULL, NULL, NULL);
+	buttonArray[BTN_FGRED].setup(X_COLOR3, Y_COLOR_FG, W_COLOR, H_COLOR, RA8875_RED, RA8875_BLACK, NULL, NULL, NULL, NULL, NULL, NULL);
+	buttonArray[BTN_FGGREEN].setup(X_COLOR4, Y_COLOR_FG, W_COLOR, H_COLOR, RA8875_GREEN, RA8875_BLACK, NULL, NULL, NULL, NULL, NULL, NULL);
+	buttonArray[BTN_FGCYAN].setup(X_COLOR5, Y_COLOR_FG, W_COLOR, H_COLOR, RA8875_CYAN, RA8875_BLACK, NULL, NULL, NULL, NULL, NULL, NULL);
+	buttonArray[BTN_FGMAGENTA].setup(X_COLOR6, Y_COLOR_FG, W_COLOR, H_COLOR, RA8875_MAGENTA, RA8875_BLACK, NULL, NULL, NULL, NULL, NULL, NULL);
+	buttonArray[BTN_FGYELLOW].setup(X_COLOR7, Y_COLOR_FG, W_COLOR, H_COLOR, RA8875_YELLOW, RA8875_BLACK, NULL, NULL, NULL, NULL, NULL, NULL);
+	buttonArray[BTN_FGWHITE].setup(X_COLOR8, Y_COLOR_FG, W_COLOR, H_COLOR, RA8875_WHITE, RA8875_BLACK, NULL, NULL, NULL, NULL, NULL, NULL);
+	buttonArray[BTN_BGBLACK].setup(X_COLOR1, Y_COLOR_BG, W_COLOR, H_COLOR, RA8875_BLACK, RA8875_WHITE, NULL, NULL, NULL, NULL, NULL, NULL);
+	buttonArray[BTN_BGBLUE].setup(X_COLOR2, Y_COLOR_BG, W_COLOR, H_COLOR, RA8875_BLUE, RA8875_WHITE, NULL, NULL, NULL, NULL, NULL, NULL);
+	buttonArray[BTN_BGRED].setup(X_COLOR3, Y_COLOR_BG, W_COLOR, H_COLOR, RA8875_RED, RA8875_BLACK, NULL, NULL, NULL, NULL, NULL, NULL);
+	buttonArray[BTN_BGGREEN].setup(X_COLOR4, Y_COLOR_BG, W_COLOR, H_COLOR, RA8875_GREEN, RA8875_BLACK, NULL, NULL, NULL, NULL, NULL, NULL);
+	buttonArray[BTN_BGCYAN].setup(X_COLOR5, Y_COLOR_BG, W_COLOR, H_COLOR, RA8875_CYAN, RA8875_BLACK, NULL, NULL, NULL, NULL, NULL, NULL);
+	buttonArray[BTN_BGMAGENTA].setup(X_COLOR6, Y_COLOR_BG, W_COLOR, H_COLOR, RA8875_MAGENTA, RA8875_BLACK, NULL, NULL, NULL, NULL, NULL, NULL);
+	buttonArray[BTN_BGYELLOW].setup(X_COLOR7, Y_COLOR_BG, W_COLOR, H_COLOR, RA8875_YELLOW, RA8875_BLACK, NULL, NULL, NULL, NULL, NULL, NULL);
+	buttonArray[BTN_BGWHITE].setup(X_COLOR8, Y_COLOR_BG, W_COLOR, H_COLOR, RA8875_WHITE, RA8875_BLACK, NULL, NULL, NULL, NULL, NULL, NULL);
+	buttonArray[BTN_BASE].setup(X_BASE, Y_BASE, W_BASE, H_BASE, RA8875_WHITE, RA8875_BLACK, RA8875_BLACK, RA8875_WHITE, SETUPFONTSIZE, (numberBase == BASE_HEX)?"HEX":"DEC", (X_BASE + DX_TOGGLETEXT), (Y_BASE + DY_TOGGLETEXT));
+	buttonArray[BTN_RST1].setup(X_RESET1, Y_RESET, W_RESET, H_RESET, RA8875_GREEN, RA8875_BLACK, RA8875_BLACK, RA8875_GREEN, SETUPFONTSIZE, "1st", (X_RESET1 + DX_RESETTEXT), (Y_RESET + DY_RESETTEXT));
+	buttonArray[BTN_RST2].setup(X_RESET2, Y_RESET, W_RESET, H_RESET, RA8875_YELLOW, RA8875_BLACK, RA8875_BLACK, RA8875_YELLOW, SETUPFONTSIZE, "2nd", (X_RESET2 + DX_RESETTEXT), (Y_RESET + DY_RESETTEXT));
+	buttonArray[BTN_RST3].setup(X_RESET3, Y_RESET, W_RESET, H_RESET, RA8875_RED, RA8875_BLACK, RA8875_WHITE, RA8875_RED, SETUPFONTSIZE, "3rd", (X_RESET3 + DX_RESETTEXT), (Y_RESET + DY_RESETTEXT));
+	buttonArray[BTN_DONE].setup(X_DONE, Y_DONE, W_DONE, H_DONE, RA8875_RED, RA8875_BLACK, RA8875_WHITE, RA8875_RED, SETUP_DONEFONTSIZE, "Done!", (X_DONE + DX_DONETEXT), (Y_DONE + DY_DONETEXT));
+	buttonArray[BTN_DISPLAY].setup(X_DISPLAY, Y_DISPLAY, W_DISPLAY, H_DISPLAY, RA8875_WHITE, RA8875_BLACK, RA8875_BLACK, RA8875_WHITE, SETUPFONTSIZE, displayLabel(), (X_DISPLAY + DX_TOGGLETEXT), (Y_DISPLAY + DY_TOGGLETEXT));
+	buttonArray[BTN_ROTATE].setup(X_ROTATE, Y_ROTATE, W_ROTATE, H_ROTATE, RA8875_WHITE, RA8875_BLACK, RA8875_BLACK, RA8875_WHITE, SETUPFONTSIZE, "Rotate", (X_ROTATE + DX_ROTATETEXT), (Y_ROTATE + DY_ROTATETEXT));
+#if FACE_ALARM
+	// The seconds can't be set, so their digits switch the time row over to an alarm (upper half) and turn it on & off
+	buttonArray[BTN_ALARMVIEW].setup(X_TIMESECONDHIGH, Y_TIME_UPPER, (W_LARGEDIGIT * 2), (H_LARGEDIGIT / 2), NULL_COLOR, NULL_COLOR, NULL_COLOR, NULL, SETUPFONTSIZE, NULL, NULL, NULL);
+	buttonArray[BTN_ALARMONOFF].setup(X_TIMESECONDHIGH, Y_TIME_MID, (W_LARGEDIGIT * 2), (H_LARGEDIGIT / 2), NULL_COLOR, NULL_COLOR, NULL_COLOR, NULL, SETUPFONTSIZE, NULL, NULL, NULL);
+#endif
+}
+
+// Draw the setup buttons and their labels
+void ClockDisplay::drawSetupButtons(ClockScreen* disp)
+{
+	Button *buttonArray = setupState->buttons;
+	int i;
+
+	disp->setFont(INT);
+	if (setupState->keyRow)		// Just the keys. The field touch areas aren't drawn anyway
+	{
+		for (i = 0; i < KEYPAD_KEYS; ++i)
+			buttonArray[i].draw(disp, fgColor, bgColor);
+		return;
+	}
+	if (setupState->pickFor)	// The picker's keys, then the sliders & preview
+	{
+		for (i = 0; i < PICKER_KEYS; ++i)
+			buttonArray[i].draw(disp, fgColor, bgColor);
+		drawPicker(disp);
+		return;
+	}
+	for (i = 0; i < MAXBUTTONS; ++i)
+		buttonArray[i].draw(disp, fgColor, bgColor);
+	disp->setTextColor(RA8875_WHITE, RA8875_BLACK);
+	disp->setFontScale(SETUPFONTSIZE);
+	disp->setCursor(X_FOREBACKBASE_LABEL, Y_FORELABEL); disp->print(F(" Foreground:"));
+	disp->setCursor(X_FOREBACKBASE_LABEL, Y_BACKLABEL); disp->print(F(" Background:"));
+	disp->setCursor(X_FOREBACKBASE_LABEL, Y_BASELABEL); disp->print(F(" Number Base:"));
+	disp->setCursor(X_DISPLAYLABEL, Y_DISPLAYLABEL); disp->print(F(" Display:"));
+	disp->setCursor(X_RESETLABEL, Y_RESETLABEL); disp->print(F(" Reset:"));
+}
+
+// Act on a single setup screen button press
+void ClockDisplay::handleSetupButton(ClockScreen* disp, int touchArea)
+{
+	uint16_t color;
+
+	// The color swatches bring up the picker, starting from the swatch's color
+	if ((touchArea >= BTN_FGBLACK) && (touchArea <= BTN_BGWHITE))
+	{
+		color = setupState->buttons[touchArea].getFill();
+#if FACE_TIMECOLOR
+		// Tapping the background color that's already chosen switches the clock face to the color of the time, and
+		// tapping it again switches back. Setting a background in the picker switches back too
+		if ((touchArea >= BTN_BGBLACK) && (color == bgColor))
+		{
+			colorMode = (colorMode == COLOR_MODE_FIXED) ? COLOR_MODE_TIME : COLOR_MODE_FIXED;
+			setupState->systemResetCounter = 0;
+			settingsDirty = true;
+			return;
+		}
+#endif
+		openPicker((touchArea >= BTN_BGBLACK) ? PICK_FOR_BG : PICK_FOR_FG, color);
+		return;
+	}
+
+	switch (touchArea)
+	{
+	case BTN_HOUR:			// Type the time (or the alarm) in, from the hours
+		openKeypad(KEY_ROW_TIME, 0);
+		return;
+	case BTN_MINUTE:		// ...from the minutes
+		openKeypad(KEY_ROW_TIME, 2);
+		return;
+	case BTN_MONTH:			// Type the date in, from the month
+		openKeypad(KEY_ROW_DATE, 0);
+		return;
+	case BTN_DAY:			// ...from the day
+		openKeypad(KEY_ROW_DATE, 2);
+		return;
+	case BTN_YEAR:			// ...from the year
+		openKeypad(KEY_ROW_DATE, 4);
+		return;
+	case BTN_BASE:			// Toggle between hex & decimal display
+		numberBase = (numberBase == BASE_HEX) ? BASE_DEC : BASE_HEX;
+		setupState->buttons[BTN_BASE].setLabel((numberBase == BASE_HEX) ? "HEX" : "DEC");
+		setupPending |= SETUP_PENDING_BUTTONS;
+		break;
+	case BTN_RST1:			// Reset clock - 1st step
+		/* 
+		Resetting the clock resets the time, color, and display components back to default state, then reboots the Arduino.
+		It does NOT reset the display calibration coordinates. To reset the calibration you must run the TftCalibration Sketch again.
+		To reset the clock, the "1st", "2nd", and "3rd" buttons must be pressed in that order.
+		This was done to prevent accidental reset due to the flaky nature of the touch screen accuracy.
+		*/
+		setupState->systemResetCounter = 1;
+		break;	
+	case BTN_RST2:			// Reset clock - second step
+		if (setupState->systemResetCounter == 1)
+			setupState->systemResetCounter = 2;
+		else 
+			setupState->systemResetCounter = 0;	// Start counting over again.
+		break;
+	case BTN_RST3:			// Reset clock - 3rd step
+		if (setupState->systemResetCounter == 2)	// First two steps have already been completed
+		{
+			disp->fillWindow(RA8875_BLACK);	// Give immediate feedback to user
+			Settings.erase();			// Throw away saved settings. Force new settings on reboot.
+			rtc->resetClock();		// Set time/date back to initial time
+			softwareReset();
+		}
+		else
+			setupState->systemResetCounter = 0;
+		break;
+	case BTN_DISPLAY:		// Step through 24H, 12H & hex day time
+		if (timeMode == TIME_MODE_HEXDAY)
+		{
+			setTimeMode(TIME_MODE_CLOCK);
+			displayBase = DISPLAY_24H;
+		}
+		else if (FACE_12H && (displayBase == DISPLAY_24H))
+			displayBase = DISPLAY_12H;
+		else if (FACE_HEXTIME)
+			setTimeMode(TIME_MODE_HEXDAY);
+		else
+			displayBase = DISPLAY_24H;
+		setupState->buttons[BTN_DISPLAY].setLabel(displayLabel());
+		setupPending |= SETUP_PENDING_BUTTONS;
+		setupState->systemResetCounter = 0;
+		break;
+	case BTN_ROTATE:		// Rotate display 180 degrees
+		setRotation((rotation == ROTATION_0) ? ROTATION_180 : ROTATION_0);		// screen Flip rotation 
+		disp->setRotation(rotation);	// Reset screen rotation
+		setupPending |= (SETUP_PENDING_FACE | SETUP_PENDING_BUTTONS);	// Old screen contents are upside-down now
+		setupState->systemResetCounter = 0;
+		break;
+	case BTN_DONE:
+		setupPending |= SETUP_PENDING_EXIT;
+		break;
+#if FACE_ALARM
+	case BTN_ALARMVIEW:		// Time row shows the clock or the alarm
+		setupState->alarmView = !setupState->alarmView;
+		setupState->systemResetCounter = 0;
+		break;
+	case BTN_ALARMONOFF:	// Turn the alarm on or off
+		if (setupState->alarmView)
+		{
+			setupState->alarm.days ^= ALARM_ON;
+			setupState->alarmDirty = true;
+		}
+		setupState->systemResetCounter = 0;
+		break;
+#endif
+	}
+
+	// New settings get written out later by saveSettings()
+	settingsDirty = true;
+}
+
+// Bring the keypad up for a row, with the cursor on the field that was tapped. The row starts off as it is now
+void ClockDisplay::openKeypad(uint8_t row, uint8_t pos)
+{
+	static char digitLabels[] = "0\0" "1\0" "2\0" "3\0" "4\0" "5\0" "6\0" "7\0" "8\0" "9";
+	static char otherLabels[] = "Del\0" "Esc\0" "Set";
+	Button *buttonArray = setupState->buttons;
+	struct ts *tm = rtc->getTime();
+	uint8_t units[3], i;
+	uint16_t fill;
+	int16_t x, y;
+	char *label;
+
+	if (row == KEY_ROW_TIME)
+	{
+		units[0] = tm->hour;
+		units[1] = tm->min;
+#if FACE_ALARM
+		if (setupState->alarmView)
+		{
+			units[0] = setupState->alarm.hour;
+			units[1] = setupState->alarm.min;
+		}
+#endif
+	}
+	else
+	{
+		units[0] = tm->mon;
+		units[1] = tm->mday;
+	}
+	units[2] = tm->year % 100;		// Unused on the time row
+	for (i = 0; i < KEY_DATE_DIGITS; ++i)
+		setupState->keyDigits[i] = (i & 1) ? units[i / 2] % 10 : units[i / 2] / 10;
+	setupState->keyRow = row;
+	setupState->keyPos = pos;
+	setupState->systemResetCounter = 0;
+
+	// The keys go in the first button slots, over the field touch areas and the controls
+	for (i = 0; i < KEYPAD_KEYS; ++i)
+	{
+		x = layoutKeyX(i);
+		y = layoutKeyY(i);
+		label = (i < KEY_DEL) ? digitLabels + i * 2 : otherLabels + (i - KEY_DEL) * 4;
+		fill = (i < KEY_DEL) ? RA8875_WHITE : (i == KEY_DEL) ? RA8875_YELLOW : (i == KEY_CANCEL) ? RA8875_RED : RA8875_GREEN;
+		buttonArray[i].setup(x, y, W_KEY, H_KEY, fill, RA8875_BLACK, (i == KEY_CANCEL) ? RA8875_WHITE : RA8875_BLACK, fill,
+			KEYFONTSIZE, label, x + (W_KEY - strlen(label) * W_KEYCHAR) / 2, y + (H_KEY - H_KEYCHAR) / 2);
+	}
+	setupPending |= (SETUP_PENDING_CONTROLS | SETUP_PENDING_BUTTONS);
+}
+
+// Put the keypad away and the setup buttons back
+void ClockDisplay::closeKeypad()
+{
+	setupState->keyRow = KEY_ROW_NONE;
+	placeSetupButtons();
+	setupPending |= (SETUP_PENDING_CONTROLS | SETUP_PENDING_BUTTONS);
+}
+
+// Bring the color picker up for the foreground or background, with the sliders on a starting color
+void ClockDisplay::openPicker(uint8_t which, uint16_t color)
+{
+	static char pickLabels[] = "Esc\0" "Set";
+	Button *buttonArray = setupState->buttons;
+	uint8_t s;
+
+	setupState->pickFor = which;
+	setupState->pickDrag = 0;
+	setupState->pickColor = color;
+	colorHsv(color, setupState->hsv);
+	setupState->systemResetCounter = 0;
+
+	// The sliders are touch areas over their ramps & knob strips, which run half a knob past the ends. drawPicker() draws them
+	for (s = PICK_HUE; s <= PICK_VAL; ++s)
+		buttonArray[s].setup(X_SLIDER - W_KNOB / 2, Y_SLIDER + s * SLIDER_PITCH, W_SLIDER + W_KNOB, H_SLIDER + H_KNOB, NULL_COLOR, NULL_COLOR, NULL_COLOR, NULL, SLIDERFONTSIZE, NULL, NULL, NULL);
+	buttonArray[PICK_CANCEL].setup(X_PICKESC, Y_PICKKEY, W_PICKKEY, H_PICKKEY, RA8875_RED, RA8875_BLACK, RA8875_WHITE, RA8875_RED,
+		KEYFONTSIZE, pickLabels, X_PICKESC + (W_PICKKEY - 3 * W_KEYCHAR) / 2, Y_PICKKEY + (H_PICKKEY - H_KEYCHAR) / 2);
+	buttonArray[PICK_SET].setup(X_PICKSET, Y_PICKKEY, W_PICKKEY, H_PICKKEY, RA8875_GREEN, RA8875_BLACK, RA8875_BLACK, RA8875_GREEN,
+		KEYFONTSIZE, pickLabels + 4, X_PICKSET + (W_PICKKEY - 3 * W_KEYCHAR) / 2, Y_PICKKEY + (H_PICKKEY - H_KEYCHAR) / 2);
+	setupPending |= (SETUP_PENDING_CONTROLS | SETUP_PENDING_BUTTONS);
+}
+
+/*
+Put the picker away and the setup buttons back. With set, the picked color goes on the face, which is redrawn the once
+in it: the full redraw clears the controls area as well, so that isn't cleared first.
+*/
+void ClockDisplay::closePicker(bool set)
+{
+	if (set)
+	{
+		if (setupState->pickFor == PICK_FOR_FG)
+			setFgColor(setupState->pickColor);
+		else
+		{
+			setBgColor(setupState->pickColor);
+#if FACE_TIMECOLOR
+			colorMode = COLOR_MODE_FIXED;
+#endif
+		}
+		settingsDirty = true;		// Written out later by saveSettings()
+		setupPending |= SETUP_PENDING_FACE;
+	}
+	else
+		setupPending |= SETUP_PENDING_CONTROLS;
+	setupState->pickFor = PICK_FOR_NONE;
+	setupState->pickDrag = 0;
+	placeSetupButtons();
+	setupPending |= SETUP_PENDING_BUTTONS;
+}
+
+// Act on a touch-down in the picker. A slider jumps to the finger and follows it from there until it comes off
+void ClockDisplay::handlePick(ClockScreen* disp, int area, int16_t x)
+{
+	if (area <= PICK_VAL)
+	{
+		setupState->pickDrag = area + 1;
+		movePicker(disp, area, x);
+	}
+	else
+		closePicker(area == PICK_SET);
+}
+
+/*
+Move a slider to the finger. Only its knob and the preview are repainted, and only if the value's changed, so a drag
+costs a few fills a sample however big the panel is. The ramps on the other sliders are left until it's let go.
+*/
+void ClockDisplay::movePicker(ClockScreen* disp, uint8_t slider, int16_t x)
+{
+	int16_t v = ((int32_t)(x - X_SLIDER) * 256) / W_SLIDER;
+	uint8_t *hsv = setupState->hsv;
+
+	if (v < 0)
+		v = 0;
+	else if (v > 255)
+		v = 255;
+	if (v == hsv[slider])
+		return;
+	hsv[slider] = v;
+	setupState->pickColor = hsvColor(hsv[PICK_HUE], hsv[PICK_SAT], hsv[PICK_VAL]);
+	drawKnob(disp, slider);
+	drawPreview(disp);
+}
+
+// Draw the picker: each slider's ramp, knob & letter, and the preview. The hue ramp is at full saturation & value
+void ClockDisplay::drawPicker(ClockScreen* disp)
+{
+	uint8_t s, i, hsv[3];
+	int16_t y;
+
+	for (s = PICK_HUE; s <= PICK_VAL; ++s)
+	{
+		y = Y_SLIDER + s * SLIDER_PITCH;
+		memcpy(hsv, setupState->hsv, sizeof(hsv));
+		if (s == PICK_HUE)
+			hsv[PICK_SAT] = hsv[PICK_VAL] = 255;
+		for (i = 0; i < PICK_RAMP_STEPS; ++i)
+		{
+			hsv[s] = i * (256 / PICK_RAMP_STEPS) + (128 / PICK_RAMP_STEPS);
+			disp->fillRect(X_SLIDER + i * (W_SLIDER / PICK_RAMP_STEPS), y, W_SLIDER / PICK_RAMP_STEPS, H_SLIDER,
+				hsvColor(hsv[PICK_HUE], hsv[PICK_SAT], hsv[PICK_VAL]));
+		}
+		drawKnob(disp, s);
+		disp->setTextColor(RA8875_WHITE, RA8875_BLACK);
+		disp->setFontScale(SLIDERFONTSIZE);
+		disp->setCursor(X_SLIDERLABEL, y + DY_SLIDERTEXT);
+		disp->print("HSV"[s]);
+	}
+	disp->drawRect(X_PREVIEW - 1, Y_PREVIEW - 1, W_PREVIEW + 2, H_PREVIEW + 2, RA8875_WHITE);
+	drawPreview(disp);
+}
+
+// A slider's knob, on the strip under it
+void ClockDisplay::drawKnob(ClockScreen* disp, uint8_t slider)
+{
+	int16_t y = Y_SLIDER + slider * SLIDER_PITCH + H_SLIDER;
+
+	disp->fillRect(X_SLIDER - W_KNOB / 2, y, W_SLIDER + W_KNOB, H_KNOB, RA8875_BLACK);
+	disp->fillRect(X_SLIDER + ((int32_t)setupState->hsv[slider] * W_SLIDER) / 256 - W_KNOB / 2, y, W_KNOB, H_KNOB, RA8875_WHITE);
+}
+
+// The picked color in place: a patch of the background with a digit on it in the foreground
+void ClockDisplay::drawPreview(ClockScreen* disp)
+{
+	uint16_t fg = (setupState->pickFor == PICK_FOR_FG) ? setupState->pickColor : fgColor;
+	uint16_t bg = (setupState->pickFor == PICK_FOR_BG) ? setupState->pickColor : bgColor;
+
+	disp->fillRect(X_PREVIEW, Y_PREVIEW, W_PREVIEW, H_PREVIEW, bg);
+	disp->setFont(INT);			// The face's digits leave their font set
+	disp->setTextColor(fg, bg);
+	disp->setFontScale(PREVIEWFONTSIZE);
+	disp->setCursor(X_PREVIEW + DX_PREVIEWTEXT, Y_PREVIEW + DY_PREVIEWTEXT);
+	disp->print('8');
+}
+
+/*
+Act on a key
+Digits go in at the cursor, which moves on; once the row's full more digits are ignored. Del moves the cursor back a
+digit. None of that touches the RTC: the digits on screen are only what's been typed (see keypadDigits()).
+*/
+void ClockDisplay::handleKey(int key)
+{
+	if (key < KEY_DEL)
+	{
+		if (setupState->keyPos < keyLength())
+			setupState->keyDigits[setupState->keyPos++] = key;
+	}
+	else if (key == KEY_DEL)
+	{
+		if (setupState->keyPos)
+			--setupState->keyPos;
+	}
+	else if ((key == KEY_CANCEL) || keypadSet())
+		closeKeypad();
+}
+
+/*
+Check the row that's been typed in and set it
+Hours 0-23 and minutes 0-59, or a month and a day that's in it, leap years included. Anything out of range puts the
+cursor back on that field and nothing is written. Otherwise it's a single RTC write (or the alarm being set changes).
+Returns true if it went in
+*/
+bool ClockDisplay::keypadSet()
+{
+	uint8_t *d = setupState->keyDigits;
+	uint8_t first = d[0] * 10 + d[1], second = d[2] * 10 + d[3];
+	uint16_t year = 2000 + d[4] * 10 + d[5];
+	struct ts tm = *rtc->getTime();
+
+	if (setupState->keyRow == KEY_ROW_TIME)
+	{
+		if (first > 23)
+		{
+			setupState->keyPos = 0;
+			return false;
+		}
+		if (second > 59)
+		{
+			setupState->keyPos = 2;
+			return false;
+		}
+#if FACE_ALARM
+		if (setupState->alarmView)
+		{
+			setupState->alarm.hour = first;
+			setupState->alarm.min = second;
+			setupState->alarmDirty = true;
+			return true;
+		}
+#endif
+		tm.hour = first;
+		tm.min = second;
+		tm.sec = 0;
+	}
+	else
+	{
+		if ((first < 1) || (first > 12))
+		{
+			setupState->keyPos = 0;
+			return false;
+		}
+		if ((second < 1) || (second > ClockRtc::daysInMonth(first, year)))
+		{
+			setupState->keyPos = 2;
+			return false;
+		}
+		tm.mon = first;
+		tm.mday = second;
+		tm.year = year;
+	}
+	ClockRtc::fromSeconds(ClockRtc::toSeconds(&tm), &tm);	// Gets the day of the week right too
+	rtc->setTime(&tm);
+	return true;
+}
+
+// The row being typed in, in place of the clock's digits. The cursor is a blank digit
+void ClockDisplay::keypadDigits(char *chars, uint8_t *values)
+{
+	uint8_t first = (setupState->keyRow == KEY_ROW_TIME) ? HRHIGH : TIME_DIGITS / 2;
+	uint8_t i;
+
+	for (i = 0; i < keyLength(); ++i)
+	{
+		values[first + i] = setupState->keyDigits[i];
+		chars[first + i] = (i == setupState->keyPos) ? ' ' : '0' + setupState->keyDigits[i];
+	}
+}
+
+// Label for the DISPLAY button
+const char *ClockDisplay::displayLabel()
+{
+	if (timeMode == TIME_MODE_HEXDAY)
+		return "16H";
+	return (displayBase == DISPLAY_24H) ? "24H" : "12H";
+}
+
+#endif // FACE_SETUP
+
+/*
+Hand changed settings to the settings store
+Called periodically from the main loop rather than after every button press. The store decides when to actually write.
+*/
+void ClockDisplay::saveSettings()
+{
+	clockSettings_t cfg;
+
+	if (!settingsDirty)
+		return;
+
+	getSettings(&cfg);
+	Settings.update(&cfg);
+	settingsDirty = false;
+}
+
+// Copy the clock's current settings into a settings block
+void ClockDisplay::getSettings(clockSettings_t *cfg)
+{
+	memset(cfg, 0, sizeof(*cfg));
+	cfg->fgColor = fgColor;
+	cfg->bgColor = bgColor;
+	cfg->numberBase = numberBase;
+	cfg->displayBase = displayBase;
+	cfg->rotation = rotation;
+	cfg->timeMode = timeMode;
+	cfg->colorMode = colorMode;
+#if FACE_SUN
+	cfg->latitude = Sun.getLatitude();
+	cfg->longitude = Sun.getLongitude();
+	cfg->utcOffset = Sun.getUtcOffset();
+#endif
+	cfg->sunPanel = sunPanel;
+#if FACE_POWER
+	cfg->dimFrom = Power.getDimFrom();
+	cfg->dimTo = Power.getDimTo();
+	cfg->offFrom = Power.getOffFrom();
+	cfg->offTo = Power.getOffTo();
+	cfg->dimLevel = Power.getDimLevel();
+#endif
+}
+
+// Set the clock up from a settings block
+void ClockDisplay::applySettings(clockSettings_t *cfg)
+{
+	setFgColor(cfg->fgColor);
+	setBgColor(cfg->bgColor);
+	setBase(cfg->numberBase);
+	setDisplayBase(cfg->displayBase);
+	setRotation(cfg->rotation);
+	setTimeMode(cfg->timeMode);
+	setColorMode(cfg->colorMode);
+#if FACE_SUN
+	Sun.setPlace(cfg->latitude, cfg->longitude, cfg->utcOffset);
+#endif
+	setSunPanel(cfg->sunPanel);
+#if FACE_POWER
+	Power.setSchedule(cfg->dimFrom, cfg->dimTo, cfg->offFrom, cfg->offTo, cfg->dimLevel);
+#endif
+	stagedValid = false;	// Staged digits were worked out for the old base
+}
+
+/*
+Settings changed from outside the setup screen (Serial). They get saved the same as changes from the setup buttons.
+The face still needs a redrawFace() to show them.
+*/
+void ClockDisplay::changeSettings(clockSettings_t *cfg)
+{
+	applySettings(cfg);
+	settingsDirty = true;
+}
+
+#if FACE_SETUP
+// Leave setup mode and put the full clock face back up
+void ClockDisplay::endSetup(ClockScreen* disp)
+{
+	configMode = false;
+	setupPending = 0;
+	stagedValid = false;
+#if FACE_ALARM
+	// The alarm set here goes into the table, and the next one due is worked out again for the time as it is now
+	if (setupState->alarmDirty)
+		Alarms.replace(setupState->alarmHour, setupState->alarmMin, &setupState->alarm);
+	Alarms.schedule(rtc->getTime());
+#endif
+	RamMon.setMode(RAM_MODE_MAIN);
+	Arena.release(ARENA_SETUP);
+	setupState = NULL;
+
+	redrawFace(disp);
+}
+#endif
+
+// Redraw the whole clock face from scratch
+void ClockDisplay::redrawFace(ClockScreen* disp)
+{
+	// Force redraw of everything. The colons & slashes especially, because the system doesn't think they've been updated
+	// and won't draw them otherwise.
+	triggerAll();
+
+	if (inWatch())
+		refreshWatch(REFRESH_ALL);
+	else
+		refreshTime(disp, REFRESH_ALL);
+	refreshClock(disp, REFRESH_ALL, DRAW_HEXBIN);
+}
+
+void ClockDisplay::softwareReset() // Restarts program from beginning but does not reset the peripherals and registers
+{
+	asm volatile ("  jmp 0");
+}
+
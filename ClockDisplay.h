@@ -1,203 +1,298 @@
-// ClockDisplay.h
-// Manages the display of the TFT clock face
-
-#ifndef _CLOCKDISPLAY_h
-#define _CLOCKDISPLAY_h
-
-#if defined(ARDUINO) && ARDUINO >= 100
-	#include "arduino.h"
-#else
-	#include "WProgram.h"
-#endif
-
-#include "ClockDigit.h"
-
-// Touch screen cal structs
-typedef struct Point
-{
-	int32_t x;
-	int32_t y;
-} tsPoint_t;
-
-typedef struct //Matrix
-{
-	int32_t An,
-		Bn,
-		Cn,
-		Dn,
-		En,
-		Fn,
-		Divider;
-} tsMatrix_t;
-
-// Definitions for connecting the RA8875 Board
-// Library only supports hardware SPI at this time
-// Connect SCLK to UNO Digital #13 (Hardware SPI clock)
-// Connect MISO to UNO Digital #12 (Hardware SPI MISO)
-// Connect MOSI to UNO Digital #11 (Hardware SPI MOSI)
-#define RA8875_INT 2
-#define RA8875_CS 10
-#define RA8875_RESET 9
-
-// Definitions for digit width & height
-#define W_LARGEDIGIT	96
-#define H_LARGEDIGIT	105
-#define W_COLON			21
-#define H_COLON			75
-#define W_SLASH			50
-#define H_SLASH			102
-
-// Large time row definitions
-#define X_TIMEHOURHIGH		55												// High-order hour digit
-#define X_TIMEHOURLOW		(X_TIMEHOURHIGH + W_LARGEDIGIT)					// Low-order hour digit
-#define X_TIMEMINUTEHIGH	(X_TIMEHOURLOW + W_LARGEDIGIT + W_COLON + 30)	// High-order minute digit
-#define X_TIMEMINUTELOW		(X_TIMEMINUTEHIGH + W_LARGEDIGIT)				// Low-order minute digit
-#define X_TIMESECONDHIGH	(X_TIMEMINUTELOW +W_LARGEDIGIT + W_COLON + 30)	// High-order second digit
-#define X_TIMESECONDLOW		(X_TIMESECONDHIGH + W_LARGEDIGIT)				// Low-order second digit
-#define X_COLON1			(X_TIMEHOURLOW + W_LARGEDIGIT + 5)					// Hour:minute colon
-#define X_COLON2			(X_TIMEMINUTELOW + W_LARGEDIGIT + 5)				// Minute:second colon
-#define Y_TIME_UPPER		(Y_TIME_LOWER - H_LARGEDIGIT)					// Upper Y of time row
-#define Y_TIME_MID			(Y_TIME_LOWER - (H_LARGEDIGIT / 2))				// Midpoint Y of time row
-#define Y_TIME_LOWER		125												// Lower Y of time row
-
-// Large date row definitions
-#define X_DATEMONTHHIGH		25												// High-order month digit
-#define X_DATEMONTHLOW		(X_DATEMONTHHIGH + W_LARGEDIGIT)				// Low-order monthdigit
-#define X_DATEDAYHIGH		(X_DATEMONTHLOW + W_LARGEDIGIT + W_SLASH + 35)	// High-order day digit
-#define X_DATEDAYLOW		(X_DATEDAYHIGH + W_LARGEDIGIT)					// Low-order day digit
-#define X_DATEYEARHIGH		(X_DATEDAYLOW + W_LARGEDIGIT + W_SLASH + 35)	// High-order year digit
-#define X_DATEYEARLOW		(X_DATEYEARHIGH + W_LARGEDIGIT)					// Low-order year digit
-#define X_SLASH1			(X_DATEMONTHLOW + W_LARGEDIGIT + 5)					// Month/day slash
-#define X_SLASH2			(X_DATEDAYLOW + W_LARGEDIGIT + 5)					// Day/year slash
-#define Y_DATE_LOWER		260												// Lower Y of time row
-#define Y_DATE_UPPER		(Y_DATE_LOWER - H_LARGEDIGIT)					// Upper Y of time row
-#define Y_DATE_MID			(Y_DATE_LOWER - (H_LARGEDIGIT / 2))				// Midpoint Y of time row
-
-// Binary row definitions
-#define X_BINTIME			131		// Starting Column for Binary Time
-#define X_BINDATE			478		// Starting Columns for Binary Date
-#define Y_BIN_1				280		// First row of binary displays
-#define Y_BIN_2				342		// Second row of binary displays
-#define Y_BIN_3				404		// Third row of binary displays
-#define X_BIN_OFFSET_HIGH	0
-#define X_BIN_OFFSET_LOW	128
-#define X_BIN_TIMELABEL		68		// Starting Column for Binary Time Label
-#define X_BIN_DATELABEL		415		// Starting Column for Binary Date Label
-
-// Defines if running initial calibration or if calibration has already been done
-#define CALIBRATE_NEW 0
-#define CALIBRATE_EXISTING 1
-
-// Define digit drawing modes
-#define DRAW_HEXBIN	0
-#define DRAW_HEXONLY 1
-
-// Number base definitions
-#define BASE_DEC 10
-#define BASE_HEX 16
-
-// X, Y, W, H locations for  various buttons
-#define X_COLOR1	175
-#define X_COLOR2	250
-#define X_COLOR3	325
-#define X_COLOR4	400
-#define X_COLOR5	475
-#define X_COLOR6	550
-#define X_COLOR7	625	
-#define X_COLOR8	700
-#define Y_COLOR_FG	290
-#define Y_COLOR_BG	355
-#define W_COLOR		50
-#define H_COLOR		30
-#define X_BASE		170
-#define Y_BASE		420
-#define W_BASE		50
-#define H_BASE		30
-#define X_RESET1	505
-#define X_RESET2	555
-#define X_RESET3	605
-#define Y_RESET		420
-#define W_RESET		40
-#define H_RESET		30
-#define X_DONE		660
-#define Y_DONE		405
-#define W_DONE		90
-#define H_DONE		50
-#define X_DISPLAY	310
-#define Y_DISPLAY	420
-#define W_DISPLAY	50
-#define H_DISPLAY	30
-#define X_ROTATE	372
-#define Y_ROTATE	420
-#define W_ROTATE	55
-#define H_ROTATE	30
-
-
-// X,Y coordinates for configuration button labels
-#define X_FOREBACKBASE_LABEL	60
-#define Y_FORELABEL				295
-#define Y_BACKLABEL				360
-#define Y_BASELABEL				425	
-#define X_RESETLABEL			440
-#define Y_RESETLABEL			425
-#define X_DISPLAYLABEL			230
-#define Y_DISPLAYLABEL			425
-
-// X/Y Coordinates for AM/PM indicators
-#define X_AMPM		(X_TIMEHOURHIGH - 20)
-#define Y_AM		(Y_TIME_UPPER + ((Y_TIME_MID - Y_TIME_UPPER)/2))
-#define Y_PM		(Y_TIME_MID + ((Y_TIME_LOWER - Y_TIME_MID)/2))
-#define AMPM_DOTSIZE	7
-
-// Definitions for display modes
-#define DISPLAY_24H		true
-#define DISPLAY_12H		false
-#define AMPM_MORNING	true
-#define AMPM_AFTERNOON	false
-
-// Definitions for screen rotation
-#define ROTATION_0		0
-#define ROTATION_90		1
-#define ROTATION_180	2
-#define ROTATION_270	3
-
-class ClockDisplay
-{
-public:
-	ClockDisplay();
-	~ClockDisplay();
-
-	void refreshTime(RA8875*, int mode = REFRESH_MIN);
-	void refreshClock(RA8875*, int rmode = REFRESH_MIN, int dmode = DRAW_HEXBIN);
-	void testPattern(RA8875*);
-	void tsCalibrate(RA8875* disp);
-	int checkForTouchEvent(RA8875* disp, tsPoint_t * point, bool waitMode = true);
-	int calibrateTSPoint(tsPoint_t * displayPtr, tsPoint_t * screenPtr);
-	void setFgColor(uint16_t fore) { fgColor = fore; }
-	void setBgColor(uint16_t back) { bgColor = back; }
-	void setBase(uint8_t base) { numberBase = base; }
-	void setRotation(uint8_t rot);
-	int getRotation() { return rotation; }
-	void setDisplayBase(uint8_t base) { displayBase = ((base & 0x11)? true: false); }
-	int setupScreen(RA8875* disp);
-
-private:
-	ClockDigit timeArray[6], dateArray[6], colonChar1, colonChar2, slashChar1, slashChar2;	// The time & date digits on the clock face
-	AmPmDot amDot, pmDot;
-	uint16_t fgColor, bgColor;	// Default foreground & background color for the screen
-
-	// Screen Point references used in screen calibration routines
-	tsMatrix_t      _tsMatrix0, _tsMatrix180, *_tsMatrixPtr;		// Calibration matrices for 0- and 180-degree rotations
-
-	uint8_t numberBase;	// Display time/date as Hex or Decimal
-	bool configMode;	// Are we in configuration mode or normal operation?
-	bool displayBase;	// DISPLAY_24H (true) or DISPLAY_12H (false)
-	bool amPm;			// AMPM_MORNING or AMPM_AFTERNOON
-	uint8_t rotation;
-
-	int identifyArea(tsPoint_t point);
-	void softwareReset(void); // Restarts program from beginning but does not reset the peripherals and registers
-
-};
-
+// ClockDisplay.h
+// Manages the display of the TFT clock face
+
+#ifndef _CLOCKDISPLAY_h
+#define _CLOCKDISPLAY_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include "FaceConfig.h"
+#include "Layout.h"
+#include "ClockDigit.h"
+#include "RTClock.h"
+#include "Settings.h"
+#include "Button.h"
+#include "Alarms.h"
+#include "Sun.h"
+
+// Touch screen cal structs
+typedef struct Point
+{
+	int32_t x;
+	int32_t y;
+} tsPoint_t;
+
+typedef struct //Matrix
+{
+	int32_t An,
+		Bn,
+		Cn,
+		Dn,
+		En,
+		Fn,
+		Divider;
+} tsMatrix_t;
+
+// Definitions for connecting the RA8875 Board
+// Library only supports hardware SPI at this time
+// Connect SCLK to UNO Digital #13 (Hardware SPI clock)
+// Connect MISO to UNO Digital #12 (Hardware SPI MISO)
+// Connect MOSI to UNO Digital #11 (Hardware SPI MOSI)
+#define RA8875_INT 2
+#define RA8875_CS 10
+#define RA8875_RESET 9
+
+// Touch sample conditioning
+// Every touch is sampled as a fixed-size burst of ADC reads, so the time spent per touch is always the same
+#define TOUCH_SETTLE_READS	1		// Reads thrown away at the start of a burst (touch-down edge noise)
+#define TOUCH_BURST			5		// Reads kept per burst. Keep this odd so the median is a real sample
+#define TOUCH_READ_SPACING	100		// Microseconds between reads in a burst
+#define TOUCH_MAX_SPREAD	24		// Largest raw ADC spread (after trimming the high & low reads) for a stable touch
+#define TOUCH_ADC_MIN		24		// Raw ADC window. Readings outside it come from a light press or a lifting finger
+#define TOUCH_ADC_MAX		1000
+
+// Return values for checkForTouchEvent()
+#define TOUCH_REJECTED		-1		// Screen is being touched, but the sample failed conditioning
+#define TOUCH_NONE			0		// Screen is not being touched
+#define TOUCH_ACCEPTED		1		// Good touch. Point holds the calibrated location
+
+// Defines if running initial calibration or if calibration has already been done
+#define CALIBRATE_NEW 0
+#define CALIBRATE_EXISTING 1
+
+// Define digit drawing modes
+#define DRAW_HEXBIN	0
+#define DRAW_HEXONLY 1
+
+// Number base definitions
+#define BASE_DEC 10
+#define BASE_HEX 16
+
+// Low RAM warning, in the strip above the time row
+#define X_RAMWARN		4
+#define Y_RAMWARN		2
+
+// Boot test pattern
+#define TESTPATTERN_STEP		500		// Default ms per color
+#define TESTPATTERN_STEPS		7		// Number of colors
+
+// Setup mode
+#define SETUP_IDLE_TIMEOUT		60000	// Return to the clock face after this many ms without a touch
+#define SETUP_PENDING_BUTTONS	0x01	// Setup buttons need to be redrawn
+#define SETUP_PENDING_FACE		0x02	// Upper part of the face needs a full redraw (colors/rotation changed)
+#define SETUP_PENDING_EXIT		0x04	// Leave setup on the next step
+#define SETUP_PENDING_CONTROLS	0x08	// Controls area changed over between the buttons, keypad & picker. Clear it first
+
+/*
+Setup keypad
+A tap on a time or date field brings up the keypad for its row, with the cursor on that field. Digits go in from
+there on, left to right, and Set checks the whole row against the calendar and writes it to the RTC in one go. The
+time row is hours & minutes (the seconds go to zero), or the alarm's when the row shows it. The date row is
+month, day & year.
+*/
+#define KEY_ROW_NONE			0		// Keypad isn't up
+#define KEY_ROW_TIME			1
+#define KEY_ROW_DATE			2
+#define KEY_TIME_DIGITS			4
+#define KEY_DATE_DIGITS			6
+
+/*
+Setup color picker
+A tap on a color swatch brings up the picker for the foreground or background, starting from the swatch's color.
+Hue, saturation & value sliders make any RGB565 color. While a slider's being dragged only its knob and the preview
+(a patch of the background with a digit on it in the foreground) are repainted, and only when the color's changed.
+The ramps on the other sliders catch up when the finger comes off. Set redraws the face once in the new color.
+*/
+#define PICK_FOR_NONE			0		// Picker isn't up
+#define PICK_FOR_FG				1
+#define PICK_FOR_BG				2
+#define PICK_RAMP_STEPS			32		// Bands each slider's ramp is drawn in
+
+#if FACE_SETUP
+// Setup screen state that only exists while it's up. Lives in the scratch arena (ScratchArena.h)
+typedef struct
+{
+	Button buttons[MAXBUTTONS];
+	bool touchDown;					// Finger is still down from the last button press
+	int systemResetCounter;			// Progress through the 1st/2nd/3rd reset buttons
+	unsigned long lastTouch;		// millis() of the last button press, for the idle timeout
+	uint8_t keyRow;					// KEY_ROW_* the keypad is up for
+	uint8_t keyPos;					// Digit the next key press goes in. The cursor shows there
+	uint8_t keyDigits[KEY_DATE_DIGITS];	// The row as it's typed in
+	uint8_t pickFor;				// PICK_FOR_* the picker is up for
+	uint8_t pickDrag;				// Slider being dragged, PICK_HUE-PICK_VAL, plus one. Zero when none is
+	uint8_t hsv[3];					// Slider values, 0-255
+	uint16_t pickColor;				// The color they make
+#if FACE_ALARM
+	alarmEntry_t alarm;				// The alarm the seconds buttons bring up, as it's being set
+	uint8_t alarmHour, alarmMin;	// Its time in the table when setup opened
+	bool alarmView;					// Time row shows the alarm, and the hour & minute buttons set it
+	bool alarmDirty;				// Changed. Goes into the table when setup closes
+#endif
+} setupScratch_t;
+
+static_assert(MAXBUTTONS >= KEYPAD_KEYS, "ClockDisplay.h: the keypad's keys don't fit in the setup buttons");
+static_assert(MAXBUTTONS >= PICKER_KEYS, "ClockDisplay.h: the color picker's keys don't fit in the setup buttons");
+#endif
+
+// Time & date digits, hours through years
+#define TIME_DIGITS		12
+
+// Definitions for display modes
+#define DISPLAY_24H		true
+#define DISPLAY_12H		false
+#define AMPM_MORNING	true
+#define AMPM_AFTERNOON	false
+
+// Definitions for time modes
+#define TIME_MODE_CLOCK		0	// Hours, minutes & seconds
+#define TIME_MODE_HEXDAY	1	// Hex day time off the 32kHz timer (HexTime.h). Setup button shows "16H"
+
+// Definitions for color modes
+#define COLOR_MODE_FIXED	0	// The foreground & background chosen in setup
+#define COLOR_MODE_TIME		1	// Background is the time as a color, #HHMMSS. Foreground black or white to stand out
+
+// Definitions for screen rotation
+#define ROTATION_0		0
+#define ROTATION_90		1
+#define ROTATION_180	2
+#define ROTATION_270	3
+
+class ClockDisplay
+{
+public:
+	ClockDisplay(ClockRtc *clock, ClockStorage *store);
+	~ClockDisplay();
+
+	bool refreshTime(ClockScreen*, int mode = REFRESH_MIN);
+	bool refreshHexTime();
+	void stageNextSecond();
+	bool applyStagedTime();
+	void refreshClock(ClockScreen*, int rmode = REFRESH_MIN, int dmode = DRAW_HEXBIN);
+	void testPattern(ClockScreen*, uint16_t stepTime = TESTPATTERN_STEP, void (*bootWork)(uint8_t) = NULL);
+	void tsCalibrate(ClockScreen* disp);
+	int checkForTouchEvent(ClockScreen* disp, tsPoint_t * point, bool waitMode = true);
+	int calibrateTSPoint(tsPoint_t * displayPtr, tsPoint_t * screenPtr);
+	void setFgColor(uint16_t fore) { fgColor = fore; }
+	void setBgColor(uint16_t back) { bgColor = back; }
+	void setBase(uint8_t base) { numberBase = FACE_DECIMAL ? base : BASE_HEX; }
+	void setRotation(uint8_t rot);
+	int getRotation() { return rotation; }
+	void setDisplayBase(uint8_t base) { displayBase = (!FACE_12H || (base & 0x11)) ? true : false; }
+	void setTimeMode(uint8_t mode);
+	void setColorMode(uint8_t mode) { colorMode = FACE_TIMECOLOR ? mode : COLOR_MODE_FIXED; }
+	void setSunPanel(uint8_t on) { sunPanel = FACE_SUN && on; }
+	void setQuiet(bool on) { quiet = on; stagedValid = false; }
+	bool isQuiet() { return quiet; }
+	bool hexDay() { return FACE_HEXTIME && (timeMode == TIME_MODE_HEXDAY) && !configMode; }	// Setup shows the clock time
+	bool inWatch();
+	bool isRecoloring() { return recolorRest; }
+	bool refreshWatch(int mode = REFRESH_MIN);
+#if FACE_SETUP
+	void startSetup(ClockScreen* disp);
+	bool serviceSetup(ClockScreen* disp);
+#endif
+	bool inSetup() { return FACE_SETUP && configMode; }
+	void saveSettings();
+	void getSettings(clockSettings_t *cfg);
+	void applySettings(clockSettings_t *cfg);
+	void changeSettings(clockSettings_t *cfg);
+	void redrawFace(ClockScreen* disp);
+	unsigned long getTimeRowDrawn() { return timeRowDrawn; }
+	unsigned long getSecondsDrawn() { return secondsDrawn; }
+	void showRamWarning(ClockScreen* disp, uint16_t freeBytes);
+	uint16_t getTouchAccepted() { return touchAccepted; }
+	uint16_t getTouchRejected() { return touchRejected; }
+
+private:
+	ClockRtc *rtc;				// The clock the face shows & sets
+	ClockStorage *storage;		// Where the touch calibration is kept
+	ClockDigit timeArray[6], dateArray[6], colonChar1, colonChar2, slashChar1, slashChar2;	// The time & date digits on the clock face
+	ClockDigit *faceDigit(uint8_t i) { return (i < TIME_DIGITS / 2) ? &timeArray[i] : &dateArray[i - TIME_DIGITS / 2]; }	// 0-11, hours through years
+#if FACE_12H
+	AmPmDot amDot, pmDot;
+#endif
+	uint16_t fgColor, bgColor;	// Default foreground & background color for the screen
+	uint16_t faceFg, faceBg;	// Colors the face is drawn in now. See faceColors()
+	bool recolorRest;			// A recolor has drawn its first half. See refreshClock()
+
+	// Screen Point references used in screen calibration routines
+	tsMatrix_t      _tsMatrix0, _tsMatrix180, *_tsMatrixPtr;		// Calibration matrices for 0- and 180-degree rotations
+
+	uint8_t numberBase;	// Display time/date as Hex or Decimal
+	bool configMode;	// Are we in configuration mode or normal operation?
+	bool displayBase;	// DISPLAY_24H (true) or DISPLAY_12H (false)
+	uint8_t timeMode;	// TIME_MODE_CLOCK or TIME_MODE_HEXDAY
+	uint8_t colorMode;	// COLOR_MODE_FIXED or COLOR_MODE_TIME
+	bool sunPanel;		// Sun panel (Sun.h) in place of the binary date rows
+	bool sunDirty;		// Sun times were worked out again and aren't on the face yet
+	bool quiet;			// Dimmed or off (Power.h): seconds hidden, redrawn on the minute
+	bool amPm;			// AMPM_MORNING or AMPM_AFTERNOON
+	uint8_t rotation;
+	uint16_t touchAccepted, touchRejected;	// Touch conditioning counters
+	unsigned long timeRowDrawn;		// millis() when the last full redraw finished the time digits
+	unsigned long secondsDrawn;		// micros() when the last redraw finished the seconds digits
+	uint8_t alarmMark;				// ALARM_MARK_* on the face now
+
+	// Next second's digits, worked out ahead of the tick. See stageNextSecond()
+	char stagedChar[TIME_DIGITS];
+	uint8_t stagedValue[TIME_DIGITS];
+	uint16_t stagedMask;			// Bit per digit that changes on the tick
+	bool stagedAmPm;
+	bool stagedValid;
+#if FACE_TIMECOLOR
+	uint16_t timeColor;				// Color of the time on the digits. See colorOfTime()
+	uint16_t stagedColor;			// ...and of the staged second
+#endif
+
+	// Setup mode state. See serviceSetup()
+	uint8_t setupPending;			// SETUP_PENDING_* work still to do
+	bool settingsDirty;				// Settings changed since they were last saved
+#if FACE_SETUP
+	setupScratch_t *setupState;		// Buttons & touch state, in the arena while setup is up
+#endif
+
+	void timeToDigits(struct ts *tm, char *chars, uint8_t *values, bool *morning);
+	void hexToDigits(uint32_t sub, char *chars, uint8_t *values);
+	bool hexTicking();
+	bool readTouchSample(ClockScreen* disp, tsPoint_t * raw);
+#if FACE_DIGITS
+	void drawDigit(ClockScreen* disp, ClockDigit* digit, bool cheapest, bool ink);
+#endif
+	bool faceColors(bool all);
+	void triggerAll(bool timeRow = true);
+	void drawAlarmMark(ClockScreen* disp, bool all);
+#if FACE_SUN
+	void drawSunPanel(ClockScreen* disp, bool all);
+	void drawSunTime(ClockScreen* disp, int16_t y, uint16_t minutes);
+#endif
+#if FACE_SETUP
+	int identifyArea(tsPoint_t point);
+	void placeSetupButtons();
+	void drawSetupButtons(ClockScreen* disp);
+	void handleSetupButton(ClockScreen* disp, int touchArea);
+	void openKeypad(uint8_t row, uint8_t pos);
+	void closeKeypad();
+	void handleKey(int key);
+	bool keypadSet();
+	void keypadDigits(char *chars, uint8_t *values);
+	const char *displayLabel();
+	uint8_t keyLength() { return (setupState->keyRow == KEY_ROW_TIME) ? KEY_TIME_DIGITS : KEY_DATE_DIGITS; }
+	void openPicker(uint8_t which, uint16_t color);
+	void closePicker(bool set);
+	void handlePick(ClockScreen* disp, int area, int16_t x);
+	void movePicker(ClockScreen* disp, uint8_t slider, int16_t x);
+	void drawPicker(ClockScreen* disp);
+	void drawKnob(ClockScreen* disp, uint8_t slider);
+	void drawPreview(ClockScreen* disp);
+	void endSetup(ClockScreen* disp);
+#endif
+	void softwareReset(void); // Restarts program from beginning but does not reset the peripherals and registers
+
+};
+
 #endif  // _CLOCKDISPLAY_h
\ No newline at end of file
@@ -0,0 +1,40 @@
+// ClockDrivers.h
+// The display, RTC and storage drivers the clock face is built against
+
+#ifndef _CLOCKDRIVERS_h
+#define _CLOCKDRIVERS_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include <SPI.h>
+#include <RA8875.h>
+#include "RTClock.h"
+#include "EEPROMFunctions.h"
+
+// Saved data, as the face reads it. Static and inline, so it's the same code as calling the EEPROM functions directly
+struct EEPROMStorage
+{
+	static int32_t readSignedLong(int address) { return EEPROMReadSignedLong(address); }
+	static uint32_t readUnsignedLong(int address) { return EEPROMReadUnsignedLong(address); }
+	static void writeLong(int address, uint32_t value) { EEPROMWritelong(address, value); }
+};
+
+/*
+Driver types
+ClockDisplay, ClockDigit and Button only ever name these, never the driver classes themselves. Every call is made on
+the concrete class, so there are no virtual calls and nothing extra in the build, and a driver that's missing
+something the face uses fails to compile rather than at run time. To build the face for a different panel, RTC or
+store, point these at the new driver. The sketch owns one of each and hands them to ClockDisplay: the display with
+every call, the RTC and storage when it's constructed. The face doesn't use the sketch's globals for any of them.
+The simulator (sim/) supplies in-memory drivers under the same library header names (sim/include/RA8875.h, ds3231.h,
+EEPROM.h), so the face builds unchanged against them and these stay as they are.
+*/
+typedef RA8875 ClockScreen;			// Display & touch panel
+typedef RTClockClass ClockRtc;		// Real-time clock
+typedef EEPROMStorage ClockStorage;	// Calibration & other saved data
+
+#endif // _CLOCKDRIVERS_h
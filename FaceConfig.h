@@ -0,0 +1,71 @@
+// FaceConfig.h
+// Which parts of the clock face go into the build
+
+#ifndef _FACECONFIG_h
+#define _FACECONFIG_h
+
+/*
+Face variants
+The full face fills the flash. A clock that doesn't need all of it can leave parts out: whatever the chosen variant
+doesn't use is never called, so the linker drops the code and tables behind it (the big digit font, the setup
+screen's buttons and so on). Pick a variant here, or on the build with -DFACE_VARIANT=n. Each FACE_ part can also
+be set on its own with -D, which overrides the variant. sim/tools/facesize.py builds each variant and reports its
+flash & RAM use.
+*/
+#define FACE_FULL			0		// Everything
+#define FACE_HEXONLY		1		// Big hex digits only: no decimal, no binary rows
+#define FACE_BINONLY		2		// Binary rows only, set up over Serial
+#define FACE_SERIALSETUP	3		// Full face, but no setup screen. Set up over Serial (sim/tools/hexlink.py)
+
+#ifndef FACE_VARIANT
+#define FACE_VARIANT		FACE_FULL
+#endif
+
+#ifndef FACE_DIGITS
+#define FACE_DIGITS			(FACE_VARIANT != FACE_BINONLY)		// Big time & date digits on the upper half
+#endif
+#ifndef FACE_DECIMAL
+#define FACE_DECIMAL		(FACE_VARIANT != FACE_HEXONLY)		// Decimal digits as an option. 0 = always hex
+#endif
+#ifndef FACE_BINARY
+#define FACE_BINARY			(FACE_VARIANT != FACE_HEXONLY)		// Binary time & date rows on the lower half
+#endif
+#ifndef FACE_12H
+#define FACE_12H			1									// 12-hour time with the AM/PM dots. 0 = always 24-hour
+#endif
+#ifndef FACE_HEXTIME
+#define FACE_HEXTIME		1									// Hex day time (HexTime.h) as an option
+#endif
+#ifndef FACE_WATCH
+#define FACE_WATCH			FACE_DIGITS							// Stopwatch & countdown (Stopwatch.h) on the big digits
+#endif
+#ifndef FACE_TIMECOLOR
+#define FACE_TIMECOLOR		1									// Background in the color of the time (#HHMMSS) as an option
+#endif
+#ifndef FACE_ALARM
+#define FACE_ALARM			1									// Alarms off the DS3231's alarm registers (Alarms.h)
+#endif
+#ifndef FACE_SUN
+#define FACE_SUN			FACE_BINARY							// Sunrise, sunset & day length (Sun.h) in place of the binary date, as an option
+#endif
+#ifndef FACE_POWER
+#define FACE_POWER			1									// Backlight dimming & panel off on a schedule (Power.h)
+#endif
+#ifndef FACE_SETUP
+#define FACE_SETUP			((FACE_VARIANT != FACE_BINONLY) && (FACE_VARIANT != FACE_SERIALSETUP))	// On-screen setup
+#endif
+
+#if !FACE_DIGITS && !FACE_BINARY
+#error "FaceConfig.h: the face needs the digits or the binary rows"
+#endif
+#if FACE_SETUP && !FACE_DIGITS
+#error "FaceConfig.h: the setup screen's time buttons sit on the big digits"
+#endif
+#if FACE_SUN && !FACE_BINARY
+#error "FaceConfig.h: the sun panel takes the binary date rows' place"
+#endif
+#if FACE_WATCH && !FACE_DIGITS
+#error "FaceConfig.h: the stopwatch's hundredths need the big digits"
+#endif
+
+#endif // _FACECONFIG_h
@@ -1,141 +1,1291 @@
-/*
- Name:		HexClockTouch3.ino
- Created:	11/25/2016 6:21:35 PM
- Author:	Stephen Fried
-*/
-
-#include <SPI.h>
-#include <RA8875.h>
-#include "EEPROMFunctions.h"
-#include "ClockDisplay.h"
-#include "RTClock.h"
-
-// Definitions for RTC
-#define CLK 8  // MUST be on PORTB! (Use pin 11 on Mega)
-#define LAT A3
-#define OE  9
-#define A   A0
-#define B   A1
-#define C   A2
-
-RA8875 tft = RA8875(RA8875_CS, RA8875_RESET);  // 800x600 TFT Display 
-RTClockClass RTClock;  // Real-time clock
-ClockDisplay theClock;  // Clockface Object
-
-unsigned long mTime1, mTime2;	// Millisecond time counters. Used to trap long-touch events
-
-void setup() {
-	struct ts t;
-
-	Serial.begin(9600);
-
-	//Serial.println("Begin setup()");
-		
-	/* Initialize the TFT display */
-	tft.begin(Adafruit_800x480);
-	tft.useINT(RA8875_INT);
-	tft.touchBegin();
-	tft.enableISR(true);
-
-	// Initialize the RTC
-	Wire.begin();
-	DS3231_init(DS3231_INTCN);
-
-	// Display boot-up test pattern
-	theClock.testPattern(&tft);
-
-	theClock.tsCalibrate(&tft);
-
-	/*
-	Check for EEPROM signature at location EEPROM_SIGNATURE_LOCATION.
-	If you find Hex 30183018 (4 bytes) there, the clock has already been configured.
-	If not, this is the first time the clock has been run since reset, so need to reconfigure screen & options
-	*/
-	uint32_t eepromSignature = EEPROMReadUnsignedLong(EEPROM_SIGNATURE_LOCATION);
-	if (eepromSignature == EEPROM_SIGNATURE_VALUE)
-	{
-		// Read clock configuration settings
-		theClock.setFgColor((uint16_t)EEPROMReadUnsignedLong(EEPROM_CONFIG_LOCATION));
-		theClock.setBgColor((uint16_t)EEPROMReadUnsignedLong(EEPROM_CONFIG_LOCATION + 4));
-		theClock.setBase((uint8_t)EEPROMReadUnsignedLong(EEPROM_CONFIG_LOCATION+8));
-		theClock.setDisplayBase((uint8_t)EEPROMReadUnsignedLong(EEPROM_CONFIG_LOCATION + 12));
-		theClock.setRotation((uint8_t)EEPROMReadUnsignedLong(EEPROM_CONFIG_LOCATION + 16));
-		tft.setRotation(theClock.getRotation());
-	}
-	else
-	{
-		// Set default colors & number base for clock operation
-		theClock.setFgColor(RA8875_WHITE);
-		theClock.setBgColor(RA8875_BLACK);
-		theClock.setBase(BASE_HEX);
-		theClock.setDisplayBase(DISPLAY_24H);
-		theClock.setRotation(ROTATION_180);
-		
-		// Save new configuration signature flag
-		EEPROMWritelong(EEPROM_SIGNATURE_LOCATION, EEPROM_SIGNATURE_VALUE);
-
-		// Save default clock configuration
-		EEPROMWritelong(EEPROM_CONFIG_LOCATION, (uint32_t)RA8875_WHITE);		// Default foreground
-		EEPROMWritelong(EEPROM_CONFIG_LOCATION + 4, (uint32_t)RA8875_BLACK);	// Default Background
-		EEPROMWritelong(EEPROM_CONFIG_LOCATION + 8, (uint32_t)BASE_HEX);		// Default number base
-		EEPROMWritelong(EEPROM_CONFIG_LOCATION + 12, (uint32_t)DISPLAY_24H);	// Default time display base
-		EEPROMWritelong(EEPROM_CONFIG_LOCATION + 16, (uint32_t)ROTATION_180);			// Default screen rotation. Set to 180 degrees because clock design mounts the display upside-down.
-
-		// Set initial time & preferences
-		theClock.setupScreen(&tft);
-	}
-
-	// Refresh all time segments. 
-	// The first time around, need to refresh all so they will all be displayed
-	// For subsequent calls, only the segments that are new will be re-displayed
-	theClock.refreshTime(&tft, REFRESH_ALL); 
-	
-	// Refresh the clock face. 
-	// The first time around, need to refresh all so everything will be displayed
-	// For subsequent calls, only the segments that are new will be re-displayed
-	theClock.refreshClock(&tft, REFRESH_ALL);
-
-	mTime1 = mTime2 = 0;
-
-	//Serial.println("Ending setup()");
-
-}
-
-// the loop function runs over and over again until power down or reset
-void loop() {
-
-	tsPoint_t raw, calibrated;
-
-	// See if screen is being touched
-	if (theClock.checkForTouchEvent(&tft, &calibrated, false) != 0)
-	{
-		// This line useful for debugging. Places a yellow circle where the screen was touched
-		//tft.fillCircle(calibrated.x, calibrated.y, 3, RA8875_YELLOW);
-		
-		// See if screen has been touched for more than 5 seonconds.
-		// If so, enter setup mode
-		if (mTime1 == 0)
-			mTime1 = millis();	// Start 5 second count
-		else
-		{
-			mTime2 = millis();	// Update 5 second count
-			if ((mTime2 - mTime1) > 5000) // 5-second press
-			{
-				mTime1 = 0;
-				theClock.setupScreen(&tft);
-			}
-		}
-	}
-	else
-	{
-		mTime1 = mTime2 = 0; // Reset 5 second count
-	}
-
-	// Get latest time info
-	theClock.refreshTime(&tft);
-	
-	// Refresh clock face with new elements
-	theClock.refreshClock(&tft);
-
-	return;
-}
+/*
+ Name:		HexClockTouch3.ino
+ Created:	11/25/2016 6:21:35 PM
+ Author:	Stephen Fried
+*/
+
+#include <SPI.h>
+#include <RA8875.h>
+#include "EEPROMFunctions.h"
+#include "ClockDisplay.h"
+#include "RTClock.h"
+#include "Scheduler.h"
+#include "Settings.h"
+#include "Profiler.h"
+#include "RamMonitor.h"
+#include "Latency.h"
+#include "SerialLink.h"
+#include "TimeSync.h"
+#include "TouchTrace.h"
+#include "Screenshot.h"
+#include "ScratchArena.h"
+#include "HexTime.h"
+#include "Stopwatch.h"
+#include "Alarms.h"
+#include "Sun.h"
+#include "Power.h"
+
+// Definitions for RTC
+#define CLK 8  // MUST be on PORTB! (Use pin 11 on Mega)
+#define LAT A3
+#define OE  9
+#define A   A0
+#define B   A1
+#define C   A2
+
+ClockScreen tft = ClockScreen(RA8875_CS, RA8875_RESET);  // TFT Display, 800x480 or 480x272 (Layout.h) 
+ClockRtc RTClock;  // Real-time clock
+ClockStorage Storage;  // Saved data (EEPROM)
+ClockDisplay theClock(&RTClock, &Storage);  // Clockface Object
+SettingsStore Settings;  // Saved clock configuration
+TaskScheduler scheduler;  // Runs the main loop tasks
+#if PROFILE
+Profiler Prof;  // Hot-path timing & bus counts
+#endif
+RamMonitor RamMon;  // Stack high-water marks
+TickLatency Lat;  // RTC tick to redraw finished
+uint8_t linkCommand(uint8_t cmd, const uint8_t *data, uint8_t len, uint8_t *reply, uint8_t *replyLen);
+SerialLink Link(linkCommand);  // Binary commands over Serial
+TimeSync Sync;  // Sets the RTC from a host clock
+TouchTrace Touch;  // Touch capture & replay
+Screenshot Shot;  // Screen export over Serial
+#if FACE_HEXTIME
+HexTime Hex;  // Hex day timer, off the RTC's 32kHz output
+#endif
+#if FACE_WATCH
+Stopwatch Watch;  // Stopwatch & countdown on the big digits
+#endif
+#if FACE_ALARM
+AlarmTable Alarms;  // Alarm table, off the RTC's alarm registers
+#endif
+#if FACE_SUN
+SunTimes Sun;  // Today's sunrise, sunset & day length
+#endif
+#if FACE_POWER
+PowerManager Power;  // Backlight dimming & panel off on a schedule
+#endif
+#if FACE_SETUP
+#define ARENA_SIZE	((sizeof(setupScratch_t) > sizeof(shotScratch_t)) ? sizeof(setupScratch_t) : sizeof(shotScratch_t))
+#else
+#define ARENA_SIZE	sizeof(shotScratch_t)
+#endif
+uint8_t arenaBlock[ARENA_SIZE] __attribute__((aligned(__BIGGEST_ALIGNMENT__)));  // Sized for the biggest owner. Aligned for the simulator (1 on the AVR)
+ScratchArena Arena(arenaBlock, sizeof(arenaBlock));  // Shared scratch RAM for setup, screenshots
+
+#define RTC_SQW_PIN 3	// DS3231 INT/SQW output. Must be an external interrupt pin (2 is taken by the RA8875)
+
+// Tick handling
+#define TICK_STAGING			1		// 1 = get the next second's digits ready before the tick and put them up on it
+#define RTC_TICK_TIMEOUT		1500	// ms without a tick before the poll goes back to reading the RTC
+
+// Main loop task periods (ms), deadlines (ms) and time budgets (us)
+#define TOUCH_PERIOD			20
+#define TOUCH_DEADLINE			20
+#define TOUCH_BUDGET			4000
+#define RTC_POLL_PERIOD			200		// Fallback if the 1Hz tick isn't connected
+#define RTC_DEADLINE			5
+#define RTC_BUDGET				3000
+#define RENDER_DEADLINE			20
+#define RENDER_BUDGET			40000
+#define SETTINGS_PERIOD			1000
+#define SETTINGS_DEADLINE		1000
+#define SETTINGS_BUDGET			20000
+#define DIAG_PERIOD				100
+#define DIAG_DEADLINE			1000
+#define DIAG_BUDGET				2000
+#define RAM_PERIOD				1000
+#define RAM_DEADLINE			1000
+#define RAM_BUDGET				2000
+#define LINK_PERIOD				20		// Often enough to keep up with 9600 baud with LINK_BYTES_PER_PASS bytes a pass
+#define LINK_DEADLINE			20
+#define LINK_BUDGET				2000
+#define SHOT_DEADLINE			50		// Screen export. Runs every SHOT_PERIOD while there's one going
+#define SHOT_BUDGET				6000
+#define POWER_PERIOD			1000
+#define POWER_DEADLINE			1000
+#define POWER_BUDGET			2000
+#define DIAG_REPORT_INTERVAL	60000	// How often the task statistics go out over Serial
+
+// Touch on the clock face
+#define SETUP_HOLD				5000	// ms. Holding a press this long opens setup
+#define WATCH_HOLD				2000	// ms. Letting go of a press held this long (but not to SETUP_HOLD) steps clock, stopwatch, countdown
+
+// Serial commands (single characters)
+#define CMD_PROFILE				'p'		// Print the profiler summary
+#define CMD_PROFILE_RESET		'r'		// Clear the profiler totals & tick latency
+#define CMD_RAM					'm'		// Print the free RAM high-water marks
+#define CMD_LATENCY				'l'		// Print the tick latency histogram
+#define CMD_HEXTIME				'x'		// Print the hex day timer's lock & jitter
+#define CMD_WATCH				'w'		// Print the stopwatch's frame times & laps
+#define CMD_ALARM				'a'		// Print the alarm state & table
+#define CMD_SUN					's'		// Print the sun panel's place & times, and the cycles they took
+#define CMD_POWER				'e'		// Print the power schedule, and the time & energy in each state
+
+// Reports printed on request. They go out one line per diagnostics pass, ahead of the periodic task stats
+#define REPORT_NONE				0
+#define REPORT_PROFILE			1
+#define REPORT_RAM				2
+#define REPORT_LATENCY			3
+#define REPORT_HEXTIME			4
+#define REPORT_WATCH			5
+#define REPORT_ALARM			6
+#define REPORT_SUN				7
+#define REPORT_POWER			8
+#define REPORT_MAX(a, b)		(((a) > (b)) ? (a) : (b))
+#define REPORT_LINE				REPORT_MAX(REPORT_MAX(REPORT_MAX(PROF_REPORT_LINE, RAM_REPORT_LINE), REPORT_MAX(LAT_REPORT_LINE, HEX_REPORT_LINE)), REPORT_MAX(REPORT_MAX(WATCH_REPORT_LINE, ALARM_REPORT_LINE), REPORT_MAX(SUN_REPORT_LINE, POWER_REPORT_LINE)))	// Longest line of any of them
+
+int8_t rtcTaskId, renderTaskId, linkTaskId, shotTaskId, powerTaskId;	// Scheduler ids for the tasks that get triggered
+int8_t diagLine = -1;			// Next line of the stats report to print. -1 when not printing a report
+uint8_t serialReport = REPORT_NONE;	// Report requested over Serial
+uint8_t serialReportLine;		// Next line of it to print
+unsigned long diagLastReport;	// millis() when the last stats report started
+uint8_t traceSeq;				// Sequence number of the next touch capture frame
+
+volatile bool tickPending;				// RTC tick came in and rtcTask hasn't seen it yet
+volatile bool hexPending;				// Hex day timer changed the time and rtcTask hasn't seen it yet
+volatile unsigned long lastTickMs;		// millis() at the last RTC tick
+bool tickSeen;							// The tick is wired up and running
+bool verifyTick;						// Staged digits went up on the tick. Check them against the RTC after the redraw
+bool fullRedraw;						// Settings changed over Serial. Next render redraws the whole face
+uint8_t pollSecond;						// RTC second at the last poll. Without the tick, the alarms count these
+uint8_t quietSecond;					// Second the quiet face is on, counted off the ticks. See rtcTask()
+
+unsigned long mTime1, mTime2;	// Millisecond time counters. Used to trap long-touch events
+bool pressActed;				// The press on the glass has had its tap handled
+bool wakeHeld;					// The press on the glass woke the face. Nothing else happens until it's let go
+
+// Fast boot
+#define FAST_BOOT				1		// 1 = skip the test pattern on a warm reset and shorten it on a cold one
+#define FASTBOOT_PATTERN_STEP	150		// ms per test pattern color on a fast cold boot
+#define BOOT_MAGIC				0x4878	// Left in RAM by a running clock. Still there after a reset means a warm boot
+
+uint16_t bootMagic __attribute__((section(".noinit")));	// Not cleared at startup, so it survives a reset (but not a power cycle)
+uint8_t resetFlags __attribute__((section(".noinit")));	// MCUSR as it was at reset
+bool warmBoot;					// This boot was a reset with power held up
+bool settingsLoaded;			// Found saved settings at boot
+clockSettings_t bootCfg;		// Settings read at boot
+unsigned long bootTime;			// Time to first frame (ms) for this boot
+
+// Grab the reset cause before anything else runs. Runs from .init3, ahead of the C runtime startup.
+// (The bootloader may have already cleared MCUSR, in which case the RAM marker alone decides.)
+void saveResetFlags(void) __attribute__((naked, used, section(".init3")));
+void saveResetFlags(void)
+{
+	resetFlags = MCUSR;
+	MCUSR = 0;
+}
+
+// Main loop tasks, defined below setup()
+void touchTask();
+void rtcTask();
+void renderTask();
+void settingsTask();
+void diagTask();
+void ramTask();
+void linkTask();
+void shotTask();
+void powerTask();
+void textCommand(char c);
+void timeWasSet();
+void watchChanged(bool redraw);
+void watchTap(tsPoint_t *point, unsigned long ms);
+void longPress();
+void rtcTickISR();
+void bootStep(uint8_t step);
+
+/*
+Boot work that used to run one after the other once the test pattern had finished.
+On a cold boot each step runs while one of the test pattern colors is up. On a warm boot they just run back to back.
+*/
+void bootStep(uint8_t step)
+{
+	switch (step)
+	{
+	case 0:		// Touch screen calibration (EEPROM)
+		theClock.tsCalibrate(&tft);
+		break;
+	case 1:		// Clock settings (EEPROM)
+		if ((settingsLoaded = Settings.load(&bootCfg)))
+			theClock.applySettings(&bootCfg);
+		break;
+	case 2:		// Current time (RTC)
+		// Refresh all time segments. 
+		// The first time around, need to refresh all so they will all be displayed
+		// For subsequent calls, only the segments that are new will be re-displayed
+		theClock.refreshTime(&tft, REFRESH_ALL);
+		break;
+	}
+}
+
+void setup() {
+	uint8_t i;
+
+	// A reset that left our marker in RAM (and didn't come from power-on) is a warm boot. The display still needs to be
+	// set up again, but there's no need to put on a show.
+	warmBoot = (bootMagic == BOOT_MAGIC) && !(resetFlags & _BV(PORF));
+	bootMagic = BOOT_MAGIC;
+
+	Serial.begin(LINK_BAUD);
+
+	//Serial.println("Begin setup()");
+
+	// Initialize the RTC
+	// INTCN off & rate select 0 puts a 1Hz square wave on INT/SQW. The falling edge is the start of each second.
+	Wire.begin();
+	DS3231_init(0);
+		
+	/* Initialize the TFT display */
+	tft.begin(PANEL_SIZE);
+	tft.useINT(RA8875_INT);
+	tft.touchBegin();
+	tft.enableISR(true);
+
+#if FAST_BOOT
+	if (warmBoot)
+	{
+		for (i = 0; i < TESTPATTERN_STEPS; ++i)
+			bootStep(i);
+	}
+	else
+		theClock.testPattern(&tft, FASTBOOT_PATTERN_STEP, bootStep);	// Display a quick boot-up test pattern
+#else
+	// Display boot-up test pattern
+	theClock.testPattern(&tft, TESTPATTERN_STEP, bootStep);
+#endif
+
+#if FACE_ALARM
+	// The time's been read. Load the next alarm due, so its mark goes up with the face
+	Alarms.schedule(RTClock.getTime());
+#endif
+
+	if (settingsLoaded)
+	{
+		tft.setRotation(theClock.getRotation());
+	
+		// Refresh the clock face. 
+		// The first time around, need to refresh all so everything will be displayed
+		// For subsequent calls, only the segments that are new will be re-displayed
+		theClock.refreshClock(&tft, REFRESH_ALL);
+	}
+	else
+	{
+		// No saved configuration, so this is the first time the clock has been run since reset.
+		// Set default colors & number base for clock operation
+		theClock.setFgColor(RA8875_WHITE);
+		theClock.setBgColor(RA8875_BLACK);
+		theClock.setBase(BASE_HEX);
+		theClock.setDisplayBase(DISPLAY_24H);
+		theClock.setRotation(ROTATION_180);		// Default screen rotation. Set to 180 degrees because clock design mounts the display upside-down.
+		
+		// Save default clock configuration
+		theClock.getSettings(&bootCfg);
+		Settings.update(&bootCfg);
+		Settings.commit();
+
+#if FACE_SETUP
+		// Set initial time & preferences. loop() runs the setup screen from here.
+		theClock.startSetup(&tft);
+#else
+		// No setup screen on this face. The time & preferences get set over Serial
+		tft.setRotation(theClock.getRotation());
+		theClock.refreshClock(&tft, REFRESH_ALL);
+#endif
+	}
+
+	// Time to first frame: from reset until the time digits are on the screen
+	bootTime = theClock.getTimeRowDrawn();
+	Serial.print(warmBoot ? F("warm") : F("cold"));
+	Serial.print(F(" boot, first frame "));
+	Serial.print(bootTime);
+	Serial.println(F("ms"));
+
+	mTime1 = mTime2 = 0;
+
+	// Set up the main loop tasks
+	scheduler.addTask(F("touch"), touchTask, TOUCH_PERIOD, TOUCH_DEADLINE, TOUCH_BUDGET);
+	rtcTaskId = scheduler.addTask(F("rtc"), rtcTask, RTC_POLL_PERIOD, RTC_DEADLINE, RTC_BUDGET);
+	renderTaskId = scheduler.addTask(F("render"), renderTask, 0, RENDER_DEADLINE, RENDER_BUDGET);
+	scheduler.addTask(F("settings"), settingsTask, SETTINGS_PERIOD, SETTINGS_DEADLINE, SETTINGS_BUDGET);
+	scheduler.addTask(F("diag"), diagTask, DIAG_PERIOD, DIAG_DEADLINE, DIAG_BUDGET);
+	scheduler.addTask(F("ram"), ramTask, RAM_PERIOD, RAM_DEADLINE, RAM_BUDGET);
+	linkTaskId = scheduler.addTask(F("link"), linkTask, LINK_PERIOD, LINK_DEADLINE, LINK_BUDGET);
+	shotTaskId = scheduler.addTask(F("shot"), shotTask, 0, SHOT_DEADLINE, SHOT_BUDGET);
+#if FACE_POWER
+	powerTaskId = scheduler.addTask(F("power"), powerTask, POWER_PERIOD, POWER_DEADLINE, POWER_BUDGET);
+#endif
+	diagLastReport = millis();
+	scheduler.resetStats();
+
+	pinMode(RTC_SQW_PIN, INPUT_PULLUP);	// SQW is open-drain
+	attachInterrupt(digitalPinToInterrupt(RTC_SQW_PIN), rtcTickISR, FALLING);
+
+	//Serial.println("Ending setup()");
+
+}
+
+/*
+Main loop tasks. loop() hands these to the scheduler, which runs whichever one is due next and sleeps in between.
+	Touch		- polls the touch screen. Runs the setup screen when it's up, otherwise watches for the 5-second press,
+				  the 2-second press that steps through the stopwatch modes, and taps on the stopwatch
+	RTC sync	- reads the time from the RTC. Runs on the RTC's 1Hz tick, with a slower poll in case the tick isn't wired
+	Render		- redraws whatever changed on the clock face. Triggered by RTC sync. Runs at the stopwatch's frame rate
+				  while it's running (Stopwatch.h)
+	Settings	- passes changed settings to the settings store, which writes them once they've stopped changing
+	Diagnostics	- prints task statistics over Serial, one line at a time so it never waits on the UART. Also prints
+				  the reports asked for by the text commands (profiler summary, RAM marks, tick latency)
+	RAM			- checks how close the stack has come to the heap, and puts a warning on the screen if it's too close
+	Link		- takes commands from Serial: framed binary commands (see SerialLink.h) and single-character text commands.
+				  Also streams the touch capture out (TouchTrace.h)
+	Shot		- screen export (Screenshot.h). Only runs while there's one going
+	Power		- dims the backlight or turns the panel off on the schedule, and back on for a touch (Power.h)
+*/
+void touchTask()
+{
+	tsPoint_t calibrated;
+	int touchState;
+
+#if FACE_SETUP
+	// Setup mode runs one step per pass so the clock keeps ticking
+	if (theClock.inSetup())
+	{
+		theClock.serviceSetup(&tft);
+		return;
+	}
+#endif
+
+	// See if screen is being touched
+	// A rejected (noisy) sample still means a finger is on the glass, so it doesn't break a long press
+	if ((touchState = theClock.checkForTouchEvent(&tft, &calibrated, false)) != TOUCH_NONE)
+	{
+#if FACE_POWER
+		// On a dimmed or dark face a touch only wakes it. The rest of the press is ignored
+		if (wakeHeld || Power.wake())
+		{
+			if (!wakeHeld)
+				scheduler.trigger(powerTaskId);
+			wakeHeld = true;
+			return;
+		}
+#endif
+		// This line useful for debugging. Places a yellow circle where the screen was touched
+		//tft.fillCircle(calibrated.x, calibrated.y, 3, RA8875_YELLOW);
+		
+		// See if screen has been touched for more than 5 seonconds.
+		// If so, enter setup mode
+		if (mTime1 == 0)
+		{
+			mTime1 = millis();	// Start 5 second count
+			pressActed = false;
+		}
+		else
+		{
+			mTime2 = millis();	// Update 5 second count
+			if ((mTime2 - mTime1) > SETUP_HOLD) // 5-second press
+			{
+				mTime1 = 0;
+#if FACE_SETUP
+#if FACE_WATCH
+				Watch.setMode(WATCH_OFF);
+				watchChanged(false);
+#endif
+				theClock.startSetup(&tft);
+				return;
+#endif
+			}
+		}
+
+#if FACE_ALARM
+		// A touch anywhere snoozes a ringing alarm, as soon as there's a good sample
+		if ((touchState == TOUCH_ACCEPTED) && !pressActed && Alarms.isRinging())
+		{
+			pressActed = true;
+			Alarms.snooze();
+			Touch.action();
+			scheduler.trigger(renderTaskId);
+		}
+#endif
+#if FACE_WATCH
+		// A tap on the watch goes as soon as there's a good sample, timed from when the finger came down
+		if ((touchState == TOUCH_ACCEPTED) && !pressActed && theClock.inWatch())
+		{
+			pressActed = true;
+			watchTap(&calibrated, mTime1);
+		}
+#endif
+	}
+	else
+	{
+		if ((mTime1 != 0) && ((mTime2 - mTime1) >= WATCH_HOLD))
+			longPress();
+		mTime1 = mTime2 = 0; // Reset 5 second count
+		wakeHeld = false;
+	}
+}
+
+/*
+RTC sync
+On a tick, the digits staged during the last second go straight up and the redraw starts; the RTC read that checks
+them waits until the redraw is done (renderTask). Without staging, or with nothing staged, the tick reads the RTC.
+Polls only read the RTC when the tick isn't running. While it is, they'd only ever read the same second again.
+In hex day time the hex timer's ticks come through here too. Once it's locked they own the time digits; the RTC
+only moves the date.
+While the face is quiet (dimmed or off, Power.h) the seconds aren't shown. The ticks are counted instead, and only the
+one that starts a new minute reads the RTC.
+*/
+void rtcTask()
+{
+	bool tick;
+#if FACE_HEXTIME
+	bool hexTick;
+#endif
+
+	noInterrupts();
+	tick = tickPending;
+	tickPending = false;
+#if FACE_HEXTIME
+	hexTick = hexPending;
+	hexPending = false;
+#endif
+	if (tick)
+		tickSeen = true;
+	else if ((millis() - lastTickMs) > RTC_TICK_TIMEOUT)
+		tickSeen = false;
+	interrupts();
+
+#if FACE_ALARM
+	if (tick && Alarms.tick())	// The alarms count every tick, whatever's on the screen
+		scheduler.trigger(renderTaskId);
+#endif
+
+	if (theClock.inSetup())	// Setup screen does its own refreshing
+		return;
+	if (theClock.inWatch())	// The watch has the digits. The time is read again when the clock face comes back
+		return;
+
+#if FACE_HEXTIME
+	if (hexTick)
+	{
+		Hex.serviced();
+		if (theClock.refreshHexTime())
+			scheduler.trigger(renderTaskId);
+	}
+#endif
+#if FACE_POWER
+	if (tick && theClock.isQuiet() && (++quietSecond < 60))
+	{
+		Lat.skip();
+		return;
+	}
+#endif
+#if TICK_STAGING
+	if (tick && theClock.applyStagedTime())
+	{
+		verifyTick = true;
+		scheduler.trigger(renderTaskId);
+		return;
+	}
+#endif
+	if (!tick && tickSeen)
+		return;
+
+	// Get latest time info
+	if (theClock.refreshTime(&tft))
+		scheduler.trigger(renderTaskId);
+#if FACE_POWER
+	quietSecond = RTClock.getTime()->sec;
+#endif
+#if TICK_STAGING
+	theClock.stageNextSecond();
+#endif
+
+#if FACE_ALARM
+	// No tick to count (or this is the first one), so the alarms count the seconds the polls see go by
+	if (!tick && (RTClock.getTime()->sec != pollSecond))
+	{
+		pollSecond = RTClock.getTime()->sec;
+		if (Alarms.tick())
+			scheduler.trigger(renderTaskId);
+	}
+#endif
+}
+
+void renderTask()
+{
+#if FACE_WATCH
+	unsigned long start = micros();
+#endif
+
+	if (theClock.inSetup())
+		return;
+#if FACE_POWER
+	if (Power.getState() == POWER_OFF)		// Nothing to see. The face is redrawn whole when the panel comes back on
+	{
+		Lat.skip();
+		return;
+	}
+#endif
+
+	// Refresh clock face with new elements
+	if (fullRedraw)
+	{
+		fullRedraw = false;
+		theClock.redrawFace(&tft);
+	}
+	else
+	{
+		if (theClock.inWatch())
+			theClock.refreshWatch();
+		theClock.refreshClock(&tft);
+	}
+	if (theClock.isRecoloring())		// The other half of the color of the time's recolor goes straight after
+		scheduler.trigger(renderTaskId);
+	Lat.frameDone(theClock.getSecondsDrawn());
+
+#if FACE_WATCH
+	// Time the watch's frames. One that runs a countdown out, or puts the watch over its budget, changes the rate
+	if (theClock.inWatch())
+	{
+		if (!Watch.isRunning())
+			scheduler.setPeriod(renderTaskId, 0);
+		else if (Watch.frameDone(micros() - start))
+			scheduler.setPeriod(renderTaskId, Watch.getPeriod());
+		return;
+	}
+#endif
+
+#if TICK_STAGING
+	// Check the staged digits against the RTC now the tick's redraw is out of the way, and stage the next second
+	if (verifyTick)
+	{
+		verifyTick = false;
+		if (theClock.refreshTime(&tft))		// Time was changed, or the tick and the RTC disagree
+			scheduler.trigger(renderTaskId);
+		theClock.stageNextSecond();
+	}
+#endif
+}
+
+void settingsTask()
+{
+	theClock.saveSettings();
+	Settings.service();
+}
+
+void diagTask()
+{
+	bool more = false;
+
+	// A requested report goes ahead of the periodic one
+	if (serialReport != REPORT_NONE)
+	{
+		if (Serial.availableForWrite() < REPORT_LINE)
+			return;
+		switch (serialReport)
+		{
+#if PROFILE
+		case REPORT_PROFILE:
+			more = Prof.printLine(&Serial, serialReportLine++);
+			break;
+#endif
+		case REPORT_RAM:	// Stack marks, then the arena
+			if (serialReportLine < RAM_REPORT_LINES)
+				more = RamMon.printLine(&Serial, serialReportLine++);
+			else
+				more = Arena.printLine(&Serial, serialReportLine++ - RAM_REPORT_LINES);
+			break;
+		case REPORT_LATENCY:
+			more = Lat.printLine(&Serial, serialReportLine++);
+			break;
+#if FACE_HEXTIME
+		case REPORT_HEXTIME:
+			more = Hex.printLine(&Serial, serialReportLine++);
+			break;
+#endif
+#if FACE_WATCH
+		case REPORT_WATCH:
+			more = Watch.printLine(&Serial, serialReportLine++);
+			break;
+#endif
+#if FACE_ALARM
+		case REPORT_ALARM:
+			more = Alarms.printLine(&Serial, serialReportLine++);
+			break;
+#endif
+#if FACE_SUN
+		case REPORT_SUN:
+			more = Sun.printLine(&Serial, serialReportLine++);
+			break;
+#endif
+#if FACE_POWER
+		case REPORT_POWER:
+			more = Power.printLine(&Serial, serialReportLine++);
+			break;
+#endif
+		}
+		if (!more)
+			serialReport = REPORT_NONE;
+		return;
+	}
+
+	if ((millis() - diagLastReport) >= DIAG_REPORT_INTERVAL)
+	{
+		diagLastReport = millis();
+		diagLine = 0;
+	}
+
+	if ((diagLine < 0) || (Serial.availableForWrite() < SCHED_REPORT_LINE))
+		return;
+
+	if (!scheduler.printStatsLine(&Serial, diagLine++))
+	{
+		diagLine = -1;		// Report finished. Start a new measurement window
+		scheduler.resetStats();
+	}
+}
+
+void ramTask()
+{
+	RamMon.checkpoint();
+	if (RamMon.getLowest() < RAM_WARN_THRESHOLD)
+		theClock.showRamWarning(&tft, RamMon.getLowest());
+}
+
+void linkTask()
+{
+	int c;
+
+	uint8_t chunk[TRACE_CHUNK], n;
+
+	if ((c = Link.poll(&Serial)) >= 0)
+		textCommand(c);
+
+	// Touch capture goes out as it fills
+	if (Touch.ready() && Link.canSend(&Serial, TRACE_CHUNK + 1))
+	{
+		n = Touch.take(chunk, TRACE_CHUNK);
+		Link.send(&Serial, LINK_TRACE_DATA | LINK_REPLY, traceSeq++, chunk, n);
+	}
+
+	// Time sync. The host's half of an exchange is timed by when it's read, so poll flat out while it's on its way
+	if (theClock.inSetup())
+		Sync.cancel();
+	else if (Sync.service())
+		timeWasSet();
+	if (Sync.waiting())
+		scheduler.trigger(linkTaskId);
+}
+
+void shotTask()
+{
+	if (!Shot.service(&tft, &Link, &Serial))
+		scheduler.setPeriod(shotTaskId, 0);
+}
+
+/*
+Power. Anything in use on the face (setup, the watch, a ringing alarm) keeps it at full. When the state changes the
+seconds are hidden or shown again, and a face that was off is redrawn whole
+*/
+void powerTask()
+{
+#if FACE_POWER
+	bool awake = theClock.inSetup() || theClock.inWatch();
+	uint8_t was = Power.getState();
+
+#if FACE_ALARM
+	awake = awake || Alarms.isRinging();
+#endif
+	if (!Power.service(&tft, RTClock.getTime(), awake))
+		return;
+	theClock.setQuiet(Power.getState() != POWER_ON);
+	if (was == POWER_OFF)
+		fullRedraw = true;
+	if (!theClock.inSetup() && !theClock.inWatch())		// Otherwise they have the digits
+	{
+		theClock.refreshTime(&tft);
+		quietSecond = RTClock.getTime()->sec;
+#if TICK_STAGING
+		theClock.stageNextSecond();
+#endif
+	}
+	scheduler.trigger(renderTaskId);
+#endif
+}
+
+// RTC was set from the Serial link. Get the face & the staged digits up to date
+void timeWasSet()
+{
+#if FACE_ALARM
+	RTClock.readTime();
+	Alarms.schedule(RTClock.getTime());
+	scheduler.trigger(renderTaskId);	// The alarm mark may have changed
+#endif
+	if (theClock.inWatch())		// The clock face picks the new time up when it comes back
+		return;
+	if (theClock.refreshTime(&tft))
+		scheduler.trigger(renderTaskId);
+#if FACE_POWER
+	quietSecond = RTClock.getTime()->sec;
+#endif
+#if TICK_STAGING
+	theClock.stageNextSecond();
+#endif
+}
+
+/*
+The watch changed mode, or started or stopped. Frames come at the watch's rate while it's running; otherwise the
+render task goes back to only running when it's triggered
+*/
+void watchChanged(bool redraw)
+{
+#if FACE_WATCH
+	scheduler.setPeriod(renderTaskId, (theClock.inWatch() && Watch.isRunning()) ? Watch.getPeriod() : 0);
+	if (redraw)
+		fullRedraw = true;
+	scheduler.trigger(renderTaskId);
+#endif
+}
+
+/*
+A press held for WATCH_HOLD (but let go before SETUP_HOLD). It turns off a ringing or snoozed alarm, otherwise it steps
+through the clock, stopwatch and countdown
+*/
+void longPress()
+{
+#if FACE_ALARM
+	if (Alarms.stop())
+	{
+		Touch.action();
+		scheduler.trigger(renderTaskId);
+		return;
+	}
+#endif
+#if FACE_WATCH
+	Watch.setMode((Watch.getMode() + 1) % (WATCH_DOWN + 1));
+	Touch.action();
+	watchChanged(true);
+#endif
+}
+
+// A tap on the watch at 'ms'. The time row starts & stops it. Below that takes a lap while it's running, or clears it
+void watchTap(tsPoint_t *point, unsigned long ms)
+{
+#if FACE_WATCH
+	if (point->y < Y_TIME_LOWER)
+		Watch.control(WATCH_START_STOP, ms);
+	else
+		Watch.control(Watch.isRunning() ? WATCH_LAP : WATCH_CLEAR, ms);
+	Touch.action();
+	watchChanged(false);
+#endif
+}
+
+// Single-character commands. The reports they ask for are printed by diagTask()
+void textCommand(char c)
+{
+	switch (c)
+	{
+#if PROFILE
+	case CMD_PROFILE:
+		serialReport = REPORT_PROFILE;
+		serialReportLine = 0;
+		break;
+#endif
+	case CMD_PROFILE_RESET:
+#if PROFILE
+		Prof.reset();
+#endif
+		Lat.reset();
+#if FACE_HEXTIME
+		Hex.reset();
+#endif
+#if FACE_WATCH
+		Watch.resetStats();
+#endif
+		break;
+	case CMD_RAM:
+		serialReport = REPORT_RAM;
+		serialReportLine = 0;
+		break;
+	case CMD_LATENCY:
+		serialReport = REPORT_LATENCY;
+		serialReportLine = 0;
+		break;
+#if FACE_HEXTIME
+	case CMD_HEXTIME:
+		serialReport = REPORT_HEXTIME;
+		serialReportLine = 0;
+		break;
+#endif
+#if FACE_WATCH
+	case CMD_WATCH:
+		serialReport = REPORT_WATCH;
+		serialReportLine = 0;
+		break;
+#endif
+#if FACE_ALARM
+	case CMD_ALARM:
+		serialReport = REPORT_ALARM;
+		serialReportLine = 0;
+		break;
+#endif
+#if FACE_SUN
+	case CMD_SUN:
+		serialReport = REPORT_SUN;
+		serialReportLine = 0;
+		break;
+#endif
+#if FACE_POWER
+	case CMD_POWER:
+		serialReport = REPORT_POWER;
+		serialReportLine = 0;
+		break;
+#endif
+	}
+}
+
+// Little-endian helpers for the binary commands
+static void linkPut16(uint8_t *p, uint16_t v)
+{
+	p[0] = (uint8_t)v;
+	p[1] = (uint8_t)(v >> 8);
+}
+
+static uint16_t linkGet16(const uint8_t *p)
+{
+	return p[0] | ((uint16_t)p[1] << 8);
+}
+
+static void linkPut32(uint8_t *p, uint32_t v)
+{
+	linkPut16(p, (uint16_t)v);
+	linkPut16(p + 2, (uint16_t)(v >> 16));
+}
+
+static uint32_t linkGet32(const uint8_t *p)
+{
+	return linkGet16(p) | ((uint32_t)linkGet16(p + 2) << 16);
+}
+
+// Settings that the clock face can actually show. Decimal, 12-hour, hex day time etc. only if this face has them (FaceConfig.h)
+static bool linkSettingsOk(clockSettings_t *cfg)
+{
+	return ((cfg->numberBase == BASE_HEX) || (FACE_DECIMAL && (cfg->numberBase == BASE_DEC))) &&
+		((cfg->displayBase == DISPLAY_24H) || (FACE_12H && (cfg->displayBase == DISPLAY_12H))) &&
+		((cfg->rotation == ROTATION_0) || (cfg->rotation == ROTATION_180)) &&
+		((cfg->timeMode == TIME_MODE_CLOCK) || (FACE_HEXTIME && (cfg->timeMode == TIME_MODE_HEXDAY))) &&
+		((cfg->colorMode == COLOR_MODE_FIXED) || (FACE_TIMECOLOR && (cfg->colorMode == COLOR_MODE_TIME))) &&
+		((cfg->sunPanel == 0) || (FACE_SUN && (cfg->sunPanel == 1))) &&
+		(abs(cfg->latitude) <= SUN_LAT_MAX) && (abs(cfg->longitude) <= SUN_LON_MAX) && (abs(cfg->utcOffset) <= SUN_UTC_MAX) &&
+		(cfg->dimFrom < POWER_QUARTERS) && (cfg->dimTo < POWER_QUARTERS) && (cfg->offFrom < POWER_QUARTERS) &&
+		(cfg->offTo < POWER_QUARTERS);
+}
+
+/*
+Binary commands from the SerialLink. Anything that changes the clock is refused while the setup screen is up.
+The counters reply is:
+	uptime ms(4) touchAccepted(2) touchRejected(2) ticks(2) ticksMissed(2) ramLowest(2) settingsCommits(2) linkErrors(2)
+*/
+uint8_t linkCommand(uint8_t cmd, const uint8_t *data, uint8_t len, uint8_t *reply, uint8_t *replyLen)
+{
+	struct ts t;
+	clockSettings_t cfg;
+	unsigned long up, us, delay;
+	uint32_t sec;
+	long offset;
+	uint16_t x, y, w, h;
+#if FACE_ALARM
+	alarmEntry_t alarm;
+#endif
+
+	switch (cmd)
+	{
+	case LINK_PING:
+		reply[0] = LINK_VERSION;
+		*replyLen = 1;
+		return LINK_OK;
+
+	case LINK_GET_TIME:
+		RTClock.readTime();
+		t = *RTClock.getTime();
+		reply[0] = t.sec; reply[1] = t.min; reply[2] = t.hour;
+		reply[3] = t.mday; reply[4] = t.mon;
+		linkPut16(reply + 5, t.year);
+		*replyLen = 7;
+		return LINK_OK;
+
+	case LINK_SET_TIME:
+		if (len != 7)
+			return LINK_ERR_ARG;
+		memset(&t, 0, sizeof(t));
+		t.sec = data[0]; t.min = data[1]; t.hour = data[2];
+		t.mday = data[3]; t.mon = data[4];
+		t.year = linkGet16(data + 5);
+		t.year_s = t.year % 100;
+		t.wday = 1;
+		if ((t.sec > 59) || (t.min > 59) || (t.hour > 23) || (t.year < 2000) || (t.year > 2099) || (t.mon < 1) ||
+			(t.mon > 12) || (t.mday < 1) || (t.mday > RTClockClass::daysInMonth(t.mon, t.year)))
+			return LINK_ERR_ARG;
+		if (theClock.inSetup())
+			return LINK_ERR_BUSY;
+		Sync.cancel();
+		RTClock.setTime(&t);
+		timeWasSet();
+		return LINK_OK;
+
+#if FACE_ALARM
+	// Alarms. See Alarms.h
+	case LINK_ALARM_STATUS:
+		reply[0] = Alarms.getState();
+		reply[1] = Alarms.count();
+		reply[2] = reply[3] = ALARM_EMPTY;
+		if (Alarms.getNext(&alarm))
+		{
+			reply[2] = alarm.hour;
+			reply[3] = alarm.min;
+		}
+		linkPut32(reply + 4, Alarms.getDueIn());
+		linkPut16(reply + 8, Alarms.getRung());
+		linkPut16(reply + 10, Alarms.getSnoozes());
+		linkPut16(reply + 12, Alarms.getChecks());
+		*replyLen = 14;
+		return LINK_OK;
+
+	case LINK_ALARM_GET:
+		if ((len != 1) || (data[0] >= ALARM_SLOTS) || !Alarms.read(data[0], &alarm))
+			return LINK_ERR_ARG;
+		reply[0] = alarm.hour;
+		reply[1] = alarm.min;
+		reply[2] = alarm.days;
+		*replyLen = 3;
+		return LINK_OK;
+
+	case LINK_ALARM_SET:
+		if ((len != 3) || (data[0] > 23) || (data[1] > 59))
+			return LINK_ERR_ARG;
+		if (theClock.inSetup())		// Setup may be setting one
+			return LINK_ERR_BUSY;
+		alarm.hour = data[0];
+		alarm.min = data[1];
+		alarm.days = data[2];
+		if (!Alarms.replace(alarm.hour, alarm.min, &alarm))
+			return LINK_ERR_STATE;
+		RTClock.readTime();
+		Alarms.schedule(RTClock.getTime());
+		scheduler.trigger(renderTaskId);
+		return LINK_OK;
+
+	case LINK_ALARM_CTRL:
+		if ((len != 1) || (data[0] > ALARM_CTRL_STOP))
+			return LINK_ERR_ARG;
+		if (!((data[0] == ALARM_CTRL_SNOOZE) ? Alarms.snooze() : Alarms.stop()))
+			return LINK_ERR_STATE;
+		scheduler.trigger(renderTaskId);
+		return LINK_OK;
+#endif
+
+	case LINK_GET_SETTINGS:
+		theClock.getSettings(&cfg);
+		linkPut16(reply, cfg.fgColor);
+		linkPut16(reply + 2, cfg.bgColor);
+		reply[4] = cfg.numberBase;
+		reply[5] = cfg.displayBase;
+		reply[6] = cfg.rotation;
+		reply[7] = cfg.timeMode;
+		reply[8] = cfg.colorMode;
+		*replyLen = 9;
+		return LINK_OK;
+
+	// The time & color modes on the end are optional, so a host that doesn't know about them leaves them alone
+	case LINK_SET_SETTINGS:
+	case LINK_SET_MODE:
+		theClock.getSettings(&cfg);
+		if ((cmd == LINK_SET_SETTINGS) && (len >= 7) && (len <= 9))
+		{
+			cfg.fgColor = linkGet16(data);
+			cfg.bgColor = linkGet16(data + 2);
+			data += 4;
+			len -= 4;
+		}
+		else if ((cmd == LINK_SET_SETTINGS) || ((len != 2) && (len != 3)))
+			return LINK_ERR_ARG;
+		cfg.numberBase = data[0];
+		cfg.displayBase = data[1];
+		if (cmd == LINK_SET_SETTINGS)
+		{
+			cfg.rotation = data[2];
+			data++;
+			len--;
+		}
+		if (len >= 3)
+			cfg.timeMode = data[2];
+		if (len == 4)
+			cfg.colorMode = data[3];
+		if (!linkSettingsOk(&cfg))
+			return LINK_ERR_ARG;
+		if (theClock.inSetup())
+			return LINK_ERR_BUSY;
+		theClock.changeSettings(&cfg);
+		fullRedraw = true;
+		scheduler.trigger(renderTaskId);
+		return LINK_OK;
+
+#if FACE_SUN
+	// The sun panel. See Sun.h
+	case LINK_SUN_GET:
+		theClock.getSettings(&cfg);
+		linkPut16(reply, cfg.latitude);
+		linkPut16(reply + 2, cfg.longitude);
+		reply[4] = cfg.utcOffset;
+		reply[5] = cfg.sunPanel;
+		linkPut16(reply + 6, Sun.get()->rise);
+		linkPut16(reply + 8, Sun.get()->set);
+		linkPut16(reply + 10, Sun.get()->length);
+		reply[12] = Sun.get()->polar;
+		linkPut16(reply + 13, Sun.getCycles());
+		linkPut16(reply + 15, Sun.getRuns());
+		*replyLen = 17;
+		return LINK_OK;
+
+	case LINK_SUN_SET:
+		if (len != 6)
+			return LINK_ERR_ARG;
+		theClock.getSettings(&cfg);
+		cfg.latitude = linkGet16(data);
+		cfg.longitude = linkGet16(data + 2);
+		cfg.utcOffset = data[4];
+		cfg.sunPanel = data[5];
+		if (!linkSettingsOk(&cfg))
+			return LINK_ERR_ARG;
+		if (theClock.inSetup())
+			return LINK_ERR_BUSY;
+		theClock.changeSettings(&cfg);
+		fullRedraw = true;
+		scheduler.trigger(renderTaskId);
+		return LINK_OK;
+#endif
+
+#if FACE_POWER
+	// Power schedule & energy. See Power.h
+	case LINK_POWER_GET:
+		reply[0] = Power.getDimFrom();
+		reply[1] = Power.getDimTo();
+		reply[2] = Power.getOffFrom();
+		reply[3] = Power.getOffTo();
+		reply[4] = Power.getDimLevel();
+		reply[5] = Power.getState();
+		linkPut16(reply + 6, Power.getMinutes(POWER_ON));
+		linkPut16(reply + 8, Power.getMinutes(POWER_DIM));
+		linkPut16(reply + 10, Power.getMinutes(POWER_OFF));
+		linkPut16(reply + 12, Power.getTodayMwh());
+		linkPut16(reply + 14, Power.getYesterdayMwh());
+		*replyLen = 16;
+		return LINK_OK;
+
+	case LINK_POWER_SET:
+		if (len != 5)
+			return LINK_ERR_ARG;
+		theClock.getSettings(&cfg);
+		cfg.dimFrom = data[0];
+		cfg.dimTo = data[1];
+		cfg.offFrom = data[2];
+		cfg.offTo = data[3];
+		cfg.dimLevel = data[4];
+		if (!linkSettingsOk(&cfg))
+			return LINK_ERR_ARG;
+		if (theClock.inSetup())
+			return LINK_ERR_BUSY;
+		theClock.changeSettings(&cfg);
+		scheduler.trigger(powerTaskId);
+		return LINK_OK;
+#endif
+
+	case LINK_GET_COUNTERS:
+		up = millis();
+		linkPut32(reply, up);
+		linkPut16(reply + 4, theClock.getTouchAccepted());
+		linkPut16(reply + 6, theClock.getTouchRejected());
+		linkPut16(reply + 8, Lat.getCount());
+		linkPut16(reply + 10, Lat.getMissed());
+		linkPut16(reply + 12, RamMon.getLowest());
+		linkPut16(reply + 14, Settings.getCommitCount());
+		linkPut16(reply + 16, Link.getErrors());
+		*replyLen = 18;
+		return LINK_OK;
+
+	// Time sync exchange. See TimeSync.h
+	case LINK_SYNC_START:
+		if (len != 1)
+			return LINK_ERR_ARG;
+		if (theClock.inSetup())
+			return LINK_ERR_BUSY;
+		if (!Sync.start(data[0], &sec, &us))
+			return LINK_ERR_STATE;
+		linkPut32(reply, sec);
+		linkPut32(reply + 4, us);
+		reply[8] = reply[9] = reply[10] = 0;	// Same length as LINK_SYNC_TIME, so both legs spend the same time on the wire
+		*replyLen = 11;
+		return LINK_OK;
+
+	case LINK_SYNC_TIME:
+		if (len != 12)
+			return LINK_ERR_ARG;
+		if (!Sync.sample(linkGet32(data), linkGet32(data + 4), linkGet32(data + 8), &delay, &offset))
+			return LINK_ERR_STATE;
+		linkPut32(reply, delay);
+		linkPut32(reply + 4, offset);
+		*replyLen = 8;
+		return LINK_OK;
+
+	case LINK_SYNC_APPLY:
+		if (theClock.inSetup())
+			return LINK_ERR_BUSY;
+		if (!Sync.apply(&sec))
+			return LINK_ERR_STATE;
+		linkPut32(reply, sec);
+		*replyLen = 4;
+		return LINK_OK;
+
+	case LINK_SYNC_STATUS:
+		linkPut16(reply, Sync.getSyncs());
+		linkPut32(reply + 2, Sync.getLastStep());
+		linkPut32(reply + 6, Sync.getDrift());
+		linkPut32(reply + 10, Sync.getLastOffset());
+		linkPut32(reply + 14, Sync.getBestDelay());
+		*replyLen = 18;
+		return LINK_OK;
+
+	// Touch capture & replay. See TouchTrace.h
+	case LINK_TRACE:
+		if ((len != 1) || (data[0] > TRACE_REPLAY))
+			return LINK_ERR_ARG;
+		Touch.setMode(data[0]);
+		traceSeq = 0;
+		return LINK_OK;
+
+	case LINK_TRACE_FEED:
+		if (len < 1)
+			return LINK_ERR_ARG;
+		if (Touch.getMode() != TRACE_REPLAY)
+			return LINK_ERR_STATE;
+		reply[0] = Touch.feed(data + 1, len - 1, data[0]);
+		reply[1] = Touch.room();
+		*replyLen = 2;
+		return LINK_OK;
+
+	case LINK_TRACE_STATUS:
+		reply[0] = Touch.getMode();
+		linkPut16(reply + 1, Touch.getDropped());
+		linkPut16(reply + 3, Touch.getUnderruns());
+		linkPut16(reply + 5, Touch.getActions());
+		linkPut32(reply + 7, Touch.getLastLatency());
+		linkPut32(reply + 11, Touch.getMaxLatency());
+		*replyLen = 15;
+		return LINK_OK;
+
+	// Screen export. The whole screen unless an area is given
+	case LINK_SHOT:
+		if ((len != 1) && (len != 9))
+			return LINK_ERR_ARG;
+		if (len == 9)
+		{
+			x = linkGet16(data + 1); y = linkGet16(data + 3);
+			w = linkGet16(data + 5); h = linkGet16(data + 7);
+		}
+		else
+		{
+			x = y = 0;
+			w = tft.width(); h = tft.height();
+		}
+		if ((w == 0) || (h == 0) || (x + w > tft.width()) || (y + h > tft.height()))
+			return LINK_ERR_ARG;
+		if (!Shot.start(x, y, w, h, data[0]))
+			return LINK_ERR_BUSY;
+		scheduler.setPeriod(shotTaskId, SHOT_PERIOD);
+		linkPut16(reply, w);
+		linkPut16(reply + 2, h);
+		linkPut32(reply + 4, Shot.getBaud());
+		*replyLen = 8;
+		return LINK_OK;
+
+	case LINK_SHOT_STOP:
+		Shot.cancel();
+		return LINK_OK;
+
+#if FACE_WATCH
+	// Stopwatch & countdown. See Stopwatch.h
+	case LINK_WATCH:
+		if (((len != 1) && (len != 3)) || (data[0] > WATCH_DOWN) ||
+			((len == 3) && (linkGet16(data + 1) > WATCH_COUNTDOWN_MAX)))
+			return LINK_ERR_ARG;
+		if (theClock.inSetup())
+			return LINK_ERR_BUSY;
+		Watch.setMode(data[0], (len == 3) ? linkGet16(data + 1) : 0);
+		watchChanged(true);
+		return LINK_OK;
+
+	case LINK_WATCH_CTRL:
+		if ((len != 1) || (data[0] > WATCH_CLEAR))
+			return LINK_ERR_ARG;
+		if (!theClock.inWatch())
+			return LINK_ERR_STATE;
+		Watch.control(data[0], millis());
+		watchChanged(false);
+		return LINK_OK;
+
+	case LINK_WATCH_STATUS:
+		reply[0] = Watch.getMode();
+		reply[1] = (Watch.isRunning() ? 1 : 0) | (Watch.isSlow() ? 2 : 0);
+		linkPut32(reply + 2, Watch.shown(millis()));
+		reply[6] = Watch.getLaps();
+		linkPut32(reply + 7, Watch.getLap());
+		linkPut16(reply + 11, Watch.getFrames());
+		linkPut16(reply + 13, Watch.getFrameAvg());
+		linkPut16(reply + 15, (Watch.getFrameMax() > 0xFFFF) ? 0xFFFF : Watch.getFrameMax());
+		linkPut16(reply + 17, Watch.getOver());
+		*replyLen = 19;
+		return LINK_OK;
+#endif
+	}
+	return LINK_ERR_CMD;
+}
+
+// RTC 1Hz square wave. The new second starts on this edge
+void rtcTickISR()
+{
+	unsigned long us = micros();
+
+#if FACE_HEXTIME
+	Hex.edge();
+	if (!Hex.locked())		// The latency report follows the hex ticks while they have the time digits
+		Lat.edge(us);
+#else
+	Lat.edge(us);
+#endif
+	Sync.edge(us);
+	lastTickMs = millis();
+	tickPending = true;
+	scheduler.trigger(rtcTaskId);
+}
+
+#if FACE_HEXTIME
+// Hex day timer, every 1/16 unit. Wakes the face when the time digits (or the progress bits) change
+ISR(TIMER1_COMPA_vect)
+{
+	uint8_t change = Hex.tick();
+
+	if (change == HEX_TICK_NONE)
+		return;
+	if (change == HEX_TICK_UNIT)
+		Lat.edge(Hex.getTickAt());
+	hexPending = true;
+	scheduler.trigger(rtcTaskId);
+}
+#endif
+
+// the loop function runs over and over again until power down or reset
+void loop() {
+
+	scheduler.run();
+
+	return;
+}
@@ -0,0 +1,237 @@
+/*
+HexTime.cpp
+Hexadecimal day time off the DS3231's 32kHz output.
+Timer1 runs in CTC mode clocked from T1, so it counts the RTC's own oscillator and the 1/16 unit boundaries fall
+exactly where they should, with nothing rounded. The only error left is getting into the interrupt, a few us.
+*/
+
+#include "HexTime.h"
+
+HexTime::HexTime()
+{
+	running = false;
+	reset();
+}
+
+// Turn the 32kHz output on and start the timer. It isn't locked until a 1Hz edge has checked it against the RTC
+void HexTime::begin()
+{
+	if (running)
+		return;
+	DS3231_set_sreg(DS3231_get_sreg() | DS3231_EN32KHZ);
+	pinMode(HEX_32K_PIN, INPUT_PULLUP);
+
+	noInterrupts();
+	TCCR1A = 0;
+	TCCR1B = _BV(WGM12) | _BV(CS12) | _BV(CS11) | _BV(CS10);	// CTC, clocked on rising edges of T1
+	OCR1A = HEX_32K_PER_SUB - 1;
+	TCNT1 = 0;
+	TIFR1 = _BV(OCF1A);
+	TIMSK1 = _BV(OCIE1A);
+	sub = 0;
+	aligned = armed = waiting = false;
+	good = 0;
+	running = true;
+	interrupts();
+}
+
+void HexTime::end()
+{
+	if (!running)
+		return;
+	noInterrupts();
+	TIMSK1 = 0;
+	TCCR1B = 0;
+	running = false;
+	good = 0;
+	interrupts();
+	DS3231_set_sreg(DS3231_get_sreg() & ~DS3231_EN32KHZ);
+}
+
+/*
+Timer1 compare match, every 1/16 unit. Says what changed so the caller knows whether to wake the face.
+Nothing shows until the timer is locked; the face is still working from the RTC seconds.
+*/
+uint8_t HexTime::tick()
+{
+	unsigned long us = micros(), gap;
+
+	if (++sub >= HEX_SUBS_PER_DAY)
+		sub = 0;
+	if (!locked())
+		return HEX_TICK_NONE;
+	if (sub % HEX_SUBS_PER_UNIT)
+		return HEX_PROGRESS ? HEX_TICK_PROGRESS : HEX_TICK_NONE;
+
+	if (lastUnitAt)
+	{
+		gap = us - lastUnitAt;
+		if (gap < gapMin)
+			gapMin = gap;
+		if (gap > gapMax)
+			gapMax = gap;
+		if (units < 0xFFFF)
+			++units;
+	}
+	lastUnitAt = us;
+	tickAt = us;
+	waiting = true;
+	return HEX_TICK_UNIT;
+}
+
+/*
+An RTC read saw 'secOfDay' and the 1Hz edge count was 'edgesBefore' when it started. If no edge came in while it
+was reading, the next edge starts the second after it, and that edge can check the timer.
+*/
+void HexTime::expect(uint32_t secOfDay, uint8_t edgesBefore)
+{
+	if (!running)
+		return;
+	noInterrupts();
+	if (edges == edgesBefore)
+	{
+		nextSec = (secOfDay + 1) % 86400UL;
+		armed = true;
+	}
+	interrupts();
+}
+
+/*
+RTC 1Hz edge, from the tick interrupt. The timer should be exactly nextSec seconds of 32kHz clocks into the day.
+Just after a match TCNT1 reads OCR1A, so a whole number of 1/16 units reads as HEX_32K_PER_SUB - 1 with the match
+either just taken or still pending. The timer and the RTC run off the same oscillator, so once set it can only be out
+if it missed clocks or the RTC was set. A small error is most likely this interrupt running late, so it's only
+recorded. Out by more than the slack, the timer and the unit count are set to where they should be and the face falls
+back to the RTC seconds until the next edge finds them in step.
+*/
+void HexTime::edge()
+{
+	uint32_t at, pos, err;
+	uint16_t count;
+	uint32_t s;
+
+	++edges;
+	if (!running || !armed)
+		return;
+	armed = false;
+
+	at = nextSec * HEX_32K_PER_SEC;
+	count = TCNT1;
+	s = sub;
+	if (TIFR1 & _BV(OCF1A))		// Match hasn't been taken yet
+		s = (s + 1) % HEX_SUBS_PER_DAY;
+	pos = s * HEX_32K_PER_SUB + (count + 1) % HEX_32K_PER_SUB;
+
+	// How far out, either way round midnight
+	err = (pos >= at) ? pos - at : at - pos;
+	if (err > HEX_SUBS_PER_DAY / 2 * HEX_32K_PER_SUB)
+		err = HEX_SUBS_PER_DAY * HEX_32K_PER_SUB - err;
+
+	if (aligned && (err <= HEX_PHASE_SLACK))
+	{
+		if ((uint16_t)err > phaseMax)
+			phaseMax = err;
+		if (good < 0xFF)
+			++good;
+		return;
+	}
+
+	if (aligned && (err > phaseMax))
+		phaseMax = (err > 0xFFFF) ? 0xFFFF : err;
+	TCNT1 = (at + HEX_32K_PER_SUB - 1) % HEX_32K_PER_SUB;
+	TIFR1 = _BV(OCF1A);
+	sub = at / HEX_32K_PER_SUB;
+	aligned = true;
+	good = 0;
+	lastUnitAt = 0;		// The gap across a resync doesn't count
+	if (syncs < 0xFFFF)
+		++syncs;
+}
+
+// 1/16 units since midnight
+uint32_t HexTime::now()
+{
+	uint32_t s;
+
+	noInterrupts();
+	s = sub;
+	interrupts();
+	return s;
+}
+
+// The task has the unit tick. Times how long it took to get there
+void HexTime::serviced()
+{
+	unsigned long late;
+
+	noInterrupts();
+	if (!waiting)
+	{
+		interrupts();
+		return;
+	}
+	waiting = false;
+	late = micros() - tickAt;
+	interrupts();
+
+	if (lateCount < 0xFFFF)
+	{
+		++lateCount;
+		lateTotal += late;
+	}
+	if (late > lateMax)
+		lateMax = late;
+}
+
+void HexTime::reset()
+{
+	noInterrupts();
+	lastUnitAt = 0;
+	interrupts();
+	gapMin = 0xFFFFFFFFUL;
+	gapMax = 0;
+	units = syncs = phaseMax = 0;
+	lateTotal = 0;
+	lateCount = 0;
+	lateMax = 0;
+}
+
+/*
+Print one line of the report. Phase is in 32kHz clocks (30.5us), the rest in us
+	hex lock 1 syncs 1 units 45
+	hex phase max 0
+	hex gap min 1318357 max 1318362
+	hex late avg 96 max 410
+Returns false once there are no more lines
+*/
+bool HexTime::printLine(Print *out, uint8_t line)
+{
+	switch (line)
+	{
+	case 0:
+		out->print(F("hex lock "));
+		out->print(locked() ? 1 : 0);
+		out->print(F(" syncs "));
+		out->print(syncs);
+		out->print(F(" units "));
+		out->println(units);
+		return true;
+	case 1:
+		out->print(F("hex phase max "));
+		out->println(phaseMax);
+		return true;
+	case 2:
+		out->print(F("hex gap min "));
+		out->print(units ? gapMin : 0);
+		out->print(F(" max "));
+		out->println(gapMax);
+		return true;
+	case 3:
+		out->print(F("hex late avg "));
+		out->print(lateCount ? lateTotal / lateCount : 0);
+		out->print(F(" max "));
+		out->println(lateMax);
+		return true;
+	}
+	return false;
+}
@@ -0,0 +1,93 @@
+// HexTime.h
+// Hexadecimal day time: the day split into 0x10000 units of about 1.318s, timed off the DS3231's 32kHz output
+
+#ifndef _HEXTIME_h
+#define _HEXTIME_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include <ds3231.h>
+
+#ifndef DS3231_EN32KHZ
+#define DS3231_EN32KHZ			0x08	// Status register: 32kHz output on
+#endif
+
+/*
+86400s of 32768Hz is exactly 2^20 * 2700 clocks, so a sixteenth of a hex unit is a whole number of 32kHz clocks and
+the hex day never has to be rounded to whole seconds. Timer1 counts the 32kHz pin (T1) and interrupts every
+HEX_32K_PER_SUB clocks. The RTC's 1Hz edges keep its phase honest: each one is checked against where the timer should
+be for that second, and the timer is put right if it's out.
+*/
+#define HEX_32K_PIN				5		// Timer1 clock input (T1). Wired to the DS3231 32K pin, which is open drain
+#define HEX_32K_PER_SEC			32768UL
+#define HEX_32K_PER_SUB			2700	// 32kHz clocks per 1/16 unit
+#define HEX_SUBS_PER_DAY		0x100000UL
+#define HEX_SUBS_PER_UNIT		16
+#define HEX_PHASE_SLACK			16		// Clocks (30.5us) the timer can read out at a 1Hz edge and still be in step. Covers the edge interrupt running late
+#define HEX_PROGRESS			1		// 1 = show the 1/16 units in the binary seconds row, updated on every one
+#define HEX_REPORT_LINE			40		// Longest line printLine() writes
+
+// What a timer interrupt changed
+#define HEX_TICK_NONE			0
+#define HEX_TICK_PROGRESS		1		// Just the 1/16 unit
+#define HEX_TICK_UNIT			2		// The hex digits
+
+/*
+The timer only counts as locked once a 1Hz edge has found it in step. Until then (or if the 32kHz line isn't
+connected, so the timer never moves) the face works the hex time out from the RTC seconds instead, which is right to
+a second and a bit, and the report says it isn't locked.
+The jitter report covers the timer against the RTC (phase), the time between unit interrupts (gap), and interrupt to
+the task picking the tick up (late). Interrupt to digits on the glass is in the tick latency report (Latency.h),
+which follows the hex ticks while the timer is locked.
+*/
+class HexTime
+{
+public:
+	HexTime();
+	void begin();
+	void end();
+	bool isRunning() { return running; }
+	bool locked() { return running && (good != 0); }
+	uint8_t tick();
+	void edge();
+	uint8_t getEdges() { return edges; }
+	void expect(uint32_t secOfDay, uint8_t edgesBefore);
+	uint32_t now();
+	unsigned long getTickAt() { return tickAt; }
+	void serviced();
+	void reset();
+	bool printLine(Print *out, uint8_t line);
+	uint16_t getUnits() { return units; }
+	unsigned long getGapMin() { return gapMin; }
+	unsigned long getGapMax() { return gapMax; }
+	uint16_t getPhaseMax() { return phaseMax; }
+	unsigned long getLateMax() { return lateMax; }
+	static uint32_t fromSeconds(uint32_t secOfDay) { return secOfDay * HEX_32K_PER_SEC / HEX_32K_PER_SUB; }
+
+private:
+	volatile uint32_t sub;				// 1/16 units since midnight
+	volatile uint8_t edges;				// 1Hz edges seen. Tells expect() whether one came in during an RTC read
+	volatile bool armed;				// nextSec is the second starting at the next edge
+	volatile uint8_t good;				// 1Hz edges in a row that found the timer in step
+	volatile bool waiting;				// A unit tick the task hasn't picked up yet
+	uint32_t nextSec;
+	bool aligned;						// Timer has been set from the RTC at least once
+	bool running;
+
+	// Jitter statistics
+	volatile unsigned long tickAt;		// micros() at the last unit tick
+	unsigned long lastUnitAt;
+	unsigned long gapMin, gapMax;		// Between unit ticks (us)
+	uint16_t units;						// Unit ticks timed
+	uint16_t syncs;						// Times the timer was set from the RTC
+	uint16_t phaseMax;					// Worst timer phase found at a 1Hz edge, in 32kHz clocks (30.5us)
+	uint32_t lateTotal;
+	uint16_t lateCount;
+	unsigned long lateMax;				// Unit tick to the task picking it up (us)
+};
+
+#endif // _HEXTIME_h
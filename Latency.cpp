@@ -0,0 +1,126 @@
+/*
+Latency.cpp
+Tick-to-photon latency.
+The RA8875 puts whatever is in its display RAM on the glass on its next scan, so the end of the last SPI write for a
+second is as close to "on the screen" as the clock can see.
+*/
+
+#include "Latency.h"
+
+TickLatency::TickLatency()
+{
+	reset();
+}
+
+void TickLatency::reset()
+{
+	uint8_t i;
+
+	noInterrupts();
+	pending = false;
+	missed = 0;
+	interrupts();
+	for (i = 0; i < LAT_BINS; ++i)
+		bins[i] = 0;
+	count = 0;
+	frameMax = secondsMax = 0;
+	secondsTotal = 0;
+}
+
+// Tick interrupt. Keeps the earliest tick if the last one hasn't been drawn yet
+void TickLatency::edge(unsigned long us)
+{
+	if (pending)
+	{
+		++missed;
+		return;
+	}
+	edgeAt = us;
+	pending = true;
+}
+
+// The tick waiting isn't going to be drawn. Neither measured nor missed
+void TickLatency::skip()
+{
+	noInterrupts();
+	pending = false;
+	interrupts();
+}
+
+// Redraw finished. Charges it to the tick waiting for it, if there is one
+void TickLatency::frameDone(unsigned long secondsAt)
+{
+	unsigned long now = micros(), at, frame, seconds;
+	uint8_t bin;
+
+	noInterrupts();
+	if (!pending)
+	{
+		interrupts();
+		return;
+	}
+	at = edgeAt;
+	pending = false;
+	interrupts();
+
+	frame = now - at;
+	seconds = ((long)(secondsAt - at) < 0) ? frame : secondsAt - at;	// Seconds weren't drawn this time round
+
+	bin = (frame / LAT_BIN_US < LAT_BINS) ? frame / LAT_BIN_US : LAT_BINS - 1;
+	if (bins[bin] < 0xFFFF)
+		++bins[bin];
+	if (count < 0xFFFF)
+	{
+		++count;
+		secondsTotal += seconds;
+	}
+	if (frame > frameMax)
+		frameMax = frame;
+	if (seconds > secondsMax)
+		secondsMax = seconds;
+}
+
+/*
+Print one line of the report. Times are in us, bins are labelled with their upper end in ms
+	lat ticks 600 missed 0
+	lat secs avg 2210 max 2304
+	lat frame max 9120
+	lat <4 593
+Empty bins are skipped. Returns false once there are no more lines
+*/
+bool TickLatency::printLine(Print *out, uint8_t line)
+{
+	uint8_t bin;
+
+	switch (line)
+	{
+	case 0:
+		out->print(F("lat ticks "));
+		out->print(count);
+		out->print(F(" missed "));
+		out->println(missed);
+		return true;
+	case 1:
+		out->print(F("lat secs avg "));
+		out->print(count ? secondsTotal / count : 0);
+		out->print(F(" max "));
+		out->println(secondsMax);
+		return true;
+	case 2:
+		out->print(F("lat frame max "));
+		out->println(frameMax);
+		return true;
+	}
+
+	bin = line - 3;
+	if (bin >= LAT_BINS)
+		return false;
+	if (bins[bin])
+	{
+		out->print((bin == LAT_BINS - 1) ? F("lat >") : F("lat <"));
+		out->print((unsigned long)(bin + ((bin == LAT_BINS - 1) ? 0 : 1)) * LAT_BIN_US / 1000);
+		out->print(' ');
+		out->println(bins[bin]);
+	}
+	return true;
+}
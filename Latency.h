@@ -0,0 +1,49 @@
+// Latency.h
+// Tick-to-photon latency: RTC second edge to the clock face showing the new second
+
+#ifndef _LATENCY_h
+#define _LATENCY_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#define LAT_BINS			16		// Histogram bins. The last one also takes everything past the end
+#define LAT_BIN_US			2000	// Width of each bin (us)
+#define LAT_REPORT_LINE		32		// Longest line printLine() writes
+
+/*
+Times each RTC tick through to the end of the redraw it caused
+edge() is called from the tick interrupt with micros(). frameDone() is called once the redraw has finished sending
+to the display, with the time the seconds digits went out. Each tick is measured once; a tick that comes in before
+the last one was drawn counts as missed. A tick that's left undrawn on purpose (the seconds are hidden while the
+face is dimmed, Power.h) is let go with skip().
+*/
+class TickLatency
+{
+public:
+	TickLatency();
+	void edge(unsigned long us);
+	void frameDone(unsigned long secondsAt);
+	void skip();
+	void reset();
+	bool printLine(Print *out, uint8_t line);
+	uint16_t getCount() { return count; }
+	uint16_t getMissed() { return missed; }
+	unsigned long getSecondsMax() { return secondsMax; }
+	unsigned long getSecondsAvg() { return count ? secondsTotal / count : 0; }
+
+private:
+	volatile unsigned long edgeAt;	// micros() at the tick still waiting for its redraw
+	volatile bool pending;			// A tick is waiting for its redraw
+	volatile uint16_t missed;		// Ticks that came in before the last one was drawn
+	uint16_t bins[LAT_BINS];		// Tick to end of redraw
+	uint16_t count;					// Ticks measured
+	unsigned long frameMax;			// Longest tick to end of redraw (us)
+	unsigned long secondsMax;		// Longest tick to seconds digits drawn (us)
+	uint32_t secondsTotal;			// For the average
+};
+
+#endif // _LATENCY_h
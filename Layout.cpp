@@ -0,0 +1,31 @@
+/*
+Layout.cpp
+Screen positions of the clock face's digits, colons & slashes.
+Worked out by the compiler from the panel's measurements in Layout.h and kept in flash, so a digit only carries its
+cell ID and drawing it is a table lookup.
+*/
+
+#include "Layout.h"
+#include "ClockDigit.h"
+
+const layoutCell_t layoutCells[LAYOUT_CELLS] PROGMEM =
+{
+	{ X_TIMEHOURHIGH,	Y_TIME_UPPER,	X_BINTIME,							Y_BIN_1 },	// HRHIGH
+	{ X_TIMEHOURLOW,	Y_TIME_UPPER,	X_BINTIME + X_BIN_OFFSET_LOW,		Y_BIN_1 },	// HRLOW
+	{ X_TIMEMINUTEHIGH,	Y_TIME_UPPER,	X_BINTIME,							Y_BIN_2 },	// MNHIGH
+	{ X_TIMEMINUTELOW,	Y_TIME_UPPER,	X_BINTIME + X_BIN_OFFSET_LOW,		Y_BIN_2 },	// MNLOW
+	{ X_TIMESECONDHIGH,	Y_TIME_UPPER,	X_BINTIME,							Y_BIN_3 },	// SEHIGH
+	{ X_TIMESECONDLOW,	Y_TIME_UPPER,	X_BINTIME + X_BIN_OFFSET_LOW,		Y_BIN_3 },	// SELOW
+	{ X_DATEDAYHIGH,	Y_DATE_UPPER,	X_BINDATE,							Y_BIN_2 },	// DYHIGH
+	{ X_DATEDAYLOW,		Y_DATE_UPPER,	X_BINDATE + X_BIN_OFFSET_LOW,		Y_BIN_2 },	// DYLOW
+	{ X_DATEMONTHHIGH,	Y_DATE_UPPER,	X_BINDATE,							Y_BIN_1 },	// MOHIGH
+	{ X_DATEMONTHLOW,	Y_DATE_UPPER,	X_BINDATE + X_BIN_OFFSET_LOW,		Y_BIN_1 },	// MOLOW
+	{ X_DATEYEARHIGH,	Y_DATE_UPPER,	X_BINDATE,							Y_BIN_3 },	// YRHIGH
+	{ X_DATEYEARLOW,	Y_DATE_UPPER,	X_BINDATE + X_BIN_OFFSET_LOW,		Y_BIN_3 },	// YRLOW
+	{ X_COLON1,			Y_TIME_UPPER,	0,									0 },		// COLON1
+	{ X_COLON2,			Y_TIME_UPPER,	0,									0 },		// COLON2
+	{ X_SLASH1,			Y_DATE_UPPER,	0,									0 },		// SLASH1
+	{ X_SLASH2,			Y_DATE_UPPER,	0,									0 },		// SLASH2
+};
+
+static_assert(SLASH2 + 1 == LAYOUT_CELLS, "Layout.cpp: a cell ID without a place in the table");
@@ -0,0 +1,392 @@
+// Layout.h
+// Where everything goes on the screen, for the panel the clock is built for
+
+#ifndef _LAYOUT_h
+#define _LAYOUT_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+/*
+Panels
+Pick the panel here, or on the build with -DLAYOUT_PANEL=n. Each panel gives a handful of measurements - digit cell
+size, row positions, the gaps between groups, font scales - and every position on the clock face is worked out from
+them at compile time (below). The setup screen's controls don't fall on a grid, so each panel lists them.
+*/
+#define PANEL_800x480		0		// 7" RA8875 panels
+#define PANEL_480x272		1		// 4.3" RA8875 panels
+
+#ifndef LAYOUT_PANEL
+#define LAYOUT_PANEL		PANEL_800x480
+#endif
+
+#if LAYOUT_PANEL == PANEL_800x480
+
+#define PANEL_SIZE			Adafruit_800x480	// For RA8875::begin()
+#define PANEL_WIDTH			800
+#define PANEL_HEIGHT		480
+
+// Big digits: MSTahomaBold48 at 3x
+#define HEXFONTSIZE			2
+#define W_LARGEDIGIT		96
+#define H_LARGEDIGIT		105
+#define W_COLON				21
+#define W_SLASH				50
+#define SEP_INSET			5		// Colon/slash start this far into the gap between digit pairs
+#define X_TIME_LEFT			55
+#define TIME_GAP			30		// Added to W_COLON between digit pairs
+#define Y_TIME_LOWER		125
+#define X_DATE_LEFT			25
+#define DATE_GAP			35		// Added to W_SLASH between digit pairs
+#define Y_DATE_LOWER		260
+
+// Binary rows: internal font at 4x
+#define BINFONTSIZE			3
+#define X_BINTIME			131		// Starting Column for Binary Time
+#define X_BINDATE			478		// Starting Columns for Binary Date
+#define X_BIN_OFFSET_LOW	128		// Low digit's bits, from the high digit's
+#define Y_BIN_1				280		// First row of binary displays
+#define H_BINROW			62		// Row to row
+#define X_BIN_TIMELABEL		68		// Starting Column for Binary Time Label
+#define X_BIN_DATELABEL		415		// Starting Column for Binary Date Label
+
+// AM/PM dots, left of the hours
+#define AMPM_INSET			20
+#define AMPM_DOTSIZE		7
+
+// Alarm mark, left of the bottom binary row
+#define ALARMFONTSIZE		1
+#define X_ALARMMARK			8
+#define Y_ALARMMARK			418
+#define W_ALARMMARK			52
+#define H_ALARMMARK			36
+#define DX_ALARMTEXT		2
+#define DY_ALARMTEXT		2
+
+// Setup screen
+#define SETUPFONTSIZE		0
+#define SETUP_DONEFONTSIZE	1
+#define X_COLOR1	175
+#define X_COLOR2	250
+#define X_COLOR3	325
+#define X_COLOR4	400
+#define X_COLOR5	475
+#define X_COLOR6	550
+#define X_COLOR7	625
+#define X_COLOR8	700
+#define Y_COLOR_FG	290
+#define Y_COLOR_BG	355
+#define W_COLOR		50
+#define H_COLOR		30
+#define X_BASE		170
+#define Y_BASE		420
+#define W_BASE		50
+#define H_BASE		30
+#define X_RESET1	505
+#define X_RESET2	555
+#define X_RESET3	605
+#define Y_RESET		420
+#define W_RESET		40
+#define H_RESET		30
+#define X_DONE		660
+#define Y_DONE		405
+#define W_DONE		90
+#define H_DONE		50
+#define X_DISPLAY	310
+#define Y_DISPLAY	420
+#define W_DISPLAY	50
+#define H_DISPLAY	30
+#define X_ROTATE	372
+#define Y_ROTATE	420
+#define W_ROTATE	55
+#define H_ROTATE	30
+
+// Keypad, in place of the setup controls while a field is being typed in
+#define X_KEYPAD	50
+#define Y_KEYPAD	300
+#define W_KEY		90
+#define H_KEY		64
+#define KEY_GAP		10
+
+// Color picker, in place of the setup controls: H, S & V sliders on the left, the preview & its keys on the right
+#define X_SLIDER		50
+#define Y_SLIDER		290
+#define W_SLIDER		512		// 2 pixels a step
+#define H_SLIDER		36
+#define H_KNOB			10		// Strip under each slider the knob runs along
+#define W_KNOB			8
+#define SLIDER_PITCH	62		// Slider to slider
+#define SLIDERFONTSIZE	1
+#define X_SLIDERLABEL	22
+#define DY_SLIDERTEXT	7		// H, S & V, centred on the slider & its strip
+#define X_PREVIEW		600
+#define Y_PREVIEW		290
+#define W_PREVIEW		160
+#define H_PREVIEW		98
+#define PREVIEWFONTSIZE	3		// Sample digit, 32x64
+#define DX_PREVIEWTEXT	64
+#define DY_PREVIEWTEXT	17
+#define X_PICKESC		600
+#define X_PICKSET		690
+#define Y_PICKKEY		414
+#define W_PICKKEY		70
+#define H_PICKKEY		46
+
+// Button text, from the button's corner
+#define DX_TOGGLETEXT	12		// HEX/DEC, 24H/12H
+#define DY_TOGGLETEXT	6
+#define DX_ROTATETEXT	3
+#define DY_ROTATETEXT	6
+#define DX_RESETTEXT	7
+#define DY_RESETTEXT	5
+#define DX_DONETEXT		7
+#define DY_DONETEXT		5
+
+// X,Y coordinates for configuration button labels
+#define X_FOREBACKBASE_LABEL	60
+#define Y_FORELABEL				295
+#define Y_BACKLABEL				360
+#define Y_BASELABEL				425
+#define X_RESETLABEL			440
+#define Y_RESETLABEL			425
+#define X_DISPLAYLABEL			230
+#define Y_DISPLAYLABEL			425
+
+#elif LAYOUT_PANEL == PANEL_480x272
+
+#define PANEL_SIZE			Adafruit_480x272
+#define PANEL_WIDTH			480
+#define PANEL_HEIGHT		272
+
+// Big digits at 2x. The slashes are wider than the gap they sit in and overlap the digits' blank edges a little
+#define HEXFONTSIZE			1
+#define W_LARGEDIGIT		62
+#define H_LARGEDIGIT		78
+#define W_COLON				14
+#define W_SLASH				30
+#define SEP_INSET			1
+#define X_TIME_LEFT			18
+#define TIME_GAP			22
+#define Y_TIME_LOWER		82
+#define X_DATE_LEFT			2
+#define DATE_GAP			22
+#define Y_DATE_LOWER		166
+
+// Binary rows at 2x
+#define BINFONTSIZE			1
+#define X_BINTIME			77
+#define X_BINDATE			303
+#define X_BIN_OFFSET_LOW	72
+#define Y_BIN_1				172
+#define H_BINROW			33
+#define X_BIN_TIMELABEL		41
+#define X_BIN_DATELABEL		267
+
+#define AMPM_INSET			11
+#define AMPM_DOTSIZE		5
+
+#define ALARMFONTSIZE		0
+#define X_ALARMMARK			4
+#define Y_ALARMMARK			240
+#define W_ALARMMARK			28
+#define H_ALARMMARK			20
+#define DX_ALARMTEXT		2
+#define DY_ALARMTEXT		2
+
+// Setup screen. Two rows of colors, then the toggles, then reset, with "Done!" on the right of both
+#define SETUPFONTSIZE		0
+#define SETUP_DONEFONTSIZE	1
+#define X_COLOR1	104
+#define X_COLOR2	150
+#define X_COLOR3	196
+#define X_COLOR4	242
+#define X_COLOR5	288
+#define X_COLOR6	334
+#define X_COLOR7	380
+#define X_COLOR8	426
+#define Y_COLOR_FG	172
+#define Y_COLOR_BG	196
+#define W_COLOR		38
+#define H_COLOR		20
+#define X_BASE		106
+#define Y_BASE		222
+#define W_BASE		40
+#define H_BASE		20
+#define X_RESET1	60
+#define X_RESET2	100
+#define X_RESET3	140
+#define Y_RESET		246
+#define W_RESET		36
+#define H_RESET		22
+#define X_DONE		380
+#define Y_DONE		226
+#define W_DONE		90
+#define H_DONE		40
+#define X_DISPLAY	228
+#define Y_DISPLAY	222
+#define W_DISPLAY	40
+#define H_DISPLAY	20
+#define X_ROTATE	276
+#define Y_ROTATE	222
+#define W_ROTATE	56
+#define H_ROTATE	20
+
+#define X_KEYPAD	16
+#define Y_KEYPAD	176
+#define W_KEY		56
+#define H_KEY		40
+#define KEY_GAP		8
+
+#define X_SLIDER		28
+#define Y_SLIDER		178
+#define W_SLIDER		256
+#define H_SLIDER		20
+#define H_KNOB			6
+#define W_KNOB			6
+#define SLIDER_PITCH	31
+#define SLIDERFONTSIZE	0
+#define X_SLIDERLABEL	8
+#define DY_SLIDERTEXT	5
+#define X_PREVIEW		300
+#define Y_PREVIEW		178
+#define W_PREVIEW		120
+#define H_PREVIEW		54
+#define PREVIEWFONTSIZE	2		// 24x48
+#define DX_PREVIEWTEXT	48
+#define DY_PREVIEWTEXT	3
+#define X_PICKESC		300
+#define X_PICKSET		364
+#define Y_PICKKEY		238
+#define W_PICKKEY		56
+#define H_PICKKEY		32
+
+#define DX_TOGGLETEXT	8
+#define DY_TOGGLETEXT	2
+#define DX_ROTATETEXT	4
+#define DY_ROTATETEXT	2
+#define DX_RESETTEXT	6
+#define DY_RESETTEXT	3
+#define DX_DONETEXT		5
+#define DY_DONETEXT		4
+
+#define X_FOREBACKBASE_LABEL	0
+#define Y_FORELABEL				174
+#define Y_BACKLABEL				198
+#define Y_BASELABEL				224
+#define X_RESETLABEL			0
+#define Y_RESETLABEL			249
+#define X_DISPLAYLABEL			154
+#define Y_DISPLAYLABEL			224
+
+#else
+#error "Layout.h: unknown LAYOUT_PANEL"
+#endif
+
+/*
+The time & date rows
+Each row is three pairs of digits with a colon or slash in the gap between pairs. col counts digits, 0-5 left to
+right; sep counts the gaps, 0-1.
+*/
+constexpr int16_t layoutDigitX(int16_t left, int16_t sepW, int16_t gap, uint8_t col)
+{
+	return left + (col / 2) * (2 * W_LARGEDIGIT + sepW + gap) + (col % 2) * W_LARGEDIGIT;
+}
+
+constexpr int16_t layoutSepX(int16_t left, int16_t sepW, int16_t gap, uint8_t sep)
+{
+	return layoutDigitX(left, sepW, gap, sep * 2 + 1) + W_LARGEDIGIT + SEP_INSET;
+}
+
+// Large time row definitions
+#define X_TIMEHOURHIGH		layoutDigitX(X_TIME_LEFT, W_COLON, TIME_GAP, 0)	// High-order hour digit
+#define X_TIMEHOURLOW		layoutDigitX(X_TIME_LEFT, W_COLON, TIME_GAP, 1)	// Low-order hour digit
+#define X_TIMEMINUTEHIGH	layoutDigitX(X_TIME_LEFT, W_COLON, TIME_GAP, 2)	// High-order minute digit
+#define X_TIMEMINUTELOW		layoutDigitX(X_TIME_LEFT, W_COLON, TIME_GAP, 3)	// Low-order minute digit
+#define X_TIMESECONDHIGH	layoutDigitX(X_TIME_LEFT, W_COLON, TIME_GAP, 4)	// High-order second digit
+#define X_TIMESECONDLOW		layoutDigitX(X_TIME_LEFT, W_COLON, TIME_GAP, 5)	// Low-order second digit
+#define X_COLON1			layoutSepX(X_TIME_LEFT, W_COLON, TIME_GAP, 0)	// Hour:minute colon
+#define X_COLON2			layoutSepX(X_TIME_LEFT, W_COLON, TIME_GAP, 1)	// Minute:second colon
+#define Y_TIME_UPPER		(Y_TIME_LOWER - H_LARGEDIGIT)					// Upper Y of time row
+#define Y_TIME_MID			(Y_TIME_LOWER - (H_LARGEDIGIT / 2))				// Midpoint Y of time row
+
+// Large date row definitions
+#define X_DATEMONTHHIGH		layoutDigitX(X_DATE_LEFT, W_SLASH, DATE_GAP, 0)	// High-order month digit
+#define X_DATEMONTHLOW		layoutDigitX(X_DATE_LEFT, W_SLASH, DATE_GAP, 1)	// Low-order month digit
+#define X_DATEDAYHIGH		layoutDigitX(X_DATE_LEFT, W_SLASH, DATE_GAP, 2)	// High-order day digit
+#define X_DATEDAYLOW		layoutDigitX(X_DATE_LEFT, W_SLASH, DATE_GAP, 3)	// Low-order day digit
+#define X_DATEYEARHIGH		layoutDigitX(X_DATE_LEFT, W_SLASH, DATE_GAP, 4)	// High-order year digit
+#define X_DATEYEARLOW		layoutDigitX(X_DATE_LEFT, W_SLASH, DATE_GAP, 5)	// Low-order year digit
+#define X_SLASH1			layoutSepX(X_DATE_LEFT, W_SLASH, DATE_GAP, 0)	// Month/day slash
+#define X_SLASH2			layoutSepX(X_DATE_LEFT, W_SLASH, DATE_GAP, 1)	// Day/year slash
+#define Y_DATE_UPPER		(Y_DATE_LOWER - H_LARGEDIGIT)					// Upper Y of date row
+#define Y_DATE_MID			(Y_DATE_LOWER - (H_LARGEDIGIT / 2))				// Midpoint Y of date row
+
+/*
+Setup keypad
+Keys go left to right, KEYS_PER_ROW to a row: the digits, then Del, Esc and Set. Their labels are the internal font
+at 2x, centred. Y_CONTROLS is the top of the area under the date row that the keypad, the color picker and the setup
+buttons take turns in. The picker's sliders run 0-255 across W_SLIDER, so make it a multiple of 256.
+*/
+#define KEYS_PER_ROW		7
+#define KEYFONTSIZE			1
+#define W_KEYCHAR			16
+#define H_KEYCHAR			32
+#define Y_CONTROLS			(Y_DATE_LOWER + 2)
+
+constexpr int16_t layoutKeyX(uint8_t key)
+{
+	return X_KEYPAD + (key % KEYS_PER_ROW) * (W_KEY + KEY_GAP);
+}
+
+constexpr int16_t layoutKeyY(uint8_t key)
+{
+	return Y_KEYPAD + (key / KEYS_PER_ROW) * (H_KEY + KEY_GAP);
+}
+
+// Binary rows: hours/months, minutes/days, seconds/years
+#define Y_BIN_2				(Y_BIN_1 + H_BINROW)
+#define Y_BIN_3				(Y_BIN_2 + H_BINROW)
+
+// X/Y Coordinates for AM/PM indicators
+#define X_AMPM		(X_TIMEHOURHIGH - AMPM_INSET)
+#define Y_AM		(Y_TIME_UPPER + ((Y_TIME_MID - Y_TIME_UPPER)/2))
+#define Y_PM		(Y_TIME_MID + ((Y_TIME_LOWER - Y_TIME_MID)/2))
+
+static_assert(X_TIMESECONDLOW + W_LARGEDIGIT <= PANEL_WIDTH, "Layout.h: time row is wider than the panel");
+static_assert(X_DATEYEARLOW + W_LARGEDIGIT <= PANEL_WIDTH, "Layout.h: date row is wider than the panel");
+static_assert(X_AMPM - AMPM_DOTSIZE >= 0, "Layout.h: AM/PM dots are off the left of the panel");
+static_assert(X_ALARMMARK + W_ALARMMARK <= X_BIN_TIMELABEL, "Layout.h: alarm mark runs into the binary labels");
+static_assert(Y_KEYPAD >= Y_CONTROLS, "Layout.h: keypad runs into the date row");
+static_assert(layoutKeyX(KEYS_PER_ROW - 1) + W_KEY <= PANEL_WIDTH, "Layout.h: keypad is wider than the panel");
+static_assert(layoutKeyY(12) + H_KEY <= PANEL_HEIGHT, "Layout.h: keypad's last key (Set) is off the bottom of the panel");
+static_assert(Y_SLIDER >= Y_CONTROLS, "Layout.h: color picker runs into the date row");
+static_assert(Y_SLIDER + 2 * SLIDER_PITCH + H_SLIDER + H_KNOB <= PANEL_HEIGHT, "Layout.h: color picker's V slider is off the bottom of the panel");
+static_assert(X_SLIDER + W_SLIDER + W_KNOB / 2 < X_PREVIEW, "Layout.h: color picker's sliders run into the preview");
+static_assert(Y_PREVIEW + H_PREVIEW < Y_PICKKEY, "Layout.h: color picker's preview runs into its keys");
+static_assert(X_PICKSET + W_PICKKEY <= PANEL_WIDTH, "Layout.h: color picker's Set key is off the panel");
+static_assert(Y_PICKKEY + H_PICKKEY <= PANEL_HEIGHT, "Layout.h: color picker's keys are off the bottom of the panel");
+
+/*
+Cells
+Every digit, colon and slash on the face has a cell: where its big character goes, and where its bits go in the
+binary rows. The table is in flash, indexed by the cell ID (ClockDigit.h).
+*/
+typedef struct
+{
+	int16_t x, y;			// Big character's top left
+	int16_t binX, binY;		// Bits' top left. Unused for colons & slashes
+} layoutCell_t;
+
+#define LAYOUT_CELLS		16
+
+extern const layoutCell_t layoutCells[LAYOUT_CELLS] PROGMEM;
+
+inline int16_t layoutX(uint8_t id) { return (int16_t)pgm_read_word(&layoutCells[id].x); }
+inline int16_t layoutY(uint8_t id) { return (int16_t)pgm_read_word(&layoutCells[id].y); }
+inline int16_t layoutBinX(uint8_t id) { return (int16_t)pgm_read_word(&layoutCells[id].binX); }
+inline int16_t layoutBinY(uint8_t id) { return (int16_t)pgm_read_word(&layoutCells[id].binY); }
+
+#endif // _LAYOUT_h
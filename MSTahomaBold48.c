@@ -1,216 +1,216 @@
-
-/*******************************************************************************
-
-* name: MSTahomaBold48
-* family: MSTahoma
-* size: 48
-* style: Bold
-* --------------------------------------
-* included characters:  /0123456789:ABCDEF
-* --------------------------------------
-* antialiasing: no
-* type: proportional
-* encoding: latin1
-* unicode bom: no
-*
-* data block size: 8 bit(s), uint8_t
-* RLE compression enabled: no
-* conversion type: Monochrome, Edge 128
-* bits per pixel: 1
-*
-* preprocess:
-*  main scan direction: top_to_bottom
-*  line scan direction: forward
-*  inverse: yes
-* ------------------------------------------------------------------------------
-* Created by a custom template of LCD-Image-Converter for .s.u.m.o.t.o.y. RA8875
-* Font template version: 2.0
-* Note: Font height should be fixed and all glyps must have the same height!
-* ------------------------------------------------------------------------------
-*******************************************************************************/
-
-
-
-#include <stdint.h>
-
-
-
-static const uint8_t image_data_MSTahomaBold48_0x20[69] __PRGMTAG_  = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};////character: ' '
-
-static const tImage MSTahomaBold48_0x20 __PRGMTAG_ = { image_data_MSTahomaBold48_0x20,
-    14, 69};//character: ' ' , height: 39, (charW,total bytes)
-
-static const uint8_t image_data_MSTahomaBold48_0x2f[137] __PRGMTAG_  = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xf0, 0x00, 0x00, 0x7e, 0x00, 0x00, 0x07, 0xe0, 0x00, 0x00, 0x7e, 0x00, 0x00, 0x0f, 0xc0, 0x00, 0x00, 0xfc, 0x00, 0x00, 0x0f, 0xc0, 0x00, 0x01, 0xf8, 0x00, 0x00, 0x1f, 0x80, 0x00, 0x01, 0xf8, 0x00, 0x00, 0x3f, 0x00, 0x00, 0x03, 0xf0, 0x00, 0x00, 0x3f, 0x00, 0x00, 0x07, 0xe0, 0x00, 0x00, 0x7e, 0x00, 0x00, 0x07, 0xe0, 0x00, 0x00, 0xfc, 0x00, 0x00, 0x0f, 0xc0, 0x00, 0x00, 0xfc, 0x00, 0x00, 0x1f, 0x80, 0x00, 0x01, 0xf8, 0x00, 0x00, 0x1f, 0x80, 0x00, 0x03, 0xf0, 0x00, 0x00, 0x3f, 0x00, 0x00, 0x03, 0xf0, 0x00, 0x00, 0x7e, 0x00, 0x00, 0x07, 0xe0, 0x00, 0x00, 0x7e, 0x00, 0x00, 0x0f, 0xc0, 0x00, 0x00, 0xfc, 0x00, 0x00, 0x0f, 0xc0, 0x00, 0x01, 0xf8, 0x00, 0x00, 0x1f, 0x80, 0x00, 0x01, 0xf8, 0x00, 0x00, 0x3f, 0x00, 0x00, 0x03, 0xf0, 0x00, 0x00, 0x3f, 0x00, 0x00, 0x07, 0xe0, 0x00, 0x00
-};////character: '/'
-
-static const tImage MSTahomaBold48_0x2f __PRGMTAG_ = { image_data_MSTahomaBold48_0x2f,
-    28, 137};//character: '/' , height: 39, (charW,total bytes)
-
-static const uint8_t image_data_MSTahomaBold48_0x30[152] __PRGMTAG_  = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x01, 0xff, 0xf0, 0x00, 0x0f, 0xff, 0xf8, 0x00, 0x3f, 0xff, 0xf8, 0x00, 0xff, 0xff, 0xf8, 0x01, 0xff, 0xff, 0xf0, 0x07, 0xfe, 0x3f, 0xf0, 0x0f, 0xf8, 0x3f, 0xe0, 0x3f, 0xe0, 0x3f, 0xe0, 0x7f, 0xc0, 0x7f, 0xc0, 0xff, 0x80, 0xff, 0x81, 0xfe, 0x00, 0xff, 0x07, 0xfc, 0x01, 0xff, 0x0f, 0xf8, 0x03, 0xfe, 0x1f, 0xf0, 0x07, 0xfc, 0x3f, 0xe0, 0x0f, 0xf8, 0x7f, 0xc0, 0x1f, 0xf0, 0xff, 0x80, 0x3f, 0xe1, 0xff, 0x00, 0x7f, 0xc3, 0xfe, 0x00, 0xff, 0x87, 0xfc, 0x01, 0xff, 0x0f, 0xf8, 0x03, 0xfe, 0x1f, 0xf0, 0x07, 0xfc, 0x3f, 0xe0, 0x0f, 0xf8, 0x7f, 0xc0, 0x1f, 0xf0, 0x7f, 0x80, 0x3f, 0xc0, 0xff, 0x80, 0xff, 0x81, 0xff, 0x01, 0xff, 0x03, 0xfe, 0x03, 0xfe, 0x03, 0xfe, 0x0f, 0xf8, 0x07, 0xfe, 0x3f, 0xf0, 0x07, 0xff, 0xff, 0xc0, 0x0f, 0xff, 0xff, 0x80, 0x0f, 0xff, 0xfe, 0x00, 0x0f, 0xff, 0xf8, 0x00, 0x07, 0xff, 0xc0, 0x00, 0x03, 0xfe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};////character: '0'
-
-static const tImage MSTahomaBold48_0x30 __PRGMTAG_ = { image_data_MSTahomaBold48_0x30,
-    31, 152};//character: '0' , height: 39, (charW,total bytes)
-
-static const uint8_t image_data_MSTahomaBold48_0x31[152] __PRGMTAG_  = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0xe0, 0x00, 0x00, 0x3f, 0xc0, 0x00, 0x00, 0xff, 0x80, 0x00, 0x03, 0xff, 0x00, 0x00, 0x1f, 0xfe, 0x00, 0x03, 0xff, 0xfc, 0x00, 0x07, 0xff, 0xf8, 0x00, 0x0f, 0xff, 0xf0, 0x00, 0x1f, 0xff, 0xe0, 0x00, 0x3f, 0xff, 0xc0, 0x00, 0x7f, 0xff, 0x80, 0x00, 0x01, 0xff, 0x00, 0x00, 0x03, 0xfe, 0x00, 0x00, 0x07, 0xfc, 0x00, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0x1f, 0xf0, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x7f, 0xc0, 0x00, 0x00, 0xff, 0x80, 0x00, 0x01, 0xff, 0x00, 0x00, 0x03, 0xfe, 0x00, 0x00, 0x07, 0xfc, 0x00, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0x1f, 0xf0, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x7f, 0xc0, 0x00, 0x00, 0xff, 0x80, 0x00, 0x01, 0xff, 0x00, 0x00, 0x03, 0xfe, 0x00, 0x03, 0xff, 0xff, 0xf8, 0x07, 0xff, 0xff, 0xf0, 0x0f, 0xff, 0xff, 0xe0, 0x1f, 0xff, 0xff, 0xc0, 0x3f, 0xff, 0xff, 0x80, 0x7f, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};////character: '1'
-
-static const tImage MSTahomaBold48_0x31 __PRGMTAG_ = { image_data_MSTahomaBold48_0x31,
-    31, 152};//character: '1' , height: 39, (charW,total bytes)
-
-static const uint8_t image_data_MSTahomaBold48_0x32[152] __PRGMTAG_  = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x07, 0xff, 0xf8, 0x00, 0x3f, 0xff, 0xf8, 0x00, 0x7f, 0xff, 0xf8, 0x00, 0xff, 0xff, 0xf8, 0x01, 0xff, 0xff, 0xf8, 0x03, 0xff, 0xff, 0xf0, 0x07, 0xe0, 0xff, 0xf0, 0x0e, 0x00, 0x7f, 0xe0, 0x10, 0x00, 0xff, 0xc0, 0x00, 0x00, 0xff, 0x80, 0x00, 0x01, 0xff, 0x00, 0x00, 0x03, 0xfe, 0x00, 0x00, 0x07, 0xfc, 0x00, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x7f, 0xc0, 0x00, 0x01, 0xff, 0x00, 0x00, 0x03, 0xfe, 0x00, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0x3f, 0xf0, 0x00, 0x00, 0xff, 0xc0, 0x00, 0x03, 0xff, 0x00, 0x00, 0x0f, 0xfc, 0x00, 0x00, 0x3f, 0xf0, 0x00, 0x00, 0xff, 0xc0, 0x00, 0x03, 0xff, 0x00, 0x00, 0x0f, 0xfc, 0x00, 0x00, 0x3f, 0xf0, 0x00, 0x00, 0xff, 0x80, 0x00, 0x07, 0xff, 0xff, 0xfe, 0x0f, 0xff, 0xff, 0xfc, 0x1f, 0xff, 0xff, 0xf8, 0x3f, 0xff, 0xff, 0xf0, 0x7f, 0xff, 0xff, 0xe0, 0xff, 0xff, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};////character: '2'
-
-static const tImage MSTahomaBold48_0x32 __PRGMTAG_ = { image_data_MSTahomaBold48_0x32,
-    31, 152};//character: '2' , height: 39, (charW,total bytes)
-
-static const uint8_t image_data_MSTahomaBold48_0x33[152] __PRGMTAG_  = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xe0, 0x00, 0x1f, 0xff, 0xf8, 0x00, 0xff, 0xff, 0xfc, 0x01, 0xff, 0xff, 0xfc, 0x03, 0xff, 0xff, 0xfc, 0x07, 0xff, 0xff, 0xf8, 0x0f, 0xff, 0xff, 0xf8, 0x1f, 0xc0, 0x7f, 0xf0, 0x3c, 0x00, 0x7f, 0xe0, 0x60, 0x00, 0x7f, 0xc0, 0x00, 0x00, 0xff, 0x80, 0x00, 0x01, 0xff, 0x00, 0x00, 0x03, 0xfc, 0x00, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0x7f, 0xe0, 0x00, 0x3f, 0xff, 0x80, 0x00, 0x7f, 0xfe, 0x00, 0x00, 0xff, 0xf0, 0x00, 0x01, 0xff, 0xf8, 0x00, 0x03, 0xff, 0xfc, 0x00, 0x07, 0xff, 0xfc, 0x00, 0x00, 0x1f, 0xfc, 0x00, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0x1f, 0xf0, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x7f, 0xc3, 0x00, 0x01, 0xff, 0x87, 0x80, 0x03, 0xff, 0x0f, 0xe0, 0x1f, 0xfc, 0x1f, 0xff, 0xff, 0xf8, 0x3f, 0xff, 0xff, 0xe0, 0x7f, 0xff, 0xff, 0xc0, 0xff, 0xff, 0xff, 0x01, 0xff, 0xff, 0xf8, 0x00, 0xff, 0xff, 0xc0, 0x00, 0x1f, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};////character: '3'
-
-static const tImage MSTahomaBold48_0x33 __PRGMTAG_ = { image_data_MSTahomaBold48_0x33,
-    31, 152};//character: '3' , height: 39, (charW,total bytes)
-
-static const uint8_t image_data_MSTahomaBold48_0x34[152] __PRGMTAG_  = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0xfe, 0x00, 0x00, 0x0f, 0xfc, 0x00, 0x00, 0x3f, 0xf8, 0x00, 0x00, 0xff, 0xf0, 0x00, 0x01, 0xff, 0xe0, 0x00, 0x07, 0xff, 0xc0, 0x00, 0x1f, 0xff, 0x80, 0x00, 0x7f, 0xff, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x03, 0xf7, 0xfc, 0x00, 0x0f, 0xcf, 0xf8, 0x00, 0x1f, 0x1f, 0xf0, 0x00, 0x7e, 0x3f, 0xe0, 0x01, 0xf8, 0x7f, 0xc0, 0x07, 0xe0, 0xff, 0x80, 0x0f, 0xc1, 0xff, 0x00, 0x3f, 0x03, 0xfe, 0x00, 0xfc, 0x07, 0xfc, 0x01, 0xf8, 0x0f, 0xf8, 0x07, 0xe0, 0x1f, 0xf0, 0x1f, 0x80, 0x3f, 0xe0, 0x3f, 0xff, 0xff, 0xfe, 0x7f, 0xff, 0xff, 0xfc, 0xff, 0xff, 0xff, 0xf9, 0xff, 0xff, 0xff, 0xf3, 0xff, 0xff, 0xff, 0xe7, 0xff, 0xff, 0xff, 0xc0, 0x00, 0x1f, 0xf0, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x7f, 0xc0, 0x00, 0x00, 0xff, 0x80, 0x00, 0x01, 0xff, 0x00, 0x00, 0x03, 0xfe, 0x00, 0x00, 0x07, 0xfc, 0x00, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};////character: '4'
-
-static const tImage MSTahomaBold48_0x34 __PRGMTAG_ = { image_data_MSTahomaBold48_0x34,
-    31, 152};//character: '4' , height: 39, (charW,total bytes)
-
-static const uint8_t image_data_MSTahomaBold48_0x35[152] __PRGMTAG_  = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0xff, 0xff, 0xc0, 0x3f, 0xff, 0xff, 0x80, 0x7f, 0xff, 0xff, 0x00, 0xff, 0xff, 0xfe, 0x01, 0xff, 0xff, 0xfc, 0x03, 0xff, 0xff, 0xf8, 0x07, 0xf8, 0x00, 0x00, 0x0f, 0xf0, 0x00, 0x00, 0x1f, 0xe0, 0x00, 0x00, 0x3f, 0xc0, 0x00, 0x00, 0x7f, 0x80, 0x00, 0x00, 0xff, 0x00, 0x00, 0x01, 0xff, 0xfe, 0x00, 0x03, 0xff, 0xff, 0x80, 0x07, 0xff, 0xff, 0x80, 0x0f, 0xff, 0xff, 0x80, 0x1f, 0xff, 0xff, 0x80, 0x3f, 0xff, 0xff, 0x80, 0x70, 0x07, 0xff, 0x00, 0x00, 0x07, 0xff, 0x00, 0x00, 0x07, 0xfe, 0x00, 0x00, 0x07, 0xfc, 0x00, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0x1f, 0xf0, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x7f, 0xc1, 0x80, 0x01, 0xff, 0x83, 0xc0, 0x07, 0xfe, 0x07, 0xe0, 0x3f, 0xfc, 0x0f, 0xff, 0xff, 0xf0, 0x1f, 0xff, 0xff, 0xe0, 0x3f, 0xff, 0xff, 0x80, 0x7f, 0xff, 0xfe, 0x00, 0xff, 0xff, 0xf8, 0x00, 0x7f, 0xff, 0xc0, 0x00, 0x0f, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};////character: '5'
-
-static const tImage MSTahomaBold48_0x35 __PRGMTAG_ = { image_data_MSTahomaBold48_0x35,
-    31, 152};//character: '5' , height: 39, (charW,total bytes)
-
-static const uint8_t image_data_MSTahomaBold48_0x36[152] __PRGMTAG_  = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xff, 0x80, 0x00, 0x3f, 0xff, 0x00, 0x01, 0xff, 0xfe, 0x00, 0x0f, 0xff, 0xfc, 0x00, 0x3f, 0xff, 0xf8, 0x00, 0xff, 0xff, 0xf0, 0x01, 0xff, 0xc0, 0x60, 0x07, 0xfe, 0x00, 0x00, 0x1f, 0xf8, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0xff, 0x80, 0x00, 0x01, 0xff, 0x00, 0x00, 0x03, 0xfe, 0x00, 0x00, 0x07, 0xf8, 0x7f, 0x00, 0x1f, 0xf3, 0xff, 0x80, 0x3f, 0xff, 0xff, 0xc0, 0x7f, 0xff, 0xff, 0xc0, 0xff, 0xff, 0xff, 0x81, 0xff, 0xff, 0xff, 0x83, 0xff, 0x07, 0xff, 0x07, 0xfc, 0x03, 0xff, 0x0f, 0xf8, 0x07, 0xfe, 0x1f, 0xf0, 0x07, 0xfc, 0x3f, 0xe0, 0x0f, 0xf8, 0x7f, 0xc0, 0x1f, 0xf0, 0xff, 0x80, 0x3f, 0xe0, 0xff, 0x00, 0x7f, 0xc1, 0xff, 0x00, 0xff, 0x83, 0xfe, 0x03, 0xfe, 0x03, 0xfe, 0x07, 0xfc, 0x07, 0xfe, 0x1f, 0xf8, 0x07, 0xff, 0xff, 0xe0, 0x0f, 0xff, 0xff, 0x80, 0x0f, 0xff, 0xfe, 0x00, 0x0f, 0xff, 0xf8, 0x00, 0x07, 0xff, 0xe0, 0x00, 0x01, 0xfe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};////character: '6'
-
-static const tImage MSTahomaBold48_0x36 __PRGMTAG_ = { image_data_MSTahomaBold48_0x36,
-    31, 152};//character: '6' , height: 39, (charW,total bytes)
-
-static const uint8_t image_data_MSTahomaBold48_0x37[152] __PRGMTAG_  = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f, 0xff, 0xff, 0xe0, 0xff, 0xff, 0xff, 0xc1, 0xff, 0xff, 0xff, 0x83, 0xff, 0xff, 0xff, 0x07, 0xff, 0xff, 0xfe, 0x0f, 0xff, 0xff, 0xfc, 0x00, 0x00, 0x1f, 0xf8, 0x00, 0x00, 0x7f, 0xe0, 0x00, 0x00, 0xff, 0xc0, 0x00, 0x03, 0xff, 0x00, 0x00, 0x07, 0xfe, 0x00, 0x00, 0x1f, 0xf8, 0x00, 0x00, 0x3f, 0xf0, 0x00, 0x00, 0xff, 0xc0, 0x00, 0x01, 0xff, 0x80, 0x00, 0x07, 0xfe, 0x00, 0x00, 0x0f, 0xfc, 0x00, 0x00, 0x3f, 0xf0, 0x00, 0x00, 0x7f, 0xe0, 0x00, 0x01, 0xff, 0x80, 0x00, 0x03, 0xff, 0x00, 0x00, 0x0f, 0xfc, 0x00, 0x00, 0x3f, 0xf8, 0x00, 0x00, 0x7f, 0xe0, 0x00, 0x01, 0xff, 0xc0, 0x00, 0x03, 0xff, 0x00, 0x00, 0x0f, 0xfe, 0x00, 0x00, 0x1f, 0xf8, 0x00, 0x00, 0x7f, 0xf0, 0x00, 0x00, 0xff, 0xc0, 0x00, 0x03, 0xff, 0x00, 0x00, 0x07, 0xfe, 0x00, 0x00, 0x1f, 0xf8, 0x00, 0x00, 0x3f, 0xf0, 0x00, 0x00, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};////character: '7'
-
-static const tImage MSTahomaBold48_0x37 __PRGMTAG_ = { image_data_MSTahomaBold48_0x37,
-    31, 152};//character: '7' , height: 39, (charW,total bytes)
-
-static const uint8_t image_data_MSTahomaBold48_0x38[152] __PRGMTAG_  = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x3f, 0xf0, 0x00, 0x03, 0xff, 0xfc, 0x00, 0x1f, 0xff, 0xfc, 0x00, 0x7f, 0xff, 0xfe, 0x01, 0xff, 0xff, 0xfe, 0x07, 0xff, 0xff, 0xfc, 0x0f, 0xfc, 0x1f, 0xfc, 0x3f, 0xf0, 0x1f, 0xf8, 0x7f, 0xc0, 0x1f, 0xf0, 0xff, 0x80, 0x3f, 0xe1, 0xff, 0x00, 0x7f, 0xc3, 0xff, 0x00, 0xff, 0x87, 0xff, 0x01, 0xfe, 0x07, 0xff, 0x87, 0xf8, 0x0f, 0xff, 0xdf, 0xf0, 0x0f, 0xff, 0xff, 0x80, 0x0f, 0xff, 0xfe, 0x00, 0x07, 0xff, 0xfc, 0x00, 0x0f, 0xff, 0xfe, 0x00, 0x7f, 0xff, 0xfe, 0x01, 0xfe, 0xff, 0xfe, 0x07, 0xf8, 0x3f, 0xfe, 0x1f, 0xf0, 0x1f, 0xfc, 0x3f, 0xc0, 0x0f, 0xfc, 0xff, 0x80, 0x0f, 0xf9, 0xff, 0x00, 0x1f, 0xf3, 0xfe, 0x00, 0x3f, 0xe7, 0xfc, 0x00, 0x7f, 0xcf, 0xfc, 0x00, 0xff, 0x9f, 0xfc, 0x03, 0xfe, 0x1f, 0xfc, 0x1f, 0xfc, 0x3f, 0xff, 0xff, 0xf0, 0x3f, 0xff, 0xff, 0xe0, 0x3f, 0xff, 0xff, 0x80, 0x3f, 0xff, 0xfc, 0x00, 0x1f, 0xff, 0xf0, 0x00, 0x07, 0xfe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};////character: '8'
-
-static const tImage MSTahomaBold48_0x38 __PRGMTAG_ = { image_data_MSTahomaBold48_0x38,
-    31, 152};//character: '8' , height: 39, (charW,total bytes)
-
-static const uint8_t image_data_MSTahomaBold48_0x39[152] __PRGMTAG_  = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x01, 0xff, 0xf0, 0x00, 0x0f, 0xff, 0xf8, 0x00, 0x3f, 0xff, 0xf8, 0x00, 0xff, 0xff, 0xf8, 0x03, 0xff, 0xff, 0xf0, 0x0f, 0xfc, 0x3f, 0xf0, 0x1f, 0xf0, 0x3f, 0xf0, 0x3f, 0xe0, 0x3f, 0xe0, 0xff, 0x80, 0x7f, 0xc1, 0xff, 0x00, 0x7f, 0x83, 0xfe, 0x00, 0xff, 0x87, 0xfc, 0x01, 0xff, 0x0f, 0xf8, 0x03, 0xfe, 0x1f, 0xf0, 0x07, 0xfc, 0x3f, 0xf0, 0x0f, 0xf8, 0x7f, 0xe0, 0x1f, 0xf0, 0x7f, 0xf0, 0x7f, 0xe0, 0xff, 0xff, 0xff, 0xc0, 0xff, 0xff, 0xff, 0x81, 0xff, 0xff, 0xff, 0x01, 0xff, 0xff, 0xfe, 0x00, 0xff, 0xe7, 0xf8, 0x00, 0x7f, 0x0f, 0xf0, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x7f, 0xc0, 0x00, 0x00, 0xff, 0x00, 0x00, 0x03, 0xfe, 0x00, 0x00, 0x0f, 0xfc, 0x00, 0x00, 0x3f, 0xf0, 0x03, 0x01, 0xff, 0xc0, 0x07, 0xff, 0xff, 0x80, 0x0f, 0xff, 0xfe, 0x00, 0x1f, 0xff, 0xf0, 0x00, 0x3f, 0xff, 0xc0, 0x00, 0x7f, 0xfe, 0x00, 0x00, 0xff, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};////character: '9'
-
-static const tImage MSTahomaBold48_0x39 __PRGMTAG_ = { image_data_MSTahomaBold48_0x39,
-    31, 152};//character: '9' , height: 39, (charW,total bytes)
-
-static const uint8_t image_data_MSTahomaBold48_0x3a[83] __PRGMTAG_  = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x7f, 0x80, 0x3f, 0xc0, 0x1f, 0xe0, 0x0f, 0xf0, 0x07, 0xf8, 0x03, 0xfc, 0x01, 0xfe, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f, 0x80, 0x3f, 0xc0, 0x1f, 0xe0, 0x0f, 0xf0, 0x07, 0xf8, 0x03, 0xfc, 0x01, 0xfe, 0x00, 0xff, 0x00, 0x7f, 0x80, 0x00, 0x00, 0x00, 0x00
-};////character: ':'
-
-static const tImage MSTahomaBold48_0x3a __PRGMTAG_ = { image_data_MSTahomaBold48_0x3a,
-    17, 83};//character: ':' , height: 39, (charW,total bytes)
-
-static const uint8_t image_data_MSTahomaBold48_0x41[161] __PRGMTAG_  = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xfe, 0x00, 0x00, 0x03, 0xff, 0x80, 0x00, 0x01, 0xff, 0xc0, 0x00, 0x00, 0xff, 0xe0, 0x00, 0x00, 0xff, 0xf8, 0x00, 0x00, 0x7f, 0xfc, 0x00, 0x00, 0x3f, 0xfe, 0x00, 0x00, 0x3f, 0xff, 0x80, 0x00, 0x1f, 0xff, 0xc0, 0x00, 0x0f, 0xef, 0xe0, 0x00, 0x0f, 0xf7, 0xf8, 0x00, 0x07, 0xfb, 0xfc, 0x00, 0x03, 0xf8, 0xfe, 0x00, 0x03, 0xfc, 0x7f, 0x80, 0x01, 0xfe, 0x3f, 0xc0, 0x00, 0xfe, 0x0f, 0xe0, 0x00, 0xff, 0x07, 0xf8, 0x00, 0x7f, 0x83, 0xfc, 0x00, 0x3f, 0x80, 0xfe, 0x00, 0x3f, 0xc0, 0x7f, 0x80, 0x1f, 0xe0, 0x3f, 0xc0, 0x0f, 0xff, 0xff, 0xe0, 0x0f, 0xff, 0xff, 0xf8, 0x07, 0xff, 0xff, 0xfc, 0x03, 0xff, 0xff, 0xfe, 0x03, 0xff, 0xff, 0xff, 0x81, 0xff, 0xff, 0xff, 0xc0, 0xff, 0x00, 0x1f, 0xe0, 0xff, 0x00, 0x07, 0xf8, 0x7f, 0x80, 0x03, 0xfc, 0x3f, 0xc0, 0x01, 0xfe, 0x3f, 0xe0, 0x00, 0xff, 0x9f, 0xe0, 0x00, 0x3f, 0xcf, 0xf0, 0x00, 0x1f, 0xef, 0xf8, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};////character: 'A'
-
-static const tImage MSTahomaBold48_0x41 __PRGMTAG_ = { image_data_MSTahomaBold48_0x41,
-    33, 161};//character: 'A' , height: 39, (charW,total bytes)
-
-static const uint8_t image_data_MSTahomaBold48_0x42[161] __PRGMTAG_  = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xff, 0xff, 0x80, 0x01, 0xff, 0xff, 0xf8, 0x00, 0xff, 0xff, 0xff, 0x00, 0x7f, 0xff, 0xff, 0xc0, 0x3f, 0xff, 0xff, 0xe0, 0x1f, 0xff, 0xff, 0xf8, 0x0f, 0xf8, 0x1f, 0xfc, 0x07, 0xfc, 0x07, 0xfe, 0x03, 0xfe, 0x01, 0xff, 0x01, 0xff, 0x00, 0xff, 0x80, 0xff, 0x80, 0x7f, 0xc0, 0x7f, 0xc0, 0x3f, 0xc0, 0x3f, 0xe0, 0x3f, 0xe0, 0x1f, 0xf0, 0x3f, 0xe0, 0x0f, 0xff, 0xff, 0xe0, 0x07, 0xff, 0xff, 0xe0, 0x03, 0xff, 0xff, 0xf8, 0x01, 0xff, 0xff, 0xff, 0x00, 0xff, 0xff, 0xff, 0xc0, 0x7f, 0xff, 0xff, 0xf0, 0x3f, 0xe0, 0x1f, 0xf8, 0x1f, 0xf0, 0x07, 0xfe, 0x0f, 0xf8, 0x01, 0xff, 0x07, 0xfc, 0x00, 0xff, 0x83, 0xfe, 0x00, 0x7f, 0xc1, 0xff, 0x00, 0x3f, 0xe0, 0xff, 0x80, 0x1f, 0xf0, 0x7f, 0xc0, 0x1f, 0xf8, 0x3f, 0xe0, 0x3f, 0xf8, 0x1f, 0xff, 0xff, 0xfc, 0x0f, 0xff, 0xff, 0xfc, 0x07, 0xff, 0xff, 0xfc, 0x03, 0xff, 0xff, 0xfc, 0x01, 0xff, 0xff, 0xf8, 0x00, 0xff, 0xff, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};////character: 'B'
-
-static const tImage MSTahomaBold48_0x42 __PRGMTAG_ = { image_data_MSTahomaBold48_0x42,
-    33, 161};//character: 'B' , height: 39, (charW,total bytes)
-
-static const uint8_t image_data_MSTahomaBold48_0x43[156] __PRGMTAG_  = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xff, 0x00, 0x00, 0x1f, 0xff, 0xe0, 0x00, 0x7f, 0xff, 0xf8, 0x00, 0xff, 0xff, 0xfc, 0x01, 0xff, 0xff, 0xfc, 0x03, 0xff, 0xff, 0xfc, 0x07, 0xff, 0xff, 0xfc, 0x07, 0xff, 0x81, 0xfc, 0x0f, 0xfe, 0x00, 0x7c, 0x0f, 0xfc, 0x00, 0x1c, 0x1f, 0xf8, 0x00, 0x04, 0x1f, 0xf8, 0x00, 0x00, 0x1f, 0xf0, 0x00, 0x00, 0x3f, 0xf0, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x3f, 0xf0, 0x00, 0x00, 0x1f, 0xf0, 0x00, 0x00, 0x1f, 0xf8, 0x00, 0x00, 0x1f, 0xf8, 0x00, 0x04, 0x0f, 0xfc, 0x00, 0x1c, 0x0f, 0xfe, 0x00, 0x3c, 0x07, 0xff, 0x81, 0xfc, 0x07, 0xff, 0xff, 0xfc, 0x03, 0xff, 0xff, 0xfc, 0x01, 0xff, 0xff, 0xfc, 0x00, 0xff, 0xff, 0xfc, 0x00, 0x7f, 0xff, 0xf8, 0x00, 0x1f, 0xff, 0xe0, 0x00, 0x03, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00
-};////character: 'C'
-
-static const tImage MSTahomaBold48_0x43 __PRGMTAG_ = { image_data_MSTahomaBold48_0x43,
-    32, 156};//character: 'C' , height: 39, (charW,total bytes)
-
-static const uint8_t image_data_MSTahomaBold48_0x44[176] __PRGMTAG_  = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0f, 0xff, 0xf8, 0x00, 0x00, 0xff, 0xff, 0xf8, 0x00, 0x0f, 0xff, 0xff, 0xc0, 0x00, 0xff, 0xff, 0xff, 0x00, 0x0f, 0xff, 0xff, 0xf8, 0x00, 0xff, 0xff, 0xff, 0xc0, 0x0f, 0xff, 0xff, 0xfe, 0x00, 0xff, 0x81, 0xff, 0xe0, 0x0f, 0xf8, 0x07, 0xff, 0x00, 0xff, 0x80, 0x3f, 0xf0, 0x0f, 0xf8, 0x01, 0xff, 0x80, 0xff, 0x80, 0x0f, 0xf8, 0x0f, 0xf8, 0x00, 0xff, 0x80, 0xff, 0x80, 0x07, 0xfc, 0x0f, 0xf8, 0x00, 0x7f, 0xc0, 0xff, 0x80, 0x07, 0xfc, 0x0f, 0xf8, 0x00, 0x7f, 0xc0, 0xff, 0x80, 0x07, 0xfc, 0x0f, 0xf8, 0x00, 0x7f, 0xc0, 0xff, 0x80, 0x07, 0xfc, 0x0f, 0xf8, 0x00, 0x7f, 0xc0, 0xff, 0x80, 0x07, 0xfc, 0x0f, 0xf8, 0x00, 0xff, 0x80, 0xff, 0x80, 0x0f, 0xf8, 0x0f, 0xf8, 0x01, 0xff, 0x80, 0xff, 0x80, 0x3f, 0xf0, 0x0f, 0xf8, 0x07, 0xff, 0x00, 0xff, 0x81, 0xff, 0xe0, 0x0f, 0xff, 0xff, 0xfe, 0x00, 0xff, 0xff, 0xff, 0xc0, 0x0f, 0xff, 0xff, 0xf8, 0x00, 0xff, 0xff, 0xff, 0x00, 0x0f, 0xff, 0xff, 0xc0, 0x00, 0xff, 0xff, 0xf0, 0x00, 0x0f, 0xff, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};////character: 'D'
-
-static const tImage MSTahomaBold48_0x44 __PRGMTAG_ = { image_data_MSTahomaBold48_0x44,
-    36, 176};//character: 'D' , height: 39, (charW,total bytes)
-
-static const uint8_t image_data_MSTahomaBold48_0x45[147] __PRGMTAG_  = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x03, 0xff, 0xff, 0xfc, 0x0f, 0xff, 0xff, 0xf0, 0x3f, 0xff, 0xff, 0xc0, 0xff, 0xff, 0xff, 0x03, 0xff, 0xff, 0xfc, 0x0f, 0xff, 0xff, 0xf0, 0x3f, 0xe0, 0x00, 0x00, 0xff, 0x80, 0x00, 0x03, 0xfe, 0x00, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0xff, 0x80, 0x00, 0x03, 0xff, 0xff, 0xf8, 0x0f, 0xff, 0xff, 0xe0, 0x3f, 0xff, 0xff, 0x80, 0xff, 0xff, 0xfe, 0x03, 0xff, 0xff, 0xf8, 0x0f, 0xff, 0xff, 0xe0, 0x3f, 0xff, 0xff, 0x80, 0xff, 0x80, 0x00, 0x03, 0xfe, 0x00, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0xff, 0x80, 0x00, 0x03, 0xfe, 0x00, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0xff, 0xff, 0xff, 0x03, 0xff, 0xff, 0xfc, 0x0f, 0xff, 0xff, 0xf0, 0x3f, 0xff, 0xff, 0xc0, 0xff, 0xff, 0xff, 0x03, 0xff, 0xff, 0xfc, 0x0f, 0xff, 0xff, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};////character: 'E'
-
-static const tImage MSTahomaBold48_0x45 __PRGMTAG_ = { image_data_MSTahomaBold48_0x45,
-    30, 147};//character: 'E' , height: 39, (charW,total bytes)
-
-static const uint8_t image_data_MSTahomaBold48_0x46[137] __PRGMTAG_  = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0f, 0xff, 0xff, 0xe0, 0xff, 0xff, 0xfe, 0x0f, 0xff, 0xff, 0xe0, 0xff, 0xff, 0xfe, 0x0f, 0xff, 0xff, 0xe0, 0xff, 0xff, 0xfe, 0x0f, 0xff, 0xff, 0xe0, 0xff, 0x80, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0xff, 0x80, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0xff, 0x80, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0xff, 0xff, 0xfc, 0x0f, 0xff, 0xff, 0xc0, 0xff, 0xff, 0xfc, 0x0f, 0xff, 0xff, 0xc0, 0xff, 0xff, 0xfc, 0x0f, 0xff, 0xff, 0xc0, 0xff, 0xff, 0xfc, 0x0f, 0xf8, 0x00, 0x00, 0xff, 0x80, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0xff, 0x80, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0xff, 0x80, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0xff, 0x80, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0xff, 0x80, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0xff, 0x80, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0xff, 0x80, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};////character: 'F'
-
-static const tImage MSTahomaBold48_0x46 __PRGMTAG_ = { image_data_MSTahomaBold48_0x46,
-    28, 137};//character: 'F' , height: 39, (charW,total bytes)
-
-
-static const tChar MSTahomaBold48_array[] = {
-
-  // character: ' '
-  {0x20, &MSTahomaBold48_0x20},
-  // character: '/'
-  {0x2f, &MSTahomaBold48_0x2f},
-  // character: '0'
-  {0x30, &MSTahomaBold48_0x30},
-  // character: '1'
-  {0x31, &MSTahomaBold48_0x31},
-  // character: '2'
-  {0x32, &MSTahomaBold48_0x32},
-  // character: '3'
-  {0x33, &MSTahomaBold48_0x33},
-  // character: '4'
-  {0x34, &MSTahomaBold48_0x34},
-  // character: '5'
-  {0x35, &MSTahomaBold48_0x35},
-  // character: '6'
-  {0x36, &MSTahomaBold48_0x36},
-  // character: '7'
-  {0x37, &MSTahomaBold48_0x37},
-  // character: '8'
-  {0x38, &MSTahomaBold48_0x38},
-  // character: '9'
-  {0x39, &MSTahomaBold48_0x39},
-  // character: ':'
-  {0x3a, &MSTahomaBold48_0x3a},
-  // character: 'A'
-  {0x41, &MSTahomaBold48_0x41},
-  // character: 'B'
-  {0x42, &MSTahomaBold48_0x42},
-  // character: 'C'
-  {0x43, &MSTahomaBold48_0x43},
-  // character: 'D'
-  {0x44, &MSTahomaBold48_0x44},
-  // character: 'E'
-  {0x45, &MSTahomaBold48_0x45},
-  // character: 'F'
-  {0x46, &MSTahomaBold48_0x46}
-};
-
-//num chars, array, width, height, compression
-
-const tFont MSTahomaBold48 = { 19, MSTahomaBold48_array,0,39,0 };
+
+/*******************************************************************************
+
+* name: MSTahomaBold48
+* family: MSTahoma
+* size: 48
+* style: Bold
+* --------------------------------------
+* included characters:  /0123456789:ABCDEF
+* --------------------------------------
+* antialiasing: no
+* type: proportional
+* encoding: latin1
+* unicode bom: no
+*
+* data block size: 8 bit(s), uint8_t
+* RLE compression enabled: no
+* conversion type: Monochrome, Edge 128
+* bits per pixel: 1
+*
+* preprocess:
+*  main scan direction: top_to_bottom
+*  line scan direction: forward
+*  inverse: yes
+* ------------------------------------------------------------------------------
+* Created by a custom template of LCD-Image-Converter for .s.u.m.o.t.o.y. RA8875
+* Font template version: 2.0
+* Note: Font height should be fixed and all glyps must have the same height!
+* ------------------------------------------------------------------------------
+*******************************************************************************/
+
+
+
+#include <stdint.h>
+
+
+
+static const uint8_t image_data_MSTahomaBold48_0x20[69] __PRGMTAG_  = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};////character: ' '
+
+static const tImage MSTahomaBold48_0x20 __PRGMTAG_ = { image_data_MSTahomaBold48_0x20,
+    14, 69};//character: ' ' , height: 39, (charW,total bytes)
+
+static const uint8_t image_data_MSTahomaBold48_0x2f[137] __PRGMTAG_  = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xf0, 0x00, 0x00, 0x7e, 0x00, 0x00, 0x07, 0xe0, 0x00, 0x00, 0x7e, 0x00, 0x00, 0x0f, 0xc0, 0x00, 0x00, 0xfc, 0x00, 0x00, 0x0f, 0xc0, 0x00, 0x01, 0xf8, 0x00, 0x00, 0x1f, 0x80, 0x00, 0x01, 0xf8, 0x00, 0x00, 0x3f, 0x00, 0x00, 0x03, 0xf0, 0x00, 0x00, 0x3f, 0x00, 0x00, 0x07, 0xe0, 0x00, 0x00, 0x7e, 0x00, 0x00, 0x07, 0xe0, 0x00, 0x00, 0xfc, 0x00, 0x00, 0x0f, 0xc0, 0x00, 0x00, 0xfc, 0x00, 0x00, 0x1f, 0x80, 0x00, 0x01, 0xf8, 0x00, 0x00, 0x1f, 0x80, 0x00, 0x03, 0xf0, 0x00, 0x00, 0x3f, 0x00, 0x00, 0x03, 0xf0, 0x00, 0x00, 0x7e, 0x00, 0x00, 0x07, 0xe0, 0x00, 0x00, 0x7e, 0x00, 0x00, 0x0f, 0xc0, 0x00, 0x00, 0xfc, 0x00, 0x00, 0x0f, 0xc0, 0x00, 0x01, 0xf8, 0x00, 0x00, 0x1f, 0x80, 0x00, 0x01, 0xf8, 0x00, 0x00, 0x3f, 0x00, 0x00, 0x03, 0xf0, 0x00, 0x00, 0x3f, 0x00, 0x00, 0x07, 0xe0, 0x00, 0x00
+};////character: '/'
+
+static const tImage MSTahomaBold48_0x2f __PRGMTAG_ = { image_data_MSTahomaBold48_0x2f,
+    28, 137};//character: '/' , height: 39, (charW,total bytes)
+
+static const uint8_t image_data_MSTahomaBold48_0x30[152] __PRGMTAG_  = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x01, 0xff, 0xf0, 0x00, 0x0f, 0xff, 0xf8, 0x00, 0x3f, 0xff, 0xf8, 0x00, 0xff, 0xff, 0xf8, 0x01, 0xff, 0xff, 0xf0, 0x07, 0xfe, 0x3f, 0xf0, 0x0f, 0xf8, 0x3f, 0xe0, 0x3f, 0xe0, 0x3f, 0xe0, 0x7f, 0xc0, 0x7f, 0xc0, 0xff, 0x80, 0xff, 0x81, 0xfe, 0x00, 0xff, 0x07, 0xfc, 0x01, 0xff, 0x0f, 0xf8, 0x03, 0xfe, 0x1f, 0xf0, 0x07, 0xfc, 0x3f, 0xe0, 0x0f, 0xf8, 0x7f, 0xc0, 0x1f, 0xf0, 0xff, 0x80, 0x3f, 0xe1, 0xff, 0x00, 0x7f, 0xc3, 0xfe, 0x00, 0xff, 0x87, 0xfc, 0x01, 0xff, 0x0f, 0xf8, 0x03, 0xfe, 0x1f, 0xf0, 0x07, 0xfc, 0x3f, 0xe0, 0x0f, 0xf8, 0x7f, 0xc0, 0x1f, 0xf0, 0x7f, 0x80, 0x3f, 0xc0, 0xff, 0x80, 0xff, 0x81, 0xff, 0x01, 0xff, 0x03, 0xfe, 0x03, 0xfe, 0x03, 0xfe, 0x0f, 0xf8, 0x07, 0xfe, 0x3f, 0xf0, 0x07, 0xff, 0xff, 0xc0, 0x0f, 0xff, 0xff, 0x80, 0x0f, 0xff, 0xfe, 0x00, 0x0f, 0xff, 0xf8, 0x00, 0x07, 0xff, 0xc0, 0x00, 0x03, 0xfe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};////character: '0'
+
+static const tImage MSTahomaBold48_0x30 __PRGMTAG_ = { image_data_MSTahomaBold48_0x30,
+    31, 152};//character: '0' , height: 39, (charW,total bytes)
+
+static const uint8_t image_data_MSTahomaBold48_0x31[152] __PRGMTAG_  = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0xe0, 0x00, 0x00, 0x3f, 0xc0, 0x00, 0x00, 0xff, 0x80, 0x00, 0x03, 0xff, 0x00, 0x00, 0x1f, 0xfe, 0x00, 0x03, 0xff, 0xfc, 0x00, 0x07, 0xff, 0xf8, 0x00, 0x0f, 0xff, 0xf0, 0x00, 0x1f, 0xff, 0xe0, 0x00, 0x3f, 0xff, 0xc0, 0x00, 0x7f, 0xff, 0x80, 0x00, 0x01, 0xff, 0x00, 0x00, 0x03, 0xfe, 0x00, 0x00, 0x07, 0xfc, 0x00, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0x1f, 0xf0, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x7f, 0xc0, 0x00, 0x00, 0xff, 0x80, 0x00, 0x01, 0xff, 0x00, 0x00, 0x03, 0xfe, 0x00, 0x00, 0x07, 0xfc, 0x00, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0x1f, 0xf0, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x7f, 0xc0, 0x00, 0x00, 0xff, 0x80, 0x00, 0x01, 0xff, 0x00, 0x00, 0x03, 0xfe, 0x00, 0x03, 0xff, 0xff, 0xf8, 0x07, 0xff, 0xff, 0xf0, 0x0f, 0xff, 0xff, 0xe0, 0x1f, 0xff, 0xff, 0xc0, 0x3f, 0xff, 0xff, 0x80, 0x7f, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};////character: '1'
+
+static const tImage MSTahomaBold48_0x31 __PRGMTAG_ = { image_data_MSTahomaBold48_0x31,
+    31, 152};//character: '1' , height: 39, (charW,total bytes)
+
+static const uint8_t image_data_MSTahomaBold48_0x32[152] __PRGMTAG_  = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x07, 0xff, 0xf8, 0x00, 0x3f, 0xff, 0xf8, 0x00, 0x7f, 0xff, 0xf8, 0x00, 0xff, 0xff, 0xf8, 0x01, 0xff, 0xff, 0xf8, 0x03, 0xff, 0xff, 0xf0, 0x07, 0xe0, 0xff, 0xf0, 0x0e, 0x00, 0x7f, 0xe0, 0x10, 0x00, 0xff, 0xc0, 0x00, 0x00, 0xff, 0x80, 0x00, 0x01, 0xff, 0x00, 0x00, 0x03, 0xfe, 0x00, 0x00, 0x07, 0xfc, 0x00, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x7f, 0xc0, 0x00, 0x01, 0xff, 0x00, 0x00, 0x03, 0xfe, 0x00, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0x3f, 0xf0, 0x00, 0x00, 0xff, 0xc0, 0x00, 0x03, 0xff, 0x00, 0x00, 0x0f, 0xfc, 0x00, 0x00, 0x3f, 0xf0, 0x00, 0x00, 0xff, 0xc0, 0x00, 0x03, 0xff, 0x00, 0x00, 0x0f, 0xfc, 0x00, 0x00, 0x3f, 0xf0, 0x00, 0x00, 0xff, 0x80, 0x00, 0x07, 0xff, 0xff, 0xfe, 0x0f, 0xff, 0xff, 0xfc, 0x1f, 0xff, 0xff, 0xf8, 0x3f, 0xff, 0xff, 0xf0, 0x7f, 0xff, 0xff, 0xe0, 0xff, 0xff, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};////character: '2'
+
+static const tImage MSTahomaBold48_0x32 __PRGMTAG_ = { image_data_MSTahomaBold48_0x32,
+    31, 152};//character: '2' , height: 39, (charW,total bytes)
+
+static const uint8_t image_data_MSTahomaBold48_0x33[152] __PRGMTAG_  = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xe0, 0x00, 0x1f, 0xff, 0xf8, 0x00, 0xff, 0xff, 0xfc, 0x01, 0xff, 0xff, 0xfc, 0x03, 0xff, 0xff, 0xfc, 0x07, 0xff, 0xff, 0xf8, 0x0f, 0xff, 0xff, 0xf8, 0x1f, 0xc0, 0x7f, 0xf0, 0x3c, 0x00, 0x7f, 0xe0, 0x60, 0x00, 0x7f, 0xc0, 0x00, 0x00, 0xff, 0x80, 0x00, 0x01, 0xff, 0x00, 0x00, 0x03, 0xfc, 0x00, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0x7f, 0xe0, 0x00, 0x3f, 0xff, 0x80, 0x00, 0x7f, 0xfe, 0x00, 0x00, 0xff, 0xf0, 0x00, 0x01, 0xff, 0xf8, 0x00, 0x03, 0xff, 0xfc, 0x00, 0x07, 0xff, 0xfc, 0x00, 0x00, 0x1f, 0xfc, 0x00, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0x1f, 0xf0, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x7f, 0xc3, 0x00, 0x01, 0xff, 0x87, 0x80, 0x03, 0xff, 0x0f, 0xe0, 0x1f, 0xfc, 0x1f, 0xff, 0xff, 0xf8, 0x3f, 0xff, 0xff, 0xe0, 0x7f, 0xff, 0xff, 0xc0, 0xff, 0xff, 0xff, 0x01, 0xff, 0xff, 0xf8, 0x00, 0xff, 0xff, 0xc0, 0x00, 0x1f, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};////character: '3'
+
+static const tImage MSTahomaBold48_0x33 __PRGMTAG_ = { image_data_MSTahomaBold48_0x33,
+    31, 152};//character: '3' , height: 39, (charW,total bytes)
+
+static const uint8_t image_data_MSTahomaBold48_0x34[152] __PRGMTAG_  = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0xfe, 0x00, 0x00, 0x0f, 0xfc, 0x00, 0x00, 0x3f, 0xf8, 0x00, 0x00, 0xff, 0xf0, 0x00, 0x01, 0xff, 0xe0, 0x00, 0x07, 0xff, 0xc0, 0x00, 0x1f, 0xff, 0x80, 0x00, 0x7f, 0xff, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x03, 0xf7, 0xfc, 0x00, 0x0f, 0xcf, 0xf8, 0x00, 0x1f, 0x1f, 0xf0, 0x00, 0x7e, 0x3f, 0xe0, 0x01, 0xf8, 0x7f, 0xc0, 0x07, 0xe0, 0xff, 0x80, 0x0f, 0xc1, 0xff, 0x00, 0x3f, 0x03, 0xfe, 0x00, 0xfc, 0x07, 0xfc, 0x01, 0xf8, 0x0f, 0xf8, 0x07, 0xe0, 0x1f, 0xf0, 0x1f, 0x80, 0x3f, 0xe0, 0x3f, 0xff, 0xff, 0xfe, 0x7f, 0xff, 0xff, 0xfc, 0xff, 0xff, 0xff, 0xf9, 0xff, 0xff, 0xff, 0xf3, 0xff, 0xff, 0xff, 0xe7, 0xff, 0xff, 0xff, 0xc0, 0x00, 0x1f, 0xf0, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x7f, 0xc0, 0x00, 0x00, 0xff, 0x80, 0x00, 0x01, 0xff, 0x00, 0x00, 0x03, 0xfe, 0x00, 0x00, 0x07, 0xfc, 0x00, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};////character: '4'
+
+static const tImage MSTahomaBold48_0x34 __PRGMTAG_ = { image_data_MSTahomaBold48_0x34,
+    31, 152};//character: '4' , height: 39, (charW,total bytes)
+
+static const uint8_t image_data_MSTahomaBold48_0x35[152] __PRGMTAG_  = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0xff, 0xff, 0xc0, 0x3f, 0xff, 0xff, 0x80, 0x7f, 0xff, 0xff, 0x00, 0xff, 0xff, 0xfe, 0x01, 0xff, 0xff, 0xfc, 0x03, 0xff, 0xff, 0xf8, 0x07, 0xf8, 0x00, 0x00, 0x0f, 0xf0, 0x00, 0x00, 0x1f, 0xe0, 0x00, 0x00, 0x3f, 0xc0, 0x00, 0x00, 0x7f, 0x80, 0x00, 0x00, 0xff, 0x00, 0x00, 0x01, 0xff, 0xfe, 0x00, 0x03, 0xff, 0xff, 0x80, 0x07, 0xff, 0xff, 0x80, 0x0f, 0xff, 0xff, 0x80, 0x1f, 0xff, 0xff, 0x80, 0x3f, 0xff, 0xff, 0x80, 0x70, 0x07, 0xff, 0x00, 0x00, 0x07, 0xff, 0x00, 0x00, 0x07, 0xfe, 0x00, 0x00, 0x07, 0xfc, 0x00, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0x1f, 0xf0, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x7f, 0xc1, 0x80, 0x01, 0xff, 0x83, 0xc0, 0x07, 0xfe, 0x07, 0xe0, 0x3f, 0xfc, 0x0f, 0xff, 0xff, 0xf0, 0x1f, 0xff, 0xff, 0xe0, 0x3f, 0xff, 0xff, 0x80, 0x7f, 0xff, 0xfe, 0x00, 0xff, 0xff, 0xf8, 0x00, 0x7f, 0xff, 0xc0, 0x00, 0x0f, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};////character: '5'
+
+static const tImage MSTahomaBold48_0x35 __PRGMTAG_ = { image_data_MSTahomaBold48_0x35,
+    31, 152};//character: '5' , height: 39, (charW,total bytes)
+
+static const uint8_t image_data_MSTahomaBold48_0x36[152] __PRGMTAG_  = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xff, 0x80, 0x00, 0x3f, 0xff, 0x00, 0x01, 0xff, 0xfe, 0x00, 0x0f, 0xff, 0xfc, 0x00, 0x3f, 0xff, 0xf8, 0x00, 0xff, 0xff, 0xf0, 0x01, 0xff, 0xc0, 0x60, 0x07, 0xfe, 0x00, 0x00, 0x1f, 0xf8, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0xff, 0x80, 0x00, 0x01, 0xff, 0x00, 0x00, 0x03, 0xfe, 0x00, 0x00, 0x07, 0xf8, 0x7f, 0x00, 0x1f, 0xf3, 0xff, 0x80, 0x3f, 0xff, 0xff, 0xc0, 0x7f, 0xff, 0xff, 0xc0, 0xff, 0xff, 0xff, 0x81, 0xff, 0xff, 0xff, 0x83, 0xff, 0x07, 0xff, 0x07, 0xfc, 0x03, 0xff, 0x0f, 0xf8, 0x07, 0xfe, 0x1f, 0xf0, 0x07, 0xfc, 0x3f, 0xe0, 0x0f, 0xf8, 0x7f, 0xc0, 0x1f, 0xf0, 0xff, 0x80, 0x3f, 0xe0, 0xff, 0x00, 0x7f, 0xc1, 0xff, 0x00, 0xff, 0x83, 0xfe, 0x03, 0xfe, 0x03, 0xfe, 0x07, 0xfc, 0x07, 0xfe, 0x1f, 0xf8, 0x07, 0xff, 0xff, 0xe0, 0x0f, 0xff, 0xff, 0x80, 0x0f, 0xff, 0xfe, 0x00, 0x0f, 0xff, 0xf8, 0x00, 0x07, 0xff, 0xe0, 0x00, 0x01, 0xfe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};////character: '6'
+
+static const tImage MSTahomaBold48_0x36 __PRGMTAG_ = { image_data_MSTahomaBold48_0x36,
+    31, 152};//character: '6' , height: 39, (charW,total bytes)
+
+static const uint8_t image_data_MSTahomaBold48_0x37[152] __PRGMTAG_  = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f, 0xff, 0xff, 0xe0, 0xff, 0xff, 0xff, 0xc1, 0xff, 0xff, 0xff, 0x83, 0xff, 0xff, 0xff, 0x07, 0xff, 0xff, 0xfe, 0x0f, 0xff, 0xff, 0xfc, 0x00, 0x00, 0x1f, 0xf8, 0x00, 0x00, 0x7f, 0xe0, 0x00, 0x00, 0xff, 0xc0, 0x00, 0x03, 0xff, 0x00, 0x00, 0x07, 0xfe, 0x00, 0x00, 0x1f, 0xf8, 0x00, 0x00, 0x3f, 0xf0, 0x00, 0x00, 0xff, 0xc0, 0x00, 0x01, 0xff, 0x80, 0x00, 0x07, 0xfe, 0x00, 0x00, 0x0f, 0xfc, 0x00, 0x00, 0x3f, 0xf0, 0x00, 0x00, 0x7f, 0xe0, 0x00, 0x01, 0xff, 0x80, 0x00, 0x03, 0xff, 0x00, 0x00, 0x0f, 0xfc, 0x00, 0x00, 0x3f, 0xf8, 0x00, 0x00, 0x7f, 0xe0, 0x00, 0x01, 0xff, 0xc0, 0x00, 0x03, 0xff, 0x00, 0x00, 0x0f, 0xfe, 0x00, 0x00, 0x1f, 0xf8, 0x00, 0x00, 0x7f, 0xf0, 0x00, 0x00, 0xff, 0xc0, 0x00, 0x03, 0xff, 0x00, 0x00, 0x07, 0xfe, 0x00, 0x00, 0x1f, 0xf8, 0x00, 0x00, 0x3f, 0xf0, 0x00, 0x00, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};////character: '7'
+
+static const tImage MSTahomaBold48_0x37 __PRGMTAG_ = { image_data_MSTahomaBold48_0x37,
+    31, 152};//character: '7' , height: 39, (charW,total bytes)
+
+static const uint8_t image_data_MSTahomaBold48_0x38[152] __PRGMTAG_  = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x3f, 0xf0, 0x00, 0x03, 0xff, 0xfc, 0x00, 0x1f, 0xff, 0xfc, 0x00, 0x7f, 0xff, 0xfe, 0x01, 0xff, 0xff, 0xfe, 0x07, 0xff, 0xff, 0xfc, 0x0f, 0xfc, 0x1f, 0xfc, 0x3f, 0xf0, 0x1f, 0xf8, 0x7f, 0xc0, 0x1f, 0xf0, 0xff, 0x80, 0x3f, 0xe1, 0xff, 0x00, 0x7f, 0xc3, 0xff, 0x00, 0xff, 0x87, 0xff, 0x01, 0xfe, 0x07, 0xff, 0x87, 0xf8, 0x0f, 0xff, 0xdf, 0xf0, 0x0f, 0xff, 0xff, 0x80, 0x0f, 0xff, 0xfe, 0x00, 0x07, 0xff, 0xfc, 0x00, 0x0f, 0xff, 0xfe, 0x00, 0x7f, 0xff, 0xfe, 0x01, 0xfe, 0xff, 0xfe, 0x07, 0xf8, 0x3f, 0xfe, 0x1f, 0xf0, 0x1f, 0xfc, 0x3f, 0xc0, 0x0f, 0xfc, 0xff, 0x80, 0x0f, 0xf9, 0xff, 0x00, 0x1f, 0xf3, 0xfe, 0x00, 0x3f, 0xe7, 0xfc, 0x00, 0x7f, 0xcf, 0xfc, 0x00, 0xff, 0x9f, 0xfc, 0x03, 0xfe, 0x1f, 0xfc, 0x1f, 0xfc, 0x3f, 0xff, 0xff, 0xf0, 0x3f, 0xff, 0xff, 0xe0, 0x3f, 0xff, 0xff, 0x80, 0x3f, 0xff, 0xfc, 0x00, 0x1f, 0xff, 0xf0, 0x00, 0x07, 0xfe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};////character: '8'
+
+static const tImage MSTahomaBold48_0x38 __PRGMTAG_ = { image_data_MSTahomaBold48_0x38,
+    31, 152};//character: '8' , height: 39, (charW,total bytes)
+
+static const uint8_t image_data_MSTahomaBold48_0x39[152] __PRGMTAG_  = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x01, 0xff, 0xf0, 0x00, 0x0f, 0xff, 0xf8, 0x00, 0x3f, 0xff, 0xf8, 0x00, 0xff, 0xff, 0xf8, 0x03, 0xff, 0xff, 0xf0, 0x0f, 0xfc, 0x3f, 0xf0, 0x1f, 0xf0, 0x3f, 0xf0, 0x3f, 0xe0, 0x3f, 0xe0, 0xff, 0x80, 0x7f, 0xc1, 0xff, 0x00, 0x7f, 0x83, 0xfe, 0x00, 0xff, 0x87, 0xfc, 0x01, 0xff, 0x0f, 0xf8, 0x03, 0xfe, 0x1f, 0xf0, 0x07, 0xfc, 0x3f, 0xf0, 0x0f, 0xf8, 0x7f, 0xe0, 0x1f, 0xf0, 0x7f, 0xf0, 0x7f, 0xe0, 0xff, 0xff, 0xff, 0xc0, 0xff, 0xff, 0xff, 0x81, 0xff, 0xff, 0xff, 0x01, 0xff, 0xff, 0xfe, 0x00, 0xff, 0xe7, 0xf8, 0x00, 0x7f, 0x0f, 0xf0, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x7f, 0xc0, 0x00, 0x00, 0xff, 0x00, 0x00, 0x03, 0xfe, 0x00, 0x00, 0x0f, 0xfc, 0x00, 0x00, 0x3f, 0xf0, 0x03, 0x01, 0xff, 0xc0, 0x07, 0xff, 0xff, 0x80, 0x0f, 0xff, 0xfe, 0x00, 0x1f, 0xff, 0xf0, 0x00, 0x3f, 0xff, 0xc0, 0x00, 0x7f, 0xfe, 0x00, 0x00, 0xff, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};////character: '9'
+
+static const tImage MSTahomaBold48_0x39 __PRGMTAG_ = { image_data_MSTahomaBold48_0x39,
+    31, 152};//character: '9' , height: 39, (charW,total bytes)
+
+static const uint8_t image_data_MSTahomaBold48_0x3a[83] __PRGMTAG_  = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x7f, 0x80, 0x3f, 0xc0, 0x1f, 0xe0, 0x0f, 0xf0, 0x07, 0xf8, 0x03, 0xfc, 0x01, 0xfe, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f, 0x80, 0x3f, 0xc0, 0x1f, 0xe0, 0x0f, 0xf0, 0x07, 0xf8, 0x03, 0xfc, 0x01, 0xfe, 0x00, 0xff, 0x00, 0x7f, 0x80, 0x00, 0x00, 0x00, 0x00
+};////character: ':'
+
+static const tImage MSTahomaBold48_0x3a __PRGMTAG_ = { image_data_MSTahomaBold48_0x3a,
+    17, 83};//character: ':' , height: 39, (charW,total bytes)
+
+static const uint8_t image_data_MSTahomaBold48_0x41[161] __PRGMTAG_  = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xfe, 0x00, 0x00, 0x03, 0xff, 0x80, 0x00, 0x01, 0xff, 0xc0, 0x00, 0x00, 0xff, 0xe0, 0x00, 0x00, 0xff, 0xf8, 0x00, 0x00, 0x7f, 0xfc, 0x00, 0x00, 0x3f, 0xfe, 0x00, 0x00, 0x3f, 0xff, 0x80, 0x00, 0x1f, 0xff, 0xc0, 0x00, 0x0f, 0xef, 0xe0, 0x00, 0x0f, 0xf7, 0xf8, 0x00, 0x07, 0xfb, 0xfc, 0x00, 0x03, 0xf8, 0xfe, 0x00, 0x03, 0xfc, 0x7f, 0x80, 0x01, 0xfe, 0x3f, 0xc0, 0x00, 0xfe, 0x0f, 0xe0, 0x00, 0xff, 0x07, 0xf8, 0x00, 0x7f, 0x83, 0xfc, 0x00, 0x3f, 0x80, 0xfe, 0x00, 0x3f, 0xc0, 0x7f, 0x80, 0x1f, 0xe0, 0x3f, 0xc0, 0x0f, 0xff, 0xff, 0xe0, 0x0f, 0xff, 0xff, 0xf8, 0x07, 0xff, 0xff, 0xfc, 0x03, 0xff, 0xff, 0xfe, 0x03, 0xff, 0xff, 0xff, 0x81, 0xff, 0xff, 0xff, 0xc0, 0xff, 0x00, 0x1f, 0xe0, 0xff, 0x00, 0x07, 0xf8, 0x7f, 0x80, 0x03, 0xfc, 0x3f, 0xc0, 0x01, 0xfe, 0x3f, 0xe0, 0x00, 0xff, 0x9f, 0xe0, 0x00, 0x3f, 0xcf, 0xf0, 0x00, 0x1f, 0xef, 0xf8, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};////character: 'A'
+
+static const tImage MSTahomaBold48_0x41 __PRGMTAG_ = { image_data_MSTahomaBold48_0x41,
+    33, 161};//character: 'A' , height: 39, (charW,total bytes)
+
+static const uint8_t image_data_MSTahomaBold48_0x42[161] __PRGMTAG_  = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xff, 0xff, 0x80, 0x01, 0xff, 0xff, 0xf8, 0x00, 0xff, 0xff, 0xff, 0x00, 0x7f, 0xff, 0xff, 0xc0, 0x3f, 0xff, 0xff, 0xe0, 0x1f, 0xff, 0xff, 0xf8, 0x0f, 0xf8, 0x1f, 0xfc, 0x07, 0xfc, 0x07, 0xfe, 0x03, 0xfe, 0x01, 0xff, 0x01, 0xff, 0x00, 0xff, 0x80, 0xff, 0x80, 0x7f, 0xc0, 0x7f, 0xc0, 0x3f, 0xc0, 0x3f, 0xe0, 0x3f, 0xe0, 0x1f, 0xf0, 0x3f, 0xe0, 0x0f, 0xff, 0xff, 0xe0, 0x07, 0xff, 0xff, 0xe0, 0x03, 0xff, 0xff, 0xf8, 0x01, 0xff, 0xff, 0xff, 0x00, 0xff, 0xff, 0xff, 0xc0, 0x7f, 0xff, 0xff, 0xf0, 0x3f, 0xe0, 0x1f, 0xf8, 0x1f, 0xf0, 0x07, 0xfe, 0x0f, 0xf8, 0x01, 0xff, 0x07, 0xfc, 0x00, 0xff, 0x83, 0xfe, 0x00, 0x7f, 0xc1, 0xff, 0x00, 0x3f, 0xe0, 0xff, 0x80, 0x1f, 0xf0, 0x7f, 0xc0, 0x1f, 0xf8, 0x3f, 0xe0, 0x3f, 0xf8, 0x1f, 0xff, 0xff, 0xfc, 0x0f, 0xff, 0xff, 0xfc, 0x07, 0xff, 0xff, 0xfc, 0x03, 0xff, 0xff, 0xfc, 0x01, 0xff, 0xff, 0xf8, 0x00, 0xff, 0xff, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};////character: 'B'
+
+static const tImage MSTahomaBold48_0x42 __PRGMTAG_ = { image_data_MSTahomaBold48_0x42,
+    33, 161};//character: 'B' , height: 39, (charW,total bytes)
+
+static const uint8_t image_data_MSTahomaBold48_0x43[156] __PRGMTAG_  = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xff, 0x00, 0x00, 0x1f, 0xff, 0xe0, 0x00, 0x7f, 0xff, 0xf8, 0x00, 0xff, 0xff, 0xfc, 0x01, 0xff, 0xff, 0xfc, 0x03, 0xff, 0xff, 0xfc, 0x07, 0xff, 0xff, 0xfc, 0x07, 0xff, 0x81, 0xfc, 0x0f, 0xfe, 0x00, 0x7c, 0x0f, 0xfc, 0x00, 0x1c, 0x1f, 0xf8, 0x00, 0x04, 0x1f, 0xf8, 0x00, 0x00, 0x1f, 0xf0, 0x00, 0x00, 0x3f, 0xf0, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0x3f, 0xf0, 0x00, 0x00, 0x1f, 0xf0, 0x00, 0x00, 0x1f, 0xf8, 0x00, 0x00, 0x1f, 0xf8, 0x00, 0x04, 0x0f, 0xfc, 0x00, 0x1c, 0x0f, 0xfe, 0x00, 0x3c, 0x07, 0xff, 0x81, 0xfc, 0x07, 0xff, 0xff, 0xfc, 0x03, 0xff, 0xff, 0xfc, 0x01, 0xff, 0xff, 0xfc, 0x00, 0xff, 0xff, 0xfc, 0x00, 0x7f, 0xff, 0xf8, 0x00, 0x1f, 0xff, 0xe0, 0x00, 0x03, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00
+};////character: 'C'
+
+static const tImage MSTahomaBold48_0x43 __PRGMTAG_ = { image_data_MSTahomaBold48_0x43,
+    32, 156};//character: 'C' , height: 39, (charW,total bytes)
+
+static const uint8_t image_data_MSTahomaBold48_0x44[176] __PRGMTAG_  = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0f, 0xff, 0xf8, 0x00, 0x00, 0xff, 0xff, 0xf8, 0x00, 0x0f, 0xff, 0xff, 0xc0, 0x00, 0xff, 0xff, 0xff, 0x00, 0x0f, 0xff, 0xff, 0xf8, 0x00, 0xff, 0xff, 0xff, 0xc0, 0x0f, 0xff, 0xff, 0xfe, 0x00, 0xff, 0x81, 0xff, 0xe0, 0x0f, 0xf8, 0x07, 0xff, 0x00, 0xff, 0x80, 0x3f, 0xf0, 0x0f, 0xf8, 0x01, 0xff, 0x80, 0xff, 0x80, 0x0f, 0xf8, 0x0f, 0xf8, 0x00, 0xff, 0x80, 0xff, 0x80, 0x07, 0xfc, 0x0f, 0xf8, 0x00, 0x7f, 0xc0, 0xff, 0x80, 0x07, 0xfc, 0x0f, 0xf8, 0x00, 0x7f, 0xc0, 0xff, 0x80, 0x07, 0xfc, 0x0f, 0xf8, 0x00, 0x7f, 0xc0, 0xff, 0x80, 0x07, 0xfc, 0x0f, 0xf8, 0x00, 0x7f, 0xc0, 0xff, 0x80, 0x07, 0xfc, 0x0f, 0xf8, 0x00, 0xff, 0x80, 0xff, 0x80, 0x0f, 0xf8, 0x0f, 0xf8, 0x01, 0xff, 0x80, 0xff, 0x80, 0x3f, 0xf0, 0x0f, 0xf8, 0x07, 0xff, 0x00, 0xff, 0x81, 0xff, 0xe0, 0x0f, 0xff, 0xff, 0xfe, 0x00, 0xff, 0xff, 0xff, 0xc0, 0x0f, 0xff, 0xff, 0xf8, 0x00, 0xff, 0xff, 0xff, 0x00, 0x0f, 0xff, 0xff, 0xc0, 0x00, 0xff, 0xff, 0xf0, 0x00, 0x0f, 0xff, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};////character: 'D'
+
+static const tImage MSTahomaBold48_0x44 __PRGMTAG_ = { image_data_MSTahomaBold48_0x44,
+    36, 176};//character: 'D' , height: 39, (charW,total bytes)
+
+static const uint8_t image_data_MSTahomaBold48_0x45[147] __PRGMTAG_  = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x03, 0xff, 0xff, 0xfc, 0x0f, 0xff, 0xff, 0xf0, 0x3f, 0xff, 0xff, 0xc0, 0xff, 0xff, 0xff, 0x03, 0xff, 0xff, 0xfc, 0x0f, 0xff, 0xff, 0xf0, 0x3f, 0xe0, 0x00, 0x00, 0xff, 0x80, 0x00, 0x03, 0xfe, 0x00, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0xff, 0x80, 0x00, 0x03, 0xff, 0xff, 0xf8, 0x0f, 0xff, 0xff, 0xe0, 0x3f, 0xff, 0xff, 0x80, 0xff, 0xff, 0xfe, 0x03, 0xff, 0xff, 0xf8, 0x0f, 0xff, 0xff, 0xe0, 0x3f, 0xff, 0xff, 0x80, 0xff, 0x80, 0x00, 0x03, 0xfe, 0x00, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0xff, 0x80, 0x00, 0x03, 0xfe, 0x00, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0x3f, 0xe0, 0x00, 0x00, 0xff, 0xff, 0xff, 0x03, 0xff, 0xff, 0xfc, 0x0f, 0xff, 0xff, 0xf0, 0x3f, 0xff, 0xff, 0xc0, 0xff, 0xff, 0xff, 0x03, 0xff, 0xff, 0xfc, 0x0f, 0xff, 0xff, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};////character: 'E'
+
+static const tImage MSTahomaBold48_0x45 __PRGMTAG_ = { image_data_MSTahomaBold48_0x45,
+    30, 147};//character: 'E' , height: 39, (charW,total bytes)
+
+static const uint8_t image_data_MSTahomaBold48_0x46[137] __PRGMTAG_  = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0f, 0xff, 0xff, 0xe0, 0xff, 0xff, 0xfe, 0x0f, 0xff, 0xff, 0xe0, 0xff, 0xff, 0xfe, 0x0f, 0xff, 0xff, 0xe0, 0xff, 0xff, 0xfe, 0x0f, 0xff, 0xff, 0xe0, 0xff, 0x80, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0xff, 0x80, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0xff, 0x80, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0xff, 0xff, 0xfc, 0x0f, 0xff, 0xff, 0xc0, 0xff, 0xff, 0xfc, 0x0f, 0xff, 0xff, 0xc0, 0xff, 0xff, 0xfc, 0x0f, 0xff, 0xff, 0xc0, 0xff, 0xff, 0xfc, 0x0f, 0xf8, 0x00, 0x00, 0xff, 0x80, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0xff, 0x80, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0xff, 0x80, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0xff, 0x80, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0xff, 0x80, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0xff, 0x80, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0xff, 0x80, 0x00, 0x0f, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};////character: 'F'
+
+static const tImage MSTahomaBold48_0x46 __PRGMTAG_ = { image_data_MSTahomaBold48_0x46,
+    28, 137};//character: 'F' , height: 39, (charW,total bytes)
+
+
+static const tChar MSTahomaBold48_array[] = {
+
+  // character: ' '
+  {0x20, &MSTahomaBold48_0x20},
+  // character: '/'
+  {0x2f, &MSTahomaBold48_0x2f},
+  // character: '0'
+  {0x30, &MSTahomaBold48_0x30},
+  // character: '1'
+  {0x31, &MSTahomaBold48_0x31},
+  // character: '2'
+  {0x32, &MSTahomaBold48_0x32},
+  // character: '3'
+  {0x33, &MSTahomaBold48_0x33},
+  // character: '4'
+  {0x34, &MSTahomaBold48_0x34},
+  // character: '5'
+  {0x35, &MSTahomaBold48_0x35},
+  // character: '6'
+  {0x36, &MSTahomaBold48_0x36},
+  // character: '7'
+  {0x37, &MSTahomaBold48_0x37},
+  // character: '8'
+  {0x38, &MSTahomaBold48_0x38},
+  // character: '9'
+  {0x39, &MSTahomaBold48_0x39},
+  // character: ':'
+  {0x3a, &MSTahomaBold48_0x3a},
+  // character: 'A'
+  {0x41, &MSTahomaBold48_0x41},
+  // character: 'B'
+  {0x42, &MSTahomaBold48_0x42},
+  // character: 'C'
+  {0x43, &MSTahomaBold48_0x43},
+  // character: 'D'
+  {0x44, &MSTahomaBold48_0x44},
+  // character: 'E'
+  {0x45, &MSTahomaBold48_0x45},
+  // character: 'F'
+  {0x46, &MSTahomaBold48_0x46}
+};
+
+//num chars, array, width, height, compression
+
+const tFont MSTahomaBold48 = { 19, MSTahomaBold48_array,0,39,0 };
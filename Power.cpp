@@ -0,0 +1,182 @@
+/*
+Power.cpp
+Backlight dimming & panel off on a schedule, with the time spent in each state and the energy it took
+*/
+
+#include "Power.h"
+
+PowerManager::PowerManager()
+{
+	dimFrom = dimTo = offFrom = offTo = 0;
+	dimLevel = 0;
+	state = POWER_ON;
+	wakeAt = lastService = 0;
+	today = 0;
+	memset(stateMs, 0, sizeof(stateMs));
+	todayMj = yesterdayMj = 0;
+}
+
+// New schedule, from the settings. The state follows it on the next service()
+void PowerManager::setSchedule(uint8_t dimStart, uint8_t dimEnd, uint8_t offStart, uint8_t offEnd, uint8_t level)
+{
+	dimFrom = dimStart;
+	dimTo = dimEnd;
+	offFrom = offStart;
+	offTo = offEnd;
+	dimLevel = level;
+}
+
+// Quarter hour 'quarter' is in the period from-to. It runs over midnight if it ends before it starts
+bool PowerManager::inPeriod(uint8_t quarter, uint8_t from, uint8_t to)
+{
+	if (from <= to)
+		return (quarter >= from) && (quarter < to);
+	return (quarter >= from) || (quarter < to);
+}
+
+// A touch. Returns true if the face was dimmed or off, so the touch only wakes it and does nothing else
+bool PowerManager::wake()
+{
+	wakeAt = millis();
+	return state != POWER_ON;
+}
+
+uint16_t PowerManager::drawMw(uint8_t s)
+{
+	switch (s)
+	{
+	case POWER_DIM:
+		return POWER_BASE_MW + (uint16_t)(((uint32_t)POWER_BACKLIGHT_MW * level()) / POWER_FULL);
+	case POWER_OFF:
+		return POWER_OFF_MW;
+	}
+	return POWER_BASE_MW + POWER_BACKLIGHT_MW;
+}
+
+/*
+Once a second. Adds the time since the last call to the state the face was in, then works out the state for 'now'
+and puts the panel into it. 'awake' is something on the face that's being used (setup, the watch, a ringing alarm),
+which keeps it at full. Returns true if the state changed: the face then needs its seconds shown or hidden, or
+redrawing after being off.
+*/
+bool PowerManager::service(ClockScreen *disp, const struct ts *now, bool awake)
+{
+	unsigned long ms = millis(), elapsed = ms - lastService;
+	uint8_t quarter = (now->hour * 4) + (now->min / 15), want;
+
+	lastService = ms;
+	if (today != now->mday)		// New day. Today's figures become yesterday's
+	{
+		if (today)
+			yesterdayMj = todayMj;
+		today = now->mday;
+		todayMj = 0;
+		memset(stateMs, 0, sizeof(stateMs));
+	}
+	else
+	{
+		stateMs[state] += elapsed;
+		todayMj += ((uint32_t)drawMw(state) * elapsed) / 1000;
+	}
+
+	if (awake)
+		wakeAt = ms;
+	if ((ms - wakeAt) < POWER_WAKE_TIME)
+		want = POWER_ON;
+	else if ((offFrom != offTo) && inPeriod(quarter, offFrom, offTo))
+		want = POWER_OFF;
+	else if ((dimFrom != dimTo) && inPeriod(quarter, dimFrom, dimTo))
+		want = POWER_DIM;
+	else
+		want = POWER_ON;
+
+	if (want == state)
+		return false;
+
+	if (want == POWER_OFF)
+	{
+		disp->brightness(0);
+		disp->displayOn(false);
+	}
+	else
+	{
+		if (state == POWER_OFF)
+			disp->displayOn(true);
+		disp->brightness((want == POWER_DIM) ? level() : POWER_FULL);
+	}
+	state = want;
+	return true;
+}
+
+// HH:MM-HH:MM, or "none"
+void PowerManager::printPeriod(Print *out, uint8_t from, uint8_t to)
+{
+	uint8_t q, i;
+
+	if (from == to)
+	{
+		out->print(F("none"));
+		return;
+	}
+	for (i = 0; i < 2; ++i)
+	{
+		q = i ? to : from;
+		if (i)
+			out->print('-');
+		if (q / 4 < 10)
+			out->print('0');
+		out->print(q / 4);
+		out->print(':');
+		if (q % 4 == 0)
+			out->print('0');
+		out->print((q % 4) * 15);
+	}
+}
+
+/*
+Print one line of the report. The schedule, today's minutes in each state, and the energy today, what it would have
+been at full brightness, and yesterday's
+	power on dim 23:00-07:00 level 40 off 01:00-05:00
+	power minutes on 840 dim 60 off 240
+	power mWh 1234 full 2345 yesterday 3456
+Returns false once there are no more lines
+*/
+bool PowerManager::printLine(Print *out, uint8_t line)
+{
+	uint32_t total;
+	uint8_t i;
+
+	switch (line)
+	{
+	case 0:
+		out->print(F("power "));
+		out->print((state == POWER_ON) ? F("on") : ((state == POWER_DIM) ? F("dim") : F("off")));
+		out->print(F(" dim "));
+		printPeriod(out, dimFrom, dimTo);
+		out->print(F(" level "));
+		out->print(level());
+		out->print(F(" off "));
+		printPeriod(out, offFrom, offTo);
+		out->println();
+		return true;
+	case 1:
+		out->print(F("power minutes on "));
+		out->print(getMinutes(POWER_ON));
+		out->print(F(" dim "));
+		out->print(getMinutes(POWER_DIM));
+		out->print(F(" off "));
+		out->println(getMinutes(POWER_OFF));
+		return true;
+	case 2:
+		for (i = 0, total = 0; i < POWER_STATES; ++i)
+			total += stateMs[i];
+		out->print(F("power mWh "));
+		out->print(getTodayMwh());
+		out->print(F(" full "));
+		out->print((uint16_t)(((total / 1000) * (POWER_BASE_MW + POWER_BACKLIGHT_MW)) / 3600));
+		out->print(F(" yesterday "));
+		out->println(getYesterdayMwh());
+		return true;
+	}
+	return false;
+}
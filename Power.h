@@ -0,0 +1,87 @@
+// Power.h
+// Backlight dimming & panel off on a schedule, touch to wake, and the energy each day took
+
+#ifndef _POWER_h
+#define _POWER_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include "Layout.h"
+#include "ClockDrivers.h"
+
+// States
+#define POWER_ON			0		// Full brightness, seconds shown
+#define POWER_DIM			1		// Backlight turned down, seconds hidden, redrawn on the minute
+#define POWER_OFF			2		// Panel & backlight off. Nothing is drawn
+#define POWER_STATES		3
+
+/*
+The schedule
+A dim period and an off period, each a start & end in quarter hours since midnight (0-95). A period can run over
+midnight (23:00-07:00). Start and end the same is no period at all, which is what a blank schedule is. Off wins where
+they overlap. A touch, a ringing alarm, the setup screen or the watch brings the face back to full for as long as
+it's in use and POWER_WAKE_TIME after.
+*/
+#define POWER_QUARTERS		96		// Quarter hours in a day
+#define POWER_WAKE_TIME		30000	// ms at full brightness after the last touch
+#define POWER_FULL			255		// Backlight PWM
+#define POWER_DIM_DEFAULT	40		// Dimmed backlight when no level has been set
+#define POWER_REPORT_LINE	56		// Longest line printLine() writes
+
+/*
+Power draw in each state (mW), for the energy figures. These are ballpark figures for a 5V Pro Mini and the RA8875
+board from the panel's data sheet: measure your own clock's and put them in here. The backlight's share scales with
+the PWM level.
+*/
+#if LAYOUT_PANEL == PANEL_800x480
+#define POWER_BASE_MW		350		// Controller, panel logic, MCU & RTC
+#define POWER_BACKLIGHT_MW	1400	// LED backlight at full
+#else
+#define POWER_BASE_MW		300
+#define POWER_BACKLIGHT_MW	500
+#endif
+#define POWER_OFF_MW		200		// Display off, backlight off. The touch controller & MCU still run
+
+/*
+Works out the state from the schedule and the time, puts the panel into it, and adds up the time spent in each state
+today (and yesterday) and the energy it took. The sketch calls service() once a second, and wake() on a touch.
+*/
+class PowerManager
+{
+public:
+	PowerManager();
+	void setSchedule(uint8_t dimStart, uint8_t dimEnd, uint8_t offStart, uint8_t offEnd, uint8_t level);
+	uint8_t getDimFrom() { return dimFrom; }
+	uint8_t getDimTo() { return dimTo; }
+	uint8_t getOffFrom() { return offFrom; }
+	uint8_t getOffTo() { return offTo; }
+	uint8_t getDimLevel() { return dimLevel; }
+	uint8_t getState() { return state; }
+	bool wake();
+	bool service(ClockScreen *disp, const struct ts *now, bool awake);
+	uint16_t getMinutes(uint8_t s) { return stateMs[s] / 60000UL; }
+	uint16_t getTodayMwh() { return todayMj / 3600; }
+	uint16_t getYesterdayMwh() { return yesterdayMj / 3600; }
+	bool printLine(Print *out, uint8_t line);
+
+private:
+	uint8_t dimFrom, dimTo, offFrom, offTo;	// Quarter hours
+	uint8_t dimLevel;				// Backlight PWM while dimmed. 0 is POWER_DIM_DEFAULT
+	uint8_t state;
+	unsigned long wakeAt;			// millis() of the last touch, or the last time something kept the face awake
+	unsigned long lastService;		// millis() of the last service(), for the time in each state
+	uint8_t today;					// Day of the month the figures are for. 0 until the first service()
+	uint32_t stateMs[POWER_STATES];	// Time in each state today
+	uint32_t todayMj, yesterdayMj;	// Energy (mJ)
+
+	static bool inPeriod(uint8_t quarter, uint8_t from, uint8_t to);
+	uint8_t level() { return dimLevel ? dimLevel : POWER_DIM_DEFAULT; }
+	uint16_t drawMw(uint8_t s);
+	void printPeriod(Print *out, uint8_t from, uint8_t to);
+};
+
+#endif // _POWER_h
@@ -0,0 +1,77 @@
+/*
+Profiler.cpp
+Per-stage timing and bus counts for the drawing & RTC hot paths.
+
+Each instrumented function starts with PROF_STAGE(), which takes micros() and a snapshot of the bus counters, and
+records the difference when the function returns. Code that talks to the display or RTC bumps the bus counters with
+PROF_SPI()/PROF_I2C(). The cost is a couple of micros() calls per stage. Set PROFILE to 0 in Profiler.h and it all
+compiles away.
+
+The summary comes out over Serial on request, one short line at a time (see printLine()).
+*/
+
+#include "Profiler.h"
+
+#if PROFILE
+
+// Stage names for the report, in stage order
+static const char stageNames[PROF_STAGES][7] PROGMEM = { "rtime", "rclock", "dchar", "dbin", "touch", "rtc" };
+
+Profiler::Profiler()
+{
+	reset();
+}
+
+// Clear the totals and start a new measurement window
+void Profiler::reset()
+{
+	memset(stages, 0, sizeof(stages));
+	spiCount = 0;
+	i2cCount = 0;
+}
+
+void Profiler::record(uint8_t stage, unsigned long start, uint32_t spiStart, uint16_t i2cStart)
+{
+	profStage_t *s = &stages[stage];
+	unsigned long elapsed = micros() - start;
+
+	++s->count;
+	s->total += elapsed;
+	if (elapsed > s->max)
+		s->max = (elapsed > 0xFFFF) ? 0xFFFF : (uint16_t)elapsed;
+	s->spi += spiCount - spiStart;
+	s->i2c += i2cCount - i2cStart;
+}
+
+/*
+Print one line of the summary
+Line 0 is the column header, lines 1 to PROF_STAGES are the stages:
+	stage  runs  total-us  max-us  spi  i2c
+Returns false once there are no more lines
+*/
+bool Profiler::printLine(Print *out, uint8_t line)
+{
+	profStage_t *s;
+	char c;
+	uint8_t i;
+
+	if (line == 0)
+	{
+		out->println(F("stage n us max spi i2c"));
+		return true;
+	}
+	if (line > PROF_STAGES)
+		return false;
+
+	s = &stages[line - 1];
+	for (i = 0; (i < sizeof(stageNames[0])) && ((c = pgm_read_byte(&stageNames[line - 1][i])) != '\0'); ++i)
+		out->print(c);
+	out->print(' '); out->print(s->count);
+	out->print(' '); out->print(s->total);
+	out->print(' '); out->print(s->max);
+	out->print(' '); out->print(s->spi);
+	out->print(' '); out->println(s->i2c);
+	return true;
+}
+
+#endif // PROFILE
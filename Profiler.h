@@ -0,0 +1,85 @@
+// Profiler.h
+// Hot-path instrumentation. Times the main drawing and RTC stages and counts the bus traffic they cause.
+
+#ifndef _PROFILER_h
+#define _PROFILER_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#define PROFILE				1		// 0 compiles all the instrumentation out
+
+// Stages
+#define PROF_REFRESHTIME	0		// ClockDisplay::refreshTime()
+#define PROF_REFRESHCLOCK	1		// ClockDisplay::refreshClock()
+#define PROF_DRAWCHAR		2		// ClockDigit::drawChar()
+#define PROF_DRAWBINARY		3		// ClockDigit::drawBinary()
+#define PROF_TOUCH			4		// ClockDisplay::checkForTouchEvent()
+#define PROF_RTC			5		// DS3231 calls
+#define PROF_STAGES			6
+
+#define PROF_REPORT_LINE	40		// Longest line printLine() writes
+
+/*
+Per-stage totals since the last reset()
+Stages nest (drawChar runs inside refreshClock), and each stage's numbers include everything that ran inside it.
+*/
+typedef struct
+{
+	uint16_t count;		// Times the stage ran
+	uint32_t total;		// us spent in the stage
+	uint16_t max;		// Longest single run, us
+	uint32_t spi;		// Display driver calls. Each one is at least one SPI transaction with the RA8875
+	uint16_t i2c;		// I2C transactions with the RTC
+} profStage_t;
+
+class Profiler
+{
+public:
+	Profiler();
+	void reset();
+	void addSpi(uint8_t n) { spiCount += n; }
+	void addI2c(uint8_t n) { i2cCount += n; }
+	bool printLine(Print *out, uint8_t line);
+
+	// Used by PROF_STAGE(). Records one run of a stage
+	void record(uint8_t stage, unsigned long start, uint32_t spiStart, uint16_t i2cStart);
+	uint32_t getSpi() { return spiCount; }
+	uint16_t getI2c() { return i2cCount; }
+
+private:
+	profStage_t stages[PROF_STAGES];
+	uint32_t spiCount;			// Running bus counters. Stages take the difference across their run
+	uint16_t i2cCount;
+};
+
+#if PROFILE
+extern Profiler Prof;
+
+// Times the rest of the enclosing block as one run of a stage, early returns included
+class ProfScope
+{
+public:
+	ProfScope(uint8_t s) { stage = s; spiStart = Prof.getSpi(); i2cStart = Prof.getI2c(); start = micros(); }
+	~ProfScope() { Prof.record(stage, start, spiStart, i2cStart); }
+
+private:
+	unsigned long start;
+	uint32_t spiStart;
+	uint16_t i2cStart;
+	uint8_t stage;
+};
+
+	#define PROF_STAGE(s)	ProfScope _profScope(s)
+	#define PROF_SPI(n)		Prof.addSpi(n)
+	#define PROF_I2C(n)		Prof.addI2c(n)
+#else
+	#define PROF_STAGE(s)
+	#define PROF_SPI(n)
+	#define PROF_I2C(n)
+#endif
+
+#endif // _PROFILER_h
@@ -1,166 +1,306 @@
-// Wrapper class for DS3231 Real-Time clock module
-
-#include "RTClock.h"
-
-RTClockClass::RTClockClass()
-{
-}
-
-RTClockClass::~RTClockClass()
-{
-}
-
-// Initialize clock back to the beginning of time (00:00:00 1/1/2016)
-void RTClockClass::resetClock()
-{
-	t.hour = t.min = t.sec = 0;
-	t.mday = t.mon = 1;
-	t.year = 2016;				// Set to 2016 so you don't have to wind up from 2000 when resetting clock
-	t.year_s = 16;
-
-	DS3231_set(t);	// Set updated time
-
-	return;
-}
-
-// Get a unit of time from the RTC
-uint8_t RTClockClass::getUnit(uint8_t unit)
-{
-	DS3231_get(&t); // Get updated time
-
-	switch (unit)
-	{
-	case UNIT_HOUR:
-		return t.hour;
-		break;
-	case UNIT_MINUTE:
-		return t.min;
-		break;
-	case UNIT_SECOND:
-		return t.sec;
-		break;
-	case UNIT_DAY:
-		return t.mday;
-		break;
-	case UNIT_MONTH:
-		return t.mon;
-		break;
-	case UNIT_YEAR:
-		return t.year;
-		break;
-	case UNIT_YEAR_SHORT:
-		return t.year_s;
-		break;
-	}
-}
-
-
-// Define number of days in each month (ignoring February shenanigans)
-uint8_t monthDays[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
-
-// Increment a specific clock segment by 1 unit
-void RTClockClass::incrementUnit(uint8_t unit)
-{
-	bool isLeap = false;	// account for leap year
-	
-	switch (unit)
-	{
-	case UNIT_HOUR:
-		if (++t.hour == 24)
-			t.hour = 0;
-		break;
-	case UNIT_MINUTE:
-		if (++t.min == 60)
-			t.min = 0;
-		t.sec = 0;
-		break;
-	case UNIT_SECOND:
-		++t.sec;
-		break;
-	case UNIT_DAY:
-		++t.mday;
-		switch (t.mon) // See which month you're incrementing, adjust accordingly
-		{
-			case 1: if (t.mday >= 32) t.mday = 1; break;
-			case 2: // Leap year evil-ness
-				if ((t.year % 4 == 0) && !(t.year % 100 == 0) || (t.year % 400 == 0))
-					isLeap = true;
-				if ((t.mday >= 29) && !isLeap) // Normal Year
-					t.mday = 1;
-				else if (t.mday >= 30) // Leap year
-					t.mday = 1;
-				break;
-			case 3: if (t.mday >= 32) t.mday = 1; break;
-			case 4: if (t.mday >= 31) t.mday = 1; break;
-			case 5: if (t.mday >= 32) t.mday = 1; break;
-			case 6: if (t.mday >= 31) t.mday = 1; break;
-			case 7: if (t.mday >= 32) t.mday = 1; break;
-			case 8: if (t.mday >= 32) t.mday = 1; break;
-			case 9: if (t.mday >= 31) t.mday = 1; break;
-			case 10: if (t.mday >= 32) t.mday = 1; break;
-			case 11: if (t.mday >= 31) t.mday = 1; break;
-			case 12: if (t.mday >= 32) t.mday = 1; break;
-		}
-		break;
-	case UNIT_MONTH:
-		if (++t.mon == 13)
-			t.mon = 1;
-		if (t.mday > monthDays[t.mon - 1])  // Day is set higher than new month will allow
-			t.mday = monthDays[t.mon - 1];
-		break;
-	case UNIT_YEAR:
-		++t.year;
-		++t.year_s;
-		break;
-	}
-
-	DS3231_set(t);		// Update new time
-}
-
-// Decrement a specific clock segment by 1 unit
-void RTClockClass::decrementUnit(uint8_t unit)
-{
-	switch (unit)
-	{
-	case UNIT_HOUR:
-		if (t.hour == 0) t.hour = 23; else --t.hour;
-		break;
-	case UNIT_MINUTE:
-		if (t.min == 0)	t.min = 59; else --t.min;
-		t.sec = 0;
-		break;
-	case UNIT_DAY:
-		if (--t.mday == 0)
-		{
-			switch (t.mon) // See which month you're incrementing, adjust accordingly
-			{
-			case 1: t.mday = 31; break;
-			case 2: // Leap year evil-ness
-				if ((t.year % 4 == 0) && !(t.year % 100 == 0) || (t.year % 400 == 0))
-					t.mday = 29;
-				else t.mday = 28;
-				break;
-			case 3: t.mday = 31; break;
-			case 4: t.mday = 30; break;
-			case 5: t.mday = 31; break;
-			case 6: t.mday = 30; break;
-			case 7: t.mday = 31; break;
-			case 8: t.mday = 31; break;
-			case 9: t.mday = 30; break;
-			case 10: t.mday = 31; break;
-			case 11: t.mday = 30; break;
-			case 12: t.mday = 31; break;
-			}
-		}
-		break;
-	case UNIT_MONTH:
-		if (--t.mon == 0) t.mon = 12;
-		break;
-	case UNIT_YEAR:
-		--t.year;
-		--t.year_s;
-		break;
-	}
-
-	DS3231_set(t);		// Update new time
+// Wrapper class for DS3231 Real-Time clock module
+
+#include "RTClock.h"
+#include "Profiler.h"
+
+RTClockClass::RTClockClass()
+{
+}
+
+RTClockClass::~RTClockClass()
+{
+}
+
+// Initialize clock back to the beginning of time (00:00:00 1/1/2016)
+void RTClockClass::resetClock()
+{
+	t.hour = t.min = t.sec = 0;
+	t.mday = t.mon = 1;
+	t.year = 2016;				// Set to 2016 so you don't have to wind up from 2000 when resetting clock
+	t.year_s = 16;
+
+	PROF_STAGE(PROF_RTC);
+	PROF_I2C(1);
+	DS3231_set(t);	// Set updated time
+
+	return;
+}
+
+// Read the whole time from the RTC in one go
+void RTClockClass::readTime()
+{
+	PROF_STAGE(PROF_RTC);
+	PROF_I2C(2);	// Register pointer write, then the read
+	DS3231_get(&t); // Get updated time
+}
+
+// Set the whole time in one go
+void RTClockClass::setTime(struct ts *tm)
+{
+	t = *tm;
+	PROF_STAGE(PROF_RTC);
+	PROF_I2C(1);
+	DS3231_set(t);
+}
+
+/*
+Load one of the DS3231 alarms. It goes off at 'at' (alarm 2 ignores the seconds), on that date
+Any flag left over from what was in it before is cleared, so the next one seen is for this time
+*/
+void RTClockClass::setAlarm(uint8_t which, const struct ts *at)
+{
+	uint8_t flags[5] = { 0, 0, 0, 0, 0 };	// Nothing masked, day field is the date
+
+	PROF_STAGE(PROF_RTC);
+	PROF_I2C(4);	// Alarm registers, then the status register read & write back
+	if (which == RTC_ALARM_1)
+	{
+		DS3231_set_a1(at->sec, at->min, at->hour, at->mday, flags);
+		DS3231_set_sreg(DS3231_get_sreg() & ~DS3231_A1F);
+	}
+	else
+	{
+		DS3231_set_a2(at->min, at->hour, at->mday, flags);
+		DS3231_set_sreg(DS3231_get_sreg() & ~DS3231_A2F);
+	}
+}
+
+// Read which alarms have gone off (DS3231_A1F, DS3231_A2F) and clear them. Only writes back if one has
+uint8_t RTClockClass::takeAlarms()
+{
+	uint8_t sreg, fired;
+
+	PROF_STAGE(PROF_RTC);
+	PROF_I2C(2);
+	sreg = DS3231_get_sreg();
+	fired = sreg & (DS3231_A1F | DS3231_A2F);
+	if (fired)
+	{
+		PROF_I2C(1);
+		DS3231_set_sreg(sreg & ~fired);
+	}
+	return fired;
+}
+
+// Get a unit of time from the RTC
+uint8_t RTClockClass::getUnit(uint8_t unit)
+{
+	readTime();
+	return unitOf(&t, unit);
+}
+
+// Pick a unit out of a time structure
+uint8_t RTClockClass::unitOf(const struct ts *tm, uint8_t unit)
+{
+	switch (unit)
+	{
+	case UNIT_HOUR:
+		return tm->hour;
+		break;
+	case UNIT_MINUTE:
+		return tm->min;
+		break;
+	case UNIT_SECOND:
+		return tm->sec;
+		break;
+	case UNIT_DAY:
+		return tm->mday;
+		break;
+	case UNIT_MONTH:
+		return tm->mon;
+		break;
+	case UNIT_YEAR:
+		return tm->year;
+		break;
+	case UNIT_YEAR_SHORT:
+		return tm->year_s;
+		break;
+	}
+	return 0;
+}
+
+
+// Define number of days in each month (ignoring February shenanigans)
+uint8_t monthDays[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+// Days in a month, leap years included
+uint8_t RTClockClass::daysInMonth(uint8_t mon, uint16_t year)
+{
+	if ((mon == 2) && (((year % 4 == 0) && !(year % 100 == 0)) || (year % 400 == 0)))
+		return 29;
+	return monthDays[mon - 1];
+}
+
+// Seconds since 00:00:00 1/1/2000, the start of the DS3231's calendar
+uint32_t RTClockClass::toSeconds(const struct ts *tm)
+{
+	uint32_t days = 0;
+	uint16_t y;
+	uint8_t m;
+
+	for (y = 2000; y < tm->year; ++y)
+		days += (daysInMonth(2, y) == 29) ? 366 : 365;
+	for (m = 1; m < tm->mon; ++m)
+		days += daysInMonth(m, tm->year);
+	days += tm->mday - 1;
+	return ((days * 24 + tm->hour) * 60 + tm->min) * 60 + tm->sec;
+}
+
+// And back again
+void RTClockClass::fromSeconds(uint32_t secs, struct ts *tm)
+{
+	uint32_t days = secs / 86400UL;
+	uint16_t len;
+
+	memset(tm, 0, sizeof(*tm));
+	secs %= 86400UL;
+	tm->sec = secs % 60;
+	tm->min = (secs / 60) % 60;
+	tm->hour = secs / 3600;
+	tm->wday = ((days + 6) % 7) + 1;	// 1/1/2000 was a Saturday. 1 = Sunday
+
+	for (tm->year = 2000; days >= (len = (daysInMonth(2, tm->year) == 29) ? 366 : 365); ++tm->year)
+		days -= len;
+	for (tm->mon = 1; days >= daysInMonth(tm->mon, tm->year); ++tm->mon)
+		days -= daysInMonth(tm->mon, tm->year);
+	tm->mday = days + 1;
+	tm->year_s = tm->year % 100;
+}
+
+/*
+Work out the time one second after the last read, without going back to the RTC
+Carries all the way up through the date, so the digits for the next second can be got ready before the tick
+*/
+void RTClockClass::getNextSecond(struct ts *next)
+{
+	*next = t;
+	if (++next->sec < 60)
+		return;
+	next->sec = 0;
+	if (++next->min < 60)
+		return;
+	next->min = 0;
+	if (++next->hour < 24)
+		return;
+	next->hour = 0;
+
+	if (++next->mday <= daysInMonth(next->mon, next->year))
+		return;
+	next->mday = 1;
+	if (++next->mon <= 12)
+		return;
+	next->mon = 1;
+	++next->year;
+	++next->year_s;
+}
+
+// Increment a specific clock segment by 1 unit
+void RTClockClass::incrementUnit(uint8_t unit)
+{
+	bool isLeap = false;	// account for leap year
+	
+	switch (unit)
+	{
+	case UNIT_HOUR:
+		if (++t.hour == 24)
+			t.hour = 0;
+		break;
+	case UNIT_MINUTE:
+		if (++t.min == 60)
+			t.min = 0;
+		t.sec = 0;
+		break;
+	case UNIT_SECOND:
+		++t.sec;
+		break;
+	case UNIT_DAY:
+		++t.mday;
+		switch (t.mon) // See which month you're incrementing, adjust accordingly
+		{
+			case 1: if (t.mday >= 32) t.mday = 1; break;
+			case 2: // Leap year evil-ness
+				if (((t.year % 4 == 0) && !(t.year % 100 == 0)) || (t.year % 400 == 0))
+					isLeap = true;
+				if ((t.mday >= 29) && !isLeap) // Normal Year
+					t.mday = 1;
+				else if (t.mday >= 30) // Leap year
+					t.mday = 1;
+				break;
+			case 3: if (t.mday >= 32) t.mday = 1; break;
+			case 4: if (t.mday >= 31) t.mday = 1; break;
+			case 5: if (t.mday >= 32) t.mday = 1; break;
+			case 6: if (t.mday >= 31) t.mday = 1; break;
+			case 7: if (t.mday >= 32) t.mday = 1; break;
+			case 8: if (t.mday >= 32) t.mday = 1; break;
+			case 9: if (t.mday >= 31) t.mday = 1; break;
+			case 10: if (t.mday >= 32) t.mday = 1; break;
+			case 11: if (t.mday >= 31) t.mday = 1; break;
+			case 12: if (t.mday >= 32) t.mday = 1; break;
+		}
+		break;
+	case UNIT_MONTH:
+		if (++t.mon == 13)
+			t.mon = 1;
+		if (t.mday > monthDays[t.mon - 1])  // Day is set higher than new month will allow
+			t.mday = monthDays[t.mon - 1];
+		break;
+	case UNIT_YEAR:
+		++t.year;
+		++t.year_s;
+		break;
+	}
+
+	PROF_STAGE(PROF_RTC);
+	PROF_I2C(1);
+	DS3231_set(t);		// Update new time
+}
+
+// Decrement a specific clock segment by 1 unit
+void RTClockClass::decrementUnit(uint8_t unit)
+{
+	switch (unit)
+	{
+	case UNIT_HOUR:
+		if (t.hour == 0) t.hour = 23; else --t.hour;
+		break;
+	case UNIT_MINUTE:
+		if (t.min == 0)	t.min = 59; else --t.min;
+		t.sec = 0;
+		break;
+	case UNIT_DAY:
+		if (--t.mday == 0)
+		{
+			switch (t.mon) // See which month you're incrementing, adjust accordingly
+			{
+			case 1: t.mday = 31; break;
+			case 2: // Leap year evil-ness
+				if (((t.year % 4 == 0) && !(t.year % 100 == 0)) || (t.year % 400 == 0))
+					t.mday = 29;
+				else t.mday = 28;
+				break;
+			case 3: t.mday = 31; break;
+			case 4: t.mday = 30; break;
+			case 5: t.mday = 31; break;
+			case 6: t.mday = 30; break;
+			case 7: t.mday = 31; break;
+			case 8: t.mday = 31; break;
+			case 9: t.mday = 30; break;
+			case 10: t.mday = 31; break;
+			case 11: t.mday = 30; break;
+			case 12: t.mday = 31; break;
+			}
+		}
+		break;
+	case UNIT_MONTH:
+		if (--t.mon == 0) t.mon = 12;
+		break;
+	case UNIT_YEAR:
+		--t.year;
+		--t.year_s;
+		break;
+	}
+
+	PROF_STAGE(PROF_RTC);
+	PROF_I2C(1);
+	DS3231_set(t);		// Update new time
 }
\ No newline at end of file
@@ -1,41 +1,61 @@
-// RTClock.h
-
-#ifndef _RTCLOCK_h
-#define _RTCLOCK_h
-
-#if defined(ARDUINO) && ARDUINO >= 100
-	#include "arduino.h"
-#else
-	#include "WProgram.h"
-#endif
-
-// RTC Header Files
-#include <Wire.h>
-#include <ds3231.h>
-
-// Define Time Structure Units
-#define UNIT_NULL		0
-#define UNIT_HOUR		1
-#define UNIT_MINUTE		2
-#define UNIT_SECOND		3
-#define UNIT_MONTH		4
-#define UNIT_DAY		5
-#define UNIT_YEAR_SHORT	6
-#define UNIT_YEAR		7
-
-class RTClockClass
-{
-public:
-	RTClockClass();
-	~RTClockClass();
-	void resetClock();
-	void incrementUnit(uint8_t);
-	void decrementUnit(uint8_t);
-	uint8_t getUnit(uint8_t);
-
-private:
-	struct ts t; // RTC time structure
-};
-
-#endif  // _RTCLOCK_H
-
+// RTClock.h
+
+#ifndef _RTCLOCK_h
+#define _RTCLOCK_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+// RTC Header Files
+#include <Wire.h>
+#include <ds3231.h>
+
+// Define Time Structure Units
+#define UNIT_NULL		0
+#define UNIT_HOUR		1
+#define UNIT_MINUTE		2
+#define UNIT_SECOND		3
+#define UNIT_MONTH		4
+#define UNIT_DAY		5
+#define UNIT_YEAR_SHORT	6
+#define UNIT_YEAR		7
+
+/*
+DS3231 alarms
+Alarm 1 matches to the second, alarm 2 at :00 of a minute. Both are set to match the date as well, so an alarm goes
+off once rather than every day or month. The INT/SQW pin stays the 1Hz square wave (INTCN off), so the alarms don't
+pull it. They still latch their flags in the status register when they match, and takeAlarms() reads & clears them.
+*/
+#define RTC_ALARM_1		1		// Seconds resolution
+#define RTC_ALARM_2		2		// Minutes resolution
+#define RTC_ALARM_NEVER	0		// Date 0 never comes round, so an alarm set to it never matches
+
+class RTClockClass
+{
+public:
+	RTClockClass();
+	~RTClockClass();
+	void resetClock();
+	void incrementUnit(uint8_t);
+	void decrementUnit(uint8_t);
+	uint8_t getUnit(uint8_t);
+	void readTime();
+	void setTime(struct ts *tm);
+	struct ts *getTime() { return &t; }		// Time from the last read. No I2C
+	void getNextSecond(struct ts *next);
+	void setAlarm(uint8_t which, const struct ts *at);
+	uint8_t takeAlarms();
+	static uint8_t unitOf(const struct ts *tm, uint8_t unit);
+	static uint8_t daysInMonth(uint8_t mon, uint16_t year);
+	static uint32_t toSeconds(const struct ts *tm);
+	static void fromSeconds(uint32_t secs, struct ts *tm);
+
+private:
+	struct ts t; // RTC time structure
+};
+
+#endif  // _RTCLOCK_H
+
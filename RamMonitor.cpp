@@ -0,0 +1,142 @@
+/*
+RamMonitor.cpp
+Stack painting & free RAM high-water marks.
+
+The AVR has no memory protection. When the stack grows down into the heap and globals it just overwrites them, and
+the clock goes strange or resets with no clue why. Painting the free RAM and looking for how much of the paint is left
+shows how close that has come.
+*/
+
+#include "RamMonitor.h"
+
+#if defined(__AVR__)
+
+extern uint8_t _end;		// End of .bss/.noinit. The heap starts here
+extern uint8_t __stack;		// Top of RAM
+extern char *__brkval;		// Top of the heap. 0 until malloc() has been used
+
+// Paint all of free RAM before anything uses the stack. Runs from .init1, ahead of the C runtime startup.
+void ramPaint(void) __attribute__((naked, used, section(".init1")));
+void ramPaint(void)
+{
+	uint8_t *p = &_end;
+
+	while (p <= &__stack)
+		*p++ = RAM_PAINT;
+}
+
+// Lowest byte the stack could grow into
+static uint8_t *ramBottom()
+{
+	return (__brkval == 0) ? &_end : (uint8_t *)__brkval;
+}
+
+// Current stack pointer
+static uint8_t *ramStackPointer()
+{
+	return (uint8_t *)SP;
+}
+
+#else
+
+// No AVR memory map to look at on other builds (the simulator). Watch a block that nothing uses, so the marks just
+// show the whole block free.
+#define RAM_HOST_SIZE	2048
+static uint8_t hostRam[RAM_HOST_SIZE];
+static uint8_t *ramBottom() { return hostRam; }
+static uint8_t *ramStackPointer() { return hostRam + RAM_HOST_SIZE - 1; }
+
+#endif
+
+RamMonitor::RamMonitor()
+{
+	uint8_t i;
+
+	for (i = 0; i < RAM_MODES; ++i)
+		marks[i] = 0xFFFF;
+	lowest = 0xFFFF;
+	mode = RAM_MODE_MAIN;
+	redrawFrom = RAM_MODE_MAIN;
+#if !defined(__AVR__)
+	memset(hostRam, RAM_PAINT, sizeof(hostRam));
+#endif
+}
+
+// Count the paint left above the heap. Stops at the first byte the stack has touched.
+uint16_t RamMonitor::scan()
+{
+	uint8_t *p = ramBottom(), *sp = ramStackPointer();
+	uint16_t n = 0;
+
+	while ((p < sp) && (*p == RAM_PAINT))
+	{
+		++p;
+		++n;
+	}
+	return n;
+}
+
+// Paint the free RAM again, up to just below where the stack is now
+void RamMonitor::repaint()
+{
+	uint8_t *p = ramBottom(), *top = ramStackPointer() - RAM_REPAINT_MARGIN;
+
+	while (p < top)
+		*p++ = RAM_PAINT;
+}
+
+// Charge the free gap since the last paint to the current mode
+void RamMonitor::checkpoint()
+{
+	uint16_t gap = scan();
+
+	if (gap < marks[mode])
+		marks[mode] = gap;
+	if (gap < lowest)
+		lowest = gap;
+}
+
+// Switch modes. Whatever the old mode used is charged to it, then the paint is renewed for the new one
+void RamMonitor::setMode(uint8_t m)
+{
+	checkpoint();
+	repaint();
+	mode = m;
+}
+
+// Full redraws get their own mark, then go back to the mode they interrupted
+void RamMonitor::enterRedraw()
+{
+	redrawFrom = mode;
+	setMode(RAM_MODE_REDRAW);
+}
+
+void RamMonitor::leaveRedraw()
+{
+	setMode(redrawFrom);
+}
+
+/*
+Print one line of the report: one line per mode, then the lowest overall
+	ram main 412
+Modes that haven't run yet show -. Returns false once there are no more lines
+*/
+bool RamMonitor::printLine(Print *out, uint8_t line)
+{
+	uint16_t v;
+
+	switch (line)
+	{
+	case RAM_MODE_MAIN: out->print(F("ram main ")); v = marks[RAM_MODE_MAIN]; break;
+	case RAM_MODE_SETUP: out->print(F("ram setup ")); v = marks[RAM_MODE_SETUP]; break;
+	case RAM_MODE_REDRAW: out->print(F("ram redraw ")); v = marks[RAM_MODE_REDRAW]; break;
+	case RAM_MODES: out->print(F("ram low ")); v = lowest; break;
+	default: return false;
+	}
+
+	if (v == 0xFFFF)
+		out->println('-');
+	else
+		out->println(v);
+	return true;
+}
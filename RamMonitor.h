@@ -0,0 +1,53 @@
+// RamMonitor.h
+// Stack painting & free RAM high-water marks
+
+#ifndef _RAMMONITOR_h
+#define _RAMMONITOR_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#define RAM_PAINT			0xC5	// Fill pattern for unused RAM. Stack use overwrites it
+#define RAM_REPAINT_MARGIN	16		// Bytes left alone just below the stack pointer when repainting (interrupt frames)
+#define RAM_WARN_THRESHOLD	128		// Show a warning on screen when the free gap has ever dropped below this many bytes
+#define RAM_REPORT_LINE		24		// Longest line printLine() writes
+
+// Modes that get their own high-water mark
+#define RAM_MODE_MAIN		0		// Clock face
+#define RAM_MODE_SETUP		1		// Setup screen
+#define RAM_MODE_REDRAW		2		// Full clock face redraw
+#define RAM_MODES			3
+#define RAM_REPORT_LINES	(RAM_MODES + 1)	// printLine() lines: each mode, then the lowest
+
+/*
+Tracks how close the stack has come to the heap
+Free RAM is painted with RAM_PAINT at reset. scan() counts the painted bytes still left above the heap, which is the
+smallest gap there has been between the heap and the stack since the last paint. Each mode change repaints the free
+RAM, so every scan can be charged to the mode that was running.
+*/
+class RamMonitor
+{
+public:
+	RamMonitor();
+	void setMode(uint8_t m);
+	void enterRedraw();
+	void leaveRedraw();
+	void checkpoint();
+	uint16_t getLowest() { return lowest; }
+	uint16_t getMark(uint8_t m) { return marks[m]; }
+	bool printLine(Print *out, uint8_t line);
+
+private:
+	uint16_t marks[RAM_MODES];	// Smallest free gap seen in each mode. 0xFFFF = mode hasn't run yet
+	uint16_t lowest;			// Smallest free gap seen since boot
+	uint8_t mode;				// Mode being charged now
+	uint8_t redrawFrom;			// Mode to go back to after a redraw
+
+	uint16_t scan();
+	void repaint();
+};
+
+#endif // _RAMMONITOR_h
@@ -0,0 +1,213 @@
+/*
+Scheduler.cpp
+Cooperative earliest-deadline-first scheduler for the main loop.
+Tasks run to completion. Nothing preempts them, so a task has to keep within its budget or it holds everything else up.
+When no task is due the CPU sleeps until the next interrupt.
+*/
+
+#include "Scheduler.h"
+#include <avr/sleep.h>
+
+TaskScheduler::TaskScheduler()
+{
+	numTasks = 0;
+	busyTime = 0;
+	windowStart = 0;
+}
+
+TaskScheduler::~TaskScheduler()
+{
+}
+
+/*
+Add a task to the table
+name - Task name, for the stats dump. Use F("name")
+func - Function to run
+period - ms between runs. 0 for a task that only runs when triggered
+deadline - ms after the task becomes due by which it must start. Decides which task runs first when several are due.
+budget - us the task may run for. Longer runs are counted as overruns.
+Returns the task id to use with trigger(), or SCHED_NO_TASK if the table is full
+*/
+int8_t TaskScheduler::addTask(const __FlashStringHelper *name, void (*func)(void), uint16_t period, uint16_t deadline, uint16_t budget)
+{
+	schedTask_t *t;
+
+	if (numTasks >= MAXTASKS)
+		return SCHED_NO_TASK;
+
+	t = &tasks[numTasks];
+	t->func = func;
+	t->name = name;
+	t->period = period;
+	t->deadline = deadline;
+	t->budget = budget;
+	t->due = millis() + period;
+	t->triggered = false;
+	t->runs = t->overruns = t->misses = t->maxTime = 0;
+
+	return numTasks++;
+}
+
+// Mark a task as due right now. Safe to call from an interrupt handler.
+void TaskScheduler::trigger(int8_t id)
+{
+	if ((id < 0) || (id >= numTasks))
+		return;
+
+	if (!tasks[id].triggered)
+	{
+		tasks[id].due = millis();
+		tasks[id].triggered = true;
+	}
+}
+
+// Change how often a task runs. 0 stops it running except when triggered
+void TaskScheduler::setPeriod(int8_t id, uint16_t period)
+{
+	if ((id < 0) || (id >= numTasks))
+		return;
+
+	tasks[id].period = period;
+	tasks[id].due = millis() + period;
+}
+
+/*
+Run the due task with the earliest deadline
+Returns true if a task ran, false if nothing was due
+*/
+bool TaskScheduler::runNext()
+{
+	unsigned long now = millis(), start, elapsed, bestDeadline = 0;
+	schedTask_t *t;
+	int8_t i, best = SCHED_NO_TASK;
+
+	for (i = 0; i < numTasks; ++i)
+	{
+		t = &tasks[i];
+		if (t->triggered || ((t->period != 0) && ((long)(now - t->due) >= 0)))
+		{
+			if ((best == SCHED_NO_TASK) || ((long)((t->due + t->deadline) - bestDeadline) < 0))
+			{
+				best = i;
+				bestDeadline = t->due + t->deadline;
+			}
+		}
+	}
+
+	if (best == SCHED_NO_TASK)
+		return false;
+
+	t = &tasks[best];
+	t->triggered = false;	// Clear first, so a trigger that arrives while the task runs isn't lost
+	if ((long)(now - bestDeadline) > 0)
+		++t->misses;
+
+	start = micros();
+	t->func();
+	elapsed = micros() - start;
+
+	busyTime += elapsed;
+	++t->runs;
+	if (elapsed > t->budget)
+		++t->overruns;
+	if (elapsed > t->maxTime)
+		t->maxTime = (elapsed > 0xFFFF) ? 0xFFFF : (uint16_t)elapsed;
+
+	if (t->period != 0)
+	{
+		t->due += t->period;
+		if ((long)(now - t->due) >= 0)	// Fell more than a whole period behind. Don't try to catch up.
+			t->due = now + t->period;
+	}
+
+	return true;
+}
+
+/*
+One pass of the main loop. Run a task if one is due, otherwise sleep.
+Call this from loop().
+*/
+void TaskScheduler::run()
+{
+	if (!runNext())
+		idle();
+}
+
+/*
+Nothing to do. Sleep until the next interrupt.
+Idle is the deepest sleep mode that keeps Timer0 (and with it millis() & micros()) running, which the scheduler needs
+for its periods and deadlines. Any interrupt wakes it: the RTC tick, the RA8875 touch interrupt, serial, or the 1ms
+Timer0 tick. Power-down would stop millis() and the UART, so it isn't used here.
+*/
+void TaskScheduler::idle()
+{
+	uint8_t i;
+
+	set_sleep_mode(SLEEP_MODE_IDLE);
+	noInterrupts();
+	for (i = 0; i < numTasks; ++i)	// Something may have been triggered since runNext() looked
+	{
+		if (tasks[i].triggered)
+		{
+			interrupts();
+			return;
+		}
+	}
+	sleep_enable();
+	interrupts();	// The instruction after sei always executes, so there's no window for an interrupt to slip in
+	sleep_cpu();
+	sleep_disable();
+}
+
+// CPU duty cycle since the last resetStats(), in tenths of a percent
+uint16_t TaskScheduler::getDutyCycle()
+{
+	unsigned long window = (micros() - windowStart) / 1000;
+
+	if (window == 0)
+		return 0;
+	return (uint16_t)(busyTime / window);
+}
+
+/*
+Print one line of the stats report
+Lines 0 to getTaskCount()-1 are the tasks, the line after that is the CPU duty cycle.
+Each line is short enough to fit in the Serial transmit buffer, so printing one never blocks.
+Returns false once there are no more lines
+*/
+bool TaskScheduler::printStatsLine(Print *out, uint8_t line)
+{
+	schedTask_t *t;
+	uint16_t duty;
+
+	if (line < numTasks)
+	{
+		t = &tasks[line];
+		out->print(t->name);
+		out->print(F(" run=")); out->print(t->runs);
+		out->print(F(" ovr=")); out->print(t->overruns);
+		out->print(F(" late=")); out->print(t->misses);
+		out->print(F(" max=")); out->println(t->maxTime);
+		return true;
+	}
+	else if (line == numTasks)
+	{
+		duty = getDutyCycle();
+		out->print(F("cpu "));
+		out->print(duty / 10); out->print('.'); out->print(duty % 10);
+		out->println('%');
+		return true;
+	}
+	return false;
+}
+
+// Start a new measurement window for the duty cycle and the task counts, so each report covers one window
+void TaskScheduler::resetStats()
+{
+	uint8_t i;
+
+	for (i = 0; i < numTasks; ++i)
+		tasks[i].runs = tasks[i].overruns = tasks[i].misses = tasks[i].maxTime = 0;
+	busyTime = 0;
+	windowStart = micros();
+}
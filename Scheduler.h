@@ -0,0 +1,63 @@
+// Scheduler.h
+// Small cooperative scheduler for the main loop
+
+#ifndef _SCHEDULER_h
+#define _SCHEDULER_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#define MAXTASKS			9		// Size of the task table
+#define SCHED_NO_TASK		-1		// addTask() return value when the table is full
+
+// Diagnostics output
+#define SCHED_REPORT_LINE	48		// Longest line printStatsLine() writes. Only print when Serial has this much room
+
+/*
+One entry in the task table
+A task is due when its period has elapsed (periodic tasks) or when something has called trigger() on it (event tasks).
+A task can be both. When several tasks are due, the one with the earliest deadline runs first.
+*/
+typedef struct
+{
+	void (*func)(void);					// Task function
+	const __FlashStringHelper *name;	// Task name for the stats dump
+	uint16_t period;					// ms between runs. 0 = only runs when triggered
+	uint16_t deadline;					// ms after becoming due that the task must have started by
+	uint16_t budget;					// us the task is allowed to run for
+	unsigned long due;					// millis() when the task next becomes due
+	volatile bool triggered;			// Set by trigger(). May be set from an ISR
+	uint16_t runs;						// Number of times the task has run since the last resetStats()
+	uint16_t overruns;					// Runs that took longer than budget
+	uint16_t misses;					// Runs that started after the deadline
+	uint16_t maxTime;					// Longest run in us
+} schedTask_t;
+
+class TaskScheduler
+{
+public:
+	TaskScheduler();
+	~TaskScheduler();
+	int8_t addTask(const __FlashStringHelper *name, void (*func)(void), uint16_t period, uint16_t deadline, uint16_t budget);
+	void trigger(int8_t id);
+	void setPeriod(int8_t id, uint16_t period);
+	bool runNext();
+	void run();
+	uint16_t getDutyCycle();
+	bool printStatsLine(Print *out, uint8_t line);
+	void resetStats();
+	uint8_t getTaskCount() { return numTasks; }
+
+private:
+	schedTask_t tasks[MAXTASKS];
+	uint8_t numTasks;
+	uint32_t busyTime;					// us spent running tasks since the last resetStats()
+	unsigned long windowStart;			// micros() at the last resetStats()
+
+	void idle();
+};
+
+#endif // _SCHEDULER_h
@@ -0,0 +1,69 @@
+/*
+ScratchArena.cpp
+One block of RAM shared by the modes that need a lot of it for a while.
+A Pro Mini has 2K of RAM. Buttons that are only on the screen during setup, or buffers only needed while a screenshot
+goes out, don't need RAM of their own the rest of the time, and the features still to come need somewhere to live.
+*/
+
+#include "ScratchArena.h"
+
+ScratchArena::ScratchArena(void *mem, uint16_t len)
+{
+	uint8_t i;
+
+	block = (uint8_t *)mem;
+	size = len;
+	owner = ARENA_FREE;
+	for (i = 0; i < ARENA_OWNERS; ++i)
+		peak[i] = 0;
+	evictions = 0;
+}
+
+/*
+Take len bytes of the arena for who. The block comes back cleared.
+Returns NULL if it won't fit, or a higher owner (or the same one) has it. A lower owner loses it.
+*/
+void *ScratchArena::take(uint8_t who, uint16_t len)
+{
+	if ((len > size) || (owner >= who))
+		return NULL;
+	if (owner != ARENA_FREE)
+		++evictions;
+	owner = who;
+	if (len > peak[who])
+		peak[who] = len;
+	memset(block, 0, len);
+	return block;
+}
+
+// Give the arena back. Does nothing if who has already lost it
+void ScratchArena::release(uint8_t who)
+{
+	if (owner == who)
+		owner = ARENA_FREE;
+}
+
+/*
+Print one line of the report: the size, then the most each owner has used, then how often one lost it to another
+	arena setup 408
+Owners that haven't had it yet show -. Returns false once there are no more lines
+*/
+bool ScratchArena::printLine(Print *out, uint8_t line)
+{
+	uint16_t v;
+
+	switch (line)
+	{
+	case ARENA_FREE: out->print(F("arena size ")); v = size; break;
+	case ARENA_SHOT: out->print(F("arena shot ")); v = peak[ARENA_SHOT]; break;
+	case ARENA_SETUP: out->print(F("arena setup ")); v = peak[ARENA_SETUP]; break;
+	case ARENA_OWNERS: out->print(F("arena evict ")); out->println(evictions); return true;
+	default: return false;
+	}
+
+	if (v == 0)
+		out->println('-');
+	else
+		out->println(v);
+	return true;
+}
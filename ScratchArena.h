@@ -0,0 +1,47 @@
+// ScratchArena.h
+// One block of RAM shared by the modes that need a lot of it for a while
+
+#ifndef _SCRATCHARENA_h
+#define _SCRATCHARENA_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+// Owners, lowest priority first. A higher owner can take the arena from a lower one
+#define ARENA_FREE			0
+#define ARENA_SHOT			1		// Screenshot export working space (Screenshot.h)
+#define ARENA_SETUP			2		// Setup screen buttons & touch state (ClockDisplay.h)
+#define ARENA_OWNERS		3
+
+/*
+Scratch arena
+The setup screen, the screenshot export and the like each need a few hundred bytes, but only while they're running,
+and never all at once. Rather than each keeping its own RAM for good, they take this one block when they start and
+give it back when they finish. Only one owner has it at a time. If a higher owner wants it, the lower one loses it:
+it has to check holds() before each use and stop if it's been taken (the setup screen beats a screenshot, say).
+The block itself is declared where the owners' layouts are all known (HexClockTouch3.ino), sized for the biggest.
+*/
+class ScratchArena
+{
+public:
+	ScratchArena(void *mem, uint16_t len);
+	void *take(uint8_t who, uint16_t len);
+	void release(uint8_t who);
+	bool holds(uint8_t who) { return owner == who; }
+	uint8_t getOwner() { return owner; }
+	uint16_t getSize() { return size; }
+	uint16_t getPeak(uint8_t who) { return peak[who]; }
+	bool printLine(Print *out, uint8_t line);
+
+private:
+	uint8_t *block;
+	uint16_t size;
+	uint8_t owner;				// ARENA_* that has it now
+	uint16_t peak[ARENA_OWNERS];	// Most each owner has taken. 0 = hasn't had it yet
+	uint16_t evictions;			// Times an owner lost it to a higher one
+};
+
+#endif // _SCRATCHARENA_h
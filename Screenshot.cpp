@@ -0,0 +1,202 @@
+/*
+Screenshot.cpp
+Reads the display back and sends it over Serial, compressed.
+For when the screen shows something it shouldn't (garbled digits, a second that didn't change) and there's no
+camera handy: the picture comes straight from the RA8875's display memory, so it's exactly what the panel is showing.
+*/
+
+#include "Screenshot.h"
+#include "ScratchArena.h"
+
+extern ScratchArena Arena;		// Shared scratch RAM
+
+Screenshot::Screenshot()
+{
+	step = SHOT_IDLE;
+	baud = LINK_BAUD;
+	work = NULL;
+}
+
+/*
+Set up an export of the area x, y, w, h. fast = change to SHOT_BAUD for it
+The export starts once the reply to the start command has gone out. Returns false if one is already running, or the
+scratch arena is in use (the setup screen is up).
+*/
+bool Screenshot::start(int16_t x, int16_t y, uint16_t width, uint16_t height, bool fast)
+{
+	if (busy())
+		return false;
+	work = (shotScratch_t *)Arena.take(ARENA_SHOT, sizeof(shotScratch_t));	// Comes back cleared: empty run, black palette
+	if (work == NULL)
+		return false;
+	x0 = x;
+	y0 = y;
+	w = width;
+	h = height;
+	col = row = 0;
+	baud = fast ? SHOT_BAUD : LINK_BAUD;
+	pixels = bytes = 0;
+	seq = 0;
+	step = SHOT_TO_FAST;
+	stepAt = startMs = millis();
+	return true;
+}
+
+// Stop the export. The port still goes back to LINK_BAUD, from service()
+void Screenshot::cancel()
+{
+	if (step == SHOT_IDLE)
+		return;
+	Arena.release(ARENA_SHOT);
+	work = NULL;
+	step = SHOT_TO_SLOW;
+}
+
+// Everything written has gone out
+bool Screenshot::txEmpty(HardwareSerial *port)
+{
+	if (port->availableForWrite() < SERIAL_TX_BUFFER_SIZE - 1)
+		return false;
+	port->flush();		// Last byte leaving the shift register
+	return true;
+}
+
+// Add the run being built to out[]
+void Screenshot::emitRun()
+{
+	uint8_t slot, len;
+	uint32_t extra;
+
+	if (work->runLen == 0)
+		return;
+	for (slot = 0; (slot < SHOT_PALETTE) && (work->palette[slot] != work->runColor); ++slot)
+		;
+	len = (work->runLen > SHOT_LONG_RUN) ? SHOT_LONG_RUN : work->runLen - 1;
+	if (slot == SHOT_PALETTE)
+	{
+		work->out[work->outLen++] = (SHOT_NEW_COLOR << 4) | len;
+		work->out[work->outLen++] = (uint8_t)work->runColor;
+		work->out[work->outLen++] = (uint8_t)(work->runColor >> 8);
+		work->palette[work->nextSlot] = work->runColor;
+		work->nextSlot = (work->nextSlot + 1) % SHOT_PALETTE;
+	}
+	else
+		work->out[work->outLen++] = (slot << 4) | len;
+	if (len == SHOT_LONG_RUN)
+	{
+		extra = work->runLen - (SHOT_LONG_RUN + 1);
+		do
+		{
+			work->out[work->outLen++] = (extra & 0x7F) | ((extra > 0x7F) ? 0x80 : 0);
+			extra >>= 7;
+		} while (extra);
+	}
+	work->runLen = 0;
+}
+
+// Send what's in out[] if there's room for it
+bool Screenshot::flush(SerialLink *link, HardwareSerial *port)
+{
+	if (!link->send(port, LINK_SHOT_DATA | LINK_REPLY, seq, work->out, work->outLen))
+		return false;
+	++seq;
+	bytes += work->outLen;
+	work->outLen = 0;
+	return true;
+}
+
+/*
+Do the next bit of the export. Returns true while there's more to do
+A pass stops when it's looked at SHOT_PIXELS_PER_PASS pixels, or when it has a frame to send and the transmit buffer
+hasn't room for it yet. Pixels are only counted as done once they're encoded, so a pass that stops part way through
+a read picks up at the same pixel next time.
+*/
+bool Screenshot::service(RA8875 *disp, SerialLink *link, HardwareSerial *port)
+{
+	uint16_t n, i, done = 0;
+	uint8_t end[12];
+	unsigned long ms;
+
+	if ((work != NULL) && !Arena.holds(ARENA_SHOT))	// Setup took the arena
+	{
+		work = NULL;
+		step = SHOT_TO_SLOW;
+	}
+
+	switch (step)
+	{
+	case SHOT_TO_FAST:
+		if (baud != LINK_BAUD)
+		{
+			if (!link->canSend(port, 0) || !txEmpty(port))	// Start reply still going out
+				return true;
+			port->begin(baud);
+		}
+		step = SHOT_RUN;
+		stepAt = millis();
+		// Fall through
+	case SHOT_RUN:
+		if ((millis() - stepAt) < SHOT_SWITCH_MS)
+			return true;
+		while ((row < h) && (done < SHOT_PIXELS_PER_PASS))
+		{
+			if ((work->outLen >= SHOT_CHUNK) && !flush(link, port))	// Don't read what can't be sent yet
+				return true;
+			n = w - col;
+			if (n > SHOT_READ)
+				n = SHOT_READ;
+			disp->getPixels(work->px, n, x0 + col, y0 + row);
+			for (i = 0; i < n; ++i)
+			{
+				if ((work->outLen >= SHOT_CHUNK) && !flush(link, port))
+					return true;
+				if (work->runLen && (work->px[i] == work->runColor))
+					++work->runLen;
+				else
+				{
+					emitRun();
+					work->runColor = work->px[i];
+					work->runLen = 1;
+				}
+				++pixels;
+				if (++col == w)
+				{
+					col = 0;
+					++row;
+				}
+			}
+			done += n;
+		}
+		if (row < h)
+			return true;
+		if ((work->outLen > SHOT_CHUNK - SHOT_TOKEN_MAX) && !flush(link, port))	// Room for the last run's token
+			return true;
+		emitRun();
+		if (work->outLen && !flush(link, port))
+			return true;
+		Arena.release(ARENA_SHOT);
+		work = NULL;
+		step = SHOT_END;
+		// Fall through
+	case SHOT_END:
+		end[0] = (uint8_t)pixels; end[1] = (uint8_t)(pixels >> 8); end[2] = (uint8_t)(pixels >> 16); end[3] = (uint8_t)(pixels >> 24);
+		end[4] = (uint8_t)bytes; end[5] = (uint8_t)(bytes >> 8); end[6] = (uint8_t)(bytes >> 16); end[7] = (uint8_t)(bytes >> 24);
+		ms = millis() - startMs;
+		end[8] = (uint8_t)ms; end[9] = (uint8_t)(ms >> 8); end[10] = (uint8_t)(ms >> 16); end[11] = (uint8_t)(ms >> 24);
+		if (!link->send(port, LINK_SHOT_END | LINK_REPLY, seq, end, sizeof(end)))
+			return true;
+		step = SHOT_TO_SLOW;
+		// Fall through
+	case SHOT_TO_SLOW:
+		if (baud != LINK_BAUD)
+		{
+			if (!txEmpty(port))
+				return true;
+			port->begin(LINK_BAUD);
+			baud = LINK_BAUD;
+		}
+		step = SHOT_IDLE;
+		break;
+	}
+	return false;
+}
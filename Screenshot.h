@@ -0,0 +1,93 @@
+// Screenshot.h
+// Reads the display back and sends it over Serial, compressed
+
+#ifndef _SCREENSHOT_h
+#define _SCREENSHOT_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include <SPI.h>
+#include <RA8875.h>
+#include "SerialLink.h"
+
+#define SHOT_BAUD			57600	// Fast rate for the export. 115200 is 2% out on a 16MHz Pro Mini, which not every adapter takes
+#define SHOT_PERIOD			2		// ms between export passes
+#define SHOT_SWITCH_MS		100		// Pause after changing the baud rate, for the host to change too
+#define SHOT_READ			32		// Pixels read from the RA8875 at a time
+#define SHOT_PIXELS_PER_PASS	400	// Most pixels looked at per pass, so a pass stays short
+#define SHOT_CHUNK			32		// Encoded bytes per frame
+#define SHOT_TOKEN_MAX		6		// Longest token
+#define SHOT_PALETTE		15		// Recent colors both ends keep
+
+/*
+Encoding
+The pixels go out in raster order, left to right then top to bottom, as runs of one color. Each run is a token:
+	byte	high 4 bits: palette slot 0-14, or 15 = new color
+			low 4 bits: run length - 1 (1-15 pixels), or 15 = longer run
+	color	2 bytes RGB565 (little-endian), only for a new color. It goes into the next palette slot in turn
+	length	varint (7 bits a byte, low first), only for a longer run: run length - 16
+Both ends start with a palette of black and fill it the same way, so it never has to be sent.
+The clock face has a handful of colors and long runs, so it comes out at a few percent of its raw size.
+*/
+#define SHOT_NEW_COLOR		0x0F
+#define SHOT_LONG_RUN		0x0F
+
+// Encoder state, only needed while an export runs. Lives in the scratch arena (ScratchArena.h)
+typedef struct
+{
+	uint16_t px[SHOT_READ];			// Pixels just read back
+	uint16_t runColor;				// Run being built
+	uint32_t runLen;
+	uint16_t palette[SHOT_PALETTE];
+	uint8_t nextSlot;
+	uint8_t out[SHOT_CHUNK + SHOT_TOKEN_MAX];	// Encoded, waiting to be sent
+	uint8_t outLen;
+} shotScratch_t;
+
+// Export steps
+#define SHOT_IDLE			0
+#define SHOT_TO_FAST		1		// Waiting for the start reply to go out, then changing baud rate
+#define SHOT_RUN			2		// Reading and sending
+#define SHOT_END			3		// Sending the totals frame
+#define SHOT_TO_SLOW		4		// Waiting for the last frame to go out, then changing back
+
+/*
+Screenshot export
+start() sets up an area of the screen; service() then does a little at a time - reads up to SHOT_READ pixels, encodes
+them, sends a frame when there's a chunk and room for it - and returns, so the clock keeps running. Each frame is
+LINK_SHOT_DATA with a sequence number first. LINK_SHOT_END carries the totals. The area is in the clock's own
+coordinates, so the picture is the right way up however the panel is mounted.
+The encoder's buffers are in the scratch arena. Opening the setup screen takes it back, which stops the export.
+*/
+class Screenshot
+{
+public:
+	Screenshot();
+	bool start(int16_t x, int16_t y, uint16_t w, uint16_t h, bool fast);
+	bool service(RA8875 *disp, SerialLink *link, HardwareSerial *port);
+	bool busy() { return step != SHOT_IDLE; }
+	void cancel();
+	unsigned long getBaud() { return baud; }
+
+private:
+	uint8_t step;
+	int16_t x0, y0;
+	uint16_t w, h;
+	uint16_t col, row;				// Next pixel to read
+	unsigned long baud;
+	unsigned long stepAt;			// millis() the current step started
+	unsigned long startMs;
+	uint32_t pixels, bytes;			// Totals for the end frame
+	uint8_t seq;
+	shotScratch_t *work;			// In the arena while the export runs
+
+	void emitRun();
+	bool flush(SerialLink *link, HardwareSerial *port);
+	bool txEmpty(HardwareSerial *port);
+};
+
+#endif // _SCREENSHOT_h
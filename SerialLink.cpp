@@ -0,0 +1,142 @@
+/*
+SerialLink.cpp
+Framed binary command protocol on the Serial port.
+There's no byte stuffing. A damaged frame is thrown away by its CRC (or by the timeout if bytes went missing) and
+the parser waits for the next SOF.
+*/
+
+#include "SerialLink.h"
+#include "Settings.h"
+
+// Parser states
+#define LINK_IDLE	0		// Waiting for SOF. Anything else is a text command
+#define LINK_LEN	1		// Next byte is LEN
+#define LINK_BODY	2		// Reading CMD & payload
+#define LINK_CRC	3		// Next byte is the CRC
+
+SerialLink::SerialLink(linkHandler_t h)
+{
+	handler = h;
+	state = LINK_IDLE;
+	got = 0;
+	replyLen = 0;
+	lastByte = 0;
+	frames = errors = 0;
+}
+
+/*
+Take what's waiting on the port, up to LINK_BYTES_PER_PASS bytes
+Returns a text command character if one came in outside a frame (the rest of the pass is left for next time),
+otherwise -1.
+*/
+int SerialLink::poll(HardwareSerial *port)
+{
+	uint8_t n, c;
+
+	if (replyLen && !sendReply(port))	// Last reply still waiting for room
+		return -1;
+
+	if ((state != LINK_IDLE) && ((millis() - lastByte) > LINK_TIMEOUT))
+	{
+		state = LINK_IDLE;		// Rest of the frame never came
+		++errors;
+	}
+
+	for (n = 0; (n < LINK_BYTES_PER_PASS) && port->available(); ++n)
+	{
+		c = port->read();
+		switch (state)
+		{
+		case LINK_IDLE:
+			if (c != LINK_SOF)
+				return c;
+			state = LINK_LEN;
+			break;
+		case LINK_LEN:
+			if (c > LINK_MAX_PAYLOAD)
+			{
+				state = LINK_IDLE;
+				++errors;
+				break;
+			}
+			frame[0] = c;
+			got = 1;
+			state = LINK_BODY;
+			break;
+		case LINK_BODY:
+			frame[got++] = c;
+			if (got == frame[0] + 2)
+				state = LINK_CRC;
+			break;
+		case LINK_CRC:
+			state = LINK_IDLE;
+			dispatch(c == crc8(frame, got));
+			if (!sendReply(port))
+				return -1;
+			break;
+		}
+	}
+	if (n)
+		lastByte = millis();
+	return -1;
+}
+
+// Run a received frame and build its reply
+void SerialLink::dispatch(bool good)
+{
+	uint8_t len = 0, status;
+
+	if (good)
+	{
+		status = handler(frame[1], frame + 2, frame[0], reply + 4, &len);
+		++frames;
+	}
+	else
+	{
+		status = LINK_ERR_CRC;
+		++errors;
+	}
+	buildReply(frame[1] | LINK_REPLY, status, len);
+}
+
+// Frame up reply[]. The payload after the first byte is already in place
+void SerialLink::buildReply(uint8_t cmd, uint8_t first, uint8_t len)
+{
+	reply[0] = LINK_SOF;
+	reply[1] = len + 1;
+	reply[2] = cmd;
+	reply[3] = first;
+	reply[len + 4] = crc8(reply + 1, len + 3);
+	replyLen = len + 5;
+}
+
+/*
+Send a frame the host didn't ask for (streamed data). first is the first payload byte, then len bytes of data.
+Only goes if nothing else is waiting and it all fits in the transmit buffer (see canSend()). Returns false if not.
+It's written straight out rather than through reply[], so it can be longer than LINK_MAX_PAYLOAD.
+*/
+bool SerialLink::send(HardwareSerial *port, uint8_t cmd, uint8_t first, const uint8_t *data, uint8_t len)
+{
+	uint8_t head[4];
+
+	if (!canSend(port, len + 1))
+		return false;
+	head[0] = LINK_SOF;
+	head[1] = len + 1;
+	head[2] = cmd;
+	head[3] = first;
+	port->write(head, 4);
+	port->write(data, len);
+	port->write(crc8(data, len, crc8(head + 1, 3)));
+	return true;
+}
+
+// Send the reply if it fits in the transmit buffer
+bool SerialLink::sendReply(HardwareSerial *port)
+{
+	if (port->availableForWrite() < replyLen)
+		return false;
+	port->write(reply, replyLen);
+	replyLen = 0;
+	return true;
+}
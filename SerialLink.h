@@ -0,0 +1,104 @@
+// SerialLink.h
+// Framed binary command protocol on the Serial port
+
+#ifndef _SERIALLINK_h
+#define _SERIALLINK_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+/*
+Frame layout, both ways:
+	SOF  LEN  CMD  PAYLOAD[LEN]  CRC
+CRC is the CRC-8 of LEN, CMD and the payload (same CRC as the settings block). A reply has LINK_REPLY set in CMD,
+and the first byte of its payload is one of the LINK_* status codes below. Multi-byte values are little-endian.
+The clock can also send a frame nobody asked for (see send()). It looks like a reply, but the first byte of its payload
+belongs to the command.
+Bytes that show up outside a frame are passed back to the sketch as single-character text commands.
+*/
+#define LINK_VERSION		1		// Protocol version, returned by LINK_PING
+#define LINK_BAUD			9600
+#define LINK_SOF			0x7E	// Start of frame
+#define LINK_REPLY			0x80	// Set in CMD on replies
+#define LINK_MAX_PAYLOAD	20		// Longest payload either way
+#define LINK_BYTES_PER_PASS	24		// Most bytes taken from the receive buffer per poll()
+#define LINK_TIMEOUT		250		// ms allowed between bytes of a frame before it's dropped
+
+// Commands
+#define LINK_PING			0x01	// -> version
+#define LINK_GET_TIME		0x10	// -> sec min hour mday mon year(2)
+#define LINK_SET_TIME		0x11	// sec min hour mday mon year(2) ->
+#define LINK_ALARM_STATUS	0x14	// -> state count nextHour nextMin dueInSec(4) rung(2) snoozes(2) checks(2). See Alarms.h
+#define LINK_ALARM_GET		0x15	// slot -> hour min days. LINK_ERR_ARG past the end of the table
+#define LINK_ALARM_SET		0x16	// hour min days -> Adds or replaces the alarm at that time. days 0 removes it. LINK_ERR_STATE if the table is full
+#define LINK_ALARM_CTRL		0x17	// action -> (ALARM_CTRL_SNOOZE or ALARM_CTRL_STOP). LINK_ERR_STATE if it isn't ringing
+#define LINK_GET_SETTINGS	0x20	// -> fgColor(2) bgColor(2) numberBase displayBase rotation timeMode colorMode
+#define LINK_SET_SETTINGS	0x21	// fgColor(2) bgColor(2) numberBase displayBase rotation [timeMode [colorMode]] ->
+#define LINK_SET_MODE		0x22	// numberBase displayBase [timeMode] ->
+#define LINK_SUN_GET		0x23	// -> latitude(2) longitude(2) utcOffset panel rise(2) set(2) length(2) polar cycles(2) runs(2). See Sun.h
+#define LINK_SUN_SET		0x24	// latitude(2) longitude(2) utcOffset panel ->
+#define LINK_POWER_GET		0x25	// -> dimFrom dimTo offFrom offTo level state minutesOn(2) minutesDim(2) minutesOff(2) todayMwh(2) yesterdayMwh(2). See Power.h
+#define LINK_POWER_SET		0x26	// dimFrom dimTo offFrom offTo level -> (quarter hours; from = to is no period)
+#define LINK_GET_COUNTERS	0x30	// -> see linkCommand() in the sketch
+#define LINK_SYNC_START		0x40	// newSession -> clockSec(4) clockUs(4) 0(3). See TimeSync.h
+#define LINK_SYNC_TIME		0x41	// hostSec(4) hostUs(4) holdUs(4) -> delayUs(4) offsetUs(4)
+#define LINK_SYNC_APPLY		0x42	// -> second(4) the RTC will be set to, on the host's second
+#define LINK_SYNC_STATUS	0x43	// -> syncs(2) lastStepUs(4) drift(4, tenths of a ppm) offsetUs(4) delayUs(4)
+#define LINK_TRACE			0x50	// mode -> (TRACE_OFF, TRACE_CAPTURE or TRACE_REPLAY. See TouchTrace.h)
+#define LINK_TRACE_FEED		0x51	// last trace[] -> taken room. Replay input; send again what wasn't taken
+#define LINK_TRACE_DATA		0x52	// Capture output, sent by the clock unasked as a reply: sequence trace[]
+#define LINK_TRACE_STATUS	0x53	// -> mode dropped(2) underruns(2) actions(2) lastLatencyUs(4) maxLatencyUs(4)
+#define LINK_SHOT			0x60	// fast [x(2) y(2) w(2) h(2)] -> w(2) h(2) baud(4). Screen export, see Screenshot.h
+#define LINK_SHOT_DATA		0x61	// Export output, sent unasked: sequence encoded[]
+#define LINK_SHOT_END		0x62	// Sent unasked at the end: sequence pixels(4) bytes(4) ms(4)
+#define LINK_SHOT_STOP		0x63	// -> Stops an export
+#define LINK_WATCH			0x70	// mode [countdownSec(2)] -> (WATCH_OFF, WATCH_UP or WATCH_DOWN. See Stopwatch.h)
+#define LINK_WATCH_CTRL		0x71	// action -> (WATCH_START_STOP, WATCH_LAP or WATCH_CLEAR). LINK_ERR_STATE if the watch is off
+#define LINK_WATCH_STATUS	0x72	// -> mode flags(1=running 2=slow) shownMs(4) laps lapMs(4) frames(2) avgUs(2) maxUs(2) over(2)
+
+// Reply status
+#define LINK_OK				0
+#define LINK_ERR_CRC		1		// Frame was damaged. Nothing was done
+#define LINK_ERR_CMD		2		// Unknown command
+#define LINK_ERR_ARG		3		// Wrong payload length or a value out of range
+#define LINK_ERR_BUSY		4		// Can't do that right now (setup screen is up)
+#define LINK_ERR_STATE		5		// Out of order (sync sample without a start, apply without a sample), or no RTC tick, or the watch is off, or no alarm to snooze or stop, or the alarm table is full
+
+// Runs a command. Fills in the reply payload after the status byte and returns the status
+typedef uint8_t (*linkHandler_t)(uint8_t cmd, const uint8_t *data, uint8_t len, uint8_t *reply, uint8_t *replyLen);
+
+/*
+Receives frames a few bytes at a time and sends back the replies
+The UART interrupt fills the receive buffer; poll() takes at most LINK_BYTES_PER_PASS bytes from it, so one pass
+takes about the same time however much is waiting. A reply only goes out when the whole frame fits in the transmit
+buffer, and nothing more is read until it has, so it never waits on the UART either.
+*/
+class SerialLink
+{
+public:
+	SerialLink(linkHandler_t h);
+	int poll(HardwareSerial *port);
+	bool canSend(HardwareSerial *port, uint8_t len) { return !replyLen && (port->availableForWrite() >= len + 4); }
+	bool send(HardwareSerial *port, uint8_t cmd, uint8_t first, const uint8_t *data, uint8_t len);
+	uint16_t getFrames() { return frames; }
+	uint16_t getErrors() { return errors; }
+
+private:
+	linkHandler_t handler;
+	uint8_t state;					// Where the parser is in a frame
+	uint8_t frame[LINK_MAX_PAYLOAD + 2];	// LEN, CMD, payload as received
+	uint8_t got;					// Bytes of frame[] filled
+	uint8_t reply[LINK_MAX_PAYLOAD + 4];	// Whole reply frame, ready to send
+	uint8_t replyLen;				// Bytes in reply[]. 0 = nothing waiting
+	unsigned long lastByte;			// millis() of the last byte received
+	uint16_t frames, errors;		// Good frames, and frames dropped (bad CRC, bad length, timed out)
+
+	void dispatch(bool good);
+	void buildReply(uint8_t cmd, uint8_t first, uint8_t len);
+	bool sendReply(HardwareSerial *port);
+};
+
+#endif // _SERIALLINK_h
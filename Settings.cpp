@@ -0,0 +1,156 @@
+/*
+Settings.cpp
+Clock settings storage.
+
+The settings live in a packed block with a version and a CRC. Every commit writes the whole block to the next slot in
+a ring of SETTINGS_SLOTS, with the sequence number one higher than the last, so no single EEPROM cell takes every
+write. At boot the newest slot with a good CRC wins. If power drops in the middle of a write the CRC on that slot
+fails and the previous slot is used.
+
+Changes aren't written straight away. update() just records them, and service() commits once they've been left alone
+for SETTINGS_COMMIT_DELAY, so tapping through the colors on the setup screen costs one write, not one per tap.
+*/
+
+#include "Settings.h"
+#include <EEPROM.h>
+
+#define SLOT_ADDRESS(n)	(EEPROM_SETTINGS_LOCATION + ((n) * SETTINGS_SLOT_SIZE))
+
+// CRC-8 (Dallas/Maxim, reflected polynomial 0x8C)
+uint8_t crc8(const uint8_t *data, uint8_t len, uint8_t crc)
+{
+	uint8_t i, b;
+
+	while (len--)
+	{
+		b = *data++;
+		for (i = 0; i < 8; ++i)
+		{
+			if ((crc ^ b) & 0x01)
+				crc = (crc >> 1) ^ 0x8C;
+			else
+				crc >>= 1;
+			b >>= 1;
+		}
+	}
+	return crc;
+}
+
+SettingsStore::SettingsStore()
+{
+	slot = SETTINGS_SLOTS - 1;	// So the first commit goes to slot 0
+	pending = false;
+	lastChange = 0;
+	commits = 0;
+	memset(&current, 0, sizeof(current));
+}
+
+SettingsStore::~SettingsStore()
+{
+}
+
+/*
+Find the newest good settings block and copy it to s
+Falls back to the old fixed-offset layout for clocks that haven't saved settings since the upgrade.
+Returns false if there are no saved settings at all (new clock, or it's been reset)
+*/
+bool SettingsStore::load(clockSettings_t *s)
+{
+	clockSettings_t block;
+	bool found = false;
+	uint8_t i;
+
+	for (i = 0; i < SETTINGS_SLOTS; ++i)
+	{
+		EEPROM.get(SLOT_ADDRESS(i), block);
+		if ((block.version == 0) || (block.version == 0xFF))	// Erased or never written
+			continue;
+		if (crc8((uint8_t *)&block, sizeof(block) - 1) != block.crc)
+			continue;
+		if (!found || ((int8_t)(block.sequence - current.sequence) > 0))	// Sequence numbers wrap, so compare the difference
+		{
+			current = block;
+			slot = i;
+			found = true;
+		}
+	}
+
+	if (!found)
+	{
+		if (!loadLegacy(&current))
+			return false;
+		pending = true;		// Rewrite in the new format the next time service() runs
+	}
+
+	// Blocks from older versions read their unknown fields as zero. Fix up new fields here when the version goes up.
+	// Version 2 added timeMode, where zero is TIME_MODE_CLOCK.
+	// Version 3 added colorMode, where zero is COLOR_MODE_FIXED.
+	// Version 4 added the sun panel's place, and the panel itself, where zero is off.
+	// Version 5 added the power schedule (Power.h). Zeros are no dim or off periods, and the default dim level.
+
+	*s = current;
+	return true;
+}
+
+// Read settings saved in the old layout: five 32-bit values behind a signature
+bool SettingsStore::loadLegacy(clockSettings_t *s)
+{
+	if (EEPROMReadUnsignedLong(EEPROM_SIGNATURE_LOCATION) != EEPROM_SIGNATURE_VALUE)
+		return false;
+
+	memset(s, 0, sizeof(*s));
+	s->fgColor = (uint16_t)EEPROMReadUnsignedLong(EEPROM_CONFIG_LOCATION);
+	s->bgColor = (uint16_t)EEPROMReadUnsignedLong(EEPROM_CONFIG_LOCATION + 4);
+	s->numberBase = (uint8_t)EEPROMReadUnsignedLong(EEPROM_CONFIG_LOCATION + 8);
+	s->displayBase = (uint8_t)EEPROMReadUnsignedLong(EEPROM_CONFIG_LOCATION + 12);
+	s->rotation = (uint8_t)EEPROMReadUnsignedLong(EEPROM_CONFIG_LOCATION + 16);
+	return true;
+}
+
+/*
+Record new settings
+Nothing is written here. If anything changed, the settings are written by service() once they've been stable for
+SETTINGS_COMMIT_DELAY. The version, sequence and crc fields of s are ignored.
+*/
+void SettingsStore::update(clockSettings_t *s)
+{
+	// Only the payload matters. Header and CRC get filled in at commit time.
+	if (memcmp(&s->fgColor, &current.fgColor, sizeof(current) - 3) == 0)
+		return;
+
+	memcpy(&current.fgColor, &s->fgColor, sizeof(current) - 3);
+	pending = true;
+	lastChange = millis();
+}
+
+// Write pending settings once they've settled. Call this regularly from the main loop.
+void SettingsStore::service()
+{
+	if (pending && ((millis() - lastChange) >= SETTINGS_COMMIT_DELAY))
+		commit();
+}
+
+// Write the current settings to the next slot in the ring right now
+void SettingsStore::commit()
+{
+	slot = (slot + 1) % SETTINGS_SLOTS;
+	current.version = SETTINGS_VERSION;
+	++current.sequence;
+	memset(current.reserved, 0, sizeof(current.reserved));
+	current.crc = crc8((uint8_t *)&current, sizeof(current) - 1);
+
+	EEPROM.put(SLOT_ADDRESS(slot), current);	// put() uses update(), so bytes that happen to match aren't rewritten
+	pending = false;
+	++commits;
+}
+
+// Throw away all saved settings, including any in the old layout. The clock starts fresh on the next boot.
+void SettingsStore::erase()
+{
+	uint8_t i;
+
+	for (i = 0; i < SETTINGS_SLOTS; ++i)
+		EEPROM.update(SLOT_ADDRESS(i), 0xFF);	// Version 0xFF marks the slot as empty
+	EEPROMWritelong(EEPROM_SIGNATURE_LOCATION, (uint32_t)0x0);
+	pending = false;
+}
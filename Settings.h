@@ -0,0 +1,76 @@
+// Settings.h
+// Versioned, checksummed clock settings kept in a wear-leveling ring of EEPROM slots
+
+#ifndef _SETTINGS_h
+#define _SETTINGS_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include "EEPROMFunctions.h"
+
+/*
+Settings block layout version. Bump this when fields are added to clockSettings_t.
+New fields come out of the reserved area so the slot size never changes. A block with an older version is still
+loaded. The fields it doesn't know about are read as zero, so give new fields a sensible zero value or fix them up
+in SettingsStore::load().
+*/
+#define SETTINGS_VERSION		5
+
+#define SETTINGS_SLOT_SIZE		24		// Bytes per slot. Fixed for all versions
+#define SETTINGS_SLOTS			8		// Slots in the ring. Each commit goes to the next one, which spreads out EEPROM wear
+#define SETTINGS_COMMIT_DELAY	5000	// Settings have to be left alone this long (ms) before they're written
+
+typedef struct __attribute__((packed))
+{
+	uint8_t version;		// SETTINGS_VERSION of the code that wrote the block
+	uint8_t sequence;		// Goes up by one on every commit. The newest good slot is the current one.
+	uint16_t fgColor;		// Clock face foreground color
+	uint16_t bgColor;		// Clock face background color
+	uint8_t numberBase;		// BASE_HEX or BASE_DEC
+	uint8_t displayBase;	// DISPLAY_24H or DISPLAY_12H
+	uint8_t rotation;		// ROTATION_0 or ROTATION_180
+	uint8_t timeMode;		// TIME_MODE_CLOCK or TIME_MODE_HEXDAY. Version 2
+	uint8_t colorMode;		// COLOR_MODE_FIXED or COLOR_MODE_TIME. Version 3
+	int16_t latitude;		// Hundredths of a degree, north positive, for the sun panel (Sun.h). Version 4
+	int16_t longitude;		// Hundredths of a degree, east positive. Version 4
+	int8_t utcOffset;		// Quarter hours the RTC's local time is ahead of UTC. Version 4
+	uint8_t sunPanel;		// Sun panel in place of the binary date rows. Version 4
+	uint8_t dimFrom;		// Power schedule (Power.h), in quarter hours. Version 5
+	uint8_t dimTo;
+	uint8_t offFrom;
+	uint8_t offTo;
+	uint8_t dimLevel;		// Backlight while dimmed. Zero is POWER_DIM_DEFAULT. Version 5
+	uint8_t reserved[SETTINGS_SLOT_SIZE - 23];	// Room for later versions. Always zero
+	uint8_t crc;			// CRC-8 of everything above
+} clockSettings_t;
+
+class SettingsStore
+{
+public:
+	SettingsStore();
+	~SettingsStore();
+	bool load(clockSettings_t *s);
+	void update(clockSettings_t *s);
+	void service();
+	void commit();
+	void erase();
+	bool isPending() { return pending; }
+	uint16_t getCommitCount() { return commits; }
+
+private:
+	clockSettings_t current;	// What's in (or about to go into) the current slot
+	uint8_t slot;				// Current slot number
+	bool pending;				// current has changes that haven't been written yet
+	unsigned long lastChange;	// millis() of the last update() that changed something
+	uint16_t commits;			// Slots written since boot
+
+	bool loadLegacy(clockSettings_t *s);
+};
+
+extern uint8_t crc8(const uint8_t *data, uint8_t len, uint8_t crc = 0);
+
+#endif // _SETTINGS_h
@@ -0,0 +1,218 @@
+/*
+Stopwatch.cpp
+Stopwatch & countdown timing, laps, and the frame statistics that decide the redraw rate.
+*/
+
+#include "Stopwatch.h"
+
+Stopwatch::Stopwatch()
+{
+	mode = WATCH_OFF;
+	presetMs = WATCH_COUNTDOWN * 1000UL;
+	control(WATCH_CLEAR, 0);
+	resetStats();
+}
+
+// Change mode. A countdown runs down from 'seconds', or from the last one set if that's 0. The watch starts off cleared
+void Stopwatch::setMode(uint8_t m, uint16_t seconds)
+{
+	mode = (m <= WATCH_DOWN) ? m : WATCH_OFF;
+	if ((mode == WATCH_DOWN) && (seconds != 0))
+		presetMs = seconds * 1000UL;
+	control(WATCH_CLEAR, 0);
+}
+
+/*
+Start/stop, lap or clear, at 'ms' (millis() when it was asked for, which for a tap is when the finger came down).
+A countdown that has run out stays at zero until it's cleared.
+*/
+void Stopwatch::control(uint8_t action, unsigned long ms)
+{
+	switch (action)
+	{
+	case WATCH_START_STOP:
+		if (running)
+		{
+			heldMs = elapsed(ms);
+			if ((mode == WATCH_DOWN) && (heldMs > presetMs))
+				heldMs = presetMs;
+			running = false;
+		}
+		else if ((mode != WATCH_OFF) && !((mode == WATCH_DOWN) && (heldMs >= presetMs)))
+		{
+			startMs = ms - heldMs;
+			running = true;
+		}
+		break;
+	case WATCH_LAP:
+		if (!running)
+			break;
+		if (laps == 0xFF)
+			break;
+		splits[laps % WATCH_SPLITS] = elapsed(ms);
+		++laps;
+		break;
+	case WATCH_CLEAR:
+		running = false;
+		heldMs = 0;
+		laps = 0;
+		slow = false;
+		windowFrames = windowOver = 0;
+		break;
+	}
+}
+
+/*
+What the face shows at 'ms': time since the start for a stopwatch, time left for a countdown. A countdown that gets to
+zero stops there.
+*/
+unsigned long Stopwatch::shown(unsigned long ms)
+{
+	unsigned long e = elapsed(ms);
+
+	if (mode != WATCH_DOWN)
+		return e % WATCH_LIMIT;
+	if (e < presetMs)
+		return presetMs - e;
+	running = false;
+	heldMs = presetMs;
+	return 0;
+}
+
+// Time of lap 'lap' (0 is the first), since the lap before it. 0 if it hasn't been taken or isn't kept any more
+unsigned long Stopwatch::lapTime(uint8_t lap)
+{
+	if ((lap >= laps) || (lap + WATCH_LAPS < laps))
+		return 0;
+	if (lap == 0)
+		return splits[0];
+	return splits[lap % WATCH_SPLITS] - splits[(lap - 1) % WATCH_SPLITS];
+}
+
+/*
+A frame has been drawn, taking 'us'. Returns true if that put the watch over its limit and it's just dropped to the
+slow rate; the caller needs to change the render period.
+*/
+bool Stopwatch::frameDone(unsigned long us)
+{
+	unsigned long ms = millis(), gap = ms - lastFrameMs;
+
+	if (frames < 0xFFFF)
+	{
+		++frames;
+		frameTotal += us;
+	}
+	if (us > frameMax)
+		frameMax = us;
+	if ((frames > 1) && (gap < 2 * WATCH_SLOW_PERIOD) && (gaps < 0xFFFF))	// A longer gap is a stop, not a late frame
+	{
+		++gaps;
+		gapTotal += gap;
+		if (gap > gapMax)
+			gapMax = gap;
+	}
+	lastFrameMs = ms;
+
+	if (++windowFrames >= WATCH_WINDOW)
+		windowFrames = windowOver = 0;
+	if (us <= WATCH_BUDGET)
+		return false;
+	if (over < 0xFFFF)
+		++over;
+	if (slow || (++windowOver <= WATCH_OVER_LIMIT))
+		return false;
+	slow = true;
+	return true;
+}
+
+void Stopwatch::resetStats()
+{
+	frames = over = 0;
+	frameTotal = 0;
+	frameMax = 0;
+	gapTotal = 0;
+	gaps = gapMax = 0;
+	lastFrameMs = 0;
+	memset(paints, 0, sizeof(paints));
+}
+
+// MM:SS:hh
+void Stopwatch::printTime(Print *out, unsigned long ms)
+{
+	uint8_t part[3] = { (uint8_t)(ms / 60000), (uint8_t)(ms / 1000 % 60), (uint8_t)(ms / 10 % 100) };
+	uint8_t i;
+
+	for (i = 0; i < 3; ++i)
+	{
+		if (i)
+			out->print(':');
+		if (part[i] < 10)
+			out->print('0');
+		out->print(part[i]);
+	}
+}
+
+/*
+Print one line of the report. Frame times in us, the gap between frames in ms, then the laps kept, oldest first
+	watch mode 1 run 1 rate 50 slow 0
+	watch frames 500 avg 4210 max 9120 over 0
+	watch gap avg 20 max 21
+	watch paint glyph 0 opaque 2 delta 120
+	watch lap 1 00:12:34 split 00:12:34
+Returns false once there are no more lines
+*/
+bool Stopwatch::printLine(Print *out, uint8_t line)
+{
+	uint8_t lap, first;
+
+	switch (line)
+	{
+	case 0:
+		out->print(F("watch mode "));
+		out->print(mode);
+		out->print(F(" run "));
+		out->print(running ? 1 : 0);
+		out->print(F(" rate "));
+		out->print(1000 / getPeriod());
+		out->print(F(" slow "));
+		out->println(slow ? 1 : 0);
+		return true;
+	case 1:
+		out->print(F("watch frames "));
+		out->print(frames);
+		out->print(F(" avg "));
+		out->print(getFrameAvg());
+		out->print(F(" max "));
+		out->print(frameMax);
+		out->print(F(" over "));
+		out->println(over);
+		return true;
+	case 2:
+		out->print(F("watch gap avg "));
+		out->print(gaps ? gapTotal / gaps : 0);
+		out->print(F(" max "));
+		out->println(gapMax);
+		return true;
+	case 3:
+		out->print(F("watch paint glyph "));
+		out->print(paints[REPAINT_GLYPH]);
+		out->print(F(" opaque "));
+		out->print(paints[REPAINT_OPAQUE]);
+		out->print(F(" delta "));
+		out->println(paints[REPAINT_DELTA]);
+		return true;
+	}
+
+	first = (laps > WATCH_LAPS) ? laps - WATCH_LAPS : 0;
+	lap = first + line - 4;
+	if (lap >= laps)
+		return false;
+	out->print(F("watch lap "));
+	out->print(lap + 1);
+	out->print(' ');
+	printTime(out, lapTime(lap));
+	out->print(F(" split "));
+	printTime(out, splits[lap % WATCH_SPLITS]);
+	out->println();
+	return true;
+}
@@ -0,0 +1,103 @@
+// Stopwatch.h
+// Stopwatch & countdown timer on the main face, with laps and the statistics for its fast redraw
+
+#ifndef _STOPWATCH_h
+#define _STOPWATCH_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include "ClockDigit.h"
+
+// Modes
+#define WATCH_OFF			0		// Clock face
+#define WATCH_UP			1		// Stopwatch
+#define WATCH_DOWN			2		// Countdown
+
+// Controls, from a tap on the face or the Serial link
+#define WATCH_START_STOP	0
+#define WATCH_LAP			1
+#define WATCH_CLEAR			2		// Back to zero, or to the countdown's start
+
+#define WATCH_LIMIT			6000000UL	// ms. The face shows 99:59:99 at most; a stopwatch goes round again after that
+#define WATCH_COUNTDOWN		300		// Default countdown (s), until one is set over Serial
+#define WATCH_COUNTDOWN_MAX	5999	// 99:59
+#define WATCH_LAPS			4		// Laps kept for the report. The face shows the last one
+#define WATCH_SPLITS		(WATCH_LAPS + 1)	// The split before the oldest lap kept is kept too, for that lap's time
+#define WATCH_REPORT_LINE	48		// Longest line printLine() writes
+
+/*
+Frame rate
+While it's running the face is redrawn every WATCH_FAST_PERIOD, with the hundredths in the seconds position. A frame
+has to leave room in the period for the touch and link tasks, so it's allowed WATCH_BUDGET. The big digits are
+repainted whichever way is cheapest (ClockDigit.h), which normally keeps a frame well inside it. If more than
+WATCH_OVER_LIMIT of the last WATCH_WINDOW frames ran over anyway, the watch drops to WATCH_SLOW_PERIOD and shows
+tenths, and stays there until it's cleared.
+*/
+#define WATCH_FAST_PERIOD	20		// ms. 50 frames a second
+#define WATCH_SLOW_PERIOD	100		// ms. 10 frames a second
+#define WATCH_BUDGET		14000	// us a frame may take
+#define WATCH_WINDOW		50		// Frames the over-budget count is taken over
+#define WATCH_OVER_LIMIT	5
+
+/*
+Stopwatch & countdown time, laps and frame statistics. Times are millis(): the watch runs off the AVR's own clock,
+which is good to the hundredth over the minutes a stopwatch is used for.
+The face (ClockDisplay::refreshWatch()) turns shown() into digits. The sketch runs the render task at getPeriod()
+while the watch is running, and hands each frame's time to frameDone().
+*/
+class Stopwatch
+{
+public:
+	Stopwatch();
+	void setMode(uint8_t m, uint16_t seconds = 0);
+	uint8_t getMode() { return mode; }
+	bool isOn() { return mode != WATCH_OFF; }
+	bool isRunning() { return running; }
+	bool isSlow() { return slow; }
+	void control(uint8_t action, unsigned long ms);
+	unsigned long shown(unsigned long ms);
+	unsigned long getLap() { return laps ? lapTime(laps - 1) : 0; }
+	unsigned long lapTime(uint8_t lap);
+	uint8_t getLaps() { return laps; }
+	uint16_t getPeriod() { return slow ? WATCH_SLOW_PERIOD : WATCH_FAST_PERIOD; }
+	void painted(uint8_t how) { if (paints[how] < 0xFFFF) ++paints[how]; }
+	bool frameDone(unsigned long us);
+	void resetStats();
+	bool printLine(Print *out, uint8_t line);
+	uint16_t getFrames() { return frames; }
+	unsigned long getFrameAvg() { return frames ? frameTotal / frames : 0; }
+	unsigned long getFrameMax() { return frameMax; }
+	uint16_t getOver() { return over; }
+	uint16_t getPaints(uint8_t how) { return paints[how]; }
+
+private:
+	uint8_t mode;
+	bool running;
+	bool slow;						// Dropped to WATCH_SLOW_PERIOD
+	unsigned long startMs;			// millis() the watch would have started at to read what it does now
+	unsigned long heldMs;			// Time on the watch while it's stopped
+	unsigned long presetMs;			// Countdown start
+	unsigned long splits[WATCH_SPLITS];	// Watch time at each lap, newest at [(laps - 1) % WATCH_SPLITS]
+	uint8_t laps;					// Laps taken since it was cleared
+
+	// Frame statistics
+	uint16_t frames;
+	uint32_t frameTotal;
+	unsigned long frameMax;			// us
+	uint16_t over;					// Frames over WATCH_BUDGET
+	uint8_t windowFrames, windowOver;
+	unsigned long lastFrameMs;		// millis() at the end of the last frame
+	uint32_t gapTotal;				// Frame to frame (ms), for the rate actually reached. Stops aren't counted
+	uint16_t gaps;
+	uint16_t gapMax;
+	uint16_t paints[REPAINT_KINDS];	// Big digits repainted each way
+
+	unsigned long elapsed(unsigned long ms) { return running ? ms - startMs : heldMs; }
+	void printTime(Print *out, unsigned long ms);
+};
+
+#endif // _STOPWATCH_h
@@ -0,0 +1,259 @@
+/*
+Sun.cpp
+Sunrise, sunset & day length from the sunrise equation, in fixed point.
+Angles are binary angles (BAM), 0x10000 to the turn, so they wrap round by themselves in a uint16_t. Sines & cosines
+are Q15 (0x7FFF is 1.0). Times are Q16 days. A turn of hour angle is a day, so an hour angle in BAM is already a time.
+It takes 35 sines off a small table, 28 of them in the two arcsines, and a single 32-bit divide. No floating point.
+*/
+
+#include "Sun.h"
+
+#define SECS_PER_DAY		86400UL
+#define Q15_ONE				0x7FFF
+#define QUARTER_TURN		0x4000
+#define HALF_DAY			0x8000L			// Q16
+
+// Degrees to BAM, worked out by the compiler
+constexpr uint16_t sunBam(double degrees)
+{
+	return (uint16_t)(degrees * 65536.0 / 360.0 + 0.5);
+}
+
+/*
+Sine table, a quarter turn in 64 steps, Q15. The compiler fills it from the Taylor series, so there are no magic
+numbers to get wrong
+*/
+constexpr double sunTaylor(double x, double x2)
+{
+	return x * (1 - x2 / 6 * (1 - x2 / 20 * (1 - x2 / 42 * (1 - x2 / 72 * (1 - x2 / 110 * (1 - x2 / 156))))));
+}
+
+constexpr int16_t sunSineQ15(uint8_t step)
+{
+	return (int16_t)(Q15_ONE * sunTaylor(step * (3.14159265358979 / 128), (step * (3.14159265358979 / 128)) * (step * (3.14159265358979 / 128))) + 0.5);
+}
+
+#define SINE_STEPS		64
+
+static const int16_t sineTable[SINE_STEPS + 1] PROGMEM =
+{
+	sunSineQ15(0),  sunSineQ15(1),  sunSineQ15(2),  sunSineQ15(3),  sunSineQ15(4),  sunSineQ15(5),  sunSineQ15(6),  sunSineQ15(7),
+	sunSineQ15(8),  sunSineQ15(9),  sunSineQ15(10), sunSineQ15(11), sunSineQ15(12), sunSineQ15(13), sunSineQ15(14), sunSineQ15(15),
+	sunSineQ15(16), sunSineQ15(17), sunSineQ15(18), sunSineQ15(19), sunSineQ15(20), sunSineQ15(21), sunSineQ15(22), sunSineQ15(23),
+	sunSineQ15(24), sunSineQ15(25), sunSineQ15(26), sunSineQ15(27), sunSineQ15(28), sunSineQ15(29), sunSineQ15(30), sunSineQ15(31),
+	sunSineQ15(32), sunSineQ15(33), sunSineQ15(34), sunSineQ15(35), sunSineQ15(36), sunSineQ15(37), sunSineQ15(38), sunSineQ15(39),
+	sunSineQ15(40), sunSineQ15(41), sunSineQ15(42), sunSineQ15(43), sunSineQ15(44), sunSineQ15(45), sunSineQ15(46), sunSineQ15(47),
+	sunSineQ15(48), sunSineQ15(49), sunSineQ15(50), sunSineQ15(51), sunSineQ15(52), sunSineQ15(53), sunSineQ15(54), sunSineQ15(55),
+	sunSineQ15(56), sunSineQ15(57), sunSineQ15(58), sunSineQ15(59), sunSineQ15(60), sunSineQ15(61), sunSineQ15(62), sunSineQ15(63),
+	sunSineQ15(64)
+};
+
+/*
+The sunrise equation's constants (Wikipedia, "Sunrise equation"). The mean anomaly goes round 0.98560028 degrees a
+day: 179 BAM and MEAN_MOTION_FRAC/65536 more. The equation of the centre's third term (0.0003 degrees) is too small
+to show
+*/
+#define MEAN_ANOMALY_2000	sunBam(357.5291)		// At J2000, noon on 1/1/2000 UTC
+#define MEAN_MOTION_FRAC	27725					// 0.42306 BAM
+#define PERIHELION			sunBam(282.9372)		// Argument of perihelion + 180 degrees
+#define CENTRE_1			22309					// 1.9148 degrees in BAM, * 64
+#define CENTRE_2			233						// 0.0200 degrees in BAM, * 64
+#define TRANSIT_M			1389					// 0.0053 days in Q16, * 4
+#define TRANSIT_L			1809					// 0.0069 days in Q16, * 4
+#define SIN_OBLIQUITY		13034					// sin(23.4397 degrees)
+#define SIN_HORIZON			-476					// sin(-0.833 degrees): the top of the sun, through the air
+#define DEGREES_TO_BAM		59652					// 0.01 degree to BAM is 1.82044, * 32768
+
+// Sine of a binary angle, Q15. Straight line between table steps
+static int16_t sine(uint16_t a)
+{
+	uint16_t x = a & (QUARTER_TURN - 1);
+	uint8_t i;
+	int16_t s, s1;
+
+	if (a & QUARTER_TURN)		// 2nd & 4th quarters run backwards
+		x = QUARTER_TURN - x;
+	i = x >> 8;
+	s = pgm_read_word(&sineTable[i]);
+	if (i < SINE_STEPS)
+	{
+		s1 = pgm_read_word(&sineTable[i + 1]);
+		s += (int16_t)(((int32_t)(s1 - s) * (x & 0xFF) + 0x80) >> 8);
+	}
+	return (a & (2 * QUARTER_TURN)) ? -s : s;
+}
+
+// Angle up to a quarter turn whose sine is s (0 to Q15_ONE). A bit at a time, off the table
+static uint16_t arcsine(int16_t s)
+{
+	uint16_t a = 0, bit;
+
+	for (bit = QUARTER_TURN >> 1; bit; bit >>= 1)
+	{
+		if (sine(a | bit) <= s)
+			a |= bit;
+	}
+	return a;
+}
+
+static int16_t mulQ15(int16_t a, int16_t b)
+{
+	return (int16_t)(((int32_t)a * b + 0x4000) >> 15);
+}
+
+// Q16 days since midnight UTC to local minutes, 0-1439
+static uint16_t localMinutes(int32_t t, int8_t utc)
+{
+	int16_t m = (int16_t)((t * SUN_DAY_MINUTES + HALF_DAY) >> 16) + utc * 15;
+
+	while (m < 0)
+		m += SUN_DAY_MINUTES;
+	while (m >= SUN_DAY_MINUTES)
+		m -= SUN_DAY_MINUTES;
+	return m;
+}
+
+/*
+The sunrise equation
+days is the local date, as days since 1/1/2000. Solar noon is found for the date's noon at the place's longitude,
+then the hour angle either side of it where the sun's top is on the horizon.
+*/
+void SunTimes::compute(uint16_t days, int16_t latitude, int16_t longitude, int8_t utcOffset, sunTimes_t *out)
+{
+	int32_t noon, num, den;
+	int16_t sinM, sinLat, cosLat, sinDec, cosDec, cosH;
+	uint16_t m, l, latBam, h;
+
+	// Mean solar noon, as a Q16 day from noon UTC on the date: east of Greenwich is earlier
+	noon = -(((int32_t)longitude * DEGREES_TO_BAM + 0x4000) >> 15);
+
+	// Mean anomaly on it, the equation of the centre and the ecliptic longitude
+	m = MEAN_ANOMALY_2000 + days * 179 +
+		(uint16_t)(((int32_t)days * MEAN_MOTION_FRAC + noon * 179 + ((noon * MEAN_MOTION_FRAC) >> 16) + 0x8000) >> 16);
+	sinM = sine(m);
+	l = m + PERIHELION + (int16_t)(((int32_t)sinM * CENTRE_1 + (int32_t)sine(m << 1) * CENTRE_2 + 0x100000L) >> 21);
+
+	// Solar noon, with the equation of time
+	noon += ((int32_t)sinM * TRANSIT_M - (int32_t)sine(l << 1) * TRANSIT_L + 0x10000L) >> 17;
+
+	// Declination
+	sinDec = mulQ15(sine(l), SIN_OBLIQUITY);
+	cosDec = sine(QUARTER_TURN - arcsine(abs(sinDec)));
+	latBam = (uint16_t)(((int32_t)latitude * DEGREES_TO_BAM + 0x4000) >> 15);
+	sinLat = sine(latBam);
+	cosLat = sine(latBam + QUARTER_TURN);
+
+	// Hour angle: cos H = (sin h0 - sin(lat) sin(dec)) / (cos(lat) cos(dec)), all Q30 until the divide
+	num = (int32_t)SIN_HORIZON * 32768L - (int32_t)sinLat * sinDec;
+	den = (int32_t)cosLat * cosDec;
+	if (num >= den)
+	{
+		out->rise = out->set = SUN_NONE;
+		out->length = 0;
+		out->polar = SUN_DOWN_ALL_DAY;
+		return;
+	}
+	if (-num >= den)
+	{
+		out->rise = out->set = SUN_NONE;
+		out->length = SUN_DAY_MINUTES;
+		out->polar = SUN_UP_ALL_DAY;
+		return;
+	}
+	cosH = num / ((den + Q15_ONE) >> 15);	// Rounded up, so it's never 0 this close to a pole
+	h = (cosH >= 0) ? QUARTER_TURN - arcsine(cosH) : QUARTER_TURN + arcsine(-cosH);
+
+	noon += HALF_DAY;		// From midnight UTC
+	out->rise = localMinutes(noon - h, utcOffset);
+	out->set = localMinutes(noon + h, utcOffset);
+	out->length = (uint16_t)(((uint32_t)h * (2 * SUN_DAY_MINUTES) + HALF_DAY) >> 16);
+	out->polar = SUN_NORMAL;
+}
+
+SunTimes::SunTimes()
+{
+	lat = lon = 0;
+	utc = 0;
+	forDay = forMonth = 0;
+	memset(&times, 0, sizeof(times));
+	cycles = 0;
+	runs = 0;
+}
+
+// A new place. The times are worked out again on the next update()
+void SunTimes::setPlace(int16_t latitude, int16_t longitude, int8_t utcOffset)
+{
+	if ((latitude != lat) || (longitude != lon) || (utcOffset != utc))
+		forDay = 0;
+	lat = latitude;
+	lon = longitude;
+	utc = utcOffset;
+}
+
+// Work the times out if the date's changed since they last were. Returns true if they were
+bool SunTimes::update(const struct ts *today)
+{
+	unsigned long start, took;
+
+	if ((today->mday == forDay) && (today->mon == forMonth))
+		return false;
+	forDay = today->mday;
+	forMonth = today->mon;
+	start = micros();
+	compute(RTClockClass::toSeconds(today) / SECS_PER_DAY, lat, lon, utc, &times);
+	took = (micros() - start) * clockCyclesPerMicrosecond();
+	cycles = (took > 0xFFFF) ? 0xFFFF : took;
+	++runs;
+	return true;
+}
+
+// HH:MM
+void SunTimes::printTime(Print *out, uint16_t minutes)
+{
+	if (minutes == SUN_NONE)
+	{
+		out->print(F("--:--"));
+		return;
+	}
+	if (minutes / 60 < 10)
+		out->print('0');
+	out->print(minutes / 60);
+	out->print(':');
+	if (minutes % 60 < 10)
+		out->print('0');
+	out->print(minutes % 60);
+}
+
+/*
+Print one line of the report. The place, then the times and what working them out took (micros(), so to 4us)
+	sun lat 5150 lon -12 utc 0
+	sun rise 07:43 set 16:14 day 08:31 cycles 3456 runs 1
+Returns false once there are no more lines
+*/
+bool SunTimes::printLine(Print *out, uint8_t line)
+{
+	switch (line)
+	{
+	case 0:
+		out->print(F("sun lat "));
+		out->print(lat);
+		out->print(F(" lon "));
+		out->print(lon);
+		out->print(F(" utc "));
+		out->println(utc);
+		return true;
+	case 1:
+		out->print(F("sun rise "));
+		printTime(out, times.rise);
+		out->print(F(" set "));
+		printTime(out, times.set);
+		out->print(F(" day "));
+		printTime(out, times.length);
+		out->print(F(" cycles "));
+		out->print(cycles);
+		out->print(F(" runs "));
+		out->println(runs);
+		return true;
+	}
+	return false;
+}
@@ -0,0 +1,72 @@
+// Sun.h
+// Today's sunrise, sunset & day length for the clock's place, worked out in fixed point once a day
+
+#ifndef _SUN_h
+#define _SUN_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include "RTClock.h"
+
+/*
+The place
+Latitude & longitude in hundredths of a degree, north & east positive. The RTC keeps local time, so the times come
+out in it by the UTC offset, in quarter hours (UTC+5:45 is 23). It's up to whoever sets it to change it for summer time.
+*/
+#define SUN_LAT_MAX			9000
+#define SUN_LON_MAX			18000
+#define SUN_UTC_MAX			56		// Quarter hours either way: UTC-14:00 to UTC+14:00
+
+#define SUN_NONE			0xFFFF	// Rise or set of a day the sun doesn't rise or doesn't set on
+#define SUN_DAY_MINUTES		1440
+
+// Polar days
+#define SUN_NORMAL			0
+#define SUN_UP_ALL_DAY		1
+#define SUN_DOWN_ALL_DAY	2
+
+#define SUN_REPORT_LINE		48		// Longest line printLine() writes
+
+typedef struct
+{
+	uint16_t rise;			// Minutes into the local day, or SUN_NONE
+	uint16_t set;
+	uint16_t length;		// Minutes of daylight
+	uint8_t polar;			// SUN_NORMAL, SUN_UP_ALL_DAY or SUN_DOWN_ALL_DAY
+} sunTimes_t;
+
+/*
+Works the day out when the date changes (update(), from ClockDisplay::refreshTime()) or the place does, and keeps it.
+compute() is the sum on its own, for the bench to check against a floating point one (sim/Bench.cpp).
+*/
+class SunTimes
+{
+public:
+	SunTimes();
+	void setPlace(int16_t latitude, int16_t longitude, int8_t utcOffset);
+	int16_t getLatitude() { return lat; }
+	int16_t getLongitude() { return lon; }
+	int8_t getUtcOffset() { return utc; }
+	bool update(const struct ts *today);
+	const sunTimes_t *get() { return &times; }
+	uint16_t getCycles() { return cycles; }
+	uint16_t getRuns() { return runs; }
+	bool printLine(Print *out, uint8_t line);
+	static void compute(uint16_t days, int16_t latitude, int16_t longitude, int8_t utcOffset, sunTimes_t *out);
+
+private:
+	int16_t lat, lon;
+	int8_t utc;
+	uint8_t forDay, forMonth;		// Date times is for. forDay 0 until it's been worked out
+	sunTimes_t times;
+	uint16_t cycles;				// CPU cycles the last compute() took
+	uint16_t runs;					// compute()s since boot
+
+	void printTime(Print *out, uint16_t minutes);
+};
+
+#endif // _SUN_h
@@ -0,0 +1,252 @@
+/*
+TimeSync.cpp
+Sets the RTC from a host clock over the Serial link, NTP style.
+Setting the time from the setup screen can only get it to within a second or so. This gets it to within a
+millisecond or two of the host, and running it again later shows how far the RTC has drifted in between.
+*/
+
+#include "TimeSync.h"
+#include "RTClock.h"
+
+extern RTClockClass RTClock;	// Real-time clock object
+
+#define SYNC_PERIOD_TOLERANCE	20000	// A tick period further than this from 1s is a glitch (or the RTC being set)
+
+TimeSync::TimeSync()
+{
+	edgeUs = period = edgeMs = 0;
+	ticks = 0;
+	baseValid = false;
+	inFlight = false;
+	haveBest = false;
+	armed = false;
+	syncs = 0;
+	lastStep = drift = 0;
+	lastOffset = SYNC_OFFSET_NONE;
+	lastSyncMs = 0;
+}
+
+// Tick interrupt, with micros() at the edge
+void TimeSync::edge(unsigned long us)
+{
+	unsigned long p = us - edgeUs;
+
+	if ((p > 1000000UL - SYNC_PERIOD_TOLERANCE) && (p < 1000000UL + SYNC_PERIOD_TOLERANCE))
+		period = p;
+	edgeUs = us;
+	edgeMs = millis();
+	++ticks;
+}
+
+bool TimeSync::tickRunning()
+{
+	unsigned long ms, p;
+
+	noInterrupts();
+	ms = edgeMs;
+	p = period;
+	interrupts();
+	return (p != 0) && ((millis() - ms) < SYNC_TICK_TIMEOUT);
+}
+
+/*
+us * err / 1000000, for the period error 'err' (us per second). The multiply is split on 15625 (1000000 >> 6) so
+neither half can overflow a long. The whole (us >> 6) times an error near SYNC_PERIOD_TOLERANCE would, after 7s.
+*/
+static long periodError(unsigned long us, long err)
+{
+	unsigned long q = us >> 6;
+
+	return (long)(q / 15625) * err + ((long)(q % 15625) * err) / 15625;
+}
+
+/*
+Convert between micros() and true (RTC) microseconds, using the measured tick period
+First order is plenty: the correction is at most a percent or so, over at most SYNC_SAMPLE_AGE.
+*/
+unsigned long TimeSync::toTrue(unsigned long us)
+{
+	return us - periodError(us, (long)period - 1000000L);
+}
+
+unsigned long TimeSync::fromTrue(unsigned long us)
+{
+	return us + periodError(us, (long)period - 1000000L);
+}
+
+// The clock's time at micros() m: seconds since 2000 from the RTC, plus the time since the tick
+void TimeSync::clockTime(unsigned long m, uint32_t *sec, unsigned long *us)
+{
+	unsigned long e, p, frac;
+	uint16_t n;
+
+	noInterrupts();
+	e = edgeUs;
+	p = period;
+	n = ticks;
+	interrupts();
+
+	frac = m - e;
+	if ((long)frac < 0)		// m was taken just before a tick that's been counted since
+	{
+		frac += p;
+		--n;
+	}
+	frac = toTrue(frac);
+	*sec = baseSec + (uint16_t)(n - baseTicks) + frac / 1000000;
+	*us = frac % 1000000;
+}
+
+/*
+First half of an exchange. Returns the clock's time as the reply goes out, or false if the tick isn't running.
+A new session throws away the samples from the last one and reads the RTC again.
+*/
+bool TimeSync::start(bool newSession, uint32_t *sec, unsigned long *us)
+{
+	uint16_t n, after;
+
+	if (!tickRunning())
+		return false;
+	if (newSession)
+	{
+		haveBest = false;
+		baseValid = false;
+	}
+	if (!baseValid)
+	{
+		// The read has to fall between two ticks, so the seconds it gets go with the tick count
+		do
+		{
+			noInterrupts();
+			n = ticks;
+			interrupts();
+			RTClock.readTime();
+			noInterrupts();
+			after = ticks;
+			interrupts();
+		} while (n != after);
+		baseSec = RTClockClass::toSeconds(RTClock.getTime());
+		baseTicks = n;
+		baseValid = true;
+	}
+
+	t0 = micros();
+	t0Ms = millis();
+	inFlight = true;
+	clockTime(t0, sec, us);
+	return true;
+}
+
+/*
+Second half of an exchange: the host's time when it sent this frame, and how long it held on to our reply first.
+Gives back the round trip and the offset (host - clock, us) for this sample. False if there was no first half.
+*/
+bool TimeSync::sample(uint32_t hostSec, unsigned long hostUs, unsigned long hold, unsigned long *delay, long *offset)
+{
+	unsigned long t1 = micros(), rtt, cu;
+	uint32_t cs;
+	long diff;
+
+	if (!inFlight)
+		return false;
+	inFlight = false;
+
+	rtt = toTrue(t1 - t0);
+	rtt = (rtt > hold) ? rtt - hold : 0;
+	hostUs += rtt / 2;			// Host's time at t1
+	hostSec += hostUs / 1000000;
+	hostUs %= 1000000;
+
+	clockTime(t1, &cs, &cu);
+	diff = (long)(hostSec - cs);
+	*offset = ((diff > -2000) && (diff < 2000)) ? diff * 1000000L + (long)hostUs - (long)cu : SYNC_OFFSET_NONE;
+	*delay = rtt;
+
+	if (!haveBest || (rtt < bestDelay))
+	{
+		haveBest = true;
+		bestDelay = rtt;
+		bestOffset = *offset;
+		bestHostSec = hostSec;
+		bestHostUs = hostUs;
+		bestAt = t1;
+		bestAtMs = millis();
+		lastOffset = bestOffset;
+	}
+	return true;
+}
+
+/*
+Schedule the step from the best sample of the session. service() writes it when the time comes.
+Returns the host second that will be written, or false if there's no recent sample.
+*/
+bool TimeSync::apply(uint32_t *target)
+{
+	unsigned long m = micros(), hu, wait, elapsed;
+	long off;
+
+	if (!haveBest || ((millis() - bestAtMs) > SYNC_SAMPLE_AGE))
+		return false;
+
+	// Host's time now, and the wait until its next whole second
+	hu = bestHostUs + toTrue(m - bestAt);
+	stepSec = bestHostSec + hu / 1000000;
+	hu %= 1000000;
+	wait = 1000000 - hu;
+	++stepSec;
+	if (wait < SYNC_MIN_LEAD_US)
+	{
+		wait += 1000000;
+		++stepSec;
+	}
+	stepAt = m + fromTrue(wait) - SYNC_WRITE_LEAD_US;
+	armed = true;
+
+	// How far the RTC got out since the last step gives its drift. + = RTC running fast
+	off = bestOffset;
+	if (syncs && (off != SYNC_OFFSET_NONE) && ((elapsed = (millis() - lastSyncMs) / 1000) >= SYNC_DRIFT_MIN))
+		drift = -((off / (long)elapsed) * 10 + ((off % (long)elapsed) * 10) / (long)elapsed);
+	lastStep = off;
+	haveBest = false;
+	*target = stepSec;
+	return true;
+}
+
+// Write the scheduled step once it's due. Returns true when the RTC has been set
+bool TimeSync::service()
+{
+	struct ts t;
+	long left;
+
+	if (!armed)
+		return false;
+	left = (long)(stepAt - micros());
+	if (left > SYNC_SPIN_US)
+		return false;
+	if (left < -SYNC_LATE_US)	// Something held us up. Go for the next second
+	{
+		stepAt += fromTrue(1000000);
+		++stepSec;
+		return false;
+	}
+
+	RTClockClass::fromSeconds(stepSec, &t);		// Do the sums before the wait
+	while ((long)(stepAt - micros()) > 0)
+		;
+	RTClock.setTime(&t);
+
+	armed = false;
+	baseValid = false;
+	++syncs;
+	lastSyncMs = millis();
+	return true;
+}
+
+// Drop everything in progress (the time was set some other way)
+void TimeSync::cancel()
+{
+	inFlight = false;
+	haveBest = false;
+	armed = false;
+	baseValid = false;
+}
@@ -0,0 +1,89 @@
+// TimeSync.h
+// Sets the RTC from a host clock over the Serial link, NTP style
+
+#ifndef _TIMESYNC_h
+#define _TIMESYNC_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#define SYNC_TICK_TIMEOUT	1500		// ms without an RTC tick before the sub-second time can't be trusted
+#define SYNC_WAIT_MS		100			// How long the link keeps polling flat out for the host's half of an exchange
+#define SYNC_SAMPLE_AGE		10000		// ms. The best sample has to be newer than this to step the clock
+#define SYNC_MIN_LEAD_US	200000		// The step is never scheduled closer than this
+#define SYNC_SPIN_US		25000		// Wait for the step in a tight loop once it's this close (longer than the link period)
+#define SYNC_LATE_US		2000		// Missed the step by more than this: go for the next second instead
+#define SYNC_WRITE_LEAD_US	300			// The DS3231 restarts its countdown when the seconds register is acked, 3 bytes into the write
+#define SYNC_DRIFT_MIN		600			// Seconds between syncs before a drift figure is worked out
+#define SYNC_OFFSET_NONE	0x7FFFFFFFL	// Offset too big to show in us (the RTC was more than half an hour out)
+
+/*
+One exchange (a sample) is two frames:
+	start()		Host asks for the clock's time. t0 is when the reply goes out
+	sample()	Host sends its time, and how long it held on to the reply before sending. It arrives at t1
+The round trip is t1 - t0 less the host's hold time. Half of it is added to the host's time to get the host's time at
+t1. The two frames are the same length, so the time they spend on the wire cancels out. Samples are repeated and the
+one with the shortest round trip is kept, since it had the least waiting in it.
+apply() then steps the RTC: it writes the next whole host second at the moment the host clock reaches it, which
+restarts the RTC's countdown in line with the host.
+The clock's own time between ticks comes from micros() since the last 1Hz edge, scaled by the measured length of a
+second (the Pro Mini's resonator can be a few tenths of a percent out), so the tick has to be running.
+*/
+class TimeSync
+{
+public:
+	TimeSync();
+	void edge(unsigned long us);
+	bool tickRunning();
+	bool start(bool newSession, uint32_t *sec, unsigned long *us);
+	bool sample(uint32_t hostSec, unsigned long hostUs, unsigned long hold, unsigned long *delay, long *offset);
+	bool apply(uint32_t *target);
+	bool service();
+	void cancel();
+	bool waiting() { return inFlight && ((millis() - t0Ms) < SYNC_WAIT_MS); }
+	uint16_t getSyncs() { return syncs; }
+	long getLastStep() { return lastStep; }
+	long getDrift() { return drift; }
+	long getLastOffset() { return lastOffset; }
+	unsigned long getBestDelay() { return haveBest ? bestDelay : 0; }
+
+private:
+	// From the tick interrupt
+	volatile unsigned long edgeUs;		// micros() at the last tick
+	volatile unsigned long period;		// micros() between the last two ticks
+	volatile uint16_t ticks;			// Ticks seen. Counts the seconds since baseSec was read
+	volatile unsigned long edgeMs;		// millis() at the last tick
+
+	uint32_t baseSec;					// RTC seconds (since 2000) at tick number baseTicks
+	uint16_t baseTicks;
+	bool baseValid;
+
+	bool inFlight;						// Waiting for the host's half of an exchange
+	unsigned long t0, t0Ms;
+
+	bool haveBest;						// Best sample of the session so far
+	unsigned long bestDelay;
+	long bestOffset;
+	uint32_t bestHostSec;				// Host time at bestAt
+	unsigned long bestHostUs;
+	unsigned long bestAt, bestAtMs;		// micros() and millis() when the best sample arrived
+
+	bool armed;							// A step is waiting to be written
+	uint32_t stepSec;
+	unsigned long stepAt;				// micros() to start the write
+
+	uint16_t syncs;						// Steps since boot
+	long lastStep;						// Offset corrected by the last step (us)
+	long drift;							// Offset per time since the step before that (tenths of a ppm)
+	long lastOffset;					// Best offset in the latest session (us). After a sync this is the residual
+	unsigned long lastSyncMs;
+
+	unsigned long toTrue(unsigned long us);
+	unsigned long fromTrue(unsigned long us);
+	void clockTime(unsigned long m, uint32_t *sec, unsigned long *us);
+};
+
+#endif // _TIMESYNC_h
@@ -0,0 +1,344 @@
+/*
+TouchTrace.cpp
+Touch panel capture & replay.
+Touch problems depend on exactly what the panel read and when, which can't be set up again by hand. A captured
+trace can be played back through the same touch code as often as needed, on the clock or in the simulator.
+*/
+
+#include "TouchTrace.h"
+
+TouchTrace::TouchTrace()
+{
+	mode = TRACE_OFF;
+	head = count = 0;
+	dropped = underruns = 0;
+	downPending = false;
+	actions = 0;
+	lastLatency = maxLatency = 0;
+	state = false;
+}
+
+/*
+Change mode. Whatever is in the buffer is thrown away.
+Replay starts when the first record is fed in, and goes back to TRACE_OFF by itself once the last one is used up.
+*/
+void TouchTrace::setMode(uint8_t m)
+{
+	mode = m;
+	head = count = 0;
+	lastAt = (m == TRACE_REPLAY) ? 0 : micros();	// Replay counts in trace time
+	lastX = lastY = 0;
+	lastState = 0xFF;
+	lost = false;
+	started = fedLast = dry = false;
+	haveNext = false;
+	state = false;
+	actions = 0;		// Fresh latency figures for the run
+	lastLatency = maxLatency = 0;
+}
+
+// Panel touched? Logged on capture when it changes
+bool TouchTrace::touched(RA8875 *disp)
+{
+	bool down;
+
+	if (mode == TRACE_REPLAY)
+	{
+		advance(micros());
+		down = state;
+	}
+	else
+	{
+		down = disp->touched();
+		if ((mode == TRACE_CAPTURE) && (down != lastState))
+		{
+			uint8_t s = down ? TRACE_STATE_DOWN : 0;
+			log(TRACE_KIND_STATE, &s, 1);
+			lastState = down;
+		}
+	}
+	touchState(down);
+	return down;
+}
+
+// Raw touch ADC read
+void TouchTrace::readAdc(RA8875 *disp, uint16_t *x, uint16_t *y)
+{
+	unsigned long now;
+
+	if (mode != TRACE_REPLAY)
+	{
+		disp->touchReadAdc(x, y);
+		if (mode == TRACE_CAPTURE)
+			logSample(*x, *y);
+		return;
+	}
+
+	now = micros();
+	advance(now);
+	if (decode() && (nextKind != TRACE_KIND_STATE) && ((long)(nextAt - (now - replayStart)) <= TRACE_LOOKAHEAD_US))
+		takeNext();		// Rest of the burst
+	*x = lastX;
+	*y = lastY;
+}
+
+// Start timing from the touch-down edge
+void TouchTrace::touchState(bool down)
+{
+	if (down && !downPending)
+	{
+		downAt = micros();
+		downPending = true;
+	}
+	else if (!down)
+		downPending = false;
+}
+
+// The UI did something about the current touch
+void TouchTrace::action()
+{
+	if (!downPending)
+		return;
+	downPending = false;
+	lastLatency = micros() - downAt;
+	if (lastLatency > maxLatency)
+		maxLatency = lastLatency;
+	++actions;
+}
+
+/*
+Capture
+*/
+
+// Add a record, stamped with the time since the last one. If it won't fit it's dropped, and the next record that does
+// fit is marked as coming after a gap.
+void TouchTrace::log(uint8_t kind, const uint8_t *data, uint8_t n)
+{
+	uint8_t rec[TRACE_RECORD_MAX + 2], len = 0, i;
+	unsigned long now = micros(), dt = (now - lastAt) / TRACE_TICK_US;
+	uint8_t gapState = 0xFF;
+
+	if (lost)
+	{
+		// A state record carries the gap itself. A sample gets a gap record (with the state) in front of it
+		if (kind == TRACE_KIND_STATE)
+			gapState = data[0] | TRACE_STATE_GAP;
+		else
+		{
+			gapState = TRACE_STATE_GAP | ((lastState == 1) ? TRACE_STATE_DOWN : 0);
+			n = 0;		// Sample goes in after the gap record
+		}
+		kind = TRACE_KIND_STATE;
+	}
+
+	if (dt < TRACE_DT_EXT)
+		rec[len++] = kind | dt;
+	else
+	{
+		rec[len++] = kind | TRACE_DT_EXT;
+		do
+		{
+			rec[len++] = (dt & 0x7F) | ((dt > 0x7F) ? 0x80 : 0);
+			dt >>= 7;
+		} while (dt);
+	}
+	if (gapState != 0xFF)
+	{
+		rec[len++] = gapState;
+		if (n == 0)		// Then the sample, at the same time
+		{
+			rec[len++] = TRACE_KIND_ABS;
+			for (i = 0; i < 3; ++i)
+				rec[len++] = data[i];
+		}
+	}
+	else
+		for (i = 0; i < n; ++i)
+			rec[len++] = data[i];
+
+	if (len > TRACE_BUFFER - count)
+	{
+		lost = true;
+		++dropped;
+		return;
+	}
+	for (i = 0; i < len; ++i)
+		buf[(uint8_t)(head + count++) % TRACE_BUFFER] = rec[i];
+	lastAt = now - ((now - lastAt) % TRACE_TICK_US);	// Keep the remainder, so the times don't creep
+	lost = false;
+}
+
+void TouchTrace::logSample(uint16_t x, uint16_t y)
+{
+	uint8_t d[3];
+	int dx = (int)x - (int)lastX, dy = (int)y - (int)lastY;
+
+	if (!lost && (dx >= -8) && (dx <= 7) && (dy >= -8) && (dy <= 7))
+	{
+		d[0] = (uint8_t)((dx << 4) | (dy & 0x0F));
+		log(TRACE_KIND_NUDGE, d, 1);
+	}
+	else if (!lost && (dx >= -128) && (dx <= 127) && (dy >= -128) && (dy <= 127))
+	{
+		d[0] = (uint8_t)dx;
+		d[1] = (uint8_t)dy;
+		log(TRACE_KIND_DELTA, d, 2);
+	}
+	else
+	{
+		d[0] = (uint8_t)x;
+		d[1] = (uint8_t)y;
+		d[2] = ((x >> 8) & 0x03) | (((y >> 8) & 0x03) << 4);
+		log(TRACE_KIND_ABS, d, 3);
+	}
+	if (!lost)
+	{
+		lastX = x;
+		lastY = y;
+	}
+}
+
+// Captured bytes worth sending now: a full chunk, or whatever there is once the panel's been let go
+uint8_t TouchTrace::ready()
+{
+	if ((mode != TRACE_CAPTURE) || ((count < TRACE_CHUNK) && (lastState == 1)))
+		return 0;
+	return count;
+}
+
+// Take up to max bytes of captured trace, for the Serial link to send
+uint8_t TouchTrace::take(uint8_t *out, uint8_t max)
+{
+	uint8_t n = 0;
+
+	while ((n < max) && count)
+	{
+		out[n++] = buf[head];
+		head = (head + 1) % TRACE_BUFFER;
+		--count;
+	}
+	return n;
+}
+
+/*
+Replay
+*/
+
+// Add trace bytes from the host. Returns how many fitted; the host sends the rest again later
+uint8_t TouchTrace::feed(const uint8_t *in, uint8_t len, bool last)
+{
+	uint8_t n = 0;
+
+	if (mode != TRACE_REPLAY)
+		return 0;
+	while ((n < len) && (count < TRACE_BUFFER))
+		buf[(uint8_t)(head + count++) % TRACE_BUFFER] = in[n++];
+	if ((n == len) && last)
+		fedLast = true;
+	return n;
+}
+
+// Decode the next record into next*, if it's all in the buffer
+bool TouchTrace::decode()
+{
+	uint8_t b, len = 1, shift = 0, data;
+	unsigned long dt;
+
+	if (haveNext)
+		return true;
+	if (count == 0)
+	{
+		if (fedLast)
+			mode = TRACE_OFF;		// Trace finished. Back to the panel
+		else if (started && !dry)
+		{
+			dry = true;
+			++underruns;
+		}
+		return false;
+	}
+
+	b = peek(0);
+	dt = b & TRACE_DT_EXT;
+	if (dt == TRACE_DT_EXT)
+	{
+		dt = 0;
+		do
+		{
+			if (len >= count)
+				return false;
+			data = peek(len++);
+			dt |= (unsigned long)(data & 0x7F) << shift;
+			shift += 7;
+		} while (data & 0x80);
+	}
+
+	nextKind = b & TRACE_KIND_MASK;
+	switch (nextKind)
+	{
+	case TRACE_KIND_STATE:
+	case TRACE_KIND_NUDGE:
+		data = 1;
+		break;
+	case TRACE_KIND_DELTA:
+		data = 2;
+		break;
+	default:
+		data = 3;
+		break;
+	}
+	if (len + data > count)
+		return false;
+
+	switch (nextKind)
+	{
+	case TRACE_KIND_STATE:
+		nextState = peek(len);
+		break;
+	case TRACE_KIND_NUDGE:
+		nextX = lastX + ((int8_t)peek(len) >> 4);
+		nextY = lastY + ((int8_t)(peek(len) << 4) >> 4);
+		break;
+	case TRACE_KIND_DELTA:
+		nextX = lastX + (int8_t)peek(len);
+		nextY = lastY + (int8_t)peek(len + 1);
+		break;
+	default:
+		nextX = peek(len) | ((uint16_t)(peek(len + 2) & 0x03) << 8);
+		nextY = peek(len + 1) | ((uint16_t)((peek(len + 2) >> 4) & 0x03) << 8);
+		break;
+	}
+	nextLen = len + data;
+	nextAt = lastAt + dt * TRACE_TICK_US;
+	haveNext = true;
+	dry = false;
+	if (!started)
+	{
+		started = true;
+		replayStart = micros() - nextAt;
+	}
+	return true;
+}
+
+// Use the decoded record
+void TouchTrace::takeNext()
+{
+	head = (head + nextLen) % TRACE_BUFFER;
+	count -= nextLen;
+	lastAt = nextAt;
+	haveNext = false;
+	if (nextKind == TRACE_KIND_STATE)
+		state = nextState & TRACE_STATE_DOWN;
+	else
+	{
+		lastX = nextX;
+		lastY = nextY;
+	}
+}
+
+// Use every record that's due by micros() now
+void TouchTrace::advance(unsigned long now)
+{
+	while ((mode == TRACE_REPLAY) && decode() && ((long)(nextAt - (now - replayStart)) <= 0))
+		takeNext();
+}
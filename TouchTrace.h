@@ -0,0 +1,104 @@
+// TouchTrace.h
+// Touch panel capture & replay
+
+#ifndef _TOUCHTRACE_h
+#define _TOUCHTRACE_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include <SPI.h>
+#include <RA8875.h>
+
+#define TRACE_BUFFER		64		// Bytes held between the touch code and the Serial link, either way
+#define TRACE_TICK_US		16		// Unit of time in the trace
+#define TRACE_LOOKAHEAD_US	2000	// On replay a read can take the next sample this early (the rest of its burst)
+#define TRACE_CHUNK			16		// Capture bytes per Serial frame. Less is sent only when the panel isn't touched
+
+// Modes
+#define TRACE_OFF			0		// Touch panel as normal
+#define TRACE_CAPTURE		1		// Touch panel as normal, and every read is logged
+#define TRACE_REPLAY		2		// Reads come from the trace instead of the touch panel
+
+/*
+Trace records
+The first byte is the kind (top 2 bits) and the time since the last record in TRACE_TICK_US units (low 6 bits). If
+the time doesn't fit, the low bits are TRACE_DT_EXT and the time follows as a varint (7 bits a byte, low first).
+Samples are the raw ADC readings, stored as the change from the last sample where they're close.
+*/
+#define TRACE_KIND_STATE	0x00	// + 1 byte: TRACE_STATE_* bits. touched() changed
+#define TRACE_KIND_NUDGE	0x40	// + 1 byte: x & y change, signed 4 bits each (x in the high half)
+#define TRACE_KIND_DELTA	0x80	// + 2 bytes: x & y change, signed 8 bits each
+#define TRACE_KIND_ABS		0xC0	// + 3 bytes: x low 8, y low 8, x high 2 | (y high 2 << 4)
+#define TRACE_KIND_MASK		0xC0
+#define TRACE_DT_EXT		0x3F
+#define TRACE_STATE_DOWN	0x01	// Panel is touched
+#define TRACE_STATE_GAP		0x02	// Records were lost before this one (capture couldn't keep up). Next sample is absolute
+#define TRACE_RECORD_MAX	9		// Longest record
+
+/*
+Sits between the clock and the touch panel
+Capture logs each touched() change and every ADC read into a small buffer, which the Serial link streams to the
+host. Replay is the other way round: the host feeds a trace in and the touch code gets it back, at the times it was
+recorded, in place of the panel. Touch changes happen when they're due; samples are handed out in order, each no
+earlier than TRACE_LOOKAHEAD_US before its time, so a burst of reads gets the burst that was recorded.
+Also times touch-to-action latency: from the panel first being touched to the UI doing something about it.
+*/
+class TouchTrace
+{
+public:
+	TouchTrace();
+	bool touched(RA8875 *disp);
+	void readAdc(RA8875 *disp, uint16_t *x, uint16_t *y);
+	void setMode(uint8_t m);
+	uint8_t getMode() { return mode; }
+	uint8_t ready();
+	uint8_t room() { return TRACE_BUFFER - count; }
+	uint8_t take(uint8_t *out, uint8_t max);
+	uint8_t feed(const uint8_t *in, uint8_t len, bool last);
+	void action();
+	uint16_t getDropped() { return dropped; }
+	uint16_t getUnderruns() { return underruns; }
+	uint16_t getActions() { return actions; }
+	unsigned long getLastLatency() { return lastLatency; }
+	unsigned long getMaxLatency() { return maxLatency; }
+
+private:
+	uint8_t mode;
+	uint8_t buf[TRACE_BUFFER];		// Ring buffer of trace bytes
+	uint8_t head, count;
+	unsigned long lastAt;			// Capture: micros() of the last record. Replay: trace time of the last record taken
+	uint16_t lastX, lastY;			// Last sample (what deltas are from)
+	uint8_t lastState;				// Capture: last touched() logged. 0xFF = none yet
+	bool lost;						// Capture: a record didn't fit
+	uint16_t dropped;				// Records that didn't fit
+
+	// Replay
+	unsigned long replayStart;		// micros() at trace time 0
+	bool started, fedLast, dry;
+	uint16_t underruns;				// Times the host didn't feed the trace fast enough
+	bool haveNext;					// next* holds the next record, decoded but not taken
+	uint8_t nextKind, nextState, nextLen;
+	unsigned long nextAt;
+	uint16_t nextX, nextY;
+	bool state;						// Replayed touched()
+
+	// Touch-to-action latency
+	unsigned long downAt;
+	bool downPending;
+	uint16_t actions;
+	unsigned long lastLatency, maxLatency;
+
+	void log(uint8_t kind, const uint8_t *data, uint8_t n);
+	void logSample(uint16_t x, uint16_t y);
+	uint8_t peek(uint8_t i) { return buf[(uint8_t)(head + i) % TRACE_BUFFER]; }
+	bool decode();
+	void takeNext();
+	void advance(unsigned long now);
+	void touchState(bool down);
+};
+
+#endif // _TOUCHTRACE_h
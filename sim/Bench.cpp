@@ -0,0 +1,1046 @@
+/*
+Bench.cpp
+Runs the clock through a set of scenarios on virtual time and reports what each one costs on the buses.
+
+Every scenario runs in its own process, so each gets a freshly powered-on clock (static constructors, EEPROM, RTC
+and framebuffer all start clean).
+
+	sim/hexclock-bench [--csv] [--dump DIR] [--echo] [--profile] [--cmd STR] [--capture FILE] [scenario...]
+	sim/hexclock-bench --replay FILE [replay]
+	sim/hexclock-bench [--ppm N] --serve
+
+--cmd sends STR to the sketch over Serial after each scenario and prints what comes back under the row.
+--profile is --cmd p (the profiler summary).
+--serve runs the clock in real time from the host's local time, with its Serial port on a pseudo-terminal (the path
+is printed on startup), until it's killed. tools/hexlink.py talks to it. --ppm makes the RTC drift by N parts per
+million against the host.
+--capture turns on touch capture (TouchTrace.h) from power-on and writes the trace the clock streams out over Serial
+to FILE (the same format tools/hextrace.py writes). --replay feeds FILE back in the replay scenario, in place of the
+touch panel.
+
+Scenarios:
+	boot		Cold power-on through setup()
+	warmboot	Reset with power held up through setup()
+	second		An ordinary seconds tick (averaged over 10)
+	minute		The tick that rolls over the minute
+	midnight	The tick that rolls over the day
+	newyear		The tick that rolls over the year
+	setup-tap	One tap on the foreground-red swatch on the setup screen, and the color picker it brings up
+	day			24 hours of ticking, totals for the day
+	screenshot	A whole-screen export over Serial at the fast baud rate (Screenshot.h), with its size and time
+	replay		The --replay trace played through the touch code, with the touch-to-action latency
+	hexday		A minute of hex day time off the RTC's 32kHz output, with the tick timing and jitter
+	stopwatch	Ten seconds of the stopwatch running at its fast rate, with six laps tapped in, and its frame times
+	alarm		An alarm ringing, snoozed with a tap, ringing again and held off, with the I2C it took in between
+	timecolor	The tick that changes the color of the time, a whole-face recolor, against an ordinary one
+	sun			The midnight tick with the sun panel up, and the fixed point sun times against a floating point reference
+	keypad		Setting the time & date on the setup screen's keypad, a wrong date included, against stepping them
+	power		A dimmed minute at night, against a minute at full and one with the panel off, then a tap to wake
+	picker		A drag along the color picker's hue slider, against the redraw when it's let go and the one Set does
+*/
+
+#include <Arduino.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <time.h>
+#include <algorithm>
+#include "SimHost.h"
+#include "../ClockDisplay.h"
+#include "../Settings.h"
+#include "../TouchTrace.h"
+#include "../SerialLink.h"
+#include "../Latency.h"
+#include "../HexTime.h"
+#include "../Stopwatch.h"
+#include "../Alarms.h"
+#include "../Sun.h"
+#include "../Power.h"
+#include <math.h>
+
+extern uint16_t bootMagic;
+extern unsigned long bootTime;
+void setup();
+void loop();
+extern TouchTrace Touch;
+extern TickLatency Lat;
+extern RTClockClass RTClock;
+extern ClockDisplay theClock;
+#if FACE_HEXTIME
+extern HexTime Hex;
+#endif
+#if FACE_WATCH
+extern Stopwatch Watch;
+#endif
+#if FACE_ALARM
+extern AlarmTable Alarms;
+#endif
+#if FACE_SUN
+extern SunTimes Sun;
+#endif
+#if FACE_POWER
+extern PowerManager Power;
+#endif
+
+#define BOOT_MAGIC_VALUE	0x4878		// Must match BOOT_MAGIC in the sketch
+
+static bool csv;
+static const char *serialCmd;
+static const char *dumpDir;
+static int32_t rtcPpm;
+static const char *captureFile;
+static const char *replayFile;
+static char note[160];				// Printed under the scenario's row
+static uint8_t bootTimeMode = TIME_MODE_CLOCK;	// Time mode in the settings prepareEeprom() writes
+static uint8_t bootColorMode = COLOR_MODE_FIXED;	// ...and color mode
+static alarmEntry_t bootAlarm = { ALARM_EMPTY, ALARM_EMPTY, ALARM_EMPTY };	// Alarm prepareEeprom() puts in the table
+static bool bootSunPanel = false;	// Sun panel up, for London
+static bool bootPower = false;		// Power schedule: dim 23:00-07:00, off 01:00-05:00
+
+#define TRACE_FILE_MAGIC	"HXTR\x01"	// Trace file header (magic & version), then the records
+#define TRACE_FILE_HEADER	5
+
+typedef struct
+{
+	const char *name;
+	void (*run)(void);
+	const char *about;
+} scenario_t;
+
+// Result of one measured window
+static simStats_t result;
+static uint64_t windowUs;
+static uint32_t perRuns = 1;		// Divide the counts by this (averaged scenarios)
+static bool checkFailed = false;	// A scenario's own check didn't hold. Its row still prints, then the run fails
+
+// Clock as it comes out of the box after calibration: white on black, hex, 24h, mounted upside down
+static void prepareEeprom()
+{
+	uint8_t *ee = simEepromData();
+	int32_t cal[14] = {
+		SIM_TFT_WIDTH, 0, 0, 0, SIM_TFT_HEIGHT, 0, 1024,		// Rotation 0: raw 0-1023 across the panel
+		-SIM_TFT_WIDTH, 0, (SIM_TFT_WIDTH - 1) * 1024, 0, -SIM_TFT_HEIGHT, (SIM_TFT_HEIGHT - 1) * 1024, 1024 };	// 180
+	clockSettings_t cfg;
+	uint8_t i;
+
+	simEepromErase();
+	for (i = 0; i < 14; ++i)	// EEPROMWritelong() stores big-endian
+	{
+		ee[EEPROM_CALIBRATION_LOCATION + 4 * i] = (uint8_t)(cal[i] >> 24);
+		ee[EEPROM_CALIBRATION_LOCATION + 4 * i + 1] = (uint8_t)(cal[i] >> 16);
+		ee[EEPROM_CALIBRATION_LOCATION + 4 * i + 2] = (uint8_t)(cal[i] >> 8);
+		ee[EEPROM_CALIBRATION_LOCATION + 4 * i + 3] = (uint8_t)cal[i];
+	}
+	ee[EEPROM_SIGNATURE_LOCATION] = (uint8_t)(EEPROM_SIGNATURE_VALUE >> 24);
+	ee[EEPROM_SIGNATURE_LOCATION + 1] = (uint8_t)(EEPROM_SIGNATURE_VALUE >> 16);
+	ee[EEPROM_SIGNATURE_LOCATION + 2] = (uint8_t)(EEPROM_SIGNATURE_VALUE >> 8);
+	ee[EEPROM_SIGNATURE_LOCATION + 3] = (uint8_t)EEPROM_SIGNATURE_VALUE;
+
+	memset(&cfg, 0, sizeof(cfg));
+	cfg.version = SETTINGS_VERSION;
+	cfg.sequence = 1;
+	cfg.fgColor = RA8875_WHITE;
+	cfg.bgColor = RA8875_BLACK;
+	cfg.numberBase = BASE_HEX;
+	cfg.displayBase = DISPLAY_24H;
+	cfg.rotation = ROTATION_180;
+	cfg.timeMode = bootTimeMode;
+	cfg.colorMode = bootColorMode;
+	cfg.sunPanel = bootSunPanel;
+	cfg.latitude = 5151;
+	cfg.longitude = -13;
+	if (bootPower)
+	{
+		cfg.dimFrom = 23 * 4;
+		cfg.dimTo = 7 * 4;
+		cfg.offFrom = 1 * 4;
+		cfg.offTo = 5 * 4;
+	}
+	cfg.crc = crc8((uint8_t *)&cfg, sizeof(cfg) - 1);
+	memcpy(ee + EEPROM_SETTINGS_LOCATION, &cfg, sizeof(cfg));
+	memcpy(ee + EEPROM_ALARM_LOCATION, &bootAlarm, sizeof(bootAlarm));
+}
+
+// Power on with the RTC at the given time. Returns the RTC seconds at power-on
+static uint32_t boot(int year, int month, int day, int hour, int minute, int second)
+{
+	uint32_t start;
+
+	prepareEeprom();
+	simRtcSet(year, month, day, hour, minute, second);
+	start = simRtcSeconds();
+	setup();
+	return start;
+}
+
+// Run until the RTC shows 'secs' (seconds since 2000). Stops within a millisecond of the rollover
+static void runUntilRtc(uint32_t secs)
+{
+	while (simRtcSeconds() < secs)
+		simRunFor(1000);
+}
+
+// Start measuring
+static void startWindow()
+{
+	simResetStats();
+	windowUs = simNow();
+}
+
+static void endWindow()
+{
+	result = simStats;
+	windowUs = simNow() - windowUs;
+}
+
+// Measure the second in which the RTC rolls over to the given time, starting half a second before it
+#define TICK_LEADIN		6		// Seconds from power-on to the rollover. Leaves time for boot to finish and settle
+
+static void measureTick(int year, int month, int day, int hour, int minute, int second)
+{
+	uint32_t target;
+
+	prepareEeprom();
+	simRtcSet(year, month, day, hour, minute, second);
+	target = simRtcSeconds();
+	simRtcSetSeconds(target - TICK_LEADIN);
+	setup();
+	runUntilRtc(target - 1);
+	simRunFor(500000);
+	startWindow();
+	simRunFor(1000000);
+	endWindow();
+}
+
+static void scenarioBoot()
+{
+	prepareEeprom();
+	simRtcSet(2017, 3, 14, 15, 9, 26);
+	startWindow();
+	setup();
+	endWindow();
+}
+
+static void scenarioWarmBoot()
+{
+	bootMagic = BOOT_MAGIC_VALUE;
+	MCUSR = _BV(EXTRF);
+	scenarioBoot();
+}
+
+static void scenarioSecond()
+{
+	boot(2017, 3, 14, 15, 9, 40);
+	runUntilRtc(simRtcSeconds() + 3);
+	simRunFor(500000);
+	startWindow();
+	simRunFor(10000000);
+	endWindow();
+	perRuns = 10;
+}
+
+static void scenarioMinute()
+{
+	measureTick(2017, 3, 14, 15, 10, 0);
+}
+
+static void scenarioMidnight()
+{
+	measureTick(2017, 3, 15, 0, 0, 0);
+}
+
+static void scenarioNewYear()
+{
+	measureTick(2018, 1, 1, 0, 0, 0);
+}
+
+static void scenarioSetupTap()
+{
+	boot(2017, 3, 14, 15, 9, 0);
+	simRunFor(500000);
+
+	// Long press to get into setup, then let go and let the setup screen settle
+	simTouch(SIM_TFT_WIDTH / 2, SIM_TFT_HEIGHT / 2);
+	simRunFor(5200000);
+	simRelease();
+	simRunFor(1000000);
+
+	startWindow();
+	simTouch(X_COLOR3 + W_COLOR / 2, Y_COLOR_FG + H_COLOR / 2);
+	simRunFor(100000);
+	simRelease();
+	simRunFor(900000);
+	endWindow();
+}
+
+/*
+Play the --replay trace through the touch code, a little ahead of when it's needed, the way the Serial link would.
+The idle time before the first record is skipped: replay starts on the first record.
+*/
+#define REPLAY_STEP_US		1000
+
+static void scenarioReplay()
+{
+	std::string trace;
+	FILE *f;
+	size_t pos = TRACE_FILE_HEADER;
+	int c;
+
+	if (!replayFile || !(f = fopen(replayFile, "rb")))
+	{
+		fprintf(stderr, "replay: needs --replay FILE\n");
+		_exit(1);
+	}
+	while ((c = fgetc(f)) != EOF)
+		trace += (char)c;
+	fclose(f);
+	if ((trace.size() < TRACE_FILE_HEADER) || trace.compare(0, TRACE_FILE_HEADER, TRACE_FILE_MAGIC, TRACE_FILE_HEADER))
+	{
+		fprintf(stderr, "replay: %s isn't a touch trace\n", replayFile);
+		_exit(1);
+	}
+
+	boot(2017, 3, 14, 15, 9, 0);
+	simRunFor(500000);
+
+	Touch.setMode(TRACE_REPLAY);
+	startWindow();
+	while ((pos < trace.size()) || (Touch.getMode() == TRACE_REPLAY))
+	{
+		if (pos < trace.size())
+			pos += Touch.feed((const uint8_t *)trace.data() + pos, (uint8_t)std::min(trace.size() - pos, (size_t)LINK_MAX_PAYLOAD - 1),
+				trace.size() - pos <= LINK_MAX_PAYLOAD - 1);
+		simRunFor(REPLAY_STEP_US);
+	}
+	simRunFor(1000000);
+	endWindow();
+	snprintf(note, sizeof(note), "touch actions %u  last %.1f ms  max %.1f ms  underruns %u", Touch.getActions(),
+		Touch.getLastLatency() / 1000.0, Touch.getMaxLatency() / 1000.0, Touch.getUnderruns());
+}
+
+// Export the screen, the way tools/hexshot.py asks for it, and wait for the end frame
+#define SHOT_TIMEOUT_US		120000000ULL
+
+static void scenarioScreenshot()
+{
+	std::string &out = simSerialOutput();
+	uint8_t cmd[] = { LINK_SOF, 1, LINK_SHOT, 1, 0 };
+	uint64_t start;
+	size_t i;
+	uint32_t bytes, ms;
+
+	boot(2017, 3, 14, 15, 9, 0);
+	simRunFor(2000000);
+	out.clear();
+	cmd[4] = crc8(cmd + 1, 3);
+	startWindow();
+	start = simNow();
+	simSerialInput(cmd, sizeof(cmd));
+	while (((i = out.find(std::string("\x7E\x0D") + (char)(LINK_SHOT_END | LINK_REPLY))) == std::string::npos) ||
+		(i + 18 > out.size()))
+	{
+		if (simNow() - start > SHOT_TIMEOUT_US)
+		{
+			fprintf(stderr, "screenshot: no end frame\n");
+			_exit(1);
+		}
+		simRunFor(10000);
+	}
+	endWindow();
+	memcpy(&bytes, out.data() + i + 8, 4);	// Little-endian host
+	memcpy(&ms, out.data() + i + 12, 4);
+	snprintf(note, sizeof(note), "export %u bytes for %u (%.1f:1)  %.2f s", bytes, SIM_TFT_WIDTH * SIM_TFT_HEIGHT * 2,
+		(double)SIM_TFT_WIDTH * SIM_TFT_HEIGHT * 2 / bytes, ms / 1000.0);
+}
+
+static void scenarioDay()
+{
+	boot(2017, 3, 14, 0, 0, 0);
+	simRunFor(3000000);
+	runUntilRtc(simRtcSeconds() + 1);
+	startWindow();
+	simRunFor(86400ULL * 1000000);
+	endWindow();
+}
+
+/*
+A minute of hex day time. The timer needs two 1Hz edges to lock (one to set it, one to check it), then the window
+covers about 45 hex units. The note has the sketch's own hex timer report ('x') and how long each unit took to get
+its digits on the screen ('l').
+*/
+static void scenarioHexDay()
+{
+#if FACE_HEXTIME
+	bootTimeMode = TIME_MODE_HEXDAY;
+	boot(2017, 3, 14, 15, 9, 0);
+	simRunFor(3000000);
+	Lat.reset();
+	Hex.reset();
+	startWindow();
+	simRunFor(60000000);
+	endWindow();
+	snprintf(note, sizeof(note), "lock %d  units %u  gap %lu-%lu us  phase max %u  late max %lu us  digits avg %lu max %lu us",
+		Hex.locked() ? 1 : 0, Hex.getUnits(), Hex.getUnits() ? Hex.getGapMin() : 0, Hex.getGapMax(), Hex.getPhaseMax(),
+		Hex.getLateMax(), Lat.getSecondsAvg(), Lat.getSecondsMax());
+#else
+	snprintf(note, sizeof(note), "no hex day time in this build (FACE_HEXTIME 0)");
+#endif
+}
+
+/*
+The stopwatch, the way it's used: a 2-second press steps the face to it, a tap on the time row starts it, and taps
+below take laps. The window is ten seconds of it running, laps included. The note has the frame times, how the big
+digits were repainted, and the laps the watch took against the taps it was given. There are more taps than the watch
+keeps laps, and every lap it still has after the first is checked against the time between the taps; the run fails if
+one is out by more than WATCH_LAP_SLACK.
+*/
+#define WATCH_TAPS			6
+#define WATCH_TAP_GAP		1500000		// us from one lap tap to the next
+#define WATCH_LAP_SLACK		30			// ms. A tap is seen on the touch task's next poll
+
+static void tap(int16_t x, int16_t y, uint32_t holdUs)
+{
+	simTouch(x, y);
+	simRunFor(holdUs);
+	simRelease();
+}
+
+static void scenarioStopwatch()
+{
+#if FACE_WATCH
+	uint8_t i;
+	long off;
+
+	boot(2017, 3, 14, 15, 9, 0);
+	simRunFor(1000000);
+	tap(SIM_TFT_WIDTH / 2, SIM_TFT_HEIGHT / 2, 2500000);
+	simRunFor(500000);
+	tap(SIM_TFT_WIDTH / 2, Y_TIME_MID, 100000);
+	simRunFor(1000000);
+	Watch.resetStats();
+	startWindow();
+	for (i = 0; i < WATCH_TAPS; ++i)
+	{
+		simRunFor(WATCH_TAP_GAP - 100000);
+		tap(SIM_TFT_WIDTH / 2, Y_BIN_2, 100000);
+	}
+	simRunFor(10000000 - WATCH_TAPS * WATCH_TAP_GAP);
+	endWindow();
+	for (i = 1; i < Watch.getLaps(); ++i)
+	{
+		off = (long)Watch.lapTime(i) - WATCH_TAP_GAP / 1000;
+		if ((i + WATCH_LAPS >= Watch.getLaps()) && (labs(off) > WATCH_LAP_SLACK))
+		{
+			fprintf(stderr, "stopwatch: lap %u is %lu ms, not %d\n", i + 1, Watch.lapTime(i), WATCH_TAP_GAP / 1000);
+			checkFailed = true;
+		}
+	}
+	snprintf(note, sizeof(note), "frames %u  avg %lu max %lu us  over %u  rate %d  paint glyph %u opaque %u delta %u  laps %u/%u",
+		Watch.getFrames(), Watch.getFrameAvg(), Watch.getFrameMax(), Watch.getOver(), 1000 / Watch.getPeriod(),
+		Watch.getPaints(REPAINT_GLYPH), Watch.getPaints(REPAINT_OPAQUE), Watch.getPaints(REPAINT_DELTA), Watch.getLaps(),
+		WATCH_TAPS);
+#else
+	snprintf(note, sizeof(note), "no stopwatch in this build (FACE_WATCH 0)");
+#endif
+}
+
+/*
+The color of the time. Its RGB565 background changes when the seconds go from :07 to :08, so that tick recolors the
+whole face. The note has the ordinary tick before it to compare, how long after the tick the new seconds digits were
+up, and the render task's budget.
+*/
+static void scenarioTimeColor()
+{
+#if FACE_TIMECOLOR
+	uint64_t plainUs;
+
+	bootColorMode = COLOR_MODE_TIME;
+	measureTick(2017, 3, 14, 15, 9, 7);
+	plainUs = result.busyUs;
+	Lat.reset();
+	startWindow();
+	simRunFor(1000000);
+	endWindow();
+	snprintf(note, sizeof(note), "plain tick busy %.3f ms  seconds digits up %lu us after the tick  (render budget 40 ms)",
+		plainUs / 1000.0, Lat.getSecondsMax());
+#else
+	snprintf(note, sizeof(note), "no color of the time in this build (FACE_TIMECOLOR 0)");
+#endif
+}
+
+/*
+A 07:00 alarm, every day. The clock boots a minute and a half before it. It rings, a tap snoozes it, it rings again
+nine minutes later, and a 2.5-second press turns it off. The window covers all of it. The note has the I2C the alarms
+cost over the idle minute before the ring (against a plain clock's), and their own counts: rings, snoozes and the
+times the RTC's flags were read.
+*/
+static void scenarioAlarm()
+{
+#if FACE_ALARM
+	uint32_t start;
+	uint64_t idleTx;
+
+	bootAlarm.hour = 7;
+	bootAlarm.min = 0;
+	bootAlarm.days = ALARM_ON | ALARM_EVERY_DAY;
+	start = boot(2017, 3, 14, 6, 58, 30);
+	runUntilRtc(start + 10);
+	simRunFor(500000);
+	startWindow();
+	runUntilRtc(start + 70);
+	idleTx = simStats.i2cTransactions;
+	runUntilRtc(start + 93);
+	tap(SIM_TFT_WIDTH / 2, SIM_TFT_HEIGHT / 2, 100000);
+	runUntilRtc(start + 93 + ALARM_SNOOZE + 3);
+	tap(SIM_TFT_WIDTH / 2, SIM_TFT_HEIGHT / 2, 2500000);
+	simRunFor(2000000);
+	endWindow();
+	snprintf(note, sizeof(note), "idle minute i2c_tx %llu  rung %u  snoozed %u  checks %u  state %u after the hold",
+		(unsigned long long)idleTx, Alarms.getRung(), Alarms.getSnoozes(), Alarms.getChecks(), Alarms.getState());
+#else
+	snprintf(note, sizeof(note), "no alarms in this build (FACE_ALARM 0)");
+#endif
+}
+
+#if FACE_SUN
+/*
+The sunrise equation in double precision, the same sum Sun.cpp does in fixed point: minutes into the local day of
+sunrise & sunset, and the day's length. Returns false if the sun doesn't rise or doesn't set
+*/
+static bool sunReference(int days, double lat, double lon, double utcHours, double *rise, double *set, double *length)
+{
+	double j = days - lon / 360, m, c, l, transit, sinDec, cosH, h;
+
+	m = fmod(357.5291 + 0.98560028 * j, 360) * M_PI / 180;
+	c = 1.9148 * sin(m) + 0.0200 * sin(2 * m) + 0.0003 * sin(3 * m);
+	l = fmod(m * 180 / M_PI + c + 180 + 102.9372, 360) * M_PI / 180;
+	transit = j + 0.0053 * sin(m) - 0.0069 * sin(2 * l);
+	sinDec = sin(l) * sin(23.4397 * M_PI / 180);
+	cosH = (sin(-0.833 * M_PI / 180) - sin(lat * M_PI / 180) * sinDec) / (cos(lat * M_PI / 180) * cos(asin(sinDec)));
+	if ((cosH >= 1) || (cosH <= -1))
+		return false;
+	h = acos(cosH) / (2 * M_PI) * 1440;
+	*rise = (transit - days + 0.5) * 1440 + utcHours * 60 - h;
+	*set = *rise + 2 * h;
+	*length = 2 * h;
+	return true;
+}
+
+// Minutes from b to a, the short way round the day
+static double minutesApart(double a, double b)
+{
+	double d = fmod(a - b, 1440);
+
+	if (d > 720)
+		d -= 1440;
+	if (d < -720)
+		d += 1440;
+	return fabs(d);
+}
+#endif
+
+/*
+The sun panel over London, through the midnight tick that works out the new day's times (and redraws the panel). The
+note has what the clock worked out, and how far the fixed point sum is from the reference: the worst minutes out, as
+shown (whole minutes) against the exact time, over every fifth day of the century at every 5 degrees of latitude to
+65 either side and every 30 of longitude, each on its own zone's time. Past 65 degrees the times near the days the
+sun stops rising or setting turn on the last hundredth of a degree, and aren't compared. The CPU cycles aren't
+modelled here; the clock reports its own ('s', or hexlink.py sun).
+The run fails if a time is more than SUN_TOLERANCE out, or the sun is up or down all day on the wrong days.
+*/
+#define SUN_TOLERANCE		1.0		// Minutes
+
+static void scenarioSun()
+{
+#if FACE_SUN
+	const sunTimes_t *t = Sun.get();
+	sunTimes_t s;
+	double rise, set, length, worst = 0, worstLength = 0;
+	uint32_t compared = 0, wrong = 0;
+	int lat, lon, day;
+	int8_t utc;
+
+	bootSunPanel = true;
+	measureTick(2017, 3, 15, 0, 0, 0);
+
+	for (lat = -6500; lat <= 6500; lat += 500)
+	{
+		for (lon = -18000; lon <= 18000; lon += 3000)
+		{
+			utc = (int8_t)(lon / 1500 * 4);
+			for (day = 0; day < 36525; day += 5)
+			{
+				SunTimes::compute(day, lat, lon, utc, &s);
+				if (!sunReference(day, lat / 100.0, lon / 100.0, utc / 4.0, &rise, &set, &length))
+				{
+					wrong += (s.polar == SUN_NORMAL);
+					continue;
+				}
+				if (s.polar != SUN_NORMAL)
+				{
+					++wrong;
+					continue;
+				}
+				worst = std::max(worst, std::max(minutesApart(s.rise, rise), minutesApart(s.set, set)));
+				worstLength = std::max(worstLength, fabs(s.length - length));
+				++compared;
+			}
+		}
+	}
+	snprintf(note, sizeof(note), "rise %02u:%02u set %02u:%02u day %02u:%02u runs %u  reference: %u days, worst "
+		"rise/set %.2f min, length %.2f min, %u polar mismatches", t->rise / 60, t->rise % 60, t->set / 60, t->set % 60,
+		t->length / 60, t->length % 60, Sun.getRuns(), compared, worst, worstLength, wrong);
+	if ((worst > SUN_TOLERANCE) || (worstLength > SUN_TOLERANCE) || wrong)
+	{
+		fprintf(stderr, "sun: more than %.1f minutes out of the reference, or the sun up/down all day wrongly\n", SUN_TOLERANCE);
+		checkFailed = true;
+	}
+#else
+	snprintf(note, sizeof(note), "no sun panel in this build (FACE_SUN 0)");
+#endif
+}
+
+/*
+The setup keypad. From 15:09 3/14/17 the time goes to 14:30 (tap the hours, 1 4 3 0 Set), then the date to 2/29/27,
+which isn't a date, so Set puts the cursor back on the day, and 2 8 Set makes it 2/28/27. A tap every half second.
+The note has the taps & RTC writes that took against stepping the same fields with the old up & down halves, what the
+clock ends up at, and whether the 29th was refused.
+*/
+#define KEYPAD_TAP_US		500000
+
+#if FACE_SETUP
+static uint16_t keypadTaps;
+
+static void keypadTap(int16_t x, int16_t y)
+{
+	tap(x, y, 100000);
+	simRunFor(KEYPAD_TAP_US - 100000);
+	++keypadTaps;
+}
+
+// Digits are their own key, d is Del, s is Set
+static void keypadType(const char *keys)
+{
+	uint8_t key;
+
+	for (; *keys; ++keys)
+	{
+		key = (*keys == 'd') ? KEY_DEL : (*keys == 's') ? KEY_SET : *keys - '0';
+		keypadTap(layoutKeyX(key) + W_KEY / 2, layoutKeyY(key) + H_KEY / 2);
+	}
+}
+
+// Taps the up & down halves take to get from one value to another, going round whichever way is shorter
+static int stepTaps(int from, int to, int span)
+{
+	int d = abs(to - from);
+
+	return std::min(d, span - d);
+}
+#endif
+
+static void scenarioKeypad()
+{
+#if FACE_SETUP
+	struct ts *t = RTClock.getTime();
+	int steps;
+	bool refused;
+
+	boot(2017, 3, 14, 15, 9, 0);
+	simRunFor(500000);
+	simTouch(SIM_TFT_WIDTH / 2, SIM_TFT_HEIGHT / 2);
+	simRunFor(5200000);
+	simRelease();
+	simRunFor(1000000);
+
+	steps = stepTaps(15, 14, 24) + stepTaps(9, 30, 60) + stepTaps(3, 2, 12) + abs(28 - 14) + abs(27 - 17);
+	startWindow();
+	keypadTap(X_TIMEHOURHIGH + W_LARGEDIGIT, Y_TIME_MID);
+	keypadType("1430s");
+	keypadTap(X_DATEMONTHHIGH + W_LARGEDIGIT, Y_DATE_MID);
+	keypadType("022927s");
+	refused = (t->mon == 3) && (t->mday == 14);
+	keypadType("28s");
+	simRunFor(1000000);
+	endWindow();
+	snprintf(note, sizeof(note), "taps %u  rtc writes %llu  (stepping: %d taps & writes)  clock %02u:%02u:%02u %02u/%02u/%02u  "
+		"2/29/27 %s", keypadTaps, (unsigned long long)result.rtcWrites, steps, t->hour, t->min, t->sec, t->mon, t->mday,
+		t->year % 100, refused ? "refused" : "TAKEN");
+#else
+	snprintf(note, sizeof(note), "no setup screen in this build (FACE_SETUP 0)");
+#endif
+}
+
+/*
+The power schedule, dim 23:00-07:00 and off 01:00-05:00. The clock boots at 22:58:30 and the window is a minute at
+23:00:10, dimmed, with the minute rollover in it. The note has the same minute at full brightness (22:58:40) and with
+the panel off (01:00:10 the next day, the RTC moved on to it), what a tap does to an off panel, and the energy figures
+(ballpark, Power.h), with the day before being the hour and a half up to midnight.
+*/
+static void scenarioPower()
+{
+#if FACE_POWER
+	simStats_t on, dim;
+	uint64_t dimUs;
+	uint32_t start;
+	uint8_t before;
+
+	bootPower = true;
+	start = boot(2017, 3, 14, 22, 58, 30);
+	runUntilRtc(start + 10);
+	simRunFor(500000);
+	startWindow();
+	simRunFor(60000000);
+	endWindow();
+	on = result;
+
+	runUntilRtc(start + 100);
+	simRunFor(500000);
+	startWindow();
+	simRunFor(60000000);
+	endWindow();
+	dim = result;
+	dimUs = windowUs;
+
+	simRtcSetSeconds(start + 100 + 60 + 118 * 60);	// 00:59:10
+	runUntilRtc(start + 100 + 60 + 119 * 60);
+	simRunFor(500000);
+	startWindow();
+	simRunFor(60000000);
+	endWindow();
+	before = Power.getState();
+	tap(SIM_TFT_WIDTH / 2, SIM_TFT_HEIGHT / 2, 100000);
+	simRunFor(1500000);
+	snprintf(note, sizeof(note), "spi/i2c bytes a minute  on %llu/%llu  dim %llu/%llu  off %llu/%llu  tap: state %u -> %u  "
+		"mWh today %u yesterday %u", (unsigned long long)on.spiBytes, (unsigned long long)on.i2cBytes,
+		(unsigned long long)dim.spiBytes, (unsigned long long)dim.i2cBytes, (unsigned long long)result.spiBytes,
+		(unsigned long long)result.i2cBytes, before, Power.getState(), Power.getTodayMwh(), Power.getYesterdayMwh());
+	result = dim;
+	windowUs = dimUs;
+#else
+	snprintf(note, sizeof(note), "no power schedule in this build (FACE_POWER 0)");
+#endif
+}
+
+/*
+The setup color picker. A tap on the red foreground swatch brings it up, then a finger goes down at the red end of the
+hue slider and drags along to blue in PICKER_STEPS moves, one every PICKER_STEP_US, and comes off. Then Set. The
+window is the drag. The note has the SPI bytes a move took, against the ramps catching up when the finger came off and
+the face redraw Set did, and the color that was picked.
+*/
+#define PICKER_STEPS		24
+#define PICKER_STEP_US		30000
+
+static void scenarioPicker()
+{
+#if FACE_SETUP
+	simStats_t drag, release;
+	uint64_t dragUs;
+	clockSettings_t cfg;
+	int16_t y = Y_SLIDER + H_SLIDER / 2;
+	uint8_t i;
+
+	boot(2017, 3, 14, 15, 9, 0);
+	simRunFor(500000);
+	simTouch(SIM_TFT_WIDTH / 2, SIM_TFT_HEIGHT / 2);
+	simRunFor(5200000);
+	simRelease();
+	simRunFor(1000000);
+	tap(X_COLOR3 + W_COLOR / 2, Y_COLOR_FG + H_COLOR / 2, 100000);
+	runUntilRtc(simRtcSeconds() + 1);		// Picker drawn, and the drag starts just after a tick
+	simRunFor(20000);
+
+	startWindow();
+	for (i = 0; i <= PICKER_STEPS; ++i)
+	{
+		simTouch(X_SLIDER + ((int32_t)W_SLIDER * 171 / 256) * i / PICKER_STEPS, y);
+		simRunFor(PICKER_STEP_US);
+	}
+	endWindow();
+	drag = result;
+	dragUs = windowUs;
+
+	simRelease();
+	startWindow();
+	simRunFor(200000);
+	endWindow();
+	release = result;
+
+	startWindow();
+	tap(X_PICKSET + W_PICKKEY / 2, Y_PICKKEY + H_PICKKEY / 2, 100000);
+	simRunFor(400000);
+	endWindow();
+	theClock.getSettings(&cfg);
+	snprintf(note, sizeof(note), "spi bytes  drag %llu, %llu a move  let go %llu  set %llu  picked fg %04X",
+		(unsigned long long)drag.spiBytes, (unsigned long long)(drag.spiBytes / (PICKER_STEPS + 1)),
+		(unsigned long long)release.spiBytes, (unsigned long long)result.spiBytes, cfg.fgColor);
+	result = drag;
+	windowUs = dragUs;
+#else
+	snprintf(note, sizeof(note), "no setup screen in this build (FACE_SETUP 0)");
+#endif
+}
+
+// Run the clock against the wall clock with Serial on a pseudo-terminal
+#define SERVE_STEP_US	1000		// Virtual time run between looks at the terminal
+
+static int serve()
+{
+	struct termios tio;
+	struct timespec wall0, wall;
+	uint8_t buf[256];
+	uint64_t sim0;
+	int64_t ahead;
+	ssize_t n;
+	time_t now;
+	struct tm *lt;
+	int master;
+
+	if (((master = posix_openpt(O_RDWR | O_NOCTTY)) < 0) || grantpt(master) || unlockpt(master))
+	{
+		perror("pty");
+		return 1;
+	}
+	tcgetattr(master, &tio);
+	cfmakeraw(&tio);
+	tcsetattr(master, TCSANOW, &tio);
+	fcntl(master, F_SETFL, O_NONBLOCK);
+	printf("%s\n", ptsname(master));
+	fflush(stdout);
+
+	clock_gettime(CLOCK_MONOTONIC, &wall0);
+	sim0 = simNow();
+	now = time(NULL);
+	lt = localtime(&now);
+	boot(lt->tm_year + 1900, lt->tm_mon + 1, lt->tm_mday, lt->tm_hour, lt->tm_min, lt->tm_sec);
+	simRtcSetPpm(rtcPpm);
+
+	for (;;)
+	{
+		// EIO just means nothing has the terminal open at the moment
+		if ((n = read(master, buf, sizeof(buf))) > 0)
+			simSerialInput(buf, n);
+		simRunFor(SERVE_STEP_US);
+
+		std::string &out = simSerialOutput();
+		if (!out.empty())
+		{
+			write(master, out.data(), out.size());	// Lost if nobody's listening, like a real UART
+			out.clear();
+		}
+
+		clock_gettime(CLOCK_MONOTONIC, &wall);
+		ahead = (int64_t)(simNow() - sim0) - ((int64_t)(wall.tv_sec - wall0.tv_sec) * 1000000 + (wall.tv_nsec - wall0.tv_nsec) / 1000);
+		if (ahead > 0)
+			usleep(ahead);
+	}
+	return 0;
+}
+
+static const scenario_t scenarios[] = {
+	{ "boot", scenarioBoot, "cold power-on to end of setup()" },
+	{ "warmboot", scenarioWarmBoot, "reset to end of setup()" },
+	{ "second", scenarioSecond, "one seconds tick (mean of 10)" },
+	{ "minute", scenarioMinute, "minute rollover" },
+	{ "midnight", scenarioMidnight, "day rollover" },
+	{ "newyear", scenarioNewYear, "year rollover" },
+	{ "setup-tap", scenarioSetupTap, "setup screen swatch tap" },
+	{ "day", scenarioDay, "24 hours" },
+	{ "screenshot", scenarioScreenshot, "screen export over Serial" },
+	{ "hexday", scenarioHexDay, "hex day time, 1 minute" },
+	{ "stopwatch", scenarioStopwatch, "stopwatch, 10 s at 50 Hz" },
+	{ "alarm", scenarioAlarm, "alarm, snooze & stop" },
+	{ "timecolor", scenarioTimeColor, "color of the time, recolor tick" },
+	{ "sun", scenarioSun, "sun panel, midnight tick" },
+	{ "keypad", scenarioKeypad, "setup keypad, time & date" },
+	{ "power", scenarioPower, "power schedule, dimmed minute" },
+	{ "picker", scenarioPicker, "color picker, hue drag" },
+	{ "replay", scenarioReplay, "touch trace replay" },
+};
+#define NUM_SCENARIOS	(sizeof(scenarios) / sizeof(scenarios[0]))
+#define NUM_DEFAULT		(NUM_SCENARIOS - 1)		// replay only runs when asked for
+
+// Let the clock finish streaming its capture, then pull the trace frames out of what it sent and save them
+#define CAPTURE_DRAIN_US	1000000
+
+static void saveCapture()
+{
+	std::string &out = simSerialOutput();
+	std::string trace(TRACE_FILE_MAGIC, TRACE_FILE_HEADER);
+	size_t i = 0, n;
+	uint8_t seq = 0;
+	unsigned lost = 0;
+	FILE *f;
+
+	simRunFor(CAPTURE_DRAIN_US);
+	while ((i = out.find((char)LINK_SOF, i)) != std::string::npos)
+	{
+		if (i + 2 > out.size() || (i + (n = (uint8_t)out[i + 1]) + 4 > out.size()))
+			break;
+		if (((uint8_t)out[i + 2] != (LINK_TRACE_DATA | LINK_REPLY)) || (n < 1) ||
+			((uint8_t)out[i + n + 3] != crc8((uint8_t *)out.data() + i + 1, n + 2)))
+		{
+			++i;
+			continue;
+		}
+		if ((uint8_t)out[i + 3] != seq)
+			++lost;
+		seq = (uint8_t)out[i + 3] + 1;
+		trace.append(out, i + 4, n - 1);
+		i += n + 4;
+	}
+	out.clear();
+
+	if (!(f = fopen(captureFile, "wb")) || (fwrite(trace.data(), 1, trace.size(), f) != trace.size()))
+		fprintf(stderr, "can't write %s\n", captureFile);
+	if (f)
+		fclose(f);
+	snprintf(note, sizeof(note), "captured %u trace bytes to %s  dropped %u  frames lost %u",
+		(unsigned)(trace.size() - TRACE_FILE_HEADER), captureFile, Touch.getDropped(), lost);
+}
+
+// Send the Serial command(s) and print what comes back, indented under the scenario's row
+static void printCommand()
+{
+	std::string &out = simSerialOutput();
+	size_t start, end;
+
+	out.clear();
+	simSerialInput((const uint8_t *)serialCmd, strlen(serialCmd));
+	simRunFor(2000000);
+	for (start = 0; (end = out.find('\n', start)) != std::string::npos; start = end + 1)
+		printf("    %s\n", out.substr(start, end - start - ((end > start) && (out[end - 1] == '\r'))).c_str());
+}
+
+static void report(const scenario_t *s)
+{
+	char overdraw[16];
+	char path[512];
+
+	if (result.pixelsChanged)
+		snprintf(overdraw, sizeof(overdraw), "%.2f", (double)result.pixelsWritten / result.pixelsChanged);
+	else
+		snprintf(overdraw, sizeof(overdraw), "-");
+
+	if (csv)
+		printf("%s,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%s,%.3f,%.3f\n", s->name,
+			(unsigned long long)(result.spiBytes / perRuns), (unsigned long long)(result.regWrites / perRuns),
+			(unsigned long long)(result.pixelBytes / perRuns), (unsigned long long)(result.i2cTransactions / perRuns),
+			(unsigned long long)(result.i2cBytes / perRuns), (unsigned long long)(result.drawOps / perRuns),
+			(unsigned long long)(result.pixelsWritten / perRuns), (unsigned long long)(result.pixelsChanged / perRuns),
+			overdraw, result.busyUs / 1000.0 / perRuns, windowUs / 1000.0 / perRuns);
+	else
+		printf("%-10s %10llu %9llu %9llu %6llu %7llu %8llu %10llu %10llu %8s %10.3f  %s\n", s->name,
+			(unsigned long long)(result.spiBytes / perRuns), (unsigned long long)(result.regWrites / perRuns),
+			(unsigned long long)(result.pixelBytes / perRuns), (unsigned long long)(result.i2cTransactions / perRuns),
+			(unsigned long long)(result.i2cBytes / perRuns), (unsigned long long)(result.drawOps / perRuns),
+			(unsigned long long)(result.pixelsWritten / perRuns), (unsigned long long)(result.pixelsChanged / perRuns),
+			overdraw, result.busyUs / 1000.0 / perRuns, s->about);
+
+	if (captureFile)
+		saveCapture();
+	if (note[0])
+		printf("    %s\n", note);
+	if (serialCmd)
+		printCommand();
+
+	if (dumpDir)
+	{
+		snprintf(path, sizeof(path), "%s/%s.ppm", dumpDir, s->name);
+		if (!simDumpFrame(path, true))
+			fprintf(stderr, "can't write %s\n", path);
+	}
+}
+
+static int runScenario(const scenario_t *s)
+{
+	pid_t pid;
+	int status;
+
+	fflush(stdout);
+	if ((pid = fork()) < 0)
+	{
+		perror("fork");
+		return 1;
+	}
+	if (pid == 0)
+	{
+		if (captureFile)
+			Touch.setMode(TRACE_CAPTURE);
+		s->run();
+		report(s);
+		fflush(stdout);
+		_exit(checkFailed ? 1 : 0);
+	}
+	waitpid(pid, &status, 0);
+	if (!WIFEXITED(status) || WEXITSTATUS(status))
+	{
+		fprintf(stderr, "%s: scenario failed\n", s->name);
+		return 1;
+	}
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	const scenario_t *list[NUM_SCENARIOS];
+	size_t count = 0, i, j;
+	int failed = 0, a;
+
+	for (a = 1; a < argc; ++a)
+	{
+		if (!strcmp(argv[a], "--csv"))
+			csv = true;
+		else if (!strcmp(argv[a], "--profile"))
+			serialCmd = "p";
+		else if (!strcmp(argv[a], "--cmd") && (a + 1 < argc))
+			serialCmd = argv[++a];
+		else if (!strcmp(argv[a], "--ppm") && (a + 1 < argc))
+			rtcPpm = atoi(argv[++a]);
+		else if (!strcmp(argv[a], "--capture") && (a + 1 < argc))
+			captureFile = argv[++a];
+		else if (!strcmp(argv[a], "--replay") && (a + 1 < argc))
+			replayFile = argv[++a];
+		else if (!strcmp(argv[a], "--serve"))
+			return serve();
+		else if (!strcmp(argv[a], "--echo"))
+			simSerialEcho(true);
+		else if (!strcmp(argv[a], "--dump") && (a + 1 < argc))
+		{
+			dumpDir = argv[++a];
+			mkdir(dumpDir, 0755);
+		}
+		else
+		{
+			for (j = 0; j < NUM_SCENARIOS; ++j)
+				if (!strcmp(argv[a], scenarios[j].name))
+					break;
+			if ((j == NUM_SCENARIOS) || (count == NUM_SCENARIOS))
+			{
+				fprintf(stderr, "usage: %s [--csv] [--dump DIR] [--echo] [--profile] [--cmd STR] [--capture FILE] [scenario...] | --replay FILE [replay] | [--ppm N] --serve\nscenarios:", argv[0]);
+				for (j = 0; j < NUM_SCENARIOS; ++j)
+					fprintf(stderr, " %s", scenarios[j].name);
+				fprintf(stderr, "\n");
+				return 2;
+			}
+			list[count++] = &scenarios[j];
+		}
+	}
+	if ((count == 0) && replayFile)
+		list[count++] = &scenarios[NUM_SCENARIOS - 1];
+	if (count == 0)
+		for (i = 0; i < NUM_DEFAULT; ++i)
+			list[count++] = &scenarios[i];
+
+	if (csv)
+		printf("scenario,spi_bytes,reg_writes,pixel_bytes,i2c_txn,i2c_bytes,draw_ops,px_written,px_changed,overdraw,busy_ms,window_ms\n");
+	else
+		printf("%-10s %10s %9s %9s %6s %7s %8s %10s %10s %8s %10s\n", "scenario", "spi_bytes", "reg_wr", "pix_bytes",
+			"i2c_tx", "i2c_b", "draw_ops", "px_written", "px_changed", "overdraw", "busy_ms");
+
+	for (i = 0; i < count; ++i)
+		failed |= runScenario(list[i]);
+	return failed;
+}
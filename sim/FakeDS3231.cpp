@@ -0,0 +1,276 @@
+/*
+FakeDS3231.cpp
+The rodan/ds3231 library API on top of a virtual DS3231.
+
+The RTC counts seconds from its own base point in virtual time, optionally drifting by simRtcSetPpm() parts per
+million. Writing the time restarts the seconds countdown, as on the real part. With INTCN clear the INT/SQW pin is a
+1Hz square wave whose falling edge is the start of each second. With INTCN set it goes low when an enabled alarm
+matches, and stays low until the flag is cleared.
+The 32kHz output runs off the same oscillator, so it drifts with it and every second starts on one of its edges.
+Writing the time re-phases it to the write, which is out by less than one 32kHz period from the real part.
+Every call is charged the I2C bytes it would move at 100kHz.
+*/
+
+#include <ds3231.h>
+#include "SimHost.h"
+
+#define SECS_PER_DAY	86400UL
+#define UNIX_OFFSET		946684800UL		// 2000-01-01 in Unix time
+
+static bool rtcReady;
+static uint32_t baseSec;				// RTC seconds (since 2000) at baseUs
+static uint64_t baseUs;
+static int32_t rtcPpm;
+static uint64_t oscBaseK;				// 32kHz edges counted up to baseUs
+static uint8_t creg = DS3231_INTCN;		// Power-on default: interrupt mode, alarms off
+static uint8_t sreg;
+static uint8_t a1[5], a2[4];			// Alarm registers: s/mi/h/d & flags, mi/h/d & flags
+static uint8_t a1Flags[5], a2Flags[4];
+
+static void i2c(uint8_t transactions, uint8_t bytes)
+{
+	simStats.i2cTransactions += transactions;
+	simStats.i2cBytes += bytes;
+	simAdvanceNs((uint64_t)bytes * SIM_I2C_NS_PER_BYTE);
+}
+
+// Seconds since the base point, at virtual time 'us'
+static uint64_t elapsedAt(uint64_t us)
+{
+	return (uint64_t)(((long double)(us - baseUs) * (1000000.0L + rtcPpm)) / 1.0e12L);
+}
+
+// Virtual time of the k-th rollover after the base point
+static uint64_t edgeTime(uint64_t k)
+{
+	long double t = ((long double)k * 1.0e12L) / (1000000.0L + rtcPpm);
+	uint64_t us = (uint64_t)t;
+
+	if ((long double)us < t)
+		++us;
+	return baseUs + us;
+}
+
+// 32kHz edges counted up to and including virtual time 'us'
+uint64_t simRtc32kCount(uint64_t us)
+{
+	if (us < baseUs)
+		return oscBaseK;
+	return oscBaseK + (uint64_t)(((long double)(us - baseUs) * (1000000.0L + rtcPpm)) / SIM_RTC_32K_PS);
+}
+
+// Virtual time of 32kHz edge 'k'. 32768 edges after the base point is the same instant as edgeTime(1)
+uint64_t simRtc32kTime(uint64_t k)
+{
+	long double t;
+	uint64_t us;
+
+	if (k <= oscBaseK)
+		return baseUs;
+	t = ((long double)(k - oscBaseK) * SIM_RTC_32K_PS) / (1000000.0L + rtcPpm);
+	us = (uint64_t)t;
+	if ((long double)us < t)
+		++us;
+	return baseUs + us;
+}
+
+// Calendar conversion (proleptic Gregorian, days since 2000-01-01)
+static int32_t daysFromCivil(int y, int m, int d)
+{
+	int32_t era, yoe, doy, doe;
+
+	y -= (m <= 2);
+	era = (y >= 0 ? y : y - 399) / 400;
+	yoe = y - era * 400;
+	doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+	doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+	return era * 146097 + doe - 730485;
+}
+
+static void civilFromDays(int32_t z, int *y, int *m, int *d)
+{
+	int32_t era, doe, yoe, doy, mp;
+
+	z += 730485;
+	era = (z >= 0 ? z : z - 146096) / 146097;
+	doe = z - era * 146097;
+	yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+	doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+	mp = (5 * doy + 2) / 153;
+	*d = doy - (153 * mp + 2) / 5 + 1;
+	*m = mp + (mp < 10 ? 3 : -9);
+	*y = yoe + era * 400 + (*m <= 2);
+}
+
+static void toTs(uint32_t secs, struct ts *t)
+{
+	int y, m, d;
+	int32_t days = secs / SECS_PER_DAY;
+	uint32_t rem = secs % SECS_PER_DAY;
+
+	civilFromDays(days, &y, &m, &d);
+	t->year = y;
+	t->year_s = y - 2000;
+	t->mon = m;
+	t->mday = d;
+	t->hour = rem / 3600;
+	t->min = (rem / 60) % 60;
+	t->sec = rem % 60;
+	t->wday = ((days + 6) % 7) + 1;		// 2000-01-01 was a Saturday. 1 = Sunday
+	t->yday = days - daysFromCivil(y, 1, 1) + 1;
+	t->isdst = 0;
+	t->unixtime = secs + UNIX_OFFSET;
+}
+
+uint32_t simRtcSeconds()
+{
+	return baseSec + (uint32_t)elapsedAt(simNow());
+}
+
+void simRtcSetSeconds(uint32_t secs)
+{
+	oscBaseK = simRtc32kCount(simNow());
+	baseSec = secs;
+	baseUs = simNow();
+	rtcReady = true;
+}
+
+void simRtcSet(int year, int month, int day, int hour, int minute, int second)
+{
+	simRtcSetSeconds(daysFromCivil(year, month, day) * SECS_PER_DAY + hour * 3600UL + minute * 60UL + second);
+}
+
+void simRtcSetPpm(int32_t ppm)
+{
+	uint32_t secs = simRtcSeconds();
+	uint64_t next = edgeTime(elapsedAt(simNow()) + 1);
+	uint64_t nextK = simRtc32kCount(next);
+
+	// Keep the current second and its phase. Re-base at the last rollover
+	rtcPpm = ppm;
+	baseSec = secs;
+	baseUs = next - (uint64_t)(1000000.0L * 1000000.0L / (1000000.0L + ppm));
+	oscBaseK = nextK - 32768;
+}
+
+uint64_t simRtcNextEdge()
+{
+	if (!rtcReady)
+		return 0;
+	return edgeTime(elapsedAt(simNow()) + 1);
+}
+
+// Does alarm register 'reg' (BCD-free here) match 'val'? Masked registers always match
+static bool alarmField(uint8_t reg, uint8_t flag, uint8_t val)
+{
+	return flag || (reg == val);
+}
+
+void simRtcEdge()
+{
+	struct ts t;
+	bool intLow = (creg & DS3231_INTCN) && (((creg & DS3231_A1IE) && (sreg & DS3231_A1F)) || ((creg & DS3231_A2IE) && (sreg & DS3231_A2F)));
+	uint8_t day;
+
+	toTs(baseSec + (uint32_t)elapsedAt(simNow()), &t);
+
+	// Alarm 1: seconds, minutes, hours, day/date. The DY/DT flag picks day of week over date
+	day = a1Flags[4] ? t.wday : t.mday;
+	if (alarmField(a1[0], a1Flags[0], t.sec) && alarmField(a1[1], a1Flags[1], t.min) &&
+		alarmField(a1[2], a1Flags[2], t.hour) && alarmField(a1[3], a1Flags[3], day))
+		sreg |= DS3231_A1F;
+
+	// Alarm 2 has no seconds. It matches at :00
+	day = a2Flags[3] ? t.wday : t.mday;
+	if ((t.sec == 0) && alarmField(a2[0], a2Flags[0], t.min) && alarmField(a2[1], a2Flags[1], t.hour) &&
+		alarmField(a2[2], a2Flags[2], day))
+		sreg |= DS3231_A2F;
+
+	if (!simIrqAttached(SIM_RTC_SQW_IRQ))
+		return;
+	if (!(creg & DS3231_INTCN))
+		simRaiseIrq(SIM_RTC_SQW_IRQ);		// Square wave falling edge
+	else if (!intLow && (((creg & DS3231_A1IE) && (sreg & DS3231_A1F)) || ((creg & DS3231_A2IE) && (sreg & DS3231_A2F))))
+		simRaiseIrq(SIM_RTC_SQW_IRQ);		// Alarm pulled INT low
+}
+
+// Library API
+void DS3231_init(const uint8_t ctrl)
+{
+	DS3231_set_creg(ctrl);
+}
+
+void DS3231_set(struct ts t)
+{
+	// Address, register pointer, 7 time registers. The countdown restarts when the seconds register is acked
+	i2c(1, 3);
+	simRtcSet(t.year, t.mon, t.mday, t.hour, t.min, t.sec);
+	i2c(0, 6);
+	++simStats.rtcWrites;
+}
+
+void DS3231_get(struct ts *t)
+{
+	i2c(2, 10);		// Set the register pointer, then read the 7 time registers back
+	if (!rtcReady)
+		simRtcSet(2000, 1, 1, 0, 0, 0);
+	toTs(simRtcSeconds(), t);
+}
+
+void DS3231_set_creg(const uint8_t val)
+{
+	i2c(1, 3);
+	creg = val;
+}
+
+void DS3231_set_sreg(const uint8_t val)
+{
+	i2c(1, 3);
+	sreg = val;
+}
+
+uint8_t DS3231_get_sreg(void)
+{
+	i2c(2, 4);
+	return sreg;
+}
+
+void DS3231_set_a1(const uint8_t s, const uint8_t mi, const uint8_t h, const uint8_t d, const uint8_t * flags)
+{
+	uint8_t i;
+
+	i2c(1, 6);
+	a1[0] = s; a1[1] = mi; a1[2] = h; a1[3] = d;
+	for (i = 0; i < 5; ++i)
+		a1Flags[i] = flags[i];
+}
+
+void DS3231_clear_a1f(void)
+{
+	DS3231_set_sreg(DS3231_get_sreg() & ~DS3231_A1F);
+}
+
+uint8_t DS3231_triggered_a1(void)
+{
+	return DS3231_get_sreg() & DS3231_A1F;
+}
+
+void DS3231_set_a2(const uint8_t mi, const uint8_t h, const uint8_t d, const uint8_t * flags)
+{
+	uint8_t i;
+
+	i2c(1, 5);
+	a2[0] = mi; a2[1] = h; a2[2] = d;
+	for (i = 0; i < 4; ++i)
+		a2Flags[i] = flags[i];
+}
+
+void DS3231_clear_a2f(void)
+{
+	DS3231_set_sreg(DS3231_get_sreg() & ~DS3231_A2F);
+}
+
+uint8_t DS3231_triggered_a2(void)
+{
+	return DS3231_get_sreg() & DS3231_A2F;
+}
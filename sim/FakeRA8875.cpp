@@ -0,0 +1,494 @@
+/*
+FakeRA8875.cpp
+The sumotoy RA8875 library API on top of a virtual 800x480 (or 480x272) panel.
+
+Drawing lands in an RGB565 framebuffer in panel orientation. Rotation 2 flips both axes, like the scan direction
+bits the library sets. Every call is charged the SPI traffic the real library generates for it:
+	register write/read		4 bytes (command byte + register, data byte + value)
+	pixel data				2 bytes per pixel through the memory write port
+	geometry engine			the fill time for the pixels it covers, plus a status poll
+Custom fonts are drawn in software by the library, so a glyph costs an optional background box plus one filled
+rectangle per run of set pixels on each row. The internal font is drawn by the controller: one data write per
+character, with the controller filling the whole (scaled) 8x16 cell.
+*/
+
+#include <RA8875.h>
+#include <math.h>
+#include "SimHost.h"
+#include "SimFont5x7.h"
+
+static uint16_t frame[SIM_TFT_HEIGHT][SIM_TFT_WIDTH];
+static uint16_t tftRotation;
+static bool touchDown;
+static int16_t touchX, touchY;		// Panel coordinates
+static uint16_t touchNoise;
+
+// Bus & engine costs
+static void regWrite(uint16_t n)
+{
+	simStats.regWrites += n;
+	simStats.spiBytes += 4 * n;
+	simAdvanceNs((uint64_t)4 * n * SIM_SPI_NS_PER_BYTE);
+}
+
+static void regRead(uint16_t n)
+{
+	simStats.regReads += n;
+	simStats.spiBytes += 4 * n;
+	simAdvanceNs((uint64_t)4 * n * SIM_SPI_NS_PER_BYTE);
+}
+
+static void pixelData(uint32_t n)
+{
+	simStats.pixelBytes += 2 * n;
+	simStats.spiBytes += 2 * n;
+	simAdvanceNs((uint64_t)2 * n * SIM_SPI_NS_PER_BYTE);
+}
+
+static void engine(uint32_t pixels)
+{
+	++simStats.drawOps;
+	simAdvanceNs((uint64_t)pixels * SIM_BTE_NS_PER_PIXEL);
+	regRead(1);		// Wait for the engine to finish
+}
+
+// Plot in the sketch's coordinates
+static void plot(int16_t x, int16_t y, uint16_t color)
+{
+	if ((x < 0) || (y < 0) || (x >= SIM_TFT_WIDTH) || (y >= SIM_TFT_HEIGHT))
+		return;
+	if (tftRotation == 2)
+	{
+		x = SIM_TFT_WIDTH - 1 - x;
+		y = SIM_TFT_HEIGHT - 1 - y;
+	}
+	++simStats.pixelsWritten;
+	if (frame[y][x] != color)
+	{
+		++simStats.pixelsChanged;
+		frame[y][x] = color;
+	}
+}
+
+static void span(int16_t x0, int16_t x1, int16_t y, uint16_t color)
+{
+	for (int16_t x = x0; x <= x1; ++x)
+		plot(x, y, color);
+}
+
+static void rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+	for (int16_t j = 0; j < h; ++j)
+		span(x, x + w - 1, y + j, color);
+}
+
+// Circle spans. Filled, or just the outline
+static void circle(int16_t x0, int16_t y0, int16_t r, uint16_t color, bool fill)
+{
+	int16_t dy, dx, inner;
+
+	for (dy = -r; dy <= r; ++dy)
+	{
+		dx = (int16_t)sqrt((double)r * r - (double)dy * dy + 0.5);
+		if (fill)
+			span(x0 - dx, x0 + dx, y0 + dy, color);
+		else
+		{
+			inner = ((dy > -r) && (dy < r)) ? (int16_t)sqrt((double)(r - 1) * (r - 1) - (double)dy * dy + 0.5) : -1;
+			if ((abs(dy) >= r - 1) || (inner < 0))
+				span(x0 - dx, x0 + dx, y0 + dy, color);
+			else
+			{
+				span(x0 - dx, x0 - inner, y0 + dy, color);
+				span(x0 + inner, x0 + dx, y0 + dy, color);
+			}
+		}
+	}
+}
+
+static void roundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color, bool fill)
+{
+	int16_t j, inset, dy;
+
+	for (j = 0; j < h; ++j)
+	{
+		inset = 0;
+		dy = (j < r) ? r - j : ((j >= h - r) ? j - (h - r - 1) : 0);
+		if (dy > 0)
+			inset = r - (int16_t)sqrt((double)r * r - (double)dy * dy + 0.5);
+		if (fill || (j == 0) || (j == h - 1))
+			span(x + inset, x + w - 1 - inset, y + j, color);
+		else
+		{
+			plot(x + inset, y + j, color);
+			plot(x + w - 1 - inset, y + j, color);
+		}
+	}
+}
+
+// Host controls
+const uint16_t *simFrame()
+{
+	return &frame[0][0];
+}
+
+uint16_t simTftRotation()
+{
+	return tftRotation;
+}
+
+bool simDumpFrame(const char *path, bool asViewed)
+{
+	FILE *f = fopen(path, "wb");
+	int x, y, px, py;
+	uint16_t c;
+
+	if (!f)
+		return false;
+	fprintf(f, "P6\n%d %d\n255\n", SIM_TFT_WIDTH, SIM_TFT_HEIGHT);
+	for (y = 0; y < SIM_TFT_HEIGHT; ++y)
+	{
+		for (x = 0; x < SIM_TFT_WIDTH; ++x)
+		{
+			px = x; py = y;
+			if (asViewed && (tftRotation == 2))		// Panel is mounted upside down
+			{
+				px = SIM_TFT_WIDTH - 1 - x;
+				py = SIM_TFT_HEIGHT - 1 - y;
+			}
+			c = frame[py][px];
+			fputc(((c >> 11) & 0x1F) * 255 / 31, f);
+			fputc(((c >> 5) & 0x3F) * 255 / 63, f);
+			fputc((c & 0x1F) * 255 / 31, f);
+		}
+	}
+	fclose(f);
+	return true;
+}
+
+void simTouch(int16_t x, int16_t y)
+{
+	if (tftRotation == 2)
+	{
+		x = SIM_TFT_WIDTH - 1 - x;
+		y = SIM_TFT_HEIGHT - 1 - y;
+	}
+	touchX = x;
+	touchY = y;
+	touchDown = true;
+	simRaiseIrq(SIM_TOUCH_IRQ);
+}
+
+void simRelease()
+{
+	touchDown = false;
+}
+
+void simSetTouchNoise(uint16_t amplitude)
+{
+	touchNoise = amplitude;
+}
+
+// Library API
+RA8875::RA8875(const uint8_t CSp, const uint8_t RSTp)
+{
+	_width = SIM_TFT_WIDTH;
+	_height = SIM_TFT_HEIGHT;
+	_rotation = 0;
+	_font = NULL;
+	_scale = 0;
+	_fg = RA8875_WHITE;
+	_bg = RA8875_BLACK;
+	_transparent = false;
+	_cursorX = _cursorY = 0;
+	_touchEnabled = false;
+}
+
+void RA8875::begin(const enum RA8875sizes s)
+{
+	regWrite(40);		// PLL, panel timing, window & layer setup
+	delay(120);			// Reset & PLL lock
+	_width = ((s == RA8875_480x272) || (s == Adafruit_480x272)) ? 480 : SIM_TFT_WIDTH;
+	_height = ((s == RA8875_480x272) || (s == Adafruit_480x272)) ? 272 : SIM_TFT_HEIGHT;
+	fillWindow(RA8875_BLACK);
+}
+
+void RA8875::setRotation(uint8_t rotation)
+{
+	regWrite(2);		// Scan direction
+	_rotation = rotation & 3;
+	tftRotation = _rotation;
+}
+
+void RA8875::displayOn(boolean on) { regWrite(1); }
+void RA8875::sleep(boolean sleep) { regWrite(1); }
+void RA8875::brightness(uint8_t val) { regWrite(1); }
+void RA8875::backlight(boolean on) { regWrite(2); }
+
+void RA8875::setFont(const tFont *font)
+{
+	_font = font;
+}
+
+void RA8875::setFont(enum RA8875fontSource s)
+{
+	regWrite(2);		// Select the internal character ROM
+	_font = NULL;
+}
+
+void RA8875::setFontScale(uint8_t scale)
+{
+	regWrite(1);
+	_scale = scale & 3;
+}
+
+void RA8875::setTextColor(uint16_t fcolor, uint16_t bcolor)
+{
+	regWrite(7);		// Foreground & background RGB, transparency off
+	_fg = fcolor;
+	_bg = bcolor;
+	_transparent = false;
+}
+
+void RA8875::setTextColor(uint16_t fcolor)
+{
+	regWrite(4);		// Foreground RGB, transparency on
+	_fg = fcolor;
+	_transparent = true;
+}
+
+void RA8875::setCursor(int16_t x, int16_t y)
+{
+	if (!_font)
+		regWrite(4);	// Internal font uses the controller's text cursor
+	_cursorX = x;
+	_cursorY = y;
+}
+
+size_t RA8875::write(uint8_t c)
+{
+	if (_font)
+		writeCustomChar(c);
+	else
+		writeChar(c);
+	return 1;
+}
+
+// Internal font: the controller fills the whole cell
+void RA8875::writeChar(uint8_t c)
+{
+	int16_t m = _scale + 1, col, row, cw = 8 * m, ch = 16 * m;
+	uint8_t bits;
+
+	if (c == '\n')
+	{
+		_cursorX = 0;
+		_cursorY += ch;
+		regWrite(4);
+		return;
+	}
+	if (c == '\r')
+		return;
+
+	regWrite(1);		// Memory write command + character code
+	if (!_transparent)
+		rect(_cursorX, _cursorY, cw, ch, _bg);
+	if ((c >= 0x20) && (c <= 0x7E))
+	{
+		for (col = 0; col < 5; ++col)
+		{
+			bits = simFont5x7[c - 0x20][col];
+			for (row = 0; row < 8; ++row)
+			{
+				if (bits & (1 << row))
+					rect(_cursorX + (col + 1) * m, _cursorY + (row + 4) * m, m, m, _fg);
+			}
+		}
+	}
+	engine(cw * ch);
+	_cursorX += cw;
+}
+
+// Custom font: drawn by the library, one rectangle per run of pixels
+void RA8875::writeCustomChar(uint8_t c)
+{
+	const tImage *img = NULL;
+	int16_t m = _scale + 1, row, col, start, w, h = _font->font_height;
+	uint32_t bit;
+	uint8_t i;
+
+	if ((c == '\n') || (c == '\r'))
+		return;
+	for (i = 0; i < _font->length; ++i)
+	{
+		if (_font->chars[i].char_code == c)
+		{
+			img = _font->chars[i].image;
+			break;
+		}
+	}
+	if (!img)
+		return;
+	w = img->image_width;
+
+	if (!_transparent)
+	{
+		regWrite(12);
+		rect(_cursorX, _cursorY, w * m, h * m, _bg);
+		engine(w * m * h * m);
+	}
+
+	for (row = 0; row < h; ++row)
+	{
+		start = -1;
+		for (col = 0; col <= w; ++col)
+		{
+			bit = (uint32_t)row * w + col;
+			if ((col < w) && (img->data[bit >> 3] & (0x80 >> (bit & 7))))
+			{
+				if (start < 0)
+					start = col;
+			}
+			else if (start >= 0)
+			{
+				regWrite(12);
+				rect(_cursorX + start * m, _cursorY + row * m, (col - start) * m, m, _fg);
+				engine((col - start) * m * m);
+				start = -1;
+			}
+		}
+	}
+	_cursorX += w * m;
+}
+
+void RA8875::fillWindow(uint16_t color)
+{
+	regWrite(4);		// Background color, clear window
+	rect(0, 0, _width, _height, color);
+	engine((uint32_t)_width * _height);
+}
+
+void RA8875::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+	regWrite(5);		// Cursor, memory write command
+	plot(x, y, color);
+	pixelData(1);
+}
+
+uint16_t RA8875::getPixel(int16_t x, int16_t y)
+{
+	regWrite(5);		// Read cursor, memory read command
+	regRead(1);			// Dummy read
+	pixelData(1);
+	if ((x < 0) || (y < 0) || (x >= SIM_TFT_WIDTH) || (y >= SIM_TFT_HEIGHT))
+		return 0;
+	if (tftRotation == 2)
+		return frame[SIM_TFT_HEIGHT - 1 - y][SIM_TFT_WIDTH - 1 - x];
+	return frame[y][x];
+}
+
+void RA8875::getPixels(uint16_t *p, uint32_t count, int16_t x, int16_t y)
+{
+	uint32_t i;
+	int16_t px, py;
+
+	regWrite(5);
+	regRead(1);
+	pixelData(count);
+	for (i = 0; i < count; ++i)
+	{
+		px = x + i;
+		py = y;
+		if (tftRotation == 2)
+		{
+			px = SIM_TFT_WIDTH - 1 - px;
+			py = SIM_TFT_HEIGHT - 1 - py;
+		}
+		p[i] = ((px >= 0) && (px < SIM_TFT_WIDTH) && (py >= 0) && (py < SIM_TFT_HEIGHT)) ? frame[py][px] : 0;
+	}
+}
+
+void RA8875::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+	regWrite(12);
+	span(x, x + w - 1, y, color);
+	span(x, x + w - 1, y + h - 1, color);
+	for (int16_t j = 1; j < h - 1; ++j)
+	{
+		plot(x, y + j, color);
+		plot(x + w - 1, y + j, color);
+	}
+	engine(2 * (w + h));
+}
+
+void RA8875::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+	regWrite(12);
+	rect(x, y, w, h, color);
+	engine((uint32_t)w * h);
+}
+
+void RA8875::drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color)
+{
+	regWrite(9);
+	circle(x0, y0, r, color, false);
+	engine(7 * r);
+}
+
+void RA8875::fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color)
+{
+	regWrite(9);
+	circle(x0, y0, r, color, true);
+	engine(4 * r * r);
+}
+
+void RA8875::drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color)
+{
+	regWrite(14);
+	roundRect(x, y, w, h, r, color, false);
+	engine(2 * (w + h));
+}
+
+void RA8875::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color)
+{
+	regWrite(14);
+	roundRect(x, y, w, h, r, color, true);
+	engine((uint32_t)w * h);
+}
+
+// Touch
+void RA8875::useINT(const uint8_t INTpin) {}
+void RA8875::enableISR(bool force) { regWrite(1); }
+
+void RA8875::touchBegin(void)
+{
+	regWrite(3);		// Touch panel control registers
+}
+
+void RA8875::touchEnable(boolean enabled)
+{
+	regWrite(1);
+	_touchEnabled = enabled;
+}
+
+boolean RA8875::touched(bool safe)
+{
+	regRead(1);			// Interrupt status
+	return _touchEnabled && touchDown;
+}
+
+void RA8875::touchReadAdc(uint16_t *x, uint16_t *y)
+{
+	int32_t rx, ry;
+
+	regRead(3);			// X high, Y high, XY low bits
+	rx = ((int32_t)touchX * 1024 + SIM_TFT_WIDTH / 2) / SIM_TFT_WIDTH;
+	ry = ((int32_t)touchY * 1024 + SIM_TFT_HEIGHT / 2) / SIM_TFT_HEIGHT;
+	if (touchNoise)
+	{
+		rx += (rand() % (2 * touchNoise + 1)) - touchNoise;
+		ry += (rand() % (2 * touchNoise + 1)) - touchNoise;
+	}
+	*x = (rx < 0) ? 0 : ((rx > 1023) ? 1023 : rx);
+	*y = (ry < 0) ? 0 : ((ry > 1023) ? 1023 : ry);
+}
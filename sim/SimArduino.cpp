@@ -0,0 +1,454 @@
+/*
+SimArduino.cpp
+The Arduino core on the host: virtual time base, external interrupts, Timer1, sleep, Serial, Print and EEPROM.
+
+Virtual time only moves when something costs time: a bus transfer, a delay, or sleeping until the next interrupt.
+Pending interrupts run when time moves with interrupts enabled, the same points at which they could run on the AVR.
+*/
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <Wire.h>
+#include <avr/sleep.h>
+#include "SimHost.h"
+
+void loop();							// The sketch
+
+simStats_t simStats;
+uint8_t MCUSR;
+HardwareSerial Serial;
+EEPROMClass EEPROM;
+TwoWire Wire;
+
+static uint64_t nowUs;					// Virtual time
+static uint64_t nsCarry;				// Sub-microsecond remainder for simAdvanceNs()
+static bool irqEnabled = true;
+static void (*irqHandler[3])(void);	// INT0, INT1, Timer1 compare A
+static bool irqPending[3];
+static bool inIsr;
+
+// Timer1 (avr/io.h)
+SimTimer1Count TCNT1;
+SimTimer1Flags TIFR1;
+uint8_t TCCR1A;
+uint8_t TCCR1B;
+uint8_t TIMSK1;
+uint16_t OCR1A;
+static uint16_t t1Value;				// Last value written to TCNT1
+static uint64_t t1Clock;				// 32kHz edges counted when it was written
+static uint64_t t1NextClock;			// 32kHz edge of the next compare match
+static bool t1Armed;					// t1NextClock is good. Set by a TCNT1 write
+
+static std::string serialOut;
+static std::string serialIn;
+static bool serialEcho;
+static unsigned long serialBaud = 9600;
+static uint64_t serialTxDone;			// Virtual time the last byte written finishes going out
+
+static uint8_t eeprom[SIM_EEPROM_SIZE];
+static uint64_t eepromWrites;
+static bool eepromReady;
+
+// Run interrupt handlers that are waiting, if interrupts are on
+static void serviceIrqs()
+{
+	uint8_t i;
+
+	if (!irqEnabled || inIsr)
+		return;
+	for (i = 0; i < 3; ++i)
+	{
+		if (irqPending[i] && ((i != SIM_TIMER1_IRQ) || (TIMSK1 & _BV(OCIE1A))))
+		{
+			irqPending[i] = false;
+			if (irqHandler[i])
+			{
+				inIsr = true;
+				irqHandler[i]();
+				inIsr = false;
+			}
+		}
+	}
+}
+
+// Timer1 counts the 32kHz pin in CTC mode, and nothing otherwise
+static bool t1Counting()
+{
+	return t1Armed && ((TCCR1B & 0x07) >= 0x06) && (TCCR1B & _BV(WGM12));
+}
+
+// Virtual time of the next compare match, 0 for none
+static uint64_t t1NextMatch()
+{
+	return t1Counting() ? simRtc32kTime(t1NextClock) : 0;
+}
+
+SimTimer1Count::operator uint16_t() const
+{
+	if (!t1Counting())
+		return t1Value;
+	return (uint16_t)((t1Value + simRtc32kCount(nowUs) - t1Clock) % ((uint32_t)OCR1A + 1));
+}
+
+// A match is on the clock that takes the count to OCR1A. Writing OCR1A itself doesn't match until it comes round again
+SimTimer1Count &SimTimer1Count::operator=(uint16_t v)
+{
+	uint32_t top = (uint32_t)OCR1A + 1;
+	uint32_t ahead = ((uint32_t)OCR1A + top - (v % top)) % top;
+
+	t1Value = v;
+	t1Clock = simRtc32kCount(nowUs);
+	t1NextClock = t1Clock + (ahead ? ahead : top);
+	t1Armed = true;
+	return *this;
+}
+
+SimTimer1Flags::operator uint8_t() const
+{
+	return irqPending[SIM_TIMER1_IRQ] ? _BV(OCF1A) : 0;
+}
+
+SimTimer1Flags &SimTimer1Flags::operator=(uint8_t v)
+{
+	if (v & _BV(OCF1A))
+		irqPending[SIM_TIMER1_IRQ] = false;
+	return *this;
+}
+
+// Move time up to 'target', raising the RTC edges and timer matches that fall on the way. An RTC edge goes first
+static void moveTo(uint64_t target)
+{
+	uint64_t edge, match, next;
+
+	irqHandler[SIM_TIMER1_IRQ] = TIMER1_COMPA_vect;
+	for (;;)
+	{
+		edge = simRtcNextEdge();
+		match = t1NextMatch();
+		next = ((edge == 0) || ((match != 0) && (match < edge))) ? match : edge;
+		if ((next == 0) || (next > target))
+			break;
+		if (next > nowUs)
+			nowUs = next;
+		if (edge == next)
+			simRtcEdge();
+		if (match == next)
+		{
+			t1NextClock += (uint32_t)OCR1A + 1;
+			irqPending[SIM_TIMER1_IRQ] = true;
+		}
+		serviceIrqs();
+	}
+	if (target > nowUs)
+		nowUs = target;
+	serviceIrqs();
+}
+
+uint64_t simNow()
+{
+	return nowUs;
+}
+
+void simAdvance(uint64_t us)
+{
+	simStats.busyUs += us;
+	moveTo(nowUs + us);
+}
+
+void simAdvanceNs(uint64_t ns)
+{
+	nsCarry += ns;
+	if (nsCarry >= 1000)
+	{
+		simAdvance(nsCarry / 1000);
+		nsCarry %= 1000;
+	}
+}
+
+void simRunFor(uint64_t us)
+{
+	uint64_t end = nowUs + us, before;
+
+	while (nowUs < end)
+	{
+		before = nowUs;
+		loop();
+		if (nowUs == before)
+			simAdvance(SIM_LOOP_US);
+	}
+}
+
+void simResetStats()
+{
+	memset(&simStats, 0, sizeof(simStats));
+}
+
+void simRaiseIrq(uint8_t irq)
+{
+	if (irq < 2)
+	{
+		irqPending[irq] = true;
+		serviceIrqs();
+	}
+}
+
+bool simIrqAttached(uint8_t irq)
+{
+	return (irq < 2) && (irqHandler[irq] != NULL);
+}
+
+// Arduino time. Reading the clock costs a little, so a busy-wait on millis() still moves time along
+unsigned long millis(void)
+{
+	simAdvanceNs(SIM_CLOCK_READ_NS);
+	return (unsigned long)(nowUs / 1000);
+}
+
+unsigned long micros(void)
+{
+	simAdvanceNs(SIM_CLOCK_READ_NS);
+	return (unsigned long)nowUs;
+}
+
+void delay(unsigned long ms)
+{
+	simAdvance((uint64_t)ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+	simAdvance(us);
+}
+
+// Pins. Nothing is wired to the plain digital pins
+void pinMode(uint8_t pin, uint8_t mode) {}
+void digitalWrite(uint8_t pin, uint8_t val) {}
+int digitalRead(uint8_t pin) { return HIGH; }
+
+void attachInterrupt(uint8_t irq, void (*isr)(void), int mode)
+{
+	if (irq < 2)
+		irqHandler[irq] = isr;
+}
+
+void detachInterrupt(uint8_t irq)
+{
+	if (irq < 2)
+		irqHandler[irq] = NULL;
+}
+
+void noInterrupts(void)
+{
+	irqEnabled = false;
+}
+
+// Like sei, this doesn't run a pending interrupt straight away. The next instruction (sleep_cpu) gets in first.
+void interrupts(void)
+{
+	irqEnabled = true;
+}
+
+// Sleep: wait for the next Timer0 tick or interrupt
+static bool sleepEnabled;
+
+void set_sleep_mode(int mode) {}
+void sleep_enable(void) { sleepEnabled = true; }
+void sleep_disable(void) { sleepEnabled = false; }
+
+void sleep_cpu(void)
+{
+	uint64_t tick, edge;
+	bool t1Wakes = (TIMSK1 & _BV(OCIE1A)) && (TIMER1_COMPA_vect != NULL);
+
+	if (!sleepEnabled)
+		return;
+	if (irqPending[0] || irqPending[1] || (irqPending[SIM_TIMER1_IRQ] && t1Wakes))	// Already waiting. Wake straight away
+	{
+		serviceIrqs();
+		return;
+	}
+
+	tick = (nowUs / SIM_TICK_US + 1) * SIM_TICK_US;
+	edge = simRtcNextEdge();
+	if ((edge != 0) && (edge < tick) && simIrqAttached(SIM_RTC_SQW_IRQ))
+		tick = edge;
+	edge = t1NextMatch();
+	if ((edge != 0) && (edge < tick) && t1Wakes)
+		tick = edge;
+	moveTo(tick);
+}
+
+// Print
+size_t Print::write(const uint8_t *buf, size_t len)
+{
+	size_t n = 0;
+
+	while (len--)
+		n += write(*buf++);
+	return n;
+}
+
+size_t Print::printNumber(unsigned long n, uint8_t base)
+{
+	char buf[8 * sizeof(long) + 1];
+	char *str = &buf[sizeof(buf) - 1];
+
+	if (base < 2)
+		base = 10;
+	*str = '\0';
+	do
+	{
+		char c = n % base;
+		n /= base;
+		*--str = c < 10 ? c + '0' : c + 'A' - 10;
+	} while (n);
+	return write(str);
+}
+
+size_t Print::print(const __FlashStringHelper *s) { return write((const char *)s); }
+size_t Print::print(const char *s) { return write(s); }
+size_t Print::print(char c) { return write((uint8_t)c); }
+size_t Print::print(unsigned char n, int base) { return printNumber(n, base); }
+size_t Print::print(int n, int base) { return print((long)n, base); }
+size_t Print::print(unsigned int n, int base) { return printNumber(n, base); }
+size_t Print::print(unsigned long n, int base) { return printNumber(n, base); }
+
+size_t Print::print(long n, int base)
+{
+	if ((base == 10) && (n < 0))
+		return write('-') + printNumber(-n, 10);
+	return printNumber(n, base);
+}
+
+size_t Print::println(void) { return write("\r\n"); }
+size_t Print::println(const __FlashStringHelper *s) { return print(s) + println(); }
+size_t Print::println(const char *s) { return print(s) + println(); }
+size_t Print::println(char c) { return print(c) + println(); }
+size_t Print::println(unsigned char n, int base) { return print(n, base) + println(); }
+size_t Print::println(int n, int base) { return print(n, base) + println(); }
+size_t Print::println(unsigned int n, int base) { return print(n, base) + println(); }
+size_t Print::println(long n, int base) { return print(n, base) + println(); }
+size_t Print::println(unsigned long n, int base) { return print(n, base) + println(); }
+
+/*
+Serial. The transmit buffer drains at the baud rate in virtual time, and a write to a full buffer waits for room, as
+on the real thing. The bytes themselves show up in simSerialOutput() as soon as they're written.
+*/
+static uint64_t serialByteUs()
+{
+	return (1000000ULL * SIM_SERIAL_BITS + serialBaud - 1) / serialBaud;
+}
+
+static int serialQueued()
+{
+	uint64_t b = serialByteUs();
+
+	return (serialTxDone > nowUs) ? (int)((serialTxDone - nowUs + b - 1) / b) : 0;
+}
+
+void HardwareSerial::begin(unsigned long baud)
+{
+	serialBaud = baud;
+	serialTxDone = nowUs;		// Whatever was still going out is lost, as on the real thing
+}
+
+void HardwareSerial::end() {}
+
+void HardwareSerial::flush()
+{
+	if (serialTxDone > nowUs)
+		simAdvance(serialTxDone - nowUs);
+}
+
+int HardwareSerial::availableForWrite() { return SERIAL_TX_BUFFER_SIZE - 1 - serialQueued(); }
+int HardwareSerial::available() { return (int)serialIn.size(); }
+
+int HardwareSerial::peek()
+{
+	return serialIn.empty() ? -1 : (uint8_t)serialIn[0];
+}
+
+int HardwareSerial::read()
+{
+	int c = peek();
+
+	if (c >= 0)
+		serialIn.erase(0, 1);
+	return c;
+}
+
+size_t HardwareSerial::write(uint8_t c)
+{
+	while (serialQueued() >= SERIAL_TX_BUFFER_SIZE - 1)
+		simAdvance(serialTxDone - nowUs - (uint64_t)(SERIAL_TX_BUFFER_SIZE - 2) * serialByteUs());
+	serialTxDone = ((serialTxDone > nowUs) ? serialTxDone : nowUs) + serialByteUs();
+	serialOut += (char)c;
+	if (serialEcho)
+		fputc(c, stderr);
+	return 1;
+}
+
+void simSerialInput(const uint8_t *data, size_t len)
+{
+	serialIn.append((const char *)data, len);
+}
+
+std::string &simSerialOutput()
+{
+	return serialOut;
+}
+
+void simSerialEcho(bool on)
+{
+	serialEcho = on;
+}
+
+// EEPROM. Starts out erased
+static void eepromInit()
+{
+	if (!eepromReady)
+	{
+		memset(eeprom, 0xFF, sizeof(eeprom));
+		eepromReady = true;
+	}
+}
+
+uint8_t EEPROMClass::read(int address)
+{
+	eepromInit();
+	return ((address >= 0) && (address < SIM_EEPROM_SIZE)) ? eeprom[address] : 0xFF;
+}
+
+void EEPROMClass::write(int address, uint8_t value)
+{
+	eepromInit();
+	if ((address >= 0) && (address < SIM_EEPROM_SIZE))
+	{
+		eeprom[address] = value;
+		++eepromWrites;
+		simAdvance(3300);		// 3.3ms EEPROM write cycle
+	}
+}
+
+void EEPROMClass::update(int address, uint8_t value)
+{
+	if (read(address) != value)
+		write(address, value);
+}
+
+void simEepromErase()
+{
+	eepromReady = false;
+	eepromInit();
+}
+
+uint8_t *simEepromData()
+{
+	eepromInit();
+	return eeprom;
+}
+
+uint64_t simEepromWrites()
+{
+	return eepromWrites;
+}
@@ -0,0 +1,94 @@
+// SimHost.h
+// Host-side controls for the HexClock simulator: virtual time, interrupts, the fake peripherals and the cost counters.
+// The sketch never sees this file. Only the stand-in libraries under include/ and the bench driver use it.
+
+#ifndef _SIMHOST_h
+#define _SIMHOST_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+
+// Cost model. Rough numbers for an 8MHz/16MHz Pro Mini talking to an RA8875 over 4MHz SPI and a DS3231 over 100kHz I2C.
+// They only need to be right relative to each other; the bench compares runs, not absolute times.
+#define SIM_SPI_NS_PER_BYTE		2500	// SPI byte plus the AVR overhead around it
+#define SIM_I2C_NS_PER_BYTE		95000	// 9 clocks per byte at 100kHz, plus start/stop slack
+#define SIM_BTE_NS_PER_PIXEL	10		// RA8875 geometry engine fill rate
+#define SIM_TICK_US				1024	// Timer0 overflow period. Wakes the CPU from idle
+#define SIM_CLOCK_READ_NS		1500	// millis()/micros(), with interrupts off around the read
+#define SIM_LOOP_US				5		// Time charged for a pass through loop() that did nothing else measurable
+#define SIM_SERIAL_BITS			10		// Start, 8 data, stop. Bytes leave the UART at baud / this
+
+// Wiring
+#define SIM_RTC_SQW_IRQ			1		// DS3231 INT/SQW on pin 3 = INT1
+#define SIM_TOUCH_IRQ			0		// RA8875 INT on pin 2 = INT0
+#define SIM_TIMER1_IRQ			2		// Timer1 compare match A
+#define SIM_RTC_32K_PS			30517578.125L	// 32kHz period in picoseconds at 0ppm (1e12 / 32768, exact)
+
+// Display. Follows the sketch's LAYOUT_PANEL (Layout.h), so FACE=-DLAYOUT_PANEL=1 benches the 480x272 panel
+#if defined(LAYOUT_PANEL) && (LAYOUT_PANEL == 1)
+#define SIM_TFT_WIDTH			480
+#define SIM_TFT_HEIGHT			272
+#else
+#define SIM_TFT_WIDTH			800
+#define SIM_TFT_HEIGHT			480
+#endif
+
+// Everything the bench measures. Reset with simResetStats()
+typedef struct
+{
+	uint64_t spiBytes;			// Bytes on the SPI bus to/from the RA8875
+	uint64_t regWrites;			// RA8875 register writes
+	uint64_t regReads;			// RA8875 register & status reads
+	uint64_t pixelBytes;		// Pixel data bytes pushed through the memory write port
+	uint64_t pixelsWritten;		// Pixels covered by any drawing operation
+	uint64_t pixelsChanged;		// Pixels whose color actually changed
+	uint64_t drawOps;			// Drawing operations (fills, circles, glyph runs, text cells)
+	uint64_t i2cTransactions;	// I2C transactions with the DS3231
+	uint64_t i2cBytes;			// I2C bytes, address bytes included
+	uint64_t rtcWrites;			// Times the DS3231's time was set
+	uint64_t busyUs;			// Virtual time spent outside sleep_cpu()
+} simStats_t;
+
+extern simStats_t simStats;
+
+// Virtual time
+uint64_t simNow();							// us since power-on
+void simAdvance(uint64_t us);				// CPU is busy for this long. Interrupts that come due on the way are run.
+void simAdvanceNs(uint64_t ns);				// Same, for the sub-microsecond bus costs. Carries the remainder
+void simRunFor(uint64_t us);				// Call loop() until this much virtual time has passed
+void simResetStats();
+
+// Interrupts
+void simRaiseIrq(uint8_t irq);				// Edge on an external interrupt line
+bool simIrqAttached(uint8_t irq);
+
+// Serial
+void simSerialInput(const uint8_t *data, size_t len);
+std::string &simSerialOutput();				// Everything the sketch has printed
+void simSerialEcho(bool on);				// Copy sketch output to stderr as it's printed
+
+// EEPROM
+void simEepromErase();
+uint8_t *simEepromData();
+uint64_t simEepromWrites();					// Cells actually written (update() skips unchanged ones)
+
+// RTC (FakeDS3231.cpp)
+void simRtcSet(int year, int month, int day, int hour, int minute, int second);
+void simRtcSetSeconds(uint32_t secs);			// Same, as seconds since 2000-01-01 00:00:00
+void simRtcSetPpm(int32_t ppm);				// RTC drift against virtual time, parts per million
+uint64_t simRtcNextEdge();					// Virtual time the RTC next rolls over a second. 0 before the RTC is set up
+void simRtcEdge();							// Called by the time base at each rollover. Raises SQW/alarm interrupts
+uint32_t simRtcSeconds();					// RTC time, seconds since 2000-01-01 00:00:00
+uint64_t simRtc32kCount(uint64_t us);		// 32kHz output edges up to virtual time 'us'
+uint64_t simRtc32kTime(uint64_t k);			// Virtual time of 32kHz edge 'k'
+
+// Display (FakeRA8875.cpp)
+void simTouch(int16_t x, int16_t y);		// Finger down at a point on the clock face, in the sketch's (rotated) coordinates
+void simRelease();
+void simSetTouchNoise(uint16_t amplitude);	// Random noise added to each raw touch ADC read
+const uint16_t *simFrame();					// Framebuffer, SIM_TFT_WIDTH x SIM_TFT_HEIGHT, RGB565, panel orientation
+bool simDumpFrame(const char *path, bool asViewed);		// Write the framebuffer as a binary PPM. asViewed undoes the panel rotation
+uint16_t simTftRotation();
+
+#endif // _SIMHOST_h
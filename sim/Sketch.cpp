@@ -0,0 +1,5 @@
+// Sketch.cpp
+// The sketch itself, built as an ordinary C++ translation unit. The IDE would add the prototypes; the .ino already
+// declares what it uses ahead of time.
+
+#include "../HexClockTouch3.ino"
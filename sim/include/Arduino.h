@@ -0,0 +1,116 @@
+// Arduino.h - host stand-in for the Arduino core, just enough to build the HexClock sketch on Linux.
+// Time is virtual. See SimHost.h.
+
+#ifndef _SIM_ARDUINO_H
+#define _SIM_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH			1
+#define LOW				0
+#define INPUT			0x0
+#define OUTPUT			0x1
+#define INPUT_PULLUP	0x2
+#define CHANGE			1
+#define FALLING			2
+#define RISING			3
+#define DEC				10
+#define HEX				16
+#define OCT				8
+#define BIN				2
+
+#define A0				14
+#define A1				15
+#define A2				16
+#define A3				17
+
+#define F_CPU			16000000UL		// 5V Pro Mini
+#define clockCyclesPerMicrosecond()	(F_CPU / 1000000L)
+
+#define digitalPinToInterrupt(p)	((p) == 2 ? 0 : ((p) == 3 ? 1 : -1))
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+void attachInterrupt(uint8_t irq, void (*isr)(void), int mode);
+void detachInterrupt(uint8_t irq);
+void noInterrupts(void);
+void interrupts(void);
+#define cli()	noInterrupts()
+#define sei()	interrupts()
+
+class __FlashStringHelper;
+#define F(s)	(reinterpret_cast<const __FlashStringHelper *>(s))
+
+class Print
+{
+public:
+	virtual ~Print() {}
+	virtual size_t write(uint8_t c) = 0;
+	virtual size_t write(const uint8_t *buf, size_t len);
+	size_t write(const char *s) { return write((const uint8_t *)s, strlen(s)); }
+
+	size_t print(const __FlashStringHelper *s);
+	size_t print(const char *s);
+	size_t print(char c);
+	size_t print(unsigned char n, int base = DEC);
+	size_t print(int n, int base = DEC);
+	size_t print(unsigned int n, int base = DEC);
+	size_t print(long n, int base = DEC);
+	size_t print(unsigned long n, int base = DEC);
+	size_t println(const __FlashStringHelper *s);
+	size_t println(const char *s);
+	size_t println(char c);
+	size_t println(unsigned char n, int base = DEC);
+	size_t println(int n, int base = DEC);
+	size_t println(unsigned int n, int base = DEC);
+	size_t println(long n, int base = DEC);
+	size_t println(unsigned long n, int base = DEC);
+	size_t println(void);
+
+private:
+	size_t printNumber(unsigned long n, uint8_t base);
+};
+
+class Stream : public Print
+{
+public:
+	virtual int available() = 0;
+	virtual int read() = 0;
+	virtual int peek() = 0;
+};
+
+// Serial port. Output is captured by the simulator, input comes from SimHost.
+#define SERIAL_TX_BUFFER_SIZE	64
+
+class HardwareSerial : public Stream
+{
+public:
+	void begin(unsigned long baud);
+	void end();
+	int available();
+	int read();
+	int peek();
+	int availableForWrite();
+	void flush();
+	size_t write(uint8_t c);
+	using Print::write;
+	operator bool() { return true; }
+};
+
+extern HardwareSerial Serial;
+
+#endif
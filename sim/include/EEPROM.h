@@ -0,0 +1,34 @@
+// Host stand-in for the AVR EEPROM library. 1K of EEPROM, initially erased (0xFF).
+#ifndef _SIM_EEPROM_H
+#define _SIM_EEPROM_H
+#include "Arduino.h"
+
+#define SIM_EEPROM_SIZE	1024
+
+struct EEPROMClass
+{
+	uint8_t read(int address);
+	void write(int address, uint8_t value);
+	void update(int address, uint8_t value);
+	uint16_t length() { return SIM_EEPROM_SIZE; }
+
+	template<typename T> T &get(int address, T &t)
+	{
+		uint8_t *p = (uint8_t *)&t;
+		for (size_t i = 0; i < sizeof(T); ++i)
+			p[i] = read(address + i);
+		return t;
+	}
+
+	template<typename T> const T &put(int address, const T &t)
+	{
+		const uint8_t *p = (const uint8_t *)&t;
+		for (size_t i = 0; i < sizeof(T); ++i)
+			update(address + i, p[i]);
+		return t;
+	}
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
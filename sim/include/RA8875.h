@@ -0,0 +1,108 @@
+// Host stand-in for the sumotoy RA8875 library, drawing into the simulator's framebuffer (FakeRA8875.cpp).
+// Only the parts of the API the HexClock uses are here. Each call is charged the SPI traffic the real library sends.
+
+#ifndef _SIM_RA8875_H
+#define _SIM_RA8875_H
+
+#include "Arduino.h"
+
+#define __PRGMTAG_
+
+// Custom font types, as produced by the LCD-Image-Converter template for this library
+typedef struct
+{
+	const uint8_t *data;
+	uint8_t image_width;
+	int image_datalen;
+} tImage;
+
+typedef struct
+{
+	uint8_t char_code;
+	const tImage *image;
+} tChar;
+
+typedef struct
+{
+	uint8_t length;
+	const tChar *chars;
+	uint8_t font_width;
+	uint8_t font_height;
+	bool rle;
+} tFont;
+
+enum RA8875sizes { RA8875_480x272, RA8875_800x480, Adafruit_480x272, Adafruit_800x480 };
+enum RA8875fontSource { INT, EXT };
+
+#define RA8875_BLACK	0x0000
+#define RA8875_BLUE		0x001F
+#define RA8875_RED		0xF800
+#define RA8875_GREEN	0x07E0
+#define RA8875_CYAN		0x07FF
+#define RA8875_MAGENTA	0xF81F
+#define RA8875_YELLOW	0xFFE0
+#define RA8875_WHITE	0xFFFF
+
+class RA8875 : public Print
+{
+public:
+	RA8875(const uint8_t CSp, const uint8_t RSTp);
+
+	void begin(const enum RA8875sizes s);
+	int16_t width() { return _width; }
+	int16_t height() { return _height; }
+	void setRotation(uint8_t rotation);
+	uint8_t getRotation() { return _rotation; }
+
+	// Display & backlight
+	void displayOn(boolean on);
+	void sleep(boolean sleep);
+	void brightness(uint8_t val);
+	void backlight(boolean on);
+
+	// Text
+	void setFont(const tFont *font);
+	void setFont(enum RA8875fontSource s);
+	void setFontScale(uint8_t scale);
+	void setTextColor(uint16_t fcolor, uint16_t bcolor);
+	void setTextColor(uint16_t fcolor);
+	void setCursor(int16_t x, int16_t y);
+	void getCursor(int16_t *x, int16_t *y) { *x = _cursorX; *y = _cursorY; }
+	size_t write(uint8_t c);
+	using Print::write;
+
+	// Geometry
+	void fillWindow(uint16_t color = RA8875_BLACK);
+	void drawPixel(int16_t x, int16_t y, uint16_t color);
+	uint16_t getPixel(int16_t x, int16_t y);
+	void getPixels(uint16_t *p, uint32_t count, int16_t x, int16_t y);
+	void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+	void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+	void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+	void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+	void drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color);
+	void fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color);
+
+	// Touch
+	void useINT(const uint8_t INTpin);
+	void enableISR(bool force = false);
+	void touchBegin(void);
+	void touchEnable(boolean enabled);
+	boolean touched(bool safe = false);
+	void touchReadAdc(uint16_t *x, uint16_t *y);
+
+private:
+	int16_t _width, _height;
+	uint8_t _rotation;
+	const tFont *_font;				// NULL = internal font
+	uint8_t _scale;
+	uint16_t _fg, _bg;
+	bool _transparent;
+	int16_t _cursorX, _cursorY;
+	bool _touchEnabled;
+
+	void writeChar(uint8_t c);
+	void writeCustomChar(uint8_t c);
+};
+
+#endif
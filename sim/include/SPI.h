@@ -0,0 +1,2 @@
+// Host stand-in. The simulated RA8875 doesn't go through a real SPI bus.
+#include "Arduino.h"
@@ -0,0 +1,14 @@
+// Host stand-in. The simulated DS3231 doesn't go through a real I2C bus.
+#ifndef _SIM_WIRE_H
+#define _SIM_WIRE_H
+#include "Arduino.h"
+
+class TwoWire
+{
+public:
+	void begin() {}
+};
+
+extern TwoWire Wire;
+
+#endif
@@ -0,0 +1,52 @@
+// Host stand-in for the AVR register definitions the sketch touches
+#ifndef _SIM_AVR_IO_H
+#define _SIM_AVR_IO_H
+#include <stdint.h>
+
+extern uint8_t MCUSR;
+#define PORF	0
+#define EXTRF	1
+#define BORF	2
+#define WDRF	3
+
+/*
+Timer1, as far as HexTime.cpp uses it: CTC mode (WGM12) clocked from the T1 pin, which has the DS3231's 32kHz output
+on it. TCNT1 works out its count from the fake RTC's oscillator (FakeDS3231.cpp) and the last value written to it,
+and the compare match interrupt is raised by the time base like the external ones. Set OCR1A and the clock select
+before writing TCNT1; the next match is worked out at the write. Other modes and clock sources don't count.
+*/
+class SimTimer1Count
+{
+public:
+	operator uint16_t() const;
+	SimTimer1Count &operator=(uint16_t v);
+};
+
+class SimTimer1Flags
+{
+public:
+	operator uint8_t() const;
+	SimTimer1Flags &operator=(uint8_t v);		// Writing a 1 clears the flag, as on the AVR
+};
+
+extern SimTimer1Count TCNT1;
+extern SimTimer1Flags TIFR1;
+extern uint8_t TCCR1A;
+extern uint8_t TCCR1B;
+extern uint8_t TIMSK1;
+extern uint16_t OCR1A;
+#define CS10	0
+#define CS11	1
+#define CS12	2
+#define WGM12	3
+#define OCIE1A	1
+#define OCF1A	1
+
+#define ISR(vector)		extern "C" void vector(void)
+extern "C" void TIMER1_COMPA_vect(void) __attribute__((weak));
+
+#ifndef _BV
+#define _BV(b)	(1 << (b))
+#endif
+
+#endif
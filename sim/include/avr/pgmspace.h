@@ -0,0 +1,21 @@
+// Host stand-in. Flash and RAM are the same thing here.
+#ifndef _SIM_AVR_PGMSPACE_H
+#define _SIM_AVR_PGMSPACE_H
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PGM_P					const char *
+#define PSTR(s)					(s)
+#define pgm_read_byte(p)		(*(const uint8_t *)(p))
+#define pgm_read_word(p)		simPgmWord(p)
+#define pgm_read_dword(p)		simPgmDword(p)
+#define pgm_read_ptr(p)			(*(void * const *)(p))
+#define memcpy_P				memcpy
+#define strlen_P				strlen
+
+// Copied out, so reading a word of a wider field (an int is 16 bits on the AVR) doesn't trip strict aliasing
+static inline uint16_t simPgmWord(const void *p) { uint16_t v; memcpy(&v, p, sizeof(v)); return v; }
+static inline uint32_t simPgmDword(const void *p) { uint32_t v; memcpy(&v, p, sizeof(v)); return v; }
+
+#endif
@@ -0,0 +1,16 @@
+// Host stand-in. sleep_cpu() advances virtual time to the next interrupt.
+#ifndef _SIM_AVR_SLEEP_H
+#define _SIM_AVR_SLEEP_H
+
+#define SLEEP_MODE_IDLE			0
+#define SLEEP_MODE_ADC			1
+#define SLEEP_MODE_PWR_DOWN		2
+#define SLEEP_MODE_PWR_SAVE		3
+#define SLEEP_MODE_STANDBY		6
+
+void set_sleep_mode(int mode);
+void sleep_enable(void);
+void sleep_disable(void);
+void sleep_cpu(void);
+
+#endif
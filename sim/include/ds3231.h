@@ -0,0 +1,44 @@
+// Host stand-in for the rodan/ds3231 library, backed by the simulator's virtual RTC (FakeDS3231.cpp)
+#ifndef _SIM_DS3231_H
+#define _SIM_DS3231_H
+#include "Arduino.h"
+
+// Control register
+#define DS3231_A1IE		0x1
+#define DS3231_A2IE		0x2
+#define DS3231_INTCN	0x4
+
+// Status register
+#define DS3231_A1F		0x1
+#define DS3231_A2F		0x2
+#define DS3231_OSF		0x80
+
+struct ts
+{
+	uint8_t sec;
+	uint8_t min;
+	uint8_t hour;
+	uint8_t mday;
+	uint8_t mon;
+	int16_t year;
+	uint8_t wday;
+	uint8_t yday;
+	uint8_t isdst;
+	uint8_t year_s;
+	uint32_t unixtime;
+};
+
+void DS3231_init(const uint8_t creg);
+void DS3231_set(struct ts t);
+void DS3231_get(struct ts *t);
+void DS3231_set_creg(const uint8_t val);
+void DS3231_set_sreg(const uint8_t val);
+uint8_t DS3231_get_sreg(void);
+void DS3231_set_a1(const uint8_t s, const uint8_t mi, const uint8_t h, const uint8_t d, const uint8_t * flags);
+void DS3231_clear_a1f(void);
+uint8_t DS3231_triggered_a1(void);
+void DS3231_set_a2(const uint8_t mi, const uint8_t h, const uint8_t d, const uint8_t * flags);
+void DS3231_clear_a2f(void);
+uint8_t DS3231_triggered_a2(void);
+
+#endif
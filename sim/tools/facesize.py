@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+"""
+facesize.py - flash & RAM used by each clock face variant (FaceConfig.h), for the Pro Mini
+
+    facesize.py [--fqbn FQBN] [--arduino-cli PATH] [--define NAME=VALUE ...]
+
+Builds the sketch once per FACE_VARIANT with arduino-cli and prints what each one takes, and what it saves against
+the full face. --define adds -D flags to every build, to see what one FACE_ part is worth on its own (for example
+--define FACE_12H=0). Needs arduino-cli with the Arduino AVR core and the sketch's libraries installed. Only the
+standard library is used.
+"""
+
+import argparse
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+SKETCH = "HexClockTouch3"
+SKETCH_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..")
+VARIANTS = [
+    (0, "full"),
+    (1, "hex only"),
+    (2, "binary only"),
+    (3, "serial setup"),
+]
+FLASH_RE = re.compile(r"Sketch uses ([\d,]+) bytes .*Maximum is ([\d,]+) bytes")
+RAM_RE = re.compile(r"Global variables use ([\d,]+) bytes .*Maximum is ([\d,]+) bytes")
+
+
+def number(text):
+    return int(text.replace(",", ""))
+
+
+def copy_sketch(dest):
+    """arduino-cli wants the sketch in a folder with its own name. Copies just the sketch's files, not sim/."""
+    os.mkdir(dest)
+    for name in os.listdir(SKETCH_DIR):
+        if os.path.splitext(name)[1] in (".ino", ".cpp", ".c", ".h"):
+            shutil.copy(os.path.join(SKETCH_DIR, name), dest)
+
+
+def build(cli, fqbn, sketch, flags):
+    cmd = [cli, "compile", "--fqbn", fqbn, "--build-property", "build.extra_flags=" + " ".join(flags), sketch]
+    out = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+    flash, ram = FLASH_RE.search(out.stdout), RAM_RE.search(out.stdout)
+    if out.returncode != 0 or not flash or not ram:
+        raise RuntimeError("build with %s failed:\n%s" % (" ".join(flags), out.stdout))
+    return number(flash.group(1)), number(flash.group(2)), number(ram.group(1)), number(ram.group(2))
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Flash & RAM used by each face variant")
+    ap.add_argument("--fqbn", default="arduino:avr:pro:cpu=16MHzatmega328", help="board (default: 16MHz Pro Mini)")
+    ap.add_argument("--arduino-cli", default="arduino-cli", help="arduino-cli to build with")
+    ap.add_argument("--define", action="append", default=[], metavar="NAME=VALUE", help="extra -D for every build")
+    a = ap.parse_args()
+
+    extra = ["-D" + d for d in a.define]
+    work = tempfile.mkdtemp()
+    try:
+        sketch = os.path.join(work, SKETCH)
+        copy_sketch(sketch)
+        print("%-14s %14s %14s %12s %12s" % ("variant", "flash", "ram", "flash saved", "ram saved"))
+        base = None
+        for v, name in VARIANTS:
+            flash, flash_max, ram, ram_max = build(a.arduino_cli, a.fqbn, sketch, ["-DFACE_VARIANT=%d" % v] + extra)
+            if base is None:
+                base = (flash, ram)
+            print("%-14s %6d (%3d%%) %6d (%3d%%) %12d %12d" % (
+                name, flash, 100 * flash // flash_max, ram, 100 * ram // ram_max, base[0] - flash, base[1] - ram))
+    except (OSError, RuntimeError) as e:
+        print("error: %s" % e, file=sys.stderr)
+        return 1
+    finally:
+        shutil.rmtree(work, ignore_errors=True)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,546 @@
+#!/usr/bin/env python3
+"""
+hexlink.py - host client for the clock's binary Serial protocol (SerialLink.h)
+
+    hexlink.py PORT ping
+    hexlink.py PORT time
+    hexlink.py PORT settime [YYYY-MM-DD HH:MM:SS]       (default: now, local time)
+    hexlink.py PORT settings
+    hexlink.py PORT set [fg=0xFFFF] [bg=0x0000] [base=hex|dec] [hours=12|24|16] [rotation=0|180] [color=fixed|time]
+    hexlink.py PORT mode hex|dec 12|24|16
+    hexlink.py PORT counters
+    hexlink.py PORT watch [up | down [SECONDS] | off | start | lap | clear]   (start starts or stops it. No argument: status)
+    hexlink.py PORT alarm [HH:MM [on|off] [DAYS] | del HH:MM | snooze | stop]    (No argument: status and the table)
+    hexlink.py PORT sun [on|off] [lat=51.51] [lon=-0.13] [utc=+1|-3:30]
+    hexlink.py PORT power [dim=23:00-07:00|none] [off=01:00-05:00|none] [level=40]
+
+hours=16 is hex day time (HexTime.h): the day in 0x10000 units, shown as four hex digits.
+color=time makes the background the color of the time (#HHMMSS), with black or white digits. fg and bg are kept.
+DAYS is the days an alarm goes off, Sunday first, with '-' for the ones it doesn't (e.g. -MTWTF-). Default: every day.
+sun on puts today's sunrise, sunset and day length (Sun.h) where the binary date goes. lat & lon are degrees, north &
+east positive; utc is the clock's time zone, hours ahead of UTC to the quarter hour.
+power sets when the backlight is dimmed (to level, 1-255) and when the panel is off (Power.h), to the quarter hour. A
+period can run over midnight. With no arguments it shows the schedule, today's minutes in each state and the energy.
+PORT is the clock's serial port (9600 baud), or the pseudo-terminal printed by "sim/hexclock-bench --serve".
+Only the standard library is used. The clock's text output (task stats etc.) shares the port and is skipped.
+"""
+
+import datetime
+import os
+import select
+import struct
+import sys
+import termios
+import time
+import tty
+
+SOF = 0x7E
+REPLY = 0x80
+
+PING = 0x01
+GET_TIME = 0x10
+SET_TIME = 0x11
+ALARM_STATUS = 0x14
+ALARM_GET = 0x15
+ALARM_SET = 0x16
+ALARM_CTRL = 0x17
+GET_SETTINGS = 0x20
+SET_SETTINGS = 0x21
+SET_MODE = 0x22
+SUN_GET = 0x23
+SUN_SET = 0x24
+POWER_GET = 0x25
+POWER_SET = 0x26
+GET_COUNTERS = 0x30
+SYNC_START = 0x40
+SYNC_TIME = 0x41
+SYNC_APPLY = 0x42
+SYNC_STATUS = 0x43
+TRACE = 0x50
+TRACE_FEED = 0x51
+TRACE_DATA = 0x52
+TRACE_STATUS = 0x53
+
+SHOT = 0x60
+SHOT_DATA = 0x61
+SHOT_END = 0x62
+SHOT_STOP = 0x63
+
+WATCH = 0x70
+WATCH_CTRL = 0x71
+WATCH_STATUS = 0x72
+
+TRACE_OFF, TRACE_CAPTURE, TRACE_REPLAY = 0, 1, 2
+WATCH_MODES = ("off", "up", "down")
+WATCH_ACTIONS = ("start", "lap", "clear")
+ALARM_STATES = ("idle", "armed", "ringing", "snoozed")
+ALARM_ACTIONS = ("snooze", "stop")
+ALARM_ON = 0x80
+ALARM_DAYS = "SMTWTFS"
+SUN_NONE = 0xFFFF
+SUN_POLAR = ("", " (up all day)", " (down all day)")
+POWER_STATES = ("on", "dim", "off")
+
+STATUS = {0: "ok", 1: "bad crc", 2: "unknown command", 3: "bad argument", 4: "busy (setup screen is up)",
+          5: "out of order, the RTC tick isn't running, not replaying a touch trace, the watch is off, "
+             "no alarm to snooze or stop, or the alarm table is full"}
+
+BASE_HEX, BASE_DEC = 16, 10
+DISPLAY_24H, DISPLAY_12H = 1, 0
+TIME_MODE_CLOCK, TIME_MODE_HEXDAY = 0, 1
+COLOR_MODES = ("fixed", "time")
+ROTATION_0, ROTATION_180 = 0, 2
+
+COUNTERS = ("uptime_ms", "touch_accepted", "touch_rejected", "ticks", "ticks_missed", "ram_lowest",
+            "settings_commits", "link_errors")
+
+REPLY_TIMEOUT = 1.0     # seconds
+RETRIES = 2
+
+
+class LinkError(Exception):
+    pass
+
+
+def crc8(data):
+    """CRC-8, reflected polynomial 0x8C. Same as crc8() in Settings.cpp."""
+    crc = 0
+    for b in data:
+        for _ in range(8):
+            if (crc ^ b) & 1:
+                crc = (crc >> 1) ^ 0x8C
+            else:
+                crc >>= 1
+            b >>= 1
+    return crc
+
+
+def frame(cmd, payload=b""):
+    body = bytes([len(payload), cmd]) + payload
+    return bytes([SOF]) + body + bytes([crc8(body)])
+
+
+class Link:
+    def __init__(self, port):
+        self.fd = os.open(port, os.O_RDWR | os.O_NOCTTY)
+        if os.isatty(self.fd):
+            tty.setraw(self.fd)
+        self.set_baud(9600)
+        self.rx = bytearray()
+
+    def set_baud(self, baud):
+        if os.isatty(self.fd):
+            attrs = termios.tcgetattr(self.fd)
+            attrs[4] = attrs[5] = getattr(termios, "B%d" % baud)
+            termios.tcsetattr(self.fd, termios.TCSADRAIN, attrs)
+
+    def close(self):
+        os.close(self.fd)
+
+    def _read(self, deadline):
+        left = deadline - time.monotonic()
+        if left <= 0:
+            return False
+        ready, _, _ = select.select([self.fd], [], [], left)
+        if ready:
+            self.rx += os.read(self.fd, 256)
+        return True
+
+    def _take_reply(self, cmd):
+        """Pull the first good reply to cmd out of the receive buffer. Text and damaged frames are skipped."""
+        frm = self._take_frame((cmd,))
+        return None if frm is None else frm[1:]
+
+    def _take_frame(self, cmds):
+        """Pull the first good reply to any of cmds out of the receive buffer, as (cmd, first byte, rest)."""
+        while True:
+            start = self.rx.find(SOF)
+            if start < 0:
+                self.rx.clear()
+                return None
+            del self.rx[:start]
+            if len(self.rx) < 2:
+                return None
+            n = self.rx[1]
+            if len(self.rx) < n + 4:
+                return None
+            body = bytes(self.rx[1:n + 3])
+            if self.rx[n + 3] != crc8(body) or body[1] not in [c | REPLY for c in cmds] or n < 1:
+                del self.rx[0]
+                continue
+            del self.rx[:n + 4]
+            return body[1] & ~REPLY, body[2], body[3:]
+
+    def receive(self, cmds, timeout):
+        """Wait for a frame the clock sends unasked (see SerialLink::send()). Returns (cmd, first byte, rest) or None."""
+        deadline = time.monotonic() + timeout
+        while True:
+            frm = self._take_frame(cmds)
+            if frm is not None:
+                return frm
+            if not self._read(deadline):
+                return None
+
+    def command(self, cmd, payload=b""):
+        """Send a command and return its reply payload (after the status byte)."""
+        for _ in range(RETRIES):
+            self.rx.clear()
+            os.write(self.fd, frame(cmd, payload))
+            deadline = time.monotonic() + REPLY_TIMEOUT
+            while True:
+                reply = self._take_reply(cmd)
+                if reply is not None:
+                    status, data = reply
+                    if status == 1:
+                        break       # Damaged on the way there. Send it again
+                    if status != 0:
+                        raise LinkError(STATUS.get(status, "status %d" % status))
+                    return data
+                if not self._read(deadline):
+                    break
+        raise LinkError("no reply")
+
+    def ping(self):
+        return self.command(PING)[0]
+
+    def get_time(self):
+        sec, mn, hour, mday, mon, year = struct.unpack("<5BH", self.command(GET_TIME))
+        return datetime.datetime(year, mon, mday, hour, mn, sec)
+
+    def set_time(self, t):
+        self.command(SET_TIME, struct.pack("<5BH", t.second, t.minute, t.hour, t.day, t.month, t.year))
+
+    def get_settings(self):
+        reply = self.command(GET_SETTINGS)
+        if len(reply) == 7:                     # Clock from before hex day time
+            reply += bytes([TIME_MODE_CLOCK])
+        if len(reply) == 8:                     # ...or before the color of the time
+            reply += bytes([0])
+        fg, bg, base, display, rotation, time_mode, color_mode = struct.unpack("<HH5B", reply)
+        return {"fg": fg, "bg": bg, "base": base, "display": display, "rotation": rotation, "time_mode": time_mode,
+                "color_mode": color_mode}
+
+    def set_settings(self, s):
+        self.command(SET_SETTINGS, struct.pack("<HH5B", s["fg"], s["bg"], s["base"], s["display"], s["rotation"],
+                                               s["time_mode"], s["color_mode"]))
+
+    def set_mode(self, base, display, time_mode):
+        self.command(SET_MODE, bytes([base, display, time_mode]))
+
+    def counters(self):
+        return dict(zip(COUNTERS, struct.unpack("<I7H", self.command(GET_COUNTERS))))
+
+    def sync_sample(self, new_session=False):
+        """One NTP-style exchange (see TimeSync.h). Returns (round trip us, offset us) as the clock worked them out."""
+        self.command(SYNC_START, bytes([1 if new_session else 0]))
+        received = time.monotonic()
+        sec, us = clock_now()
+        hold = int((time.monotonic() - received) * 1e6)
+        delay, offset = struct.unpack("<Ii", self.command(SYNC_TIME, struct.pack("<III", sec, us, hold)))
+        return delay, (None if offset == OFFSET_NONE else offset)
+
+    def sync_apply(self):
+        return struct.unpack("<I", self.command(SYNC_APPLY))[0]
+
+    def sync_status(self):
+        syncs, step, drift, offset, delay = struct.unpack("<HiiiI", self.command(SYNC_STATUS))
+        return {"syncs": syncs, "last_step_us": None if step == OFFSET_NONE else step, "drift_ppm": drift / 10.0,
+                "offset_us": None if offset == OFFSET_NONE else offset, "delay_us": delay}
+
+    def trace_mode(self, mode):
+        self.command(TRACE, bytes([mode]))
+
+    def trace_feed(self, data, last):
+        """Offer replay bytes. Returns (bytes taken, room left in the clock's buffer)."""
+        taken, room = self.command(TRACE_FEED, bytes([1 if last else 0]) + data)
+        return taken, room
+
+    def trace_status(self):
+        mode, dropped, underruns, actions, last, peak = struct.unpack("<B3H2I", self.command(TRACE_STATUS))
+        return {"mode": ("off", "capture", "replay")[mode], "dropped": dropped, "underruns": underruns,
+                "actions": actions, "last_latency_us": last, "max_latency_us": peak}
+
+    def shot_start(self, fast, area=None):
+        """Start a screen export. Returns (width, height, baud it's sent at)."""
+        payload = bytes([1 if fast else 0]) + (struct.pack("<4H", *area) if area else b"")
+        return struct.unpack("<HHI", self.command(SHOT, payload))
+
+    def shot_stop(self):
+        self.command(SHOT_STOP)
+
+    def watch_mode(self, mode, seconds=None):
+        """Stopwatch (up), countdown (down) or back to the clock (off). seconds sets the countdown"""
+        payload = bytes([WATCH_MODES.index(mode)]) + (struct.pack("<H", seconds) if seconds is not None else b"")
+        self.command(WATCH, payload)
+
+    def watch_ctrl(self, action):
+        self.command(WATCH_CTRL, bytes([WATCH_ACTIONS.index(action)]))
+
+    def watch_status(self):
+        mode, flags, shown, laps, lap, frames, avg, peak, over = struct.unpack("<BBIBIHHHH",
+                                                                              self.command(WATCH_STATUS))
+        return {"mode": WATCH_MODES[mode], "running": bool(flags & 1), "slow": bool(flags & 2), "shown_ms": shown,
+                "laps": laps, "lap_ms": lap, "frames": frames, "frame_avg_us": avg, "frame_max_us": peak,
+                "frames_over": over}
+
+    def alarm_status(self):
+        state, count, hour, minute, due, rung, snoozes, checks = struct.unpack("<4BI3H", self.command(ALARM_STATUS))
+        return {"state": ALARM_STATES[state], "count": count, "next": (hour, minute) if hour < 24 else None,
+                "due_in": due, "rung": rung, "snoozes": snoozes, "checks": checks}
+
+    def alarm_get(self, slot):
+        """Table entry: (hour, minute, days byte)"""
+        return tuple(self.command(ALARM_GET, bytes([slot])))
+
+    def alarm_set(self, hour, minute, days):
+        """Add or replace the alarm at hour:minute. days 0 removes it"""
+        self.command(ALARM_SET, bytes([hour, minute, days]))
+
+    def alarm_ctrl(self, action):
+        self.command(ALARM_CTRL, bytes([ALARM_ACTIONS.index(action)]))
+
+    def sun_get(self):
+        lat, lon, utc, panel, rise, sunset, length, polar, cycles, runs = struct.unpack("<hhbB3HB2H",
+                                                                                     self.command(SUN_GET))
+        return {"lat": lat, "lon": lon, "utc": utc, "panel": panel, "rise": rise, "set": sunset, "length": length,
+                "polar": polar, "cycles": cycles, "runs": runs}
+
+    def sun_set(self, s):
+        """lat & lon in hundredths of a degree, utc in quarter hours"""
+        self.command(SUN_SET, struct.pack("<hhbB", s["lat"], s["lon"], s["utc"], s["panel"]))
+
+    def power_get(self):
+        dim_from, dim_to, off_from, off_to, level, state, on, dim, off, today, yesterday = struct.unpack(
+            "<6B5H", self.command(POWER_GET))
+        return {"dim": (dim_from, dim_to), "off": (off_from, off_to), "level": level, "state": state,
+                "minutes": (on, dim, off), "today_mwh": today, "yesterday_mwh": yesterday}
+
+    def power_set(self, p):
+        """Periods in quarter hours; from == to is no period"""
+        self.command(POWER_SET, bytes(list(p["dim"]) + list(p["off"]) + [p["level"]]))
+
+
+EPOCH_2000 = 946684800      # 2000-01-01 in Unix time
+OFFSET_NONE = 0x7FFFFFFF    # Clock was too far out to give an offset in us
+
+
+def clock_now():
+    """Host local time as the clock counts it: (seconds since 2000-01-01, microseconds)."""
+    now = time.time()
+    local = now + datetime.datetime.fromtimestamp(now).astimezone().utcoffset().total_seconds()
+    us = int(round(local * 1e6)) - EPOCH_2000 * 1000000
+    return us // 1000000, us % 1000000
+
+
+def show_settings(s):
+    print("fg=0x%04X bg=0x%04X base=%s hours=%s rotation=%d color=%s" % (
+        s["fg"], s["bg"], "hex" if s["base"] == BASE_HEX else "dec",
+        16 if s["time_mode"] == TIME_MODE_HEXDAY else 24 if s["display"] == DISPLAY_24H else 12,
+        180 if s["rotation"] == ROTATION_180 else 0, COLOR_MODES[s["color_mode"]]))
+
+
+def parse_base(v):
+    return {"hex": BASE_HEX, "dec": BASE_DEC}[v]
+
+
+def parse_hours(v, s):
+    """12 or 24 is the clock time, 16 the hex day time (which keeps the 12/24 setting for later)"""
+    if v == "16":
+        s["time_mode"] = TIME_MODE_HEXDAY
+    else:
+        s["display"] = {"24": DISPLAY_24H, "12": DISPLAY_12H}[v]
+        s["time_mode"] = TIME_MODE_CLOCK
+
+
+def watch_time(ms):
+    return "%02d:%02d.%02d" % (ms // 60000, ms // 1000 % 60, ms // 10 % 100)
+
+
+def parse_alarm_time(v):
+    h, _, m = v.partition(":")
+    return int(h), int(m)
+
+
+def parse_days(v):
+    if len(v) != 7 or any(c not in (d, "-") for c, d in zip(v.upper(), ALARM_DAYS)):
+        raise ValueError(v)
+    return sum(1 << i for i, c in enumerate(v) if c != "-")
+
+
+def show_alarms(link):
+    a = link.alarm_status()
+    print("%s%s rung=%d snoozed=%d checks=%d" % (
+        a["state"], " next %02d:%02d in %ds" % (a["next"] + (a["due_in"],)) if a["next"] else "",
+        a["rung"], a["snoozes"], a["checks"]))
+    for slot in range(a["count"]):
+        hour, minute, days = link.alarm_get(slot)
+        print("%02d:%02d %-3s %s" % (hour, minute, "on" if days & ALARM_ON else "off",
+                                     "".join(d if days & (1 << i) else "-" for i, d in enumerate(ALARM_DAYS))))
+
+
+def parse_utc(v):
+    """+5:45, -3.5 or 1 to quarter hours"""
+    h, _, m = v.partition(":")
+    quarters = float(h) * 4 + (int(m) // 15 if m else 0) * (-1 if h.startswith("-") else 1)
+    if quarters != int(quarters):
+        raise ValueError(v)
+    return int(quarters)
+
+
+def sun_time(minutes):
+    return "--:--" if minutes == SUN_NONE else "%02d:%02d" % (minutes // 60, minutes % 60)
+
+
+def show_sun(s):
+    print("panel=%s lat=%.2f lon=%.2f utc=%s%d:%02d" % ("on" if s["panel"] else "off", s["lat"] / 100.0,
+                                                       s["lon"] / 100.0, "-" if s["utc"] < 0 else "+",
+                                                       abs(s["utc"]) // 4, abs(s["utc"]) % 4 * 15))
+    if not s["runs"]:
+        print("not worked out yet")
+        return
+    print("rise %s set %s day %s%s  (%d cycles, worked out %d times)" % (
+        sun_time(s["rise"]), sun_time(s["set"]), sun_time(s["length"]), SUN_POLAR[s["polar"]], s["cycles"], s["runs"]))
+
+
+def parse_period(v):
+    """HH:MM-HH:MM to quarter hours, or none"""
+    if v == "none":
+        return (0, 0)
+    period = []
+    for t in v.split("-"):
+        h, _, m = t.partition(":")
+        if int(m or 0) % 15 or not 0 <= int(h) < 24:
+            raise ValueError(v)
+        period.append(int(h) * 4 + int(m or 0) // 15)
+    if len(period) != 2:
+        raise ValueError(v)
+    return tuple(period)
+
+
+def show_period(p):
+    return "none" if p[0] == p[1] else "%02d:%02d-%02d:%02d" % (p[0] // 4, p[0] % 4 * 15, p[1] // 4, p[1] % 4 * 15)
+
+
+def show_power(p):
+    print("%s  dim=%s level=%d  off=%s" % (POWER_STATES[p["state"]], show_period(p["dim"]), p["level"] or 40,
+                                        show_period(p["off"])))
+    print("today: on %d min, dim %d min, off %d min, %d mWh  yesterday: %d mWh  (estimates, see Power.h)" % (
+        p["minutes"] + (p["today_mwh"], p["yesterday_mwh"])))
+
+
+def main(argv):
+    if len(argv) < 3:
+        sys.stderr.write(__doc__)
+        return 2
+    link = Link(argv[1])
+    cmd, args = argv[2], argv[3:]
+    try:
+        if cmd == "ping":
+            print("protocol version %d" % link.ping())
+        elif cmd == "time":
+            print(link.get_time())
+        elif cmd == "settime":
+            t = datetime.datetime.strptime(" ".join(args), "%Y-%m-%d %H:%M:%S") if args else datetime.datetime.now()
+            link.set_time(t)
+            print(link.get_time())
+        elif cmd == "settings":
+            show_settings(link.get_settings())
+        elif cmd == "set":
+            s = link.get_settings()
+            for a in args:
+                key, _, v = a.partition("=")
+                if key in ("fg", "bg"):
+                    s[key] = int(v, 0)
+                elif key == "base":
+                    s["base"] = parse_base(v)
+                elif key == "hours":
+                    parse_hours(v, s)
+                elif key == "rotation":
+                    s["rotation"] = {"0": ROTATION_0, "180": ROTATION_180}[v]
+                elif key == "color":
+                    s["color_mode"] = COLOR_MODES.index(v)
+                else:
+                    raise KeyError(key)
+            link.set_settings(s)
+            show_settings(link.get_settings())
+        elif cmd == "mode" and len(args) == 2:
+            s = link.get_settings()
+            parse_hours(args[1], s)
+            link.set_mode(parse_base(args[0]), s["display"], s["time_mode"])
+            show_settings(link.get_settings())
+        elif cmd == "counters":
+            for k, v in link.counters().items():
+                print("%-17s %d" % (k, v))
+        elif cmd == "watch" and len(args) <= 2:
+            if args and args[0] in WATCH_MODES:
+                link.watch_mode(args[0], int(args[1]) if len(args) == 2 else None)
+            elif len(args) == 1:
+                link.watch_ctrl(args[0])
+            elif args:
+                raise ValueError(" ".join(args))
+            w = link.watch_status()
+            print("%s %s%s %s laps=%d last=%s" % (w["mode"], "running" if w["running"] else "stopped",
+                                                 " slow" if w["slow"] else "", watch_time(w["shown_ms"]),
+                                                 w["laps"], watch_time(w["lap_ms"])))
+            print("frames=%d avg=%dus max=%dus over=%d" % (w["frames"], w["frame_avg_us"], w["frame_max_us"],
+                                                         w["frames_over"]))
+        elif cmd == "alarm" and len(args) <= 3:
+            if len(args) == 1 and args[0] in ALARM_ACTIONS:
+                link.alarm_ctrl(args[0])
+            elif len(args) == 2 and args[0] == "del":
+                link.alarm_set(*parse_alarm_time(args[1]), 0)
+            elif args:
+                days = ALARM_ON | 0x7F
+                for a in args[1:]:
+                    if a in ("on", "off"):
+                        days = (days & ~ALARM_ON) | (ALARM_ON if a == "on" else 0)
+                    else:
+                        days = (days & ALARM_ON) | parse_days(a)
+                link.alarm_set(*parse_alarm_time(args[0]), days)
+            show_alarms(link)
+        elif cmd == "sun":
+            s = link.sun_get()
+            for a in args:
+                key, _, v = a.partition("=")
+                if key in ("on", "off") and not v:
+                    s["panel"] = 1 if key == "on" else 0
+                elif key in ("lat", "lon"):
+                    s[key] = int(round(float(v) * 100))
+                elif key == "utc":
+                    s["utc"] = parse_utc(v)
+                else:
+                    raise KeyError(key)
+            if args:
+                link.sun_set(s)
+                s = link.sun_get()
+            show_sun(s)
+        elif cmd == "power":
+            p = link.power_get()
+            for a in args:
+                key, _, v = a.partition("=")
+                if key in ("dim", "off"):
+                    p[key] = parse_period(v)
+                elif key == "level":
+                    p["level"] = int(v)
+                else:
+                    raise KeyError(key)
+            if args:
+                link.power_set(p)
+                p = link.power_get()
+            show_power(p)
+        else:
+            sys.stderr.write(__doc__)
+            return 2
+    except LinkError as e:
+        print("error: %s" % e, file=sys.stderr)
+        return 1
+    except (KeyError, ValueError) as e:
+        print("bad argument: %s" % e, file=sys.stderr)
+        return 2
+    finally:
+        link.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,162 @@
+#!/usr/bin/env python3
+"""
+hexshot.py - screenshot of the clock, read back from the display over the binary Serial protocol (Screenshot.h)
+
+    hexshot.py PORT OUT.png [--area X,Y,W,H] [--slow]
+
+The clock reads its display memory back a little at a time (it keeps running meanwhile), compresses it and sends it
+at 57600 baud, then goes back to 9600. --slow keeps it at 9600 for adapters that can't change speed. Prints how long
+it took and how well it compressed. Only the standard library is used.
+"""
+
+import argparse
+import struct
+import sys
+import time
+import zlib
+
+from hexlink import Link, LinkError, SHOT_DATA, SHOT_END
+
+PALETTE = 15
+NEW_COLOR = 0x0F
+LONG_RUN = 0x0F
+FRAME_TIMEOUT = 3.0     # seconds without a frame before giving up
+
+
+class Decoder:
+    """Turns the token stream back into RGB565 pixels. Mirrors the encoder in Screenshot.cpp."""
+
+    def __init__(self):
+        self.palette = [0] * PALETTE
+        self.next_slot = 0
+        self.pixels = []
+        self.pending = bytearray()
+
+    def feed(self, data):
+        self.pending += data
+        while True:
+            used = self._token()
+            if not used:
+                return
+            del self.pending[:used]
+
+    def _token(self):
+        p = self.pending
+        if not p:
+            return 0
+        slot, n = p[0] >> 4, p[0] & 0x0F
+        i = 1
+        if slot == NEW_COLOR:
+            if len(p) < 3:
+                return 0
+            color = p[1] | (p[2] << 8)
+            i = 3
+        run = n + 1
+        if n == LONG_RUN:
+            extra, shift = 0, 0
+            while True:
+                if i >= len(p):
+                    return 0
+                c = p[i]
+                i += 1
+                extra |= (c & 0x7F) << shift
+                shift += 7
+                if not c & 0x80:
+                    break
+            run = LONG_RUN + 1 + extra
+        if slot == NEW_COLOR:
+            self.palette[self.next_slot] = color
+            self.next_slot = (self.next_slot + 1) % PALETTE
+        else:
+            color = self.palette[slot]
+        self.pixels.extend([color] * run)
+        return i
+
+
+def write_png(path, width, height, pixels):
+    def chunk(kind, data):
+        return struct.pack(">I", len(data)) + kind + data + struct.pack(">I", zlib.crc32(kind + data) & 0xFFFFFFFF)
+
+    rgb = {}
+    rows = bytearray()
+    for y in range(height):
+        rows.append(0)
+        for c in pixels[y * width:(y + 1) * width]:
+            if c not in rgb:
+                r, g, b = (c >> 11) & 0x1F, (c >> 5) & 0x3F, c & 0x1F
+                rgb[c] = bytes(((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)))
+            rows += rgb[c]
+    with open(path, "wb") as f:
+        f.write(b"\x89PNG\r\n\x1a\n")
+        f.write(chunk(b"IHDR", struct.pack(">IIBBBBB", width, height, 8, 2, 0, 0, 0)))
+        f.write(chunk(b"IDAT", zlib.compress(bytes(rows), 9)))
+        f.write(chunk(b"IEND", b""))
+
+
+def screenshot(link, path, area, fast):
+    started = time.monotonic()
+    width, height, baud = link.shot_start(fast, area)
+    if baud != 9600:
+        link.set_baud(baud)
+    dec = Decoder()
+    seq, received, totals = 0, 0, None
+    try:
+        while totals is None:
+            frm = link.receive((SHOT_DATA, SHOT_END), FRAME_TIMEOUT)
+            if frm is None:
+                raise LinkError("export stopped after %d bytes" % received)
+            cmd, s, data = frm
+            if s != seq & 0xFF:
+                raise LinkError("frame %d missing" % seq)
+            seq += 1
+            if cmd == SHOT_DATA:
+                dec.feed(data)
+                received += len(data)
+            else:
+                totals = struct.unpack("<3I", data)
+    finally:
+        if baud != 9600:
+            time.sleep(0.05)
+            link.set_baud(9600)
+    elapsed = time.monotonic() - started
+
+    pixels, sent, clock_ms = totals
+    if len(dec.pixels) != width * height or pixels != width * height or sent != received:
+        raise LinkError("got %d of %d pixels, %d of %d bytes" % (len(dec.pixels), width * height, received, sent))
+    write_png(path, width, height, dec.pixels)
+    raw = width * height * 2
+    print("%dx%d  %d bytes for %d (%.1f:1, %.1f%%)  %.2f s on the wire at %d baud (clock says %.2f s)" % (
+        width, height, received, raw, raw / float(received), 100.0 * received / raw, elapsed, baud, clock_ms / 1000.0))
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Screenshot of the clock's display")
+    ap.add_argument("port")
+    ap.add_argument("png")
+    ap.add_argument("--area", help="X,Y,W,H in the clock's coordinates (default: whole screen)")
+    ap.add_argument("--slow", action="store_true", help="stay at 9600 baud")
+    a = ap.parse_args()
+
+    link = Link(a.port)
+    try:
+        area = tuple(int(v) for v in a.area.split(",")) if a.area else None
+        if area is not None and len(area) != 4:
+            raise ValueError("--area wants X,Y,W,H")
+        screenshot(link, a.png, area, not a.slow)
+    except LinkError as e:
+        print("error: %s" % e, file=sys.stderr)
+        try:
+            link.shot_stop()
+        except LinkError:
+            pass
+        return 1
+    except (OSError, ValueError) as e:
+        print("error: %s" % e, file=sys.stderr)
+        return 1
+    finally:
+        link.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+"""
+hexsync.py - keeps the clock's RTC set from this computer's clock, over the binary Serial protocol
+
+    hexsync.py PORT [--interval SECONDS] [--samples N] [--once]
+
+Each round runs N exchanges and has the clock step its RTC using the one with the shortest round trip, then runs N
+more to measure what's left (the residual offset). From the second round on, the clock also works out how fast its
+RTC is drifting. Stands in for a time server when testing against "sim/hexclock-bench --serve".
+"""
+
+import argparse
+import sys
+import time
+
+from hexlink import Link, LinkError
+
+
+def session(link, samples):
+    """Run the exchanges. Returns the (delay, offset) with the shortest round trip."""
+    best = None
+    for i in range(samples):
+        delay, offset = link.sync_sample(new_session=(i == 0))
+        if best is None or delay < best[0]:
+            best = (delay, offset)
+        time.sleep(0.05)
+    return best
+
+
+def fmt_us(us):
+    return "out by more than 30 minutes" if us is None else "%+.3f ms" % (us / 1000.0)
+
+
+def sync_round(link, samples):
+    delay, offset = session(link, samples)
+    print("before  offset %s  (round trip %.3f ms)" % (fmt_us(offset), delay / 1000.0))
+    target = link.sync_apply()
+    # Wait for the step, and a tick after it so the clock has its sub-second time back
+    time.sleep(2.5)
+    delay, offset = session(link, samples)
+    status = link.sync_status()
+    print("after   offset %s  (round trip %.3f ms)  residual after step to second %d" % (
+        fmt_us(offset), delay / 1000.0, target))
+    if status["syncs"] > 1:
+        print("drift   %+.1f ppm  (syncs %d)" % (status["drift_ppm"], status["syncs"]))
+    sys.stdout.flush()
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Keep the clock's RTC in step with this computer")
+    ap.add_argument("port")
+    ap.add_argument("--interval", type=float, default=3600, help="seconds between syncs (default 3600)")
+    ap.add_argument("--samples", type=int, default=8, help="exchanges per measurement (default 8)")
+    ap.add_argument("--once", action="store_true", help="sync once and exit")
+    args = ap.parse_args()
+
+    link = Link(args.port)
+    try:
+        while True:
+            try:
+                sync_round(link, args.samples)
+            except LinkError as e:
+                print("sync failed: %s" % e, file=sys.stderr)
+                if args.once:
+                    return 1
+            if args.once:
+                return 0
+            time.sleep(args.interval)
+    except KeyboardInterrupt:
+        return 0
+    finally:
+        link.close()
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,175 @@
+#!/usr/bin/env python3
+"""
+hextrace.py - capture and replay touch panel traces (TouchTrace.h) over the binary Serial protocol
+
+    hextrace.py PORT capture FILE [--seconds N]     (default: until Ctrl-C)
+    hextrace.py PORT replay FILE
+    hextrace.py PORT status
+    hextrace.py dump FILE
+
+capture records every touch panel read the clock makes, with its timing. replay sends a trace back and the clock
+runs its touch code on it instead of the panel, then prints the touch-to-action latency. dump prints a trace as text.
+"sim/hexclock-bench --capture FILE" and "--replay FILE" use the same files, on the simulator in virtual time.
+"""
+
+import argparse
+import sys
+import time
+
+from hexlink import Link, LinkError, TRACE_DATA, TRACE_OFF, TRACE_CAPTURE, TRACE_REPLAY
+
+MAGIC = b"HXTR\x01"     # File header (magic & version), then the records as the clock sends them
+TICK_US = 16
+CHUNK = 19              # Trace bytes per feed frame (LINK_MAX_PAYLOAD less the flags byte)
+DRAIN = 1.0             # seconds to wait for the rest of a capture after stopping
+
+
+def load(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if not data.startswith(MAGIC):
+        raise ValueError("%s isn't a touch trace" % path)
+    return data[len(MAGIC):]
+
+
+def records(trace):
+    """Decode a trace. Yields (time us, kind, value): ("state", byte) or ("sample", (x, y))."""
+    i, t, x, y = 0, 0, 0, 0
+    while i < len(trace):
+        b = trace[i]
+        i += 1
+        dt = b & 0x3F
+        if dt == 0x3F:
+            dt, shift = 0, 0
+            while True:
+                c = trace[i]
+                i += 1
+                dt |= (c & 0x7F) << shift
+                shift += 7
+                if not c & 0x80:
+                    break
+        t += dt * TICK_US
+        kind = b & 0xC0
+        if kind == 0x00:
+            yield t, "state", trace[i]
+            i += 1
+            continue
+        if kind == 0x40:
+            d = trace[i]
+            x += ((d ^ 0x80) - 0x80) >> 4
+            y += (((d & 0x0F) ^ 0x08) - 0x08)
+            i += 1
+        elif kind == 0x80:
+            x += (trace[i] ^ 0x80) - 0x80
+            y += (trace[i + 1] ^ 0x80) - 0x80
+            i += 2
+        else:
+            x = trace[i] | ((trace[i + 2] & 0x03) << 8)
+            y = trace[i + 1] | (((trace[i + 2] >> 4) & 0x03) << 8)
+            i += 3
+        yield t, "sample", (x, y)
+
+
+def dump(path):
+    samples = 0
+    for t, kind, v in records(load(path)):
+        if kind == "state":
+            print("%12.3f ms  %s%s" % (t / 1000.0, "down" if v & 1 else "up", "  (gap before this)" if v & 2 else ""))
+        else:
+            samples += 1
+            print("%12.3f ms      %4d %4d" % (t / 1000.0, v[0], v[1]))
+    print("%d samples" % samples)
+
+
+def capture(link, path, seconds):
+    trace = bytearray()
+    seq, lost = None, 0
+    link.trace_mode(TRACE_CAPTURE)
+    end = time.monotonic() + seconds if seconds else None
+    print("capturing%s" % ("" if end else ", Ctrl-C to stop"))
+    try:
+        while end is None or time.monotonic() < end:
+            frm = link.receive((TRACE_DATA,), 0.2)
+            if frm is not None:
+                if seq is not None and frm[1] != (seq + 1) & 0xFF:
+                    lost += 1
+                seq = frm[1]
+                trace += frm[2]
+    except KeyboardInterrupt:
+        pass
+    # Whatever the clock still has goes out once the panel is let go
+    while True:
+        frm = link.receive((TRACE_DATA,), DRAIN)
+        if frm is None:
+            break
+        trace += frm[2]
+    link.trace_mode(TRACE_OFF)
+    with open(path, "wb") as f:
+        f.write(MAGIC + trace)
+    status = link.trace_status()
+    print("%d bytes, %d records dropped by the clock, %d frames lost" % (len(trace), status["dropped"], lost))
+
+
+def replay(link, path):
+    trace = load(path)
+    pos = 0
+    link.trace_mode(TRACE_REPLAY)
+    started = time.monotonic()
+    while pos < len(trace):
+        chunk = trace[pos:pos + CHUNK]
+        taken, room = link.trace_feed(chunk, pos + len(chunk) == len(trace))
+        pos += taken
+        if room < CHUNK:
+            time.sleep(0.01)    # The clock's buffer is full. Give it time to use some
+    # Wait for the clock to play the rest and go back to the panel
+    while link.trace_status()["mode"] == "replay":
+        time.sleep(0.2)
+    status = link.trace_status()
+    print("replayed %d bytes in %.1f s, %d underruns" % (len(trace), time.monotonic() - started, status["underruns"]))
+    show_latency(status)
+
+
+def show_latency(status):
+    print("touch actions %d  last %.1f ms  max %.1f ms" % (
+        status["actions"], status["last_latency_us"] / 1000.0, status["max_latency_us"] / 1000.0))
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Capture and replay touch panel traces")
+    ap.add_argument("args", nargs="+", help="PORT capture FILE | PORT replay FILE | PORT status | dump FILE")
+    ap.add_argument("--seconds", type=float, default=0, help="capture for this long (default: until Ctrl-C)")
+    a = ap.parse_args()
+
+    try:
+        if a.args[0] == "dump" and len(a.args) == 2:
+            dump(a.args[1])
+            return 0
+        if len(a.args) < 2:
+            ap.print_usage(sys.stderr)
+            return 2
+        link = Link(a.args[0])
+        try:
+            if a.args[1] == "capture" and len(a.args) == 3:
+                capture(link, a.args[2], a.seconds)
+            elif a.args[1] == "replay" and len(a.args) == 3:
+                replay(link, a.args[2])
+            elif a.args[1] == "status" and len(a.args) == 2:
+                status = link.trace_status()
+                print("mode %s  dropped %d  underruns %d" % (status["mode"], status["dropped"], status["underruns"]))
+                show_latency(status)
+            else:
+                ap.print_usage(sys.stderr)
+                return 2
+        finally:
+            link.close()
+    except LinkError as e:
+        print("error: %s" % e, file=sys.stderr)
+        return 1
+    except (OSError, ValueError, IndexError) as e:
+        print("error: %s" % e, file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())